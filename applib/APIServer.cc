@@ -21,7 +21,12 @@
 #include <algorithm>
 
 #include <sys/types.h>
+#include <sys/socket.h>
 #include <sys/stat.h>
+#include <sys/mman.h>
+#include <netinet/in.h>
+#include <fcntl.h>
+#include <unistd.h>
 #include <limits.h>
 
 #include <oasys/compat/inet_aton.h>
@@ -47,6 +52,7 @@
 #include "reg/APIRegistration.h"
 #include "reg/RegistrationTable.h"
 #include "routing/BundleRouter.h"
+#include "storage/BundleStore.h"
 #include "storage/GlobalStore.h"
 #include "session/Session.h"
 
@@ -208,6 +214,7 @@ APIClient::~APIClient()
     log_debug("client destroyed");
     delete_z(bindings_);
     delete_z(sessions_);
+    release_shm_payloads();
 }
 
 //----------------------------------------------------------------------
@@ -365,6 +372,10 @@ APIClient::run()
             return;
         }
 
+        // the client is done with any shared memory payloads it was
+        // handed in response to its last message
+        release_shm_payloads();
+
         // dispatch to the handler routine
         switch(type) {
 #define DISPATCH(_type, _fn)                    \
@@ -1159,11 +1170,49 @@ APIClient::handle_send()
     // copy it in yet
     size_t payload_len;
     char filename[PATH_MAX];
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    int shm_fd = -1;
+#endif
 
     switch (payload.location) {
     case DTN_PAYLOAD_MEM:
         payload_len = payload.buf.buf_len;
         break;
+
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    case DTN_PAYLOAD_SHM: {
+        struct stat shminfo;
+
+        if (!is_local_session()) {
+            log_err("shared memory payload sent by a remote client");
+            return DTN_EINVAL;
+        }
+
+        if (payload.filename.filename_len >= sizeof(filename)) {
+            log_err("shared memory payload name too long (%u bytes)",
+                    payload.filename.filename_len);
+            return DTN_EINVAL;
+        }
+        
+        snprintf(filename, sizeof(filename), "%.*s",
+                 (int)payload.filename.filename_len,
+                 payload.filename.filename_val);
+
+        shm_fd = shm_open(filename, O_RDONLY, 0);
+        if (shm_fd < 0 || fstat(shm_fd, &shminfo) != 0)
+        {
+            log_err("payload shared memory %s can't be opened: %s",
+                    filename, strerror(errno));
+            if (shm_fd >= 0) {
+                ::close(shm_fd);
+            }
+            return DTN_EINVAL;
+        }
+        
+        payload_len = shminfo.st_size;
+        break;
+    }
+#endif
         
     case DTN_PAYLOAD_FILE:
     case DTN_PAYLOAD_TEMP_FILE:
@@ -1200,6 +1249,12 @@ APIClient::handle_send()
         log_info("DTN_SEND bundle not accepted: reason %s",
                  BundleStatusReport::reason_to_str(reason));
 
+#ifdef DTN_HAVE_SHM_PAYLOAD
+        if (shm_fd >= 0) {
+            ::close(shm_fd);
+        }
+#endif
+
         switch (reason) {
         case BundleProtocol::REASON_DEPLETED_STORAGE:
             return DTN_ENOSPACE;
@@ -1213,6 +1268,26 @@ APIClient::handle_send()
         b->mutable_payload()->set_data((u_char*)payload.buf.buf_val,
                                        payload.buf.buf_len);
         break;
+
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    case DTN_PAYLOAD_SHM:
+        // the client keeps ownership of the segment and removes it
+        // once we reply, so copy the payload straight out of it
+        if (payload_len != 0) {
+            void* shm = mmap(NULL, payload_len, PROT_READ, MAP_SHARED,
+                             shm_fd, 0);
+            if (shm == MAP_FAILED) {
+                log_err("payload shared memory %s can't be mapped: %s",
+                        filename, strerror(errno));
+                ::close(shm_fd);
+                return DTN_EINVAL;
+            }
+            b->mutable_payload()->write_data((u_char*)shm, 0, payload_len);
+            munmap(shm, payload_len);
+        }
+        ::close(shm_fd);
+        break;
+#endif
         
     case DTN_PAYLOAD_FILE:
         FILE* file;
@@ -1273,8 +1348,12 @@ APIClient::handle_send()
     
     log_info("DTN_SEND bundle *%p", b.object());
 
-    // Sync the bundle payload to disk
-    b->mutable_payload()->sync_payload();
+    // Sync the bundle payload to disk (in group commit mode this is
+    // done by the batch commit that stores the bundle, which happens
+    // before we get notified)
+    if (! BundleStore::instance()->group_commit()) {
+        b->mutable_payload()->sync_payload();
+    }
 
     // deliver the bundle
     // Note: the bundle state may change once it has been posted
@@ -1291,6 +1370,118 @@ APIClient::handle_send()
     return DTN_SUCCESS;
 }
 
+//----------------------------------------------------------------------
+bool
+APIClient::is_local_session()
+{
+    // segment names only mean something on this host, so the client
+    // must have connected over loopback or to one of our own addresses
+    if ((ntohl(remote_addr()) >> IN_CLASSA_NSHIFT) == IN_LOOPBACKNET) {
+        return true;
+    }
+
+    struct sockaddr_in sa;
+    socklen_t salen = sizeof(sa);
+    memset(&sa, 0, sizeof(sa));
+    if (::getsockname(TCPClient::fd_, (struct sockaddr*)&sa, &salen) != 0) {
+        log_err("error getting local address of session: %s",
+                strerror(errno));
+        return false;
+    }
+
+    return sa.sin_addr.s_addr == remote_addr();
+}
+
+#ifdef DTN_HAVE_SHM_PAYLOAD
+//----------------------------------------------------------------------
+// Fill the buffer with unpredictable bytes for a segment name, falling
+// back to random() if /dev/urandom can't be read.
+static void
+shm_nonce(void* buf, size_t len)
+{
+    int fd = ::open("/dev/urandom", O_RDONLY);
+    if (fd >= 0) {
+        ssize_t cc = ::read(fd, buf, len);
+        ::close(fd);
+        if (cc == (ssize_t)len) {
+            return;
+        }
+    }
+
+    for (size_t i = 0; i < len; ++i) {
+        ((u_char*)buf)[i] = random() & 0xff;
+    }
+}
+#endif
+
+//----------------------------------------------------------------------
+int
+APIClient::export_shm_payload(Bundle* b, char* name, size_t namelen)
+{
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    size_t payload_len = b->payload().length();
+    
+    // the name can't be guessed by other local users, and the segment
+    // is only accessible to the daemon's own user, so the client has
+    // to run as that same user
+    u_int32_t nonce[2];
+    shm_nonce(nonce, sizeof(nonce));
+    snprintf(name, namelen, "/dtn-recv-%d-%08x%08x",
+             (int)getpid(), nonce[0], nonce[1]);
+
+    int fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        log_err("can't create shared memory %s to deliver bundle: %s",
+                name, strerror(errno));
+        return DTN_EINTERNAL;
+    }
+    shm_payloads_.push_back(name);
+
+    if (ftruncate(fd, payload_len) != 0) {
+        log_err("can't size shared memory %s to %zu bytes: %s",
+                name, payload_len, strerror(errno));
+        ::close(fd);
+        return DTN_EINTERNAL;
+    }
+
+    if (payload_len != 0) {
+        void* shm = mmap(NULL, payload_len, PROT_WRITE, MAP_SHARED, fd, 0);
+        if (shm == MAP_FAILED) {
+            log_err("can't map shared memory %s: %s", name, strerror(errno));
+            ::close(fd);
+            return DTN_EINTERNAL;
+        }
+        b->payload().read_data(0, payload_len, (u_char*)shm);
+        munmap(shm, payload_len);
+    }
+    
+    ::close(fd);
+    return 0;
+#else
+    (void)b;
+    (void)name;
+    (void)namelen;
+    log_err("shared memory payloads not supported");
+    return DTN_EINVAL;
+#endif
+}
+
+//----------------------------------------------------------------------
+void
+APIClient::release_shm_payloads()
+{
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    for (size_t i = 0; i < shm_payloads_.size(); ++i) {
+        // the client usually gets there first
+        if (shm_unlink(shm_payloads_[i].c_str()) != 0 && errno != ENOENT) {
+            log_warn("error removing shared memory %s: %s",
+                     shm_payloads_[i].c_str(), strerror(errno));
+        }
+    }
+#endif
+    shm_payloads_.clear();
+}
+
 //----------------------------------------------------------------------
 int
 APIClient::handle_cancel()
@@ -1378,6 +1569,7 @@ APIClient::handle_recv()
     APIRegistration*              reg = NULL;
     bool                          sock_ready = false;
     oasys::FileIOClient           tmpfile;
+    char                          shm_name[64];
 
     // unpack the arguments
     if ((!xdr_dtn_bundle_payload_location_t(&xdr_decode_, &location)) ||
@@ -1386,6 +1578,11 @@ APIClient::handle_recv()
         log_err("error in xdr unpacking arguments");
         return DTN_EXDR;
     }
+
+    if (location == DTN_PAYLOAD_SHM && !is_local_session()) {
+        log_err("shared memory payload requested by a remote client");
+        return DTN_EINVAL;
+    }
     
     int err = wait_for_notify("recv", timeout, &reg, NULL, &sock_ready);
     if (err != 0) {
@@ -1610,6 +1807,17 @@ APIClient::handle_recv()
             payload.buf.buf_val = 0;
         }
         
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    } else if (location == DTN_PAYLOAD_SHM) {
+        // the app wants the payload in memory, however big it is
+        int err = export_shm_payload(b.object(), shm_name, sizeof(shm_name));
+        if (err != 0) {
+            return err;
+        }
+        payload.filename.filename_val = shm_name;
+        payload.filename.filename_len = strlen(shm_name) + 1;
+#endif
+
     } else if (location == DTN_PAYLOAD_FILE) {
         const char *tdir;
         char templ[64];
@@ -1718,6 +1926,7 @@ APIClient::handle_peek()
     APIRegistration*              reg = NULL;
     bool                          sock_ready = false;
     oasys::FileIOClient           tmpfile;
+    char                          shm_name[64];
 
     // unpack the arguments
     if ((!xdr_dtn_bundle_payload_location_t(&xdr_decode_, &location)) ||
@@ -1726,6 +1935,11 @@ APIClient::handle_peek()
         log_err("error in xdr unpacking arguments");
         return DTN_EXDR;
     }
+
+    if (location == DTN_PAYLOAD_SHM && !is_local_session()) {
+        log_err("shared memory payload requested by a remote client");
+        return DTN_EINVAL;
+    }
     
     int err = wait_for_notify("recv", timeout, &reg, NULL, &sock_ready);
     if (err != 0) {
@@ -1886,6 +2100,17 @@ APIClient::handle_peek()
             payload.buf.buf_val = 0;
         }
         
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    } else if (location == DTN_PAYLOAD_SHM) {
+        // the app wants the payload in memory, however big it is
+        int err = export_shm_payload(b.object(), shm_name, sizeof(shm_name));
+        if (err != 0) {
+            return err;
+        }
+        payload.filename.filename_val = shm_name;
+        payload.filename.filename_len = strlen(shm_name) + 1;
+#endif
+
     } else if (location == DTN_PAYLOAD_FILE) {
         const char *tdir;
         char templ[64];
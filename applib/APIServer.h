@@ -18,6 +18,8 @@
 #define _APISERVER_H_
 
 #include <list>
+#include <string>
+#include <vector>
 
 #include <oasys/compat/rpc.h>
 #include <oasys/debug/Log.h>
@@ -34,6 +36,7 @@ namespace dtn {
 
 class APIClient;
 class APIRegistration;
+class Bundle;
 class APIRegistrationList;
 
 /**
@@ -126,6 +129,21 @@ protected:
     int send_response(int ret);
 
     bool is_bound(u_int32_t regid);
+
+    // whether the client is on this host, which is required for
+    // DTN_PAYLOAD_SHM payloads
+    bool is_local_session();
+
+    // copy the payload of a bundle being delivered with the
+    // DTN_PAYLOAD_SHM location into a new shared memory segment,
+    // returning its name in the given buffer
+    int export_shm_payload(Bundle* b, char* name, size_t namelen);
+
+    // remove the shared memory segments handed out for earlier
+    // deliveries. the client maps the segment before it returns from
+    // dtn_recv or dtn_peek, so this is safe once the next message
+    // arrives (or the session closes)
+    void release_shm_payloads();
     
     char buf_[DTN_MAX_API_MSG];
     XDR xdr_encode_;
@@ -136,6 +154,7 @@ protected:
     APIServer* parent_;
     size_t total_sent_;
     size_t total_rcvd_;
+    std::vector<std::string> shm_payloads_;
 };
 
 } // namespace dtn
@@ -30,6 +30,7 @@
 #include <netinet/in.h>
 #include <stdlib.h>
 #include <unistd.h>
+#include <sys/mman.h>
 
 #include "dtn_api.h"
 #include "dtn_ipc.h"
@@ -432,6 +433,116 @@ dtn_unbind(dtn_handle_t h, dtn_reg_id_t regid)
     return 0;
 }
 
+#ifdef DTN_HAVE_SHM_PAYLOAD
+//----------------------------------------------------------------------
+// Copy an in-memory payload into a new shared memory segment for the
+// daemon to read. The caller unlinks the segment once dtn_send returns.
+static int
+dtn_shm_export(const char* buf, unsigned int len, char* name, size_t namelen)
+{
+    unsigned int nonce[2];
+    unsigned int i;
+    int fd;
+    void* p;
+
+    // use a name other local users can't guess, and only let the
+    // daemon's user (which must be ours) open the segment
+    fd = open("/dev/urandom", O_RDONLY);
+    if (fd < 0 || read(fd, nonce, sizeof(nonce)) != sizeof(nonce)) {
+        for (i = 0; i < 2; ++i) {
+            nonce[i] = (unsigned int)random();
+        }
+    }
+    if (fd >= 0) {
+        close(fd);
+    }
+    
+    snprintf(name, namelen, "/dtn-send-%d-%08x%08x",
+             (int)getpid(), nonce[0], nonce[1]);
+
+    fd = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0600);
+    if (fd < 0) {
+        fprintf(stderr, "DTN API error creating shared memory %s: %s\n",
+                name, strerror(errno));
+        return DTN_EINTERNAL;
+    }
+
+    if (ftruncate(fd, len) != 0) {
+        fprintf(stderr, "DTN API error sizing shared memory %s: %s\n",
+                name, strerror(errno));
+        close(fd);
+        shm_unlink(name);
+        return DTN_EINTERNAL;
+    }
+
+    if (len != 0) {
+        p = mmap(NULL, len, PROT_WRITE, MAP_SHARED, fd, 0);
+        if (p == MAP_FAILED) {
+            fprintf(stderr, "DTN API error mapping shared memory %s: %s\n",
+                    name, strerror(errno));
+            close(fd);
+            shm_unlink(name);
+            return DTN_EINTERNAL;
+        }
+        memcpy(p, buf, len);
+        munmap(p, len);
+    }
+
+    close(fd);
+    return 0;
+}
+
+//----------------------------------------------------------------------
+// Map a shared memory segment handed back by the daemon in dtn_recv
+// or dtn_peek into the payload buffer, which is then unmapped by
+// dtn_free_payload.
+static int
+dtn_shm_import(dtn_bundle_payload_t* payload)
+{
+    char name[PATH_MAX];
+    struct stat st;
+    void* p = NULL;
+    int fd;
+
+    snprintf(name, sizeof(name), "%.*s",
+             (int)payload->filename.filename_len,
+             payload->filename.filename_val);
+
+    fd = shm_open(name, O_RDONLY, 0);
+    if (fd < 0) {
+        fprintf(stderr, "DTN API internal error opening shared memory %s: %s\n",
+                name, strerror(errno));
+        return DTN_EXDR;
+    }
+
+    if (fstat(fd, &st) != 0) {
+        fprintf(stderr, "DTN API internal error getting stat of shared memory: %s\n",
+                strerror(errno));
+        close(fd);
+        return DTN_EXDR;
+    }
+
+    if (st.st_size != 0) {
+        p = mmap(NULL, st.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (p == MAP_FAILED) {
+            fprintf(stderr, "DTN API internal error mapping shared memory: %s\n",
+                    strerror(errno));
+            close(fd);
+            return DTN_EXDR;
+        }
+    }
+    close(fd);
+
+    // the daemon removes the segment itself if we lack permission to
+    shm_unlink(name);
+
+    free(payload->buf.buf_val);
+    payload->buf.buf_val = (char*)p;
+    payload->buf.buf_len = st.st_size;
+    return 0;
+}
+#endif /* DTN_HAVE_SHM_PAYLOAD */
+
 //----------------------------------------------------------------------
 int
 dtn_send(dtn_handle_t h,
@@ -450,6 +561,34 @@ dtn_send(dtn_handle_t h,
         return -1;
     }
 
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    // shared memory payloads are handed to the daemon by name in
+    // place of the in-band buffer
+    dtn_bundle_payload_t shm_payload;
+    char shm_name[128];
+    shm_name[0] = '\0';
+    
+    if (payload->location == DTN_PAYLOAD_SHM) {
+        int err = dtn_shm_export(payload->buf.buf_val, payload->buf.buf_len,
+                                 shm_name, sizeof(shm_name));
+        if (err != 0) {
+            handle->err = err;
+            return -1;
+        }
+
+        memset(&shm_payload, 0, sizeof(shm_payload));
+        shm_payload.location = DTN_PAYLOAD_SHM;
+        shm_payload.filename.filename_val = shm_name;
+        shm_payload.filename.filename_len = strlen(shm_name) + 1;
+        payload = &shm_payload;
+    }
+#else
+    if (payload->location == DTN_PAYLOAD_SHM) {
+        handle->err = DTN_EINVAL;
+        return -1;
+    }
+#endif
+
     // pack the arguments
     if ((!xdr_dtn_reg_id_t(xdr_encode, &regid)) ||
         (!xdr_dtn_bundle_spec_t(xdr_encode, spec)) ||
@@ -459,7 +598,16 @@ dtn_send(dtn_handle_t h,
     }
 
     // send the message
-    if (dtnipc_send_recv(handle, DTN_SEND) < 0) {
+    int ret = dtnipc_send_recv(handle, DTN_SEND);
+
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    // the daemon has copied the payload out by the time it replies
+    if (shm_name[0] != '\0') {
+        shm_unlink(shm_name);
+    }
+#endif
+    
+    if (ret < 0) {
         return -1;
     }
     
@@ -606,6 +754,16 @@ dtn_recv(dtn_handle_t h,
             return DTN_EXDR;
         }
     }
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    else if (location == DTN_PAYLOAD_SHM &&
+             payload->location == DTN_PAYLOAD_SHM)
+    {
+        if (dtn_shm_import(payload) != 0) {
+            handle->err = DTN_EXDR;
+            return -1;
+        }
+    }
+#endif
     else if (location != payload->location)
     {
         fprintf(stderr,
@@ -759,6 +917,16 @@ dtn_peek(dtn_handle_t h,
             return DTN_EXDR;
         }
     }
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    else if (location == DTN_PAYLOAD_SHM &&
+             payload->location == DTN_PAYLOAD_SHM)
+    {
+        if (dtn_shm_import(payload) != 0) {
+            handle->err = DTN_EXDR;
+            return -1;
+        }
+    }
+#endif
     else if (location != payload->location)
     {
         fprintf(stderr,
@@ -964,6 +1132,7 @@ dtn_set_payload(dtn_bundle_payload_t* payload,
     
     switch (location) {
     case DTN_PAYLOAD_MEM:
+    case DTN_PAYLOAD_SHM:
         payload->buf.buf_val = val;
         payload->buf.buf_len = len;
         break;
@@ -981,6 +1150,14 @@ dtn_set_payload(dtn_bundle_payload_t* payload,
 void
 dtn_free_payload(dtn_bundle_payload_t* payload)
 {
+#ifdef DTN_HAVE_SHM_PAYLOAD
+    // received shared memory payloads are mapped, not malloc'd
+    if (payload->location == DTN_PAYLOAD_SHM && payload->buf.buf_val != NULL) {
+        munmap(payload->buf.buf_val, payload->buf.buf_len);
+        payload->buf.buf_val = NULL;
+        payload->buf.buf_len = 0;
+    }
+#endif
     xdr_free((xdrproc_t)xdr_dtn_bundle_payload_t, (char*)payload);
 }
 
@@ -269,6 +269,12 @@ extern int dtn_parse_eid_string(dtn_endpoint_id_t* eid, const char* str);
  * Sets the value of the given payload structure to either a memory
  * buffer or a file location.
  *
+ * The DTN_PAYLOAD_SHM location also takes a memory buffer, but it has
+ * no size limit. The buffer is passed to the daemon in a POSIX shared
+ * memory segment instead of in the IPC message, so it can only be used
+ * by an application on the same host and running as the same user as
+ * the daemon (which rejects it from remote clients with DTN_EINVAL).
+ *
  * Returns: 0 on success, DTN_ESIZE if the memory location is
  * selected and the payload is too big.
  */
@@ -278,7 +284,8 @@ extern int dtn_set_payload(dtn_bundle_payload_t* payload,
 
 /**
  * Frees dynamic storage allocated by the xdr for a bundle payload in
- * dtn_recv.
+ * dtn_recv. This also unmaps a payload received with the
+ * DTN_PAYLOAD_SHM location.
  */
 void dtn_free_payload(dtn_bundle_payload_t* payload);
 
@@ -247,6 +247,11 @@ dtn_send(int           handle,
         payload.buf.buf_val = (char*)payload_data.data();
         payload.buf.buf_len = payload_data.length();
         break;
+    case DTN_PAYLOAD_SHM:
+        payload.location    = DTN_PAYLOAD_SHM;
+        payload.buf.buf_val = (char*)payload_data.data();
+        payload.buf.buf_len = payload_data.length();
+        break;
     case DTN_PAYLOAD_FILE:
         payload.location = DTN_PAYLOAD_FILE;
         payload.filename.filename_val = (char*)payload_data.data();
@@ -371,6 +376,10 @@ dtn_recv(int handle, unsigned int payload_location, int timeout)
         bundle->payload.assign(payload.buf.buf_val,
                                payload.buf.buf_len);
         break;
+    case DTN_PAYLOAD_SHM:
+        bundle->payload.assign(payload.buf.buf_val,
+                               payload.buf.buf_len);
+        break;
     case DTN_PAYLOAD_FILE:
     case DTN_PAYLOAD_TEMP_FILE:
         bundle->payload.assign(payload.filename.filename_val,
@@ -408,6 +417,12 @@ dtn_recv(int handle, unsigned int payload_location, int timeout)
         bundle->status_report = NULL;
     }
 
+    // unmap the segment only now, since freeing the payload also
+    // frees the status report
+    if (location == DTN_PAYLOAD_SHM) {
+        dtn_free_payload(&payload);
+    }
+
     return bundle;
 }
 
@@ -448,6 +463,10 @@ dtn_peek(int handle, unsigned int payload_location, int timeout)
         bundle->payload.assign(payload.buf.buf_val,
                                payload.buf.buf_len);
         break;
+    case DTN_PAYLOAD_SHM:
+        bundle->payload.assign(payload.buf.buf_val,
+                               payload.buf.buf_len);
+        break;
     case DTN_PAYLOAD_FILE:
     case DTN_PAYLOAD_TEMP_FILE:
         bundle->payload.assign(payload.filename.filename_val,
@@ -485,6 +504,12 @@ dtn_peek(int handle, unsigned int payload_location, int timeout)
         bundle->status_report = NULL;
     }
 
+    // unmap the segment only now, since freeing the payload also
+    // frees the status report
+    if (location == DTN_PAYLOAD_SHM) {
+        dtn_free_payload(&payload);
+    }
+
     return bundle;
 }
 
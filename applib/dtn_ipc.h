@@ -18,6 +18,7 @@
 #define DTN_IPC_H
 
 #include <rpc/rpc.h>
+#include <unistd.h>
 
 #ifdef __CYGWIN__
 #include <stdio.h>
@@ -60,6 +61,16 @@ extern "C" {
  */
 #define DTN_MAX_API_MSG 65536
 
+/**
+ * Whether DTN_PAYLOAD_SHM payloads can be used, which requires POSIX
+ * shared memory objects. The location was added without changing the
+ * message formats, so the IPC version is unchanged and a daemon that
+ * doesn't support it simply rejects it with DTN_EINVAL.
+ */
+#if defined(_POSIX_SHARED_MEMORY_OBJECTS) && (_POSIX_SHARED_MEMORY_OBJECTS > 0)
+#define DTN_HAVE_SHM_PAYLOAD 1
+#endif
+
 /**
  * State of a DTN IPC channel.
  */
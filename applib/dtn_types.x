@@ -367,11 +367,15 @@ struct dtn_bundle_status_report_t {
 % *     DTN_PAYLOAD_MEM         - payload contents in memory
 % *     DTN_PAYLOAD_FILE        - payload contents in file
 % *     DTN_PAYLOAD_TEMP_FILE   - in file, assume ownership (send only)
+% *     DTN_PAYLOAD_SHM         - in memory of any size, passed to and
+% *                               from the daemon in a POSIX shared
+% *                               memory segment named by 'filename'
 % */
 enum dtn_bundle_payload_location_t {
     DTN_PAYLOAD_FILE,
     DTN_PAYLOAD_MEM,
-    DTN_PAYLOAD_TEMP_FILE
+    DTN_PAYLOAD_TEMP_FILE,
+    DTN_PAYLOAD_SHM
 };
 
 struct dtn_bundle_payload_t
@@ -12230,6 +12230,11 @@ XS(SWIG_init) {
     sv_setsv(sv, SWIG_From_int  SWIG_PERL_CALL_ARGS_1(static_cast< int >(DTN_PAYLOAD_TEMP_FILE)));
     SvREADONLY_on(sv);
   } while(0) /*@SWIG@*/;
+  /*@SWIG:/usr/local/share/swig/1.3.35/perl5/perltypemaps.swg,64,%set_constant@*/ do {
+    SV *sv = get_sv((char*) SWIG_prefix "DTN_PAYLOAD_SHM", TRUE | 0x2 | GV_ADDMULTI);
+    sv_setsv(sv, SWIG_From_int  SWIG_PERL_CALL_ARGS_1(static_cast< int >(DTN_PAYLOAD_SHM)));
+    SvREADONLY_on(sv);
+  } while(0) /*@SWIG@*/;
   SWIG_TypeClientData(SWIGTYPE_p_dtn_bundle_payload_t, (void*) "dtnapi::dtn_bundle_payload_t");
   SWIG_TypeClientData(SWIGTYPE_p_dtn_bundle_payload_t_buf, (void*) "dtnapi::dtn_bundle_payload_t_buf");
   SWIG_TypeClientData(SWIGTYPE_p_dtn_bundle_payload_t_filename, (void*) "dtnapi::dtn_bundle_payload_t_filename");
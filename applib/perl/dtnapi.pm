@@ -1103,6 +1103,7 @@ package dtnapi;
 *DTN_PAYLOAD_FILE = *dtnapic::DTN_PAYLOAD_FILE;
 *DTN_PAYLOAD_MEM = *dtnapic::DTN_PAYLOAD_MEM;
 *DTN_PAYLOAD_TEMP_FILE = *dtnapic::DTN_PAYLOAD_TEMP_FILE;
+*DTN_PAYLOAD_SHM = *dtnapic::DTN_PAYLOAD_SHM;
 *DTN_SUCCESS = *dtnapic::DTN_SUCCESS;
 *DTN_ERRBASE = *dtnapic::DTN_ERRBASE;
 *DTN_EINVAL = *dtnapic::DTN_EINVAL;
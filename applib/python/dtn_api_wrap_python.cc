@@ -11828,6 +11828,7 @@ SWIGEXPORT void SWIG_init(void) {
   SWIG_Python_SetConstant(d, "DTN_PAYLOAD_FILE",SWIG_From_int(static_cast< int >(DTN_PAYLOAD_FILE)));
   SWIG_Python_SetConstant(d, "DTN_PAYLOAD_MEM",SWIG_From_int(static_cast< int >(DTN_PAYLOAD_MEM)));
   SWIG_Python_SetConstant(d, "DTN_PAYLOAD_TEMP_FILE",SWIG_From_int(static_cast< int >(DTN_PAYLOAD_TEMP_FILE)));
+  SWIG_Python_SetConstant(d, "DTN_PAYLOAD_SHM",SWIG_From_int(static_cast< int >(DTN_PAYLOAD_SHM)));
   SWIG_Python_SetConstant(d, "DTN_SUCCESS",SWIG_From_int(static_cast< int >(0)));
   SWIG_Python_SetConstant(d, "DTN_ERRBASE",SWIG_From_int(static_cast< int >(128)));
   SWIG_Python_SetConstant(d, "DTN_EINVAL",SWIG_From_int(static_cast< int >((128+1))));
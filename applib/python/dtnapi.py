@@ -389,6 +389,7 @@ dtn_bundle_status_report_t_swigregister(dtn_bundle_status_report_t)
 DTN_PAYLOAD_FILE = _dtnapi.DTN_PAYLOAD_FILE
 DTN_PAYLOAD_MEM = _dtnapi.DTN_PAYLOAD_MEM
 DTN_PAYLOAD_TEMP_FILE = _dtnapi.DTN_PAYLOAD_TEMP_FILE
+DTN_PAYLOAD_SHM = _dtnapi.DTN_PAYLOAD_SHM
 class dtn_bundle_payload_t:
     __swig_setmethods__ = {}
     __setattr__ = lambda self, name, value: _swig_setattr(self, dtn_bundle_payload_t, name, value)
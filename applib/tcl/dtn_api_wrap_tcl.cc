@@ -10340,6 +10340,7 @@ SWIGEXPORT int SWIG_init(Tcl_Interp *interp) {
   SWIG_Tcl_SetConstantObj(interp, "DTN_PAYLOAD_FILE", SWIG_From_int(static_cast< int >(DTN_PAYLOAD_FILE)));
   SWIG_Tcl_SetConstantObj(interp, "DTN_PAYLOAD_MEM", SWIG_From_int(static_cast< int >(DTN_PAYLOAD_MEM)));
   SWIG_Tcl_SetConstantObj(interp, "DTN_PAYLOAD_TEMP_FILE", SWIG_From_int(static_cast< int >(DTN_PAYLOAD_TEMP_FILE)));
+  SWIG_Tcl_SetConstantObj(interp, "DTN_PAYLOAD_SHM", SWIG_From_int(static_cast< int >(DTN_PAYLOAD_SHM)));
   SWIG_Tcl_SetConstantObj(interp, "DTN_SUCCESS", SWIG_From_int(static_cast< int >(0)));
   SWIG_Tcl_SetConstantObj(interp, "DTN_ERRBASE", SWIG_From_int(static_cast< int >(128)));
   SWIG_Tcl_SetConstantObj(interp, "DTN_EINVAL", SWIG_From_int(static_cast< int >((128+1))));
@@ -47,6 +47,9 @@ namespace dtntunnel {
 //----------------------------------------------------------------------
 DTNTunnel::DTNTunnel()
     : App("DTNTunnel", "dtntunnel"),
+      udptunnel_(NULL),
+      tcptunnel_(NULL),
+      sender_(NULL),
       send_lock_("/dtntunnel", oasys::Mutex::TYPE_RECURSIVE, true),
       listen_(false),
       custody_(false),
@@ -63,7 +66,10 @@ DTNTunnel::DTNTunnel()
       max_size_(32 * 1024),
       tunnel_spec_(""),
       tunnel_spec_set_(false),
-      transparent_(false)
+      transparent_(false),
+      window_(4),
+      coalesce_(false),
+      latency_(100)
 {
     // override default logging setting
     loglevel_ = oasys::LOG_NOTICE;
@@ -72,6 +78,117 @@ DTNTunnel::DTNTunnel()
     memset(&dest_eid_,  0, sizeof(dest_eid_));
 }
 
+//----------------------------------------------------------------------
+SendWindow::SendWindow(const char* logpath, u_int depth)
+    : notifier_(logpath),
+      depth_(depth),
+      in_flight_(0),
+      bundles_sent_(0),
+      bytes_sent_(0)
+{
+}
+
+//----------------------------------------------------------------------
+void
+SendWindow::add()
+{
+    oasys::ScopeLock l(&lock_, "SendWindow::add");
+    ++in_flight_;
+}
+
+//----------------------------------------------------------------------
+void
+SendWindow::done(size_t len)
+{
+    // notify under the lock, since the connection may go away as
+    // soon as it sees the window empty
+    oasys::ScopeLock l(&lock_, "SendWindow::done");
+    ASSERT(in_flight_ > 0);
+    --in_flight_;
+    ++bundles_sent_;
+    bytes_sent_ += len;
+    notifier_.notify();
+}
+
+//----------------------------------------------------------------------
+bool
+SendWindow::full()
+{
+    oasys::ScopeLock l(&lock_, "SendWindow::full");
+    return in_flight_ >= depth_;
+}
+
+//----------------------------------------------------------------------
+u_int
+SendWindow::in_flight()
+{
+    oasys::ScopeLock l(&lock_, "SendWindow::in_flight");
+    return in_flight_;
+}
+
+//----------------------------------------------------------------------
+void
+SendWindow::wait_empty()
+{
+    while (in_flight() != 0) {
+        notifier_.wait(NULL, 1000);
+    }
+}
+
+//----------------------------------------------------------------------
+u_int32_t
+SendWindow::bundles_sent()
+{
+    oasys::ScopeLock l(&lock_, "SendWindow::bundles_sent");
+    return bundles_sent_;
+}
+
+//----------------------------------------------------------------------
+u_int64_t
+SendWindow::bytes_sent()
+{
+    oasys::ScopeLock l(&lock_, "SendWindow::bytes_sent");
+    return bytes_sent_;
+}
+
+//----------------------------------------------------------------------
+DTNTunnel::Sender::Sender(DTNTunnel* t)
+    : Thread("DTNTunnel::Sender"),
+      Logger("DTNTunnel::Sender", "/dtntunnel/sender"),
+      queue_("/dtntunnel/sender"),
+      tunnel_(t)
+{
+}
+
+//----------------------------------------------------------------------
+void
+DTNTunnel::Sender::run()
+{
+    while (1) {
+        Send s = queue_.pop_blocking();
+        size_t len = s.bundle_->payload_.len();
+
+        int err;
+        while ((err = tunnel_->send_bundle(s.bundle_, &s.bundle_->spec_.dest))
+               == DTN_ENOSPACE)
+        {
+            log_debug("no space for %zu byte payload... "
+                      "retrying in one second", len);
+            sleep(1);
+        }
+
+        if (err != DTN_SUCCESS) {
+            log_err("error sending bundle: %s", dtn_strerror(err));
+            exit(1);
+        }
+
+        log_debug("sent %zu byte payload to dtn (%zu queued)",
+                  len, queue_.size());
+        delete s.bundle_;
+        s.window_->done(len - sizeof(BundleHeader));
+    }
+}
+
 //----------------------------------------------------------------------
 void
 DTNTunnel::fill_options()
@@ -111,6 +228,21 @@ DTNTunnel::fill_options()
         new oasys::UIntOpt('z', "max_size", &max_size_, "<bytes>",
                            "maximum bundle size for stream transports (e.g. tcp)"));
 
+    opts_.addopt(
+        new oasys::UIntOpt("window", &window_, "<bundles>",
+                           "bundles in flight per connection for stream "
+                           "transports"));
+
+    opts_.addopt(
+        new oasys::BoolOpt("coalesce", &coalesce_,
+                           "coalesce stream data adaptively: send when "
+                           "max_size is reached, the latency budget runs "
+                           "out or nothing is in flight (overrides delay)"));
+
+    opts_.addopt(
+        new oasys::UIntOpt("latency", &latency_, "<millisecs>",
+                           "latency budget in msecs for coalesced bundles"));
+
     opts_.addopt(
         new oasys::StringOpt('T', "tunnel", &tunnel_spec_, "<spec>",
                              "tunnel specification [lhost:]lport:rhost:rport",
@@ -223,6 +355,13 @@ DTNTunnel::validate_options(int argc, char* const argv[], int remainder)
 		  "only in transparent_proxy mode");
 	}
     }
+
+    // the tcp connections on both ends bundle up their data
+    CHECK_OPT(max_size_ <= sizeof(BundleHeader) ||
+              max_size_ > DTN_MAX_BUNDLE_MEM,
+              "max_size must fit a header and data in an "
+              "in-memory bundle");
+    CHECK_OPT(window_ == 0, "window must be at least one bundle");
     
 #undef CHECK_OPT
 }
@@ -327,6 +466,11 @@ DTNTunnel::get_dest_eid(in_addr_t remote_addr, dtn_endpoint_id_t* dest_eid)
 void
 DTNTunnel::init_tunnel()
 {
+    // created before the listeners so that connections can queue
+    // bundles from the start, but only started once the send handle
+    // is open
+    sender_ = new Sender(this);
+
     tcptunnel_ = new TCPTunnel();
     udptunnel_ = new UDPTunnel();
 
@@ -459,6 +603,21 @@ DTNTunnel::send_bundle(dtn::APIBundle* bundle, dtn_endpoint_id_t* dest_eid)
     return DTN_SUCCESS;
 }
 
+//----------------------------------------------------------------------
+void
+DTNTunnel::queue_bundle(dtn::APIBundle* bundle, dtn_endpoint_id_t* dest_eid,
+                        SendWindow* window)
+{
+    ASSERT(sender_ != NULL);
+    dtn_copy_eid(&bundle->spec_.dest, dest_eid);
+    window->add();
+
+    Sender::Send s;
+    s.bundle_ = bundle;
+    s.window_ = window;
+    sender_->queue_.push_back(s);
+}
+
 //----------------------------------------------------------------------
 int
 DTNTunnel::handle_bundle(dtn_bundle_spec_t* spec,
@@ -506,6 +665,8 @@ DTNTunnel::main(int argc, char* argv[])
     init_tunnel();
     init_registration();
 
+    sender_->start();
+
     // if we've daemonized, now is the time to notify our parent
     // process that we've successfully initialized
     if (daemonize_) {
@@ -26,7 +26,11 @@
 #include <dtn_api.h>
 #include <APIBundleQueue.h>
 #include <oasys/debug/Log.h>
+#include <oasys/thread/MsgQueue.h>
 #include <oasys/thread/Mutex.h>
+#include <oasys/thread/Notifier.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/thread/Thread.h>
 #include <oasys/util/App.h>
 #include <oasys/util/Singleton.h>
 
@@ -35,6 +39,55 @@ namespace dtntunnel {
 class TCPTunnel;
 class UDPTunnel;
 
+/**
+ * Tracks the bundles a stream connection has queued for the sender
+ * thread but that haven't yet been handed to the daemon, so that
+ * several can be in flight without the connection blocking in
+ * dtn_send.
+ */
+class SendWindow {
+public:
+    /// Constructor
+    SendWindow(const char* logpath, u_int depth);
+
+    /// Called by the connection as it queues a bundle
+    void add();
+
+    /// Called by the sender once a bundle carrying len bytes of
+    /// stream data has been handed to the daemon
+    void done(size_t len);
+
+    /// Whether the window is full
+    bool full();
+
+    /// Number of bundles queued but not yet sent
+    u_int in_flight();
+
+    /// File descriptor that becomes readable when a send completes
+    int read_fd() { return notifier_.read_fd(); }
+
+    /// Clear the completion notification, before looking at the
+    /// window after a poll
+    void clear() { notifier_.clear(); }
+
+    /// Wait until all the queued bundles have been sent
+    void wait_empty();
+
+    /// Number of bundles handed to the daemon
+    u_int32_t bundles_sent();
+
+    /// Stream data handed to the daemon in those bundles
+    u_int64_t bytes_sent();
+
+protected:
+    oasys::SpinLock lock_;
+    oasys::Notifier notifier_;
+    u_int           depth_;
+    u_int           in_flight_;
+    u_int32_t       bundles_sent_;
+    u_int64_t       bytes_sent_;
+};
+
 /**
  * Main wrapper class for the DTN Tunnel.
  */
@@ -93,6 +146,13 @@ public:
     /// @return DTN_SUCCESS on success, a DTN_ERRNO value on error
     int send_bundle(dtn::APIBundle* bundle, dtn_endpoint_id_t* dest_eid);
 
+    /// Queue a bundle to be sent by the sender thread, which shares
+    /// the one send handle among all the connections. Assumes
+    /// ownership of the passed-in bundle, and the window must
+    /// outlive the send.
+    void queue_bundle(dtn::APIBundle* bundle, dtn_endpoint_id_t* dest_eid,
+                      SendWindow* window);
+
     /// Called for arriving bundles
     int handle_bundle(dtn_bundle_spec_t* spec,
                       dtn_bundle_payload_t* payload);
@@ -113,11 +173,38 @@ public:
     u_int delay_set()             { return delay_set_; }
     bool reorder_udp()            { return reorder_udp_; }
     bool transparent()            { return transparent_; }
+    u_int window()                { return window_; }
+    bool coalesce()               { return coalesce_; }
+    u_int latency()               { return latency_; }
     dtn_endpoint_id_t* dest_eid() { return &dest_eid_; }
 
 protected:
+    /// Thread that sends the bundles queued by the stream connections
+    class Sender : public oasys::Thread,
+                   public oasys::Logger
+    {
+    public:
+        Sender(DTNTunnel* t);
+
+        /// A queued bundle and the window it counts against
+        struct Send {
+            dtn::APIBundle* bundle_;
+            SendWindow*     window_;
+        };
+
+        /// Queue of bundles to send
+        oasys::MsgQueue<Send> queue_;
+
+    protected:
+        /// virtual run method
+        void run();
+
+        DTNTunnel* tunnel_;
+    };
+
     UDPTunnel*          udptunnel_;
     TCPTunnel*          tcptunnel_;
+    Sender*             sender_;
 
     dtn_handle_t 	recv_handle_;
     dtn_handle_t 	send_handle_;
@@ -140,6 +227,9 @@ protected:
     std::string	        tunnel_spec_;
     bool	        tunnel_spec_set_;
     bool		transparent_;
+    u_int		window_;
+    bool		coalesce_;
+    u_int		latency_;
 
     /// Helper struct for network IP address in CIDR notation
     struct CIDR {
@@ -113,6 +113,60 @@ TCPTunnel::kill_connection(Connection* c)
 
 }
 
+//----------------------------------------------------------------------
+void
+TCPTunnel::add_stats(const Stats& stats)
+{
+    oasys::ScopeLock l(&lock_, "TCPTunnel::add_stats");
+    totals_.add(stats);
+
+    oasys::StringBuffer buf;
+    totals_.format(&buf, 0);
+    log_notice("tunnel totals: %s", buf.c_str());
+}
+
+//----------------------------------------------------------------------
+TCPTunnel::Stats::Stats()
+    : connections_(0),
+      bytes_to_dtn_(0),
+      bundles_to_dtn_(0),
+      bytes_from_dtn_(0),
+      bundles_from_dtn_(0)
+{
+}
+
+//----------------------------------------------------------------------
+void
+TCPTunnel::Stats::add(const Stats& other)
+{
+    connections_      += other.connections_;
+    bytes_to_dtn_     += other.bytes_to_dtn_;
+    bundles_to_dtn_   += other.bundles_to_dtn_;
+    bytes_from_dtn_   += other.bytes_from_dtn_;
+    bundles_from_dtn_ += other.bundles_from_dtn_;
+}
+
+//----------------------------------------------------------------------
+void
+TCPTunnel::Stats::format(oasys::StringBuffer* buf, u_int32_t elapsed_ms) const
+{
+    buf->appendf("%u connections -- "
+                 "%llu bytes in %u bundles to dtn (avg %llu), "
+                 "%llu bytes in %u bundles from dtn",
+                 connections_,
+                 (unsigned long long)bytes_to_dtn_, bundles_to_dtn_,
+                 (unsigned long long)
+                 (bundles_to_dtn_ ? bytes_to_dtn_ / bundles_to_dtn_ : 0),
+                 (unsigned long long)bytes_from_dtn_, bundles_from_dtn_);
+
+    if (elapsed_ms != 0) {
+        buf->appendf(" -- %.1f KB/s to dtn, %.1f KB/s from dtn over %u ms",
+                     bytes_to_dtn_ / 1.024 / elapsed_ms,
+                     bytes_from_dtn_ / 1.024 / elapsed_ms,
+                     elapsed_ms);
+    }
+}
+
 //----------------------------------------------------------------------
 void
 TCPTunnel::handle_bundle(dtn::APIBundle* bundle)
@@ -313,6 +367,8 @@ TCPTunnel::Connection::Connection(TCPTunnel* t, dtn_endpoint_id_t* dest_eid,
       tcptun_(t),
       sock_("/dtntunnel/tcp/conn/sock"),
       queue_("/dtntunnel/tcp/conn"),
+      window_("/dtntunnel/tcp/conn/window",
+              DTNTunnel::instance()->window()),
       next_seqno_(0),
       client_addr_(client_addr),
       client_port_(client_port),
@@ -334,6 +390,8 @@ TCPTunnel::Connection::Connection(TCPTunnel* t, dtn_endpoint_id_t* dest_eid,
       tcptun_(t),
       sock_(fd, client_addr, client_port, "/dtntunnel/tcp/conn/sock"),
       queue_("/dtntunnel/tcp/conn"),
+      window_("/dtntunnel/tcp/conn/window",
+              DTNTunnel::instance()->window()),
       next_seqno_(0),
       client_addr_(client_addr),
       client_port_(client_port),
@@ -373,20 +431,22 @@ TCPTunnel::Connection::run()
     DTNTunnel* tunnel = DTNTunnel::instance();
     u_int32_t send_seqno = 0;
     u_int32_t next_recv_seqno = 0;
-    u_int32_t total_sent = 0;
     bool sock_eof = false;
-    bool dtn_blocked = false;
     bool first = true;
+    bool coalesce = tunnel->coalesce();
     
     transparent_ = tunnel->transparent();
+    stats_.connections_ = 1;
 
     // outgoing (tcp -> dtn) / incoming (dtn -> tcp) bundles
     dtn::APIBundle* b_xmit = NULL;
     dtn::APIBundle* b_recv = NULL;
 
-    // time values to implement nagle
-    oasys::Time tbegin, tnow;
+    // time values to implement nagle. tbegin is the time of the last
+    // read, or when coalescing, of the first data in the bundle
+    oasys::Time tbegin, tnow, tstart;
     ASSERT(tbegin.sec_ == 0);
+    tstart.get_time();
     
     // header for outgoing bundles
     DTNTunnel::BundleHeader hdr;
@@ -445,28 +505,44 @@ TCPTunnel::Connection::run()
     }
 
     while (1) {
-        struct pollfd pollfds[2];
+        struct pollfd pollfds[3];
 
         struct pollfd* msg_poll  = &pollfds[0];
         msg_poll->fd             = queue_.read_fd();
         msg_poll->events         = POLLIN;
         msg_poll->revents        = 0;
 
-        struct pollfd* sock_poll = &pollfds[1];
+        struct pollfd* win_poll  = &pollfds[1];
+        win_poll->fd             = window_.read_fd();
+        win_poll->events         = POLLIN;
+        win_poll->revents        = 0;
+
+        struct pollfd* sock_poll = &pollfds[2];
         sock_poll->fd            = sock_.fd();
         sock_poll->events        = POLLIN | POLLERR;
         sock_poll->revents       = 0;
 
-        // if the socket already had an eof or if dtn is write
-        // blocked, we just poll for activity on the message queue to
-        // look for data that needs to be returned out the TCP socket
-        int nfds = (sock_eof || dtn_blocked) ? 1 : 2;
+        // if the socket already had an eof or if the send window is
+        // full, we just poll for activity on the message queue to
+        // look for data that needs to be returned out the TCP socket,
+        // and for sends to complete
+        bool window_full = window_.full();
+        int nfds = (sock_eof || window_full) ? 2 : 3;
 
         int timeout = -1;
-        if (first || dtn_blocked) {
-            timeout = 1000; // one second between retries
+        if (first) {
+            timeout = 1000; // one second to wait for initial data
+        } else if (window_full) {
+            timeout = -1;   // nothing can be sent until the window opens
         } else if (tbegin.sec_ != 0) {
-            timeout = tunnel->delay();
+            if (coalesce) {
+                tnow.get_time();
+                u_int32_t waited = (tnow - tbegin).in_milliseconds();
+                timeout = (waited < tunnel->latency()) ?
+                          tunnel->latency() - waited : 0;
+            } else {
+                timeout = tunnel->delay();
+            }
         }
         
         log_debug("blocking in poll... (timeout %d)", timeout);
@@ -477,6 +553,12 @@ TCPTunnel::Connection::run()
             goto done;
         }
 
+        // clear the completion notification before the window is
+        // looked at again below
+        if (win_poll->revents != 0) {
+            window_.clear();
+        }
+
         // check if we need to create a new bundle, either because
         // this is the first time through and we'll need to send an
         // initial bundle to create the connection on the remote side,
@@ -495,13 +577,16 @@ TCPTunnel::Connection::run()
             u_int payload_todo = tunnel->max_size() - b_xmit->payload_.len();
 
             if (payload_todo != 0) {
-                tbegin.get_time();
+                if (!coalesce || tbegin.sec_ == 0) {
+                    tbegin.get_time();
+                }
                 
                 char* bp = b_xmit->payload_.end();
                 int ret = sock_.read(bp, payload_todo);
                 if (ret < 0) {
                     log_err("error reading from socket: %s", strerror(errno));
                     delete b_xmit;
+                    b_xmit = NULL;
                     goto done;
                 }
                 
@@ -516,34 +601,27 @@ TCPTunnel::Connection::run()
             }
         }
 
-        // now check if we should send the outgoing bundle
+        // now check if we should send the outgoing bundle. when
+        // coalescing, a bundle that isn't full goes once the latency
+        // budget runs out, or straight away if nothing is in flight,
+        // so bundles grow only while the sends are the bottleneck
         tnow.get_time();
-        if ((b_xmit != NULL) &&
+        if ((b_xmit != NULL) && !window_.full() &&
             ((sock_eof == true) ||
              (b_xmit->payload_.len() == tunnel->max_size()) ||
-             ((tnow - tbegin).in_milliseconds() >= tunnel->delay())))
+             (coalesce ?
+              ((window_.in_flight() == 0) ||
+               ((tnow - tbegin).in_milliseconds() >= tunnel->latency())) :
+              ((tnow - tbegin).in_milliseconds() >= tunnel->delay()))))
         {
             size_t len = b_xmit->payload_.len();
-            int err = tunnel->send_bundle(b_xmit, &dest_eid_);
-            if (err == DTN_SUCCESS) {
-                total_sent += len;
-                log_debug("sent %zu byte payload #%u to dtn (%u total)",
-                          len, send_seqno, total_sent);
-                delete b_xmit;
-                b_xmit = NULL;
-                tbegin.sec_ = 0;
-                tbegin.usec_ = 0;
-                dtn_blocked = false;
-                
-            } else if (err == DTN_ENOSPACE) {
-                log_debug("no space for %zu byte payload... "
-                          "setting dtn_blocked", len);
-                dtn_blocked = true;
-                continue;
-            } else {
-                log_err("error sending bundle: %s", dtn_strerror(err));
-                exit(1);
-            }
+            tunnel->queue_bundle(b_xmit, &dest_eid_, &window_);
+            log_debug("queued %zu byte payload #%u to dtn "
+                      "(%u in flight)",
+                      len, send_seqno, window_.in_flight());
+            b_xmit = NULL;
+            tbegin.sec_ = 0;
+            tbegin.usec_ = 0;
         }
         
         // now check for activity on the incoming bundle queue
@@ -588,6 +666,8 @@ TCPTunnel::Connection::run()
 
                 log_debug("sent %d byte payload to client", len);
             }
+            stats_.bytes_from_dtn_ += len;
+            stats_.bundles_from_dtn_++;
 
             if (recv_hdr->eof_) {
                 log_info("bundle had eof bit set... closing connection");
@@ -595,20 +675,22 @@ TCPTunnel::Connection::run()
                 if ( !sock_eof ) {
                     sock_eof = true;
 
-                    dtn::APIBundle* b = new dtn::APIBundle();
-                    hdr.eof_ = 1;
-                    hdr.seqno_ = ntohl(send_seqno++);
-                    memcpy(b->payload_.buf(sizeof(hdr)), &hdr, sizeof(hdr));
-                    b->payload_.set_len(sizeof(hdr));
-                    int err;
-                    if ((err = tunnel->send_bundle(b, &dest_eid_)) != DTN_SUCCESS) {
-                        log_err("error sending final socket closed packet bundle: %s",
-                                dtn_strerror(err));
-                        tcptun_->kill_connection(this);
-                        exit(1);
+                    // finish off any bundle being coalesced, or send
+                    // an empty one to carry the eof
+                    if (b_xmit == NULL) {
+                        b_xmit = new dtn::APIBundle();
+                        hdr.seqno_ = ntohl(send_seqno++);
+                        memcpy(b_xmit->payload_.buf(sizeof(hdr)), &hdr, sizeof(hdr));
+                        b_xmit->payload_.set_len(sizeof(hdr));
                     }
-                    delete b;
+                    DTNTunnel::BundleHeader* hdrp =
+                        (DTNTunnel::BundleHeader*)b_xmit->payload_.buf();
+                    hdrp->eof_ = 1;
+
+                    tunnel->queue_bundle(b_xmit, &dest_eid_, &window_);
+                    b_xmit = NULL;
                 }
+                delete b_recv;
                 sock_.close();
                 goto done;
             }
@@ -618,6 +700,22 @@ TCPTunnel::Connection::run()
     }
 
  done:
+    // the sender still refers to the window for any bundles in flight
+    window_.wait_empty();
+    if (b_xmit != NULL) {
+        delete b_xmit;
+    }
+
+    // only count what the sender actually handed to the daemon
+    stats_.bundles_to_dtn_ = window_.bundles_sent();
+    stats_.bytes_to_dtn_   = window_.bytes_sent();
+
+    tnow.get_time();
+    oasys::StringBuffer buf;
+    stats_.format(&buf, (tnow - tstart).in_milliseconds());
+    log_notice("connection closed: %s", buf.c_str());
+    tcptun_->add_stats(stats_);
+
     tcptun_->kill_connection(this);
 }
 
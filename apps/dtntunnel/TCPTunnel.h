@@ -26,7 +26,10 @@
 #include <oasys/thread/MsgQueue.h>
 #include <oasys/thread/Thread.h>
 #include <oasys/util/ExpandableBuffer.h>
+#include <oasys/util/StringBuffer.h>
+#include <oasys/util/Time.h>
 
+#include "DTNTunnel.h"
 #include "IPTunnel.h"
 
 namespace dtntunnel {
@@ -48,6 +51,24 @@ public:
     void handle_bundle(dtn::APIBundle* bundle);
 
 protected:
+    /// Goodput counters, kept for each connection and totalled for
+    /// the tunnel
+    struct Stats {
+        Stats();
+
+        /// Add in the counters of another connection
+        void add(const Stats& other);
+
+        /// Format the counters, with rates if elapsed_ms is nonzero
+        void format(oasys::StringBuffer* buf, u_int32_t elapsed_ms) const;
+
+        u_int32_t connections_;
+        u_int64_t bytes_to_dtn_;        ///< socket data sent to the daemon
+        u_int32_t bundles_to_dtn_;
+        u_int64_t bytes_from_dtn_;      ///< bundle data written to the socket
+        u_int32_t bundles_from_dtn_;
+    };
+
     /// Helper class to accept incoming TCP connections
     class Listener : public oasys::TCPServerThread {
     public:
@@ -118,6 +139,12 @@ protected:
         /// Queue for bundles on this connection
         dtn::APIBundleQueue queue_;
 
+        /// Bundles queued to the sender but not yet sent
+        SendWindow window_;
+
+        /// Goodput counters for the connection
+        Stats stats_;
+
         /// Table for out-of-order bundles
         typedef std::map<u_int32_t, dtn::APIBundle*> ReorderTable;
         ReorderTable reorder_table_;
@@ -146,6 +173,10 @@ protected:
     /// Hook called when a new connection dies
     void kill_connection(Connection* c);
 
+    /// Hook called by a closing connection to add its counters to
+    /// the tunnel totals, which are logged
+    void add_stats(const Stats& stats);
+
     /// Helper struct used as the index key into the connection table
     struct ConnKey {
         ConnKey()
@@ -200,6 +231,9 @@ protected:
 
     /// Increasing counter for connection identifiers
     u_int32_t next_connection_id_;
+
+    /// Totals for all closed connections
+    Stats totals_;
 };
 
 } // namespace dtntunnel
@@ -36,6 +36,7 @@ public:
     int consume(Bundle* bundle, BlockInfo* block, u_char* buf, size_t len);
     int generate(const Bundle* bundle, BlockInfoVec* xmit_blocks,
                   BlockInfo* block, const LinkRef& link, bool last);
+    bool link_independent() const { return true; }
     /// @}
 };
 
@@ -64,7 +64,10 @@ BPQResponse::create_bpq_response(Bundle*      new_response,
     new_response->set_creation_ts(*ts);
 
     // set payload
+    // the whole file is linked, so a cached fragment can't keep
+    // sharing it with the bundle it was split from
     log_debug_p(LOG, "Copy response payload");
+    cached_response->mutable_payload()->unshare();
     new_response->mutable_payload()->
         replace_with_file(cached_response->payload().filename().c_str());
 
@@ -248,7 +248,8 @@ BlockInfoVec::find_block(u_int8_t type) const
 
 //----------------------------------------------------------------------
 LinkBlockSet::Entry::Entry(const LinkRef& link)
-    : blocks_(NULL), link_(link.object(), "LinkBlockSet::Entry")
+    : blocks_(NULL), link_(link.object(), "LinkBlockSet::Entry"),
+      image_("LinkBlockSet::Entry")
 {
 }
 
@@ -314,4 +315,134 @@ LinkBlockSet::delete_blocks(const LinkRef& link)
           "no block vector for link *%p", link.object());
 }
 
+//----------------------------------------------------------------------
+WireImage*
+LinkBlockSet::find_image() const
+{
+    oasys::ScopeLock l(lock_, "LinkBlockSet::find_image");
+    
+    for (const_iterator iter = entries_.begin();
+         iter != entries_.end();
+         ++iter)
+    {
+        if (iter->image_ != NULL) {
+            return iter->image_.object();
+        }
+    }
+    return NULL;
+}
+
+//----------------------------------------------------------------------
+void
+LinkBlockSet::set_image(const LinkRef& link, WireImage* image)
+{
+    oasys::ScopeLock l(lock_, "LinkBlockSet::set_image");
+    
+    for (iterator iter = entries_.begin();
+         iter != entries_.end();
+         ++iter)
+    {
+        if (iter->link_ == link) {
+            iter->image_ = image;
+            return;
+        }
+    }
+    
+    PANIC("LinkBlockVec::set_image: "
+          "no block vector for link *%p", link.object());
+}
+
+//----------------------------------------------------------------------
+WireImage::WireImage(BlockInfoVec* blocks)
+    : RefCountedObject("/dtn/bundle/wire_image/refs")
+{
+    blocks_.resize(blocks->size());
+    for (size_t i = 0; i < blocks->size(); ++i) {
+        const BlockInfo* block = &(*blocks)[i];
+        Block* b = &blocks_[i];
+        
+        b->owner_  = block->owner();
+        b->source_ = block->source();
+        b->last_   = (i == blocks->size() - 1);
+        b->shared_ = block->owner()->link_independent();
+        if (! b->shared_) {
+            continue;
+        }
+        
+        b->eid_list_    = block->eid_list();
+        b->contents_.assign((const char*)block->contents().buf(),
+                            block->contents().len());
+        b->data_offset_ = block->data_offset();
+        b->data_length_ = block->data_length();
+    }
+
+    dict_.assign((const char*)blocks->dict()->dict(),
+                 blocks->dict()->length());
+}
+
+//----------------------------------------------------------------------
+bool
+WireImage::cacheable(const BlockInfoVec* blocks)
+{
+    // the payload and extension security blocks rewrite the blocks
+    // they protect for each link
+    for (BlockInfoVec::const_iterator iter = blocks->begin();
+         iter != blocks->end();
+         ++iter)
+    {
+        switch (iter->owner()->block_type()) {
+        case BundleProtocol::PAYLOAD_SECURITY_BLOCK:
+        case BundleProtocol::CONFIDENTIALITY_BLOCK:
+        case BundleProtocol::EXTENSION_SECURITY_BLOCK:
+            return false;
+        default:
+            break;
+        }
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+WireImage::reuse(size_t index, BlockInfo* block, bool last, Dictionary* dict)
+{
+    if (index >= blocks_.size()) {
+        return false;
+    }
+
+    const Block* b = &blocks_[index];
+    if (! b->shared_ ||
+        b->owner_  != block->owner() ||
+        b->source_ != block->source() ||
+        b->last_   != last)
+    {
+        return false;
+    }
+
+    block->set_eid_list(b->eid_list_);
+    if (dict != NULL) {
+        EndpointIDVector::const_iterator iter;
+        for (iter = b->eid_list_.begin(); iter != b->eid_list_.end(); ++iter) {
+            dict->add_eid(*iter);
+        }
+    }
+
+    BlockInfo::DataBuffer* contents = block->writable_contents();
+    contents->reserve(b->contents_.size());
+    memcpy(contents->buf(), b->contents_.data(), b->contents_.size());
+    contents->set_len(b->contents_.size());
+    block->set_data_offset(b->data_offset_);
+    block->set_data_length(b->data_length_);
+    
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+WireImage::same_dict(const Dictionary* dict) const
+{
+    return dict->length() == dict_.size() &&
+        memcmp(dict->dict(), dict_.data(), dict_.size()) == 0;
+}
+
 } // namespace dtn
@@ -211,6 +211,67 @@ protected:
     NO_ASSIGN_COPY(BlockInfoVec);
 };
 
+/**
+ * The encoded form of the link-independent blocks (see
+ * BlockProcessor::link_independent) of a bundle's transmit block list,
+ * captured after the blocks were generated for one link so they can
+ * be copied into the block lists for other links rather than
+ * regenerated. The image is shared by reference between all the
+ * LinkBlockSet entries that used it.
+ */
+class WireImage : public oasys::RefCountedObject {
+public:
+    /**
+     * Capture the image of the given (fully generated) block list.
+     */
+    WireImage(BlockInfoVec* blocks);
+
+    /**
+     * Whether a block list can use (or be captured in) an image at
+     * all, i.e. that there are no blocks whose processing rewrites
+     * other blocks.
+     */
+    static bool cacheable(const BlockInfoVec* blocks);
+
+    /**
+     * If the image has a matching encoding for the block at the given
+     * index (same processor, source block and position), copy it in,
+     * adding its EIDs to the dictionary (if given) just as generating
+     * the block would.
+     *
+     * @return true if the block was filled in from the image
+     */
+    bool reuse(size_t index, BlockInfo* block, bool last, Dictionary* dict);
+
+    /**
+     * Whether the given dictionary is the same as the one the image
+     * was encoded with, in which case all the EID offsets and the
+     * primary block are still valid.
+     */
+    bool same_dict(const Dictionary* dict) const;
+
+protected:
+    /// Encoded state of one block
+    struct Block {
+        BlockProcessor*  owner_;
+        const BlockInfo* source_;
+        bool             last_;
+        bool             shared_;	///< Whether the block can be reused
+        EndpointIDVector eid_list_;
+        std::string      contents_;
+        u_int32_t        data_offset_;
+        u_int32_t        data_length_;
+    };
+
+    std::vector<Block> blocks_;
+    std::string        dict_;
+};
+
+/**
+ * Typedef for a reference to a WireImage.
+ */
+typedef oasys::Ref<WireImage> WireImageRef;
+
 /**
  * A set of BlockInfoVecs, one for each outgoing link.
  */
@@ -242,6 +303,18 @@ public:
      */
     void delete_blocks(const LinkRef& link);
 
+    /**
+     * Find a wire image used by the block list of any link.
+     *
+     * @return the image or NULL if there is none
+     */
+    WireImage* find_image() const;
+
+    /**
+     * Record that the block list for the given link uses the image.
+     */
+    void set_image(const LinkRef& link, WireImage* image);
+
 protected:
     /**
      * Struct to hold a block list and a link pointer. Note that we
@@ -255,6 +328,7 @@ protected:
         
         BlockInfoVec* blocks_;
         LinkRef       link_;
+        WireImageRef  image_;
     };
 
     typedef std::vector<Entry> Vector;
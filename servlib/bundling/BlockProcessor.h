@@ -246,6 +246,15 @@ public:
      */
     virtual int format(oasys::StringBuffer* buf, BlockInfo *b = NULL);
 
+    /**
+     * Whether the generated block depends only on the bundle (and the
+     * dictionary), not on the link it is sent on, so the encoding made
+     * for one link can be reused for the others (see WireImage).
+     * Processors whose blocks carry link or time dependent data, or
+     * whose finalize() touches other blocks, must return false.
+     */
+    virtual bool link_independent() const { return false; }
+
 protected:
     friend class BundleProtocol;
     friend class BlockInfo;
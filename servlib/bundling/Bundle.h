@@ -37,6 +37,7 @@
 #include "naming/EndpointID.h"
 #include "security/BundleSecurityConfig.h"
 #include "security/Ciphersuite.h"
+#include "security/DigestCache.h"
 
 typedef oasys::ScratchBuffer<u_char*, 64> DataBuffer;
 
@@ -251,6 +252,10 @@ public:
     const u_char * payload_tag() const {return payload_tag_;}
     bool payload_encrypted() const {return payload_encrypted_;}
     bool payload_bek_set() const {return payload_bek_set_;}
+
+    /// Integrity digests already computed over the bundle, which
+    /// isn't part of the bundle state, so it's usable when const
+    DigestCache* digest_cache() const { return &digest_cache_; }
     
 #endif
 
@@ -374,6 +379,7 @@ private:
     bool payload_encrypted_;
     bool payload_bek_set_;
     BundleSecurityConfig security_config_; ///The security config that applies to this particular bundle
+    mutable DigestCache digest_cache_; ///< Cached BA/PI digests
 #endif
     
     u_int64_t age_;             ///< Age of our bundle [AEB]
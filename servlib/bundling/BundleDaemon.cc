@@ -18,6 +18,8 @@
 #  include <dtn-config.h>
 #endif
 
+#include <set>
+
 #include <oasys/io/IO.h>
 #include <oasys/tclcmd/TclCommand.h>
 #include <oasys/util/Time.h>
@@ -66,7 +68,8 @@ BundleDaemon::Params::Params()
        retry_reliable_unacked_(true),
        test_permuted_delivery_(false),
        injected_bundles_in_memory_(false),
-       recreate_links_on_restart_(true)
+       recreate_links_on_restart_(true),
+       event_shards_(0)
 {}
 
 BundleDaemon::Params BundleDaemon::params_;
@@ -77,7 +80,9 @@ bool BundleDaemon::shutting_down_ = false;
 BundleDaemon::BundleDaemon()
     : BundleEventHandler("BundleDaemon", "/dtn/bundle/daemon"),
       Thread("BundleDaemon", CREATE_JOINABLE),
-      load_previous_links_executed_(false)
+      load_previous_links_executed_(false),
+      commit_pending_(0),
+      expired_batch_(NULL)
 {
     // default local eid
     local_eid_.assign(EndpointID::NULL_EID());
@@ -91,6 +96,18 @@ BundleDaemon::BundleDaemon()
     pending_bundles_ = new BundleList("pending_bundles");
     custody_bundles_ = new BundleList("custody_bundles");
 
+    // every received bundle is checked against the pending list for
+    // duplicates, and the router, API and custody signal handling all
+    // look up bundles by id, so keep indexes rather than scanning the
+    // lists. note that bundles are put on all_bundles_ before their
+    // primary block fields are known, so it is only indexed by id.
+    all_bundles_->enable_index(BundleList::INDEX_BUNDLEID);
+    pending_bundles_->enable_index(BundleList::INDEX_DUPLICATE |
+                                   BundleList::INDEX_BUNDLEID |
+                                   BundleList::INDEX_GBOFID);
+    custody_bundles_->enable_index(BundleList::INDEX_BUNDLEID |
+                                   BundleList::INDEX_GBOFID);
+
 #ifdef BPQ_ENABLED
 	bpq_cache_ 	     = new BPQCache();
 #endif /* BPQ_ENABLED */
@@ -106,6 +123,9 @@ BundleDaemon::BundleDaemon()
 
     rtr_shutdown_proc_ = 0;
     rtr_shutdown_data_ = 0;
+
+    shards_ = new EventShards(this, "/dtn/bundle/daemon/shard");
+    timer_wheel_ = new BundleTimerWheel(TIMER_TICK_MS, oasys::Time::now());
 }
 
 //----------------------------------------------------------------------
@@ -126,6 +146,8 @@ BundleDaemon::~BundleDaemon()
 
     delete actions_;
     delete eventq_;
+    delete shards_;
+    delete timer_wheel_;
 }
 
 //----------------------------------------------------------------------
@@ -246,16 +268,178 @@ BundleDaemon::get_bundle_stats(oasys::StringBuffer* buf)
                  stats_.injected_bundles_);
 }
 
+//----------------------------------------------------------------------
+void
+BundleDaemon::get_bundle_memory_stats(oasys::StringBuffer* buf)
+{
+    // the interned eid strings are shared, so each one is only
+    // counted once no matter how many bundles refer to it
+    typedef std::set<const EndpointIDTable::Entry*> EntrySet;
+    EntrySet eids;
+
+    size_t count = 0, eid_bytes = 0, owner_bytes = 0, block_bytes = 0;
+    size_t fwdlog_bytes = 0, payload_bytes = 0;
+
+    oasys::ScopeLock l(all_bundles_->lock(),
+                       "BundleDaemon::get_bundle_memory_stats");
+    BundleList::iterator iter;
+    for (iter = all_bundles_->begin(); iter != all_bundles_->end(); ++iter)
+    {
+        Bundle* bundle = *iter;
+        oasys::ScopeLock bl(bundle->lock(),
+                            "BundleDaemon::get_bundle_memory_stats");
+        ++count;
+
+        const EndpointID* fields[] = {
+            &bundle->source(), &bundle->dest(), &bundle->custodian(),
+            &bundle->replyto(), &bundle->prevhop(), &bundle->session_eid()
+        };
+        for (size_t i = 0; i < sizeof(fields) / sizeof(fields[0]); ++i) {
+            if (eids.insert(fields[i]->entry()).second) {
+                eid_bytes += fields[i]->entry()->bytes();
+            }
+        }
+
+        owner_bytes += bundle->owner().capacity();
+
+        const BlockInfoVec* vecs[] = {
+            &bundle->recv_blocks(), bundle->api_blocks_c()
+        };
+        for (size_t i = 0; i < sizeof(vecs) / sizeof(vecs[0]); ++i) {
+            block_bytes += vecs[i]->capacity() * sizeof(BlockInfo);
+            BlockInfoVec::const_iterator bi;
+            for (bi = vecs[i]->begin(); bi != vecs[i]->end(); ++bi) {
+                block_bytes += bi->contents().buf_len();
+            }
+        }
+
+        fwdlog_bytes += bundle->fwdlog()->get_count() * sizeof(ForwardingInfo);
+
+        if (bundle->payload().location() == BundlePayload::MEMORY) {
+            payload_bytes += bundle->payload().length();
+        }
+    }
+
+    size_t struct_bytes = count * sizeof(Bundle);
+    size_t total = struct_bytes + eid_bytes + owner_bytes + block_bytes +
+                   fwdlog_bytes + payload_bytes;
+    size_t n = (count == 0) ? 1 : count;
+
+    buf->appendf("%zu bundles -- %zu bytes (%zu per bundle)\n",
+                 count, total, total / n);
+
+#define FIELD(_name, _bytes) \
+    buf->appendf("  %-8s %10zu bytes %8zu per bundle\n", \
+                 _name, (size_t)(_bytes), (size_t)(_bytes) / n)
+
+    FIELD("struct",  struct_bytes);
+    FIELD("eids",    eid_bytes);
+    FIELD("owner",   owner_bytes);
+    FIELD("blocks",  block_bytes);
+    FIELD("fwdlog",  fwdlog_bytes);
+    FIELD("payload", payload_bytes);
+#undef FIELD
+
+    buf->appendf("  (%zu bytes per EndpointID field, %zu distinct eids -- ",
+                 sizeof(EndpointID), eids.size());
+    EndpointIDTable::instance()->dump(buf);
+    buf->appendf(")");
+}
+
 //----------------------------------------------------------------------
 void
 BundleDaemon::get_daemon_stats(oasys::StringBuffer* buf)
 {
+    RegistrationTable::DemuxStats demux = reg_table_->demux_stats();
+    
     buf->appendf("%zu pending_events -- "
                  "%u processed_events -- "
-                 "%zu pending_timers",
+                 "%zu pending_timers -- "
+                 "%zu bundle_timers -- "
+                 "%u duplicate_matches -- "
+                 "%u duplicate_no_matches -- "
+                 "%u sharded_events -- "
+                 "%u max_queue_depth -- "
+                 "%u demux_lookups -- "
+                 "%u demux_scans -- "
+                 "%llu demux_avg_usec -- "
+                 "%llu demux_max_usec",
                  event_queue_size(),
-                 stats_.events_processed_,
-                 oasys::TimerSystem::instance()->num_pending_timers());
+                 stats_.events_processed_.value,
+                 oasys::TimerSystem::instance()->num_pending_timers(),
+                 timer_wheel_->size(),
+                 stats_.duplicate_matches_,
+                 stats_.duplicate_no_matches_,
+                 stats_.sharded_events_.value,
+                 stats_.max_queue_depth_,
+                 demux.lookups_,
+                 demux.scans_,
+                 (unsigned long long)(demux.lookups_ == 0 ? 0 :
+                                      demux.total_usec_ / demux.lookups_),
+                 (unsigned long long)demux.max_usec_);
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::get_event_stats(oasys::StringBuffer* buf, bool raw)
+{
+    oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::get_event_stats");
+
+    if (raw) {
+        buf->append("# type count queue_count queue_sum queue_max "
+                    "queue_buckets handle_count handle_sum handle_max "
+                    "handle_buckets\n");
+    }
+    
+    for (int i = 0; i < EVENT_TYPE_MAX; ++i) {
+        EventStats* es = &event_stats_[i];
+        if (es->count_ == 0) {
+            continue;
+        }
+
+        const char* type = event_to_str((event_type_t)i);
+        if (raw) {
+            buf->appendf("%s %llu ", type, U64FMT(es->count_));
+            es->queue_usec_.format_raw(buf);
+            buf->append(" ");
+            es->handle_usec_.format_raw(buf);
+            buf->append("\n");
+        } else {
+            buf->appendf("%s: %llu events\n    queue usec: ",
+                         type, U64FMT(es->count_));
+            es->queue_usec_.format(buf);
+            buf->append("\n    handler usec: ");
+            es->handle_usec_.format(buf);
+            buf->append("\n");
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::record_event_stats(BundleEvent* event,
+                                 const oasys::Time& start,
+                                 const oasys::Time& end)
+{
+    if (event->type_ <= 0 || event->type_ >= EVENT_TYPE_MAX) {
+        return;
+    }
+    
+    // the time may have moved backwards since the event was posted
+    u_int64_t queue_usec = 0;
+    if (start >= event->posted_time_) {
+        queue_usec = (start - event->posted_time_).in_microseconds();
+    }
+    u_int64_t handle_usec = 0;
+    if (end >= start) {
+        handle_usec = (end - start).in_microseconds();
+    }
+
+    oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::record_event_stats");
+    EventStats* es = &event_stats_[event->type_];
+    es->count_++;
+    es->queue_usec_.add(queue_usec);
+    es->handle_usec_.add(handle_usec);
 }
 
 
@@ -264,6 +448,16 @@ void
 BundleDaemon::reset_stats()
 {
     memset(&stats_, 0, sizeof(stats_));
+    reg_table_->reset_demux_stats();
+
+    {
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::reset_stats");
+        for (int i = 0; i < EVENT_TYPE_MAX; ++i) {
+            event_stats_[i].count_ = 0;
+            event_stats_[i].queue_usec_.clear();
+            event_stats_[i].handle_usec_.clear();
+        }
+    }
 
     oasys::ScopeLock l(contactmgr_->lock(), "BundleDaemon::reset_stats");
     
@@ -312,9 +506,18 @@ BundleDaemon::generate_custody_signal(Bundle* bundle, bool succeeded,
     Bundle* signal = new Bundle();
     CustodySignal::create_custody_signal(signal, bundle, local_eid_,
                                          succeeded, reason);
-    
-    BundleReceivedEvent e(signal, EVENTSRC_ADMIN);
-    handle_event(&e);
+
+    if (BundleStore::instance()->group_commit()) {
+        // the signal releases the previous custodian from its
+        // obligation, so hold it until our custody is durable
+        oasys::ScopeLock l(&daemon_lock_,
+                           "BundleDaemon::generate_custody_signal");
+        commit_signals_.push_back(
+            BundleRef(signal, "BundleDaemon::generate_custody_signal"));
+    } else {
+        BundleReceivedEvent e(signal, EVENTSRC_ADMIN);
+        handle_event(&e);
+    }
 	s10_bundle(S10_TXADMIN,signal,NULL,0,0,bundle,"custody signal");
 
 }
@@ -325,22 +528,21 @@ BundleDaemon::cancel_custody_timers(Bundle* bundle)
 {
     oasys::ScopeLock l(bundle->lock(), "BundleDaemon::cancel_custody_timers");
     
-    CustodyTimerVec::iterator iter;
-    for (iter =  bundle->custody_timers()->begin();
-         iter != bundle->custody_timers()->end();
-         ++iter)
-    {
-        bool ok = (*iter)->cancel();
-        if (!ok) {
-            log_crit("unexpected error cancelling custody timer for bundle *%p",
-                     bundle);
+    // cancelled timers are removed from the wheel and can be freed
+    // right away. a timer that fails to cancel has just fired and
+    // its timeout event is on the way, so it stays in the list for
+    // handle_custody_timeout to clean up
+    CustodyTimerVec* timers = bundle->custody_timers();
+    CustodyTimerVec::iterator iter = timers->begin();
+    while (iter != timers->end()) {
+        if (timer_wheel_->cancel(*iter)) {
+            delete *iter;
+            iter = timers->erase(iter);
+        } else {
+            log_debug("custody timer for bundle *%p already fired", bundle);
+            ++iter;
         }
-        
-        // the timer will be deleted when it bubbles to the top of the
-        // timer queue
     }
-    
-    bundle->custody_timers()->clear();
 }
 
 //----------------------------------------------------------------------
@@ -609,6 +811,53 @@ BundleDaemon::handle_bundle_accept(BundleAcceptRequest* request)
              BundleStatusReport::reason_to_str(*request->reason_));
 }
     
+//----------------------------------------------------------------------
+void
+BundleDaemon::validate_received(BundleReceivedEvent* event)
+{
+    ASSERT(event->source_ == EVENTSRC_PEER);
+    if (event->validated_) {
+        return;
+    }
+    event->validated_ = true;
+
+    Bundle* bundle = event->bundleref_.object();
+    
+    /*
+     * If a previous hop block wasn't included, but we know the remote
+     * endpoint id of the link where the bundle arrived, assign the
+     * prevhop_ field in the bundle so it's available for routing.
+     */
+    if (bundle->prevhop()       == EndpointID::NULL_EID() ||
+        bundle->prevhop().str() == "")
+    {
+        bundle->mutable_prevhop()->assign(event->prevhop_);
+    }
+
+    if (bundle->prevhop() != event->prevhop_)
+    {
+        log_warn("previous hop mismatch: prevhop header contains '%s' but "
+                 "convergence layer indicates prevhop is '%s'",
+                 bundle->prevhop().c_str(),
+                 event->prevhop_.c_str());
+    }
+    
+    /*
+     * Check if the bundle isn't complete. If so, do reactive
+     * fragmentation.
+     */
+    ASSERT(event->bytes_received_ != 0);
+    fragmentmgr_->try_to_convert_to_fragment(bundle);
+
+    /*
+     * Check all BlockProcessors to validate the bundle.
+     */
+    log_info("validate_received: validating bundle: calling BlockProcessors?");
+    event->valid_ = BundleProtocol::validate(bundle,
+                                             &event->reception_reason_,
+                                             &event->deletion_reason_);
+}
+
 //----------------------------------------------------------------------
 void
 BundleDaemon::handle_bundle_received(BundleReceivedEvent* event)
@@ -722,53 +971,18 @@ BundleDaemon::handle_bundle_received(BundleReceivedEvent* event)
     }
 
     /*
-     * If a previous hop block wasn't included, but we know the remote
-     * endpoint id of the link where the bundle arrived, assign the
-     * prevhop_ field in the bundle so it's available for routing.
-     */
-    if (event->source_ == EVENTSRC_PEER)
-    {
-        if (bundle->prevhop()       == EndpointID::NULL_EID() ||
-            bundle->prevhop().str() == "")
-        {
-            bundle->mutable_prevhop()->assign(event->prevhop_);
-        }
-
-        if (bundle->prevhop() != event->prevhop_)
-        {
-            log_warn("previous hop mismatch: prevhop header contains '%s' but "
-                     "convergence layer indicates prevhop is '%s'",
-                     bundle->prevhop().c_str(),
-                     event->prevhop_.c_str());
-        }
-    }
-    
-    /*
-     * Check if the bundle isn't complete. If so, do reactive
-     * fragmentation.
-     */
-    if (event->source_ == EVENTSRC_PEER) {
-        ASSERT(event->bytes_received_ != 0);
-        fragmentmgr_->try_to_convert_to_fragment(bundle);
-    }
-
-    /*
-     * validate a bundle, including all bundle blocks, received from a peer
+     * Fill in the previous hop, do reactive fragmentation and validate
+     * a bundle received from a peer (unless a shard thread already
+     * did so before handing the event over).
      */
     if (event->source_ == EVENTSRC_PEER) { 
 
-        /*
-         * Check all BlockProcessors to validate the bundle.
-         */
-        status_report_reason_t
-            reception_reason = BundleProtocol::REASON_NO_ADDTL_INFO,
-            deletion_reason = BundleProtocol::REASON_NO_ADDTL_INFO;
+        validate_received(event);
 
-        
-        log_info("handle_bundle_received: validating bundle: calling BlockProcessors?");
-        bool valid = BundleProtocol::validate(bundle,
-                                              &reception_reason,
-                                              &deletion_reason);
+        status_report_reason_t
+            reception_reason = event->reception_reason_,
+            deletion_reason = event->deletion_reason_;
+        bool valid = event->valid_;
         
         /*
          * Send the reception receipt if requested within the primary
@@ -1017,6 +1231,20 @@ BundleDaemon::handle_deliver_bundle_to_reg(DeliverBundleToRegEvent* event)
     deliver_to_registration(bundle, registration);
  }
 
+//----------------------------------------------------------------------
+void
+BundleDaemon::handle_bundle_received_batch(BundleReceivedBatchEvent* event)
+{
+    log_debug("handling batch of %zu received bundles", event->events_.size());
+
+    // run each arrival through the full handler chain (including the
+    // router and contact manager), leaving the store transaction to
+    // be closed once for the whole batch
+    for (size_t i = 0; i < event->events_.size(); ++i) {
+        handle_event(event->events_[i], false);
+    }
+}
+
 //----------------------------------------------------------------------
 void
 BundleDaemon::handle_bundle_transmitted(BundleTransmittedEvent* event)
@@ -1271,6 +1499,19 @@ BundleDaemon::handle_bundle_expired(BundleExpiredEvent* event)
     // fall through to notify the routers
 }
 
+//----------------------------------------------------------------------
+void
+BundleDaemon::handle_bundle_expired_batch(BundleExpiredBatchEvent* event)
+{
+    log_debug("handling batch of %zu expired bundles", event->events_.size());
+
+    // as for received batches, each expiration goes through the full
+    // handler chain and the store transaction is closed once
+    for (size_t i = 0; i < event->events_.size(); ++i) {
+        handle_event(event->events_[i], false);
+    }
+}
+
 //----------------------------------------------------------------------
 void
 BundleDaemon::handle_bundle_send(BundleSendRequest* event)
@@ -2326,7 +2567,13 @@ BundleDaemon::handle_custody_timeout(CustodyTimeoutEvent* event)
         return;
     }
 
-    ASSERT(!timer->cancelled());
+    // custody may have been released while the timer was firing
+    if (!bundle->local_custody()) {
+        log_debug("custody timeout for *%p after custody was released",
+                  bundle);
+        delete timer;
+        return;
+    }
     
     if (!pending_bundles_->contains(bundle)) {
         log_err("custody timeout for *%p *%p: bundle not in pending list",
@@ -2550,7 +2797,9 @@ BundleDaemon::add_to_pending(Bundle* bundle, bool add_to_store)
        }
 
        bundle->set_expiration_timer(new ExpirationTimer(bundle));
-       bundle->expiration_timer()->schedule_at(&expiration_time);
+       timer_wheel_->schedule_at(bundle->expiration_timer(),
+                                 oasys::Time(expiration_time.tv_sec,
+                                             expiration_time.tv_usec));
 
     return ok_to_route;
 }
@@ -2562,19 +2811,19 @@ BundleDaemon::delete_from_pending(const BundleRef& bundle)
     log_debug("removing bundle *%p from pending list", bundle.object());
 
     // first try to cancel the expiration timer if it's still
-    // around
-    if (bundle->expiration_timer()) {
-        log_debug("cancelling expiration timer for bundle id %d",
-                  bundle->bundleid());
-        
-        bool cancelled = bundle->expiration_timer()->cancel();
-        if (!cancelled) {
-            log_crit("unexpected error cancelling expiration timer "
-                     "for bundle *%p", bundle.object());
+    // around. if it has just fired, clearing the bundle's pointer
+    // tells the timer to drop the expiration and clean itself up
+    {
+        oasys::ScopeLock l(bundle->lock(), "BundleDaemon::delete_from_pending");
+        ExpirationTimer* timer = bundle->expiration_timer();
+        if (timer) {
+            log_debug("cancelling expiration timer for bundle id %d",
+                      bundle->bundleid());
+            bundle->set_expiration_timer(NULL);
+            if (timer_wheel_->cancel(timer)) {
+                delete timer;
+            }
         }
-        
-        bundle->expiration_timer()->bundleref_.release();
-        bundle->set_expiration_timer(NULL);
     }
 
     // XXX/demmer the whole BundleDaemon core should be changed to use
@@ -2744,35 +2993,21 @@ BundleDaemon::find_duplicate(Bundle* b)
     oasys::ScopeLock l(pending_bundles_->lock(), 
                        "BundleDaemon::find_duplicate");
     log_debug("pending_bundles size %zd", pending_bundles_->size());
-    Bundle *found = NULL;
-    BundleList::iterator iter;
-    for (iter = pending_bundles_->begin();
-         iter != pending_bundles_->end();
-         ++iter)
-    {
-        Bundle* b2 = *iter;
-        
-        if ((b->source().equals(b2->source())) &&
-            (b->creation_ts().seconds_ == b2->creation_ts().seconds_) &&
-            (b->creation_ts().seqno_   == b2->creation_ts().seqno_) &&
-            (b->is_fragment()          == b2->is_fragment()) &&
-            (b->frag_offset()          == b2->frag_offset()) &&
-            /*(b->orig_length()          == b2->orig_length()) &&*/
-            (b->payload().length()     == b2->payload().length()))
-        {
-            // b is a duplicate of b2
-            found = b2;
-            /*
-             * If we are not suppressing duplicates, we might have custody of
-             * one of any number of duplicates, so if this one does not have
-             * custody, keep looking until we find one that does have custody
-             * or we run out of choices. If we are suppressing duplicates
-             * there's no need to keep looking.
-             */
-            if (params_.suppress_duplicates_ || b2->local_custody()) {
-                break;
-            }
-        }
+
+    /*
+     * If we are not suppressing duplicates, we might have custody of
+     * one of any number of duplicates, so if this one does not have
+     * custody, keep looking until we find one that does have custody
+     * or we run out of choices. If we are suppressing duplicates
+     * there's no need to keep looking.
+     */
+    Bundle* found = pending_bundles_->find_duplicate(
+        b, !params_.suppress_duplicates_);
+
+    if (found != NULL) {
+        stats_.duplicate_matches_++;
+    } else {
+        stats_.duplicate_no_matches_++;
     }
 
     return found;
@@ -2948,24 +3183,261 @@ BundleDaemon::handle_event(BundleEvent* event, bool closeTransaction)
     }
 
     event_handlers_completed(event);
+    event_completed(event, closeTransaction);
+}
 
-    if (closeTransaction) {
-        oasys::DurableStore* ds = oasys::DurableStore::instance();
-        if ( ds->is_transaction_open() ) {
-            log_debug("handle_event closing transaction");
-            ds->end_transaction();
+//----------------------------------------------------------------------
+void
+BundleDaemon::event_completed(BundleEvent* event, bool closeTransaction)
+{
+    if (BundleStore::instance()->group_commit()) {
+        // the commit itself is done from the main loop, see
+        // commit_due()
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::event_completed");
+        if (commit_pending_ == 0) {
+            commit_opened_.get_time();
         }
+        commit_pending_++;
+        oasys::atomic_incr(&stats_.events_processed_);
+        if (event->processed_notifier_) {
+            commit_notifiers_.push_back(event->processed_notifier_);
+        }
+        return;
+    }
+    
+    if (closeTransaction) {
+        close_transaction();
     } else {
         log_debug("handle_event NOT closing transaction");
     }
 
-    stats_.events_processed_++;
+    oasys::atomic_incr(&stats_.events_processed_);
 
     if (event->processed_notifier_) {
         event->processed_notifier_->notify();
     }
 }
 
+//----------------------------------------------------------------------
+bool
+BundleDaemon::commit_due()
+{
+    if (! BundleStore::instance()->group_commit()) {
+        return false;
+    }
+
+    // commit whenever the queue goes idle (including waiting for any
+    // events still out on the shards), or once the batch is full or
+    // has been open for too long
+    if (eventq_->size() == 0) {
+        if (shards_->outstanding() != 0) {
+            return true;
+        }
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::commit_due");
+        return commit_pending_ != 0;
+    }
+
+    oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::commit_due");
+    BundleStore* bs = BundleStore::instance();
+    return commit_pending_ != 0 &&
+        (commit_pending_ >= bs->group_commit_batch() ||
+         commit_opened_.elapsed_ms() >= bs->group_commit_interval());
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::commit_batch()
+{
+    // the shards may be in the middle of the batch's events
+    shards_->drain();
+
+    std::vector<oasys::Notifier*> notifiers;
+    std::vector<BundleRef> signals;
+    {
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::commit_batch");
+        if (commit_pending_ == 0) {
+            return;
+        }
+        
+        BundleStore::instance()->commit(commit_pending_, commit_opened_);
+        commit_pending_ = 0;
+        notifiers.swap(commit_notifiers_);
+        signals.swap(commit_signals_);
+    }
+
+    for (size_t i = 0; i < notifiers.size(); ++i) {
+        notifiers[i]->notify();
+    }
+
+    // the signals go into the next batch
+    for (size_t i = 0; i < signals.size(); ++i) {
+        BundleReceivedEvent e(signals[i].object(), EVENTSRC_ADMIN);
+        handle_event(&e);
+    }
+}
+
+//----------------------------------------------------------------------
+int
+BundleDaemon::run_bundle_timers()
+{
+    ASSERT(expired_batch_ == NULL);
+    expired_batch_ = new BundleExpiredBatchEvent();
+
+    int timeout = timer_wheel_->run(oasys::Time::now());
+
+    if (expired_batch_->events_.empty()) {
+        delete expired_batch_;
+    } else {
+        log_debug("posting batch of %zu expired bundles",
+                  expired_batch_->events_.size());
+        post_at_head(expired_batch_);
+    }
+    expired_batch_ = NULL;
+
+    return timeout;
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::add_expired_bundle(Bundle* bundle)
+{
+    ASSERT(expired_batch_ != NULL);
+    expired_batch_->events_.push_back(new BundleExpiredEvent(bundle));
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::close_transaction()
+{
+    oasys::DurableStore* ds = oasys::DurableStore::instance();
+    if ( ds->is_transaction_open() ) {
+        log_debug("handle_event closing transaction");
+        ds->end_transaction();
+    }
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::handle_sharded_event(BundleEvent* event)
+{
+    ASSERT(! event->daemon_only_);
+
+    oasys::Time start, end;
+    start.get_time();
+
+    // the checks (and any security processing) that only involve the
+    // arriving bundle itself run in parallel with the other shards
+    if (event->type_ == BUNDLE_RECEIVED) {
+        BundleReceivedEvent* received = (BundleReceivedEvent*)event;
+        if (received->source_ == EVENTSRC_PEER) {
+            validate_received(received);
+        }
+    }
+
+    {
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::handle_sharded_event");
+        dispatch_event(event);
+        if (! BundleStore::instance()->group_commit()) {
+            close_transaction();
+        }
+    }
+
+    // the router has declared that it can handle this event
+    // concurrently with events for other bundles
+    router_->handle_event(event);
+
+    {
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::handle_sharded_event");
+        contactmgr_->handle_event(event);
+        event_handlers_completed(event);
+    }
+
+    event_completed(event, true);
+
+    end.get_time();
+    record_event_stats(event, start, end);
+}
+
+//----------------------------------------------------------------------
+void
+BundleDaemon::handle_locked_event(BundleEvent* event)
+{
+    ASSERT(event->daemon_only_);
+
+    {
+        oasys::ScopeLock l(&daemon_lock_, "BundleDaemon::handle_locked_event");
+        dispatch_event(event);
+        if (! BundleStore::instance()->group_commit()) {
+            close_transaction();
+        }
+        event_handlers_completed(event);
+    }
+
+    event_completed(event, true);
+}
+
+//----------------------------------------------------------------------
+bool
+BundleDaemon::shard_event(BundleEvent* event)
+{
+    if (shards_->empty()) {
+        return false;
+    }
+
+    // a batch of arrivals is split up, so each bundle goes to its
+    // own shard just as if it had been posted on its own
+    if (event->type_ == BUNDLE_RECEIVED_BATCH) {
+        BundleReceivedBatchEvent* batch = (BundleReceivedBatchEvent*)event;
+        if (batch->events_.empty() ||
+            ! router_->parallel_safe(batch->events_[0]))
+        {
+            return false;
+        }
+
+        for (size_t i = 0; i < batch->events_.size(); ++i) {
+            BundleReceivedEvent* received = batch->events_[i];
+            oasys::atomic_incr(&stats_.sharded_events_);
+            shards_->post(received->bundleref_.object()->bundleid(), received);
+        }
+        batch->events_.clear();
+        delete batch;
+        return true;
+    }
+
+    if (event->daemon_only_) {
+        return false;
+    }
+
+    Bundle* bundle;
+    switch (event->type_) {
+    case BUNDLE_RECEIVED:
+        bundle = ((BundleReceivedEvent*)event)->bundleref_.object();
+        break;
+    case BUNDLE_TRANSMITTED:
+        bundle = ((BundleTransmittedEvent*)event)->bundleref_.object();
+        break;
+    case BUNDLE_DELIVERED:
+        bundle = ((BundleDeliveredEvent*)event)->bundleref_.object();
+        break;
+    case BUNDLE_EXPIRED:
+        bundle = ((BundleExpiredEvent*)event)->bundleref_.object();
+        break;
+    default:
+        return false;
+    }
+
+    if (bundle == NULL || ! router_->parallel_safe(event)) {
+        return false;
+    }
+
+    oasys::atomic_incr(&stats_.sharded_events_);
+
+    // all events for a given bundle go to the same shard so they
+    // are still handled in the order they were posted
+    shards_->post(bundle->bundleid(), event);
+    return true;
+}
+
 //----------------------------------------------------------------------
 void
 BundleDaemon::load_registrations()
@@ -3198,6 +3670,12 @@ BundleDaemon::run()
     load_bundles();
     load_registrations();
 
+    if (params_.event_shards_ != 0) {
+        shards_->start(params_.event_shards_);
+        log_info("handling bundle events on %zu shard threads",
+                 shards_->size());
+    }
+
     BundleEvent* event;
 
     oasys::TimerSystem* timersys = oasys::TimerSystem::instance();
@@ -3213,20 +3691,41 @@ BundleDaemon::run()
 
     timer_poll->fd     = timersys->notifier()->read_fd();
     timer_poll->events = POLLIN;
+
+    // newly scheduled bundle timers that are due before we next wake
+    // up poke the same notifier as the oasys timers
+    timer_wheel_->set_notifier(timersys->notifier());
     
     while (1) {
         if (should_stop()) {
             log_debug("BundleDaemon: stopping");
+            commit_batch();
+            shards_->stop();
             break;
         }
 
         int timeout = timersys->run_expired_timers();
+        int wheel_timeout = run_bundle_timers();
+        if (wheel_timeout != -1 && (timeout == -1 || wheel_timeout < timeout)) {
+            timeout = wheel_timeout;
+        }
+
+        if (commit_due()) {
+            log_debug_p(LOOP_LOG, "BundleDaemon: committing batch");
+            commit_batch();
+            continue; // the custody signals may have posted events
+        }
 
         log_debug_p(LOOP_LOG, 
                     "BundleDaemon: checking eventq_->size() > 0, its size is %zu", 
                     eventq_->size());
 
-        if (eventq_->size() > 0) {
+        size_t depth = eventq_->size();
+        if (depth > 0) {
+            if (depth > stats_.max_queue_depth_) {
+                stats_.max_queue_depth_ = depth;
+            }
+            
             bool ok = eventq_->try_pop(&event);
             ASSERT(ok);
             
@@ -3249,10 +3748,31 @@ BundleDaemon::run()
             }
             
             
+            // hand bundle-scoped events off to the shards if the
+            // router allows it, otherwise wait for any outstanding
+            // sharded events before handling this one
+            if (shard_event(event)) {
+                last_event_.get_time();
+                continue;
+            }
+
             log_debug_p(LOOP_LOG, "BundleDaemon: handling event %s",
                         event->type_str());
-            // handle the event
-            handle_event(event);
+
+            // a freed bundle isn't referenced by any of the sharded
+            // events, so rather than waiting for them the free is
+            // just kept out of the shards' way with the daemon lock
+            if (event->type_ == BUNDLE_FREE && shards_->outstanding() != 0) {
+                handle_locked_event(event);
+            } else {
+                shards_->drain();
+                // handle the event
+                handle_event(event);
+            }
+
+            oasys::Time done;
+            done.get_time();
+            record_event_stats(event, now, done);
 
             int elapsed = now.elapsed_ms();
             if (elapsed > 2000) {
@@ -26,9 +26,12 @@
 #include <oasys/compat/inttypes.h>
 #include <oasys/debug/Log.h>
 #include <oasys/tclcmd/IdleTclExit.h>
+#include <oasys/thread/Atomic.h>
 #include <oasys/thread/Timer.h>
 #include <oasys/thread/Thread.h>
 #include <oasys/thread/MsgQueue.h>
+#include <oasys/thread/Notifier.h>
+#include <oasys/thread/SpinLock.h>
 #include <oasys/util/StringBuffer.h>
 #include <oasys/util/Time.h>
 
@@ -37,6 +40,9 @@
 #include "BundleProtocol.h"
 #include "BundleActions.h"
 #include "BundleStatusReport.h"
+#include "BundleTimerWheel.h"
+#include "EventShards.h"
+#include "Log2Histogram.h"
 
 #ifdef BPQ_ENABLED
 #	include "BPQBlock.h"
@@ -65,6 +71,7 @@ class RegistrationTable;
  */
 class BundleDaemon : public oasys::Singleton<BundleDaemon, false>,
                      public BundleEventHandler,
+                     public EventShards::Handler,
                      public oasys::Thread
 {
 public:
@@ -170,6 +177,18 @@ public:
      */
     BundleList* custody_bundles() { return custody_bundles_; }
     
+    /**
+     * Accessor for the wheel holding the bundle expiration and
+     * custody timers.
+     */
+    BundleTimerWheel* timer_wheel() { return timer_wheel_; }
+
+    /**
+     * Add an expiration to the batch being collected while the timer
+     * wheel runs. Only called from ExpirationTimer::timeout.
+     */
+    void add_expired_bundle(Bundle* bundle);
+
 #ifdef BPQ_ENABLED
     /**
      * Accessor for the BPQ Cache.
@@ -188,12 +207,27 @@ public:
      */
     void get_bundle_stats(oasys::StringBuffer* buf);
 
+    /**
+     * Format the given StringBuffer with an estimate of the memory
+     * used by the bundles currently in the system, broken down by
+     * field, in total and per bundle.
+     */
+    void get_bundle_memory_stats(oasys::StringBuffer* buf);
+
     /**
      * Format the given StringBuffer with the current internal
      * statistics value.
      */
     void get_daemon_stats(oasys::StringBuffer* buf);
 
+    /**
+     * Format the given StringBuffer with the per event type counts
+     * and queue wait / handler time histograms (in microseconds),
+     * one line per event type that has been seen. If raw is set, the
+     * histograms are written in Log2Histogram::format_raw form.
+     */
+    void get_event_stats(oasys::StringBuffer* buf, bool raw);
+
     /**
      * Reset all internal stats.
      */
@@ -245,6 +279,10 @@ public:
         /// DTN daemon is restarted.
         bool recreate_links_on_restart_;
 
+        /// Number of worker threads across which bundle-scoped events
+        /// are sharded by bundle id (zero to handle all events on the
+        /// daemon thread)
+        u_int event_shards_;
     };
 
     static Params params_;
@@ -298,6 +336,17 @@ public:
     void handle_event(BundleEvent* event);
     void handle_event(BundleEvent* event, bool closeTransaction);
 
+    /**
+     * Event handling function used by the event shard threads. The
+     * checks on a bundle received from a peer (see validate_received)
+     * run without any lock, so they overlap across the shards. The
+     * daemon's own handler and the post-processing are serialized
+     * with the daemon lock, while the router's handler is run
+     * without it, overlapping with the daemon's handling of events
+     * on the other shards.
+     */
+    virtual void handle_sharded_event(BundleEvent* event);
+
     /**
      * Load in the previous links data.  This information is used to ensure
      * consistency between links created in this session and links created in
@@ -342,10 +391,12 @@ protected:
      * Event type specific handlers.
      */
     void handle_bundle_received(BundleReceivedEvent* event);
+    void handle_bundle_received_batch(BundleReceivedBatchEvent* event);
     void handle_bundle_transmitted(BundleTransmittedEvent* event);
     void handle_bundle_delivered(BundleDeliveredEvent* event);
     void handle_bundle_acknowledged_by_app(BundleAckEvent* event);
     void handle_bundle_expired(BundleExpiredEvent* event);
+    void handle_bundle_expired_batch(BundleExpiredBatchEvent* event);
     void handle_bundle_free(BundleFreeEvent* event);
     void handle_bundle_send(BundleSendRequest* event);
     void handle_bundle_cancel(BundleCancelRequest* event);
@@ -403,6 +454,70 @@ protected:
     void event_handlers_completed(BundleEvent* event);
     /// @}
 
+    /**
+     * Close the durable store transaction (if any) opened by an
+     * event handler.
+     */
+    void close_transaction();
+
+    /**
+     * Fill in the previous hop, do reactive fragmentation and run the
+     * block processors' validation for a bundle received from a peer,
+     * recording the outcome in the event. This only involves the
+     * bundle itself, so the shard threads do it before taking the
+     * daemon lock; otherwise it is done by handle_bundle_received.
+     */
+    void validate_received(BundleReceivedEvent* event);
+
+    /**
+     * Handle a daemon-only event on the daemon thread while the
+     * shards are busy, holding the daemon lock instead of draining
+     * them first.
+     */
+    void handle_locked_event(BundleEvent* event);
+
+    /**
+     * If the event is bundle-scoped and the router can handle it in
+     * parallel, hand it off to the shard for its bundle. A batch of
+     * arrivals is split up across the shards.
+     *
+     * @return true if the event was handed off, in which case the
+     * shard thread takes ownership of it
+     */
+    bool shard_event(BundleEvent* event);
+
+    /**
+     * Update the per event type statistics for an event that was
+     * handled between the given times.
+     */
+    void record_event_stats(BundleEvent* event,
+                            const oasys::Time& start,
+                            const oasys::Time& end);
+
+    /**
+     * Finish off an event once all the handlers have run: either
+     * close the transaction and notify any waiter now, or (in group
+     * commit mode) add the event to the open commit batch.
+     */
+    void event_completed(BundleEvent* event, bool closeTransaction);
+
+    /**
+     * Whether the open group commit batch should be committed now.
+     */
+    bool commit_due();
+
+    /**
+     * Commit the open group commit batch, then release the
+     * acknowledgements (waiters and custody signals) held for it.
+     */
+    void commit_batch();
+
+    /**
+     * Fire the due bundle timers, posting any expirations as a single
+     * batch event, and return the time until the wheel is due again.
+     */
+    int run_bundle_timers();
+
     typedef BundleProtocol::custody_signal_reason_t custody_signal_reason_t;
     typedef BundleProtocol::status_report_flag_t status_report_flag_t;
     typedef BundleProtocol::status_report_reason_t status_report_reason_t;
@@ -553,12 +668,28 @@ protected:
         u_int32_t deleted_bundles_;
         u_int32_t duplicate_bundles_;
         u_int32_t injected_bundles_;
-        u_int32_t events_processed_;
+        oasys::atomic_t events_processed_; ///< updated by the shards too
+        u_int32_t duplicate_matches_;      ///< find_duplicate found a match
+        u_int32_t duplicate_no_matches_;   ///< find_duplicate found none
+        oasys::atomic_t sharded_events_;   ///< events handed to shards
+        u_int32_t max_queue_depth_;        ///< deepest the eventq_ has been
     };
 
     /// Stats instance
     Stats stats_;
 
+    /// Per event type statistics
+    struct EventStats {
+        EventStats() : count_(0) {}
+        
+        u_int64_t count_;
+        Log2Histogram queue_usec_;	///< Time from post to handling
+        Log2Histogram handle_usec_;	///< Time spent in the handlers
+    };
+
+    /// EventStats instances, indexed by event type
+    EventStats event_stats_[EVENT_TYPE_MAX];
+
     /// Application-specific shutdown handler
     ShutdownProc app_shutdown_proc_;
  
@@ -586,6 +717,34 @@ protected:
 
     /// Time value when the last event was handled
     oasys::Time last_event_;
+
+    /// The event shard threads (empty unless configured)
+    EventShards* shards_;
+
+    /// Lock that serializes the daemon's own event handling across
+    /// the shard threads
+    oasys::SpinLock daemon_lock_;
+
+    /// Number of events in the open group commit batch
+    u_int commit_pending_;
+
+    /// Time the first event in the open batch completed
+    oasys::Time commit_opened_;
+
+    /// Waiters to notify once the open batch commits
+    std::vector<oasys::Notifier*> commit_notifiers_;
+
+    /// Custody signals to send once the open batch commits
+    std::vector<BundleRef> commit_signals_;
+
+    /// Tick length of the bundle timer wheel
+    static const u_int32_t TIMER_TICK_MS = 100;
+
+    /// The bundle expiration and custody timers
+    BundleTimerWheel* timer_wheel_;
+
+    /// Expirations collected during run_bundle_timers
+    BundleExpiredBatchEvent* expired_batch_;
 };
 
 } // namespace dtn
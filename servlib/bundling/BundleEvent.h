@@ -123,6 +123,10 @@ typedef enum {
     CLA_PARAMS_QUERY,           ///< Query CLA for config parameters
     CLA_PARAMS_REPORT,          ///< Report from CLA with config paramters
 
+    BUNDLE_RECEIVED_BATCH,      ///< Batch of new bundle arrivals
+    BUNDLE_EXPIRED_BATCH,       ///< Batch of bundle expirations
+
+    EVENT_TYPE_MAX              ///< Bound on the type codes (not an event)
 } event_type_t;
 
 /**
@@ -212,6 +216,9 @@ event_to_str(event_type_t event)
     case CLA_PARAMS_QUERY:         return "CLA_PARAMS_QUERY";
     case CLA_PARAMS_REPORT:        return "CLA_PARAMS_REPORT";
 
+    case BUNDLE_RECEIVED_BATCH: return "BUNDLE_RECEIVED_BATCH";
+    case BUNDLE_EXPIRED_BATCH:  return "BUNDLE_EXPIRED_BATCH";
+
     default:                   return "(invalid event type)";
         
     }
@@ -339,7 +346,11 @@ public:
           bytes_received_(bytes_received),
           link_(originator, "BundleReceivedEvent"),
           prevhop_(prevhop),
-          registration_(NULL)
+          registration_(NULL),
+          validated_(false),
+          valid_(false),
+          reception_reason_(BundleProtocol::REASON_NO_ADDTL_INFO),
+          deletion_reason_(BundleProtocol::REASON_NO_ADDTL_INFO)
     {
         ASSERT(source == EVENTSRC_PEER);
     }
@@ -357,7 +368,11 @@ public:
           bytes_received_(0),
           link_("BundleReceivedEvent"),
           prevhop_(EndpointID::NULL_EID()),
-          registration_(registration)
+          registration_(registration),
+          validated_(false),
+          valid_(false),
+          reception_reason_(BundleProtocol::REASON_NO_ADDTL_INFO),
+          deletion_reason_(BundleProtocol::REASON_NO_ADDTL_INFO)
     {
     }
 
@@ -373,7 +388,11 @@ public:
           bytes_received_(0),
           link_("BundleReceivedEvent"),
           prevhop_(EndpointID::NULL_EID()),
-          registration_(NULL)
+          registration_(NULL),
+          validated_(false),
+          valid_(false),
+          reception_reason_(BundleProtocol::REASON_NO_ADDTL_INFO),
+          deletion_reason_(BundleProtocol::REASON_NO_ADDTL_INFO)
     {
     }
 
@@ -394,6 +413,42 @@ public:
 
     /// Registration where the bundle arrived
     Registration* registration_;
+
+    /// @{
+    /// Outcome of BundleDaemon::validate_received, which is run ahead
+    /// of the daemon's handler when the event is sharded
+    bool validated_;
+    bool valid_;
+    BundleProtocol::status_report_reason_t reception_reason_;
+    BundleProtocol::status_report_reason_t deletion_reason_;
+    /// @}
+};
+
+/**
+ * Event class for a batch of bundle arrivals from a convergence
+ * layer that reads several bundles at once. The daemon handles each
+ * contained BundleReceivedEvent in turn exactly as if it had been
+ * posted on its own, so the batch itself is never seen by the
+ * routers.
+ */
+class BundleReceivedBatchEvent : public BundleEvent {
+public:
+    BundleReceivedBatchEvent()
+        : BundleEvent(BUNDLE_RECEIVED_BATCH)
+    {
+        // should be processed only by the daemon
+        daemon_only_ = true;
+    }
+
+    ~BundleReceivedBatchEvent()
+    {
+        for (size_t i = 0; i < events_.size(); ++i) {
+            delete events_[i];
+        }
+    }
+
+    /// The arrival events, in the order the bundles were received
+    std::vector<BundleReceivedEvent*> events_;
 };
 
 /**
@@ -504,6 +559,32 @@ public:
     BundleRef bundleref_;
 };
 
+/**
+ * Event class for all the bundles whose expiration timers fired on
+ * the same tick of the daemon's timer wheel. As with received
+ * batches, the daemon handles each contained BundleExpiredEvent in
+ * turn, so the routers only ever see the individual expirations.
+ */
+class BundleExpiredBatchEvent : public BundleEvent {
+public:
+    BundleExpiredBatchEvent()
+        : BundleEvent(BUNDLE_EXPIRED_BATCH)
+    {
+        // should be processed only by the daemon
+        daemon_only_ = true;
+    }
+
+    ~BundleExpiredBatchEvent()
+    {
+        for (size_t i = 0; i < events_.size(); ++i) {
+            delete events_[i];
+        }
+    }
+
+    /// The expiration events
+    std::vector<BundleExpiredEvent*> events_;
+};
+
 /**
  * Event class for bundles that have no more references to them.
  */
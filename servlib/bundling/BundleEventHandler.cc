@@ -37,6 +37,10 @@ BundleEventHandler::dispatch_event(BundleEvent* e)
         handle_bundle_received((BundleReceivedEvent*)e);
         break;
 
+    case BUNDLE_RECEIVED_BATCH:
+        handle_bundle_received_batch((BundleReceivedBatchEvent*)e);
+        break;
+
     case BUNDLE_TRANSMITTED:
         handle_bundle_transmitted((BundleTransmittedEvent*)e);
         break;
@@ -52,6 +56,10 @@ BundleEventHandler::dispatch_event(BundleEvent* e)
     case BUNDLE_EXPIRED:
     	handle_bundle_expired((BundleExpiredEvent*)e);
         break;
+
+    case BUNDLE_EXPIRED_BATCH:
+        handle_bundle_expired_batch((BundleExpiredBatchEvent*)e);
+        break;
         
     case BUNDLE_FREE:
         handle_bundle_free((BundleFreeEvent*)e);
@@ -293,6 +301,14 @@ void
 BundleEventHandler::handle_bundle_received(BundleReceivedEvent*)
 {
 }
+
+/**
+ * Default event handler for batches of new bundle arrivals.
+ */
+void
+BundleEventHandler::handle_bundle_received_batch(BundleReceivedBatchEvent*)
+{
+}
     
 /**
  * Default event handler when bundles are transmitted.
@@ -326,6 +342,14 @@ BundleEventHandler::handle_bundle_expired(BundleExpiredEvent*)
 {
 }
 
+/**
+ * Default event handler for batches of bundle expirations.
+ */
+void
+BundleEventHandler::handle_bundle_expired_batch(BundleExpiredBatchEvent*)
+{
+}
+
 /**
  * Default event handler when bundles are free (i.e. no more
  * references).
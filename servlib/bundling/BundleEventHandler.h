@@ -61,6 +61,11 @@ protected:
      * Default event handler for new bundle arrivals.
      */
     virtual void handle_bundle_received(BundleReceivedEvent* event);
+
+    /**
+     * Default event handler for batches of new bundle arrivals.
+     */
+    virtual void handle_bundle_received_batch(BundleReceivedBatchEvent* event);
     
     /**
      * Default event handler when bundles are transmitted.
@@ -82,6 +87,11 @@ protected:
      */
     virtual void handle_bundle_expired(BundleExpiredEvent* event);
 
+    /**
+     * Default event handler for batches of bundle expirations.
+     */
+    virtual void handle_bundle_expired_batch(BundleExpiredBatchEvent* event);
+
     /**
      * Default event handler when bundles are free (i.e. no more
      * references).
@@ -33,7 +33,7 @@ namespace dtn {
 //----------------------------------------------------------------------
 BundleList::BundleList(const std::string& name, oasys::SpinLock* lock)
     : Logger("BundleList", "/dtn/bundle/list/%s", name.c_str()),
-      name_(name), notifier_(NULL)
+      name_(name), indexes_(0), notifier_(NULL)
 {
     if (lock != NULL) {
         lock_     = lock;
@@ -62,6 +62,192 @@ BundleList::~BundleList()
     lock_ = NULL;
 }
 
+//----------------------------------------------------------------------
+void
+BundleList::enable_index(u_int32_t indexes)
+{
+    oasys::ScopeLock l(lock_, "BundleList::enable_index");
+
+    u_int32_t added = indexes & ~indexes_;
+    if (added == 0) {
+        return;
+    }
+
+    // build the newly enabled index(es) from the current contents
+    u_int32_t old_indexes = indexes_;
+    indexes_ = added;
+    for (iterator iter = list_.begin(); iter != list_.end(); ++iter) {
+        oasys::ScopeLock bl((*iter)->lock(), "BundleList::enable_index");
+        index_bundle(*iter);
+    }
+    indexes_ = old_indexes | added;
+
+    log_debug("enabled indexes 0x%x (now 0x%x) over %zu bundles",
+              added, indexes_, list_.size());
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::get_duplicate_key(const Bundle* bundle, std::string* key)
+{
+    char buf[128];
+    snprintf(buf, 128, "%llu.%llu.%d.%u.%zu:",
+             bundle->creation_ts().seconds_,
+             bundle->creation_ts().seqno_,
+             bundle->is_fragment() ? 1 : 0,
+             bundle->frag_offset(),
+             bundle->payload().length());
+
+    key->append(buf);
+    key->append(bundle->source().c_str());
+}
+
+//----------------------------------------------------------------------
+bool
+BundleList::is_duplicate(const Bundle* b1, const Bundle* b2)
+{
+    return ((b1->source().equals(b2->source())) &&
+            (b1->creation_ts().seconds_ == b2->creation_ts().seconds_) &&
+            (b1->creation_ts().seqno_   == b2->creation_ts().seqno_) &&
+            (b1->is_fragment()          == b2->is_fragment()) &&
+            (b1->frag_offset()          == b2->frag_offset()) &&
+            (b1->payload().length()     == b2->payload().length()));
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::get_gbof_key(const EndpointID& source,
+                         const BundleTimestamp& creation_ts,
+                         bool is_fragment,
+                         u_int32_t frag_length,
+                         u_int32_t frag_offset,
+                         std::string* key)
+{
+    char buf[128];
+    if (is_fragment) {
+        snprintf(buf, 128, "%llu.%llu.1.%u.%u:",
+                 creation_ts.seconds_, creation_ts.seqno_,
+                 frag_length, frag_offset);
+    } else {
+        snprintf(buf, 128, "%llu.%llu.0:",
+                 creation_ts.seconds_, creation_ts.seqno_);
+    }
+
+    key->append(buf);
+    key->append(source.c_str());
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::get_gbof_key(const Bundle* bundle, std::string* key)
+{
+    // note that, as in the linear search, the payload length stands
+    // in for the fragment length
+    get_gbof_key(bundle->source(),
+                 bundle->creation_ts(),
+                 bundle->is_fragment(),
+                 bundle->payload().length(),
+                 bundle->frag_offset(),
+                 key);
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::string_index_add(StringIndex* index,
+                             const std::string& key, Bundle* b)
+{
+    (*index)[key].push_back(b);
+}
+
+//----------------------------------------------------------------------
+bool
+BundleList::string_index_del(StringIndex* index,
+                             const std::string& key, Bundle* b)
+{
+    bool found = false;
+    StringIndex::iterator iter = index->find(key);
+    if (iter != index->end()) {
+        std::vector<Bundle*>& bundles = iter->second;
+        std::vector<Bundle*>::iterator pos =
+            std::find(bundles.begin(), bundles.end(), b);
+        if (pos != bundles.end()) {
+            bundles.erase(pos);
+            found = true;
+        }
+        if (bundles.empty()) {
+            index->erase(iter);
+        }
+    }
+    return found;
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::index_bundle(Bundle* b)
+{
+    ASSERT(lock_->is_locked_by_me());
+
+    if (indexes_ & INDEX_DUPLICATE) {
+        std::string key;
+        get_duplicate_key(b, &key);
+        string_index_add(&dup_index_, key, b);
+    }
+
+    if (indexes_ & INDEX_GBOFID) {
+        std::string key;
+        get_gbof_key(b, &key);
+        string_index_add(&gbof_index_, key, b);
+    }
+
+    if (indexes_ & INDEX_BUNDLEID) {
+        std::pair<BundleIdIndex::iterator, bool> ret =
+            id_index_.insert(BundleIdIndex::value_type(b->bundleid(), b));
+        if (! ret.second) {
+            log_err("ERROR in index bundle: "
+                    "bundle id %d already indexed for list [%s]",
+                    b->bundleid(), name_.c_str());
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+void
+BundleList::unindex_bundle(Bundle* b)
+{
+    ASSERT(lock_->is_locked_by_me());
+
+    if (indexes_ & INDEX_DUPLICATE) {
+        std::string key;
+        get_duplicate_key(b, &key);
+        if (! string_index_del(&dup_index_, key, b)) {
+            log_err("ERROR in unindex bundle: "
+                    "bundle id %d not in duplicate index for list [%s]",
+                    b->bundleid(), name_.c_str());
+        }
+    }
+
+    if (indexes_ & INDEX_GBOFID) {
+        std::string key;
+        get_gbof_key(b, &key);
+        if (! string_index_del(&gbof_index_, key, b)) {
+            log_err("ERROR in unindex bundle: "
+                    "bundle id %d not in gbof id index for list [%s]",
+                    b->bundleid(), name_.c_str());
+        }
+    }
+
+    if (indexes_ & INDEX_BUNDLEID) {
+        BundleIdIndex::iterator iter = id_index_.find(b->bundleid());
+        if (iter == id_index_.end() || iter->second != b) {
+            log_err("ERROR in unindex bundle: "
+                    "bundle id %d not in bundle id index for list [%s]",
+                    b->bundleid(), name_.c_str());
+        } else {
+            id_index_.erase(iter);
+        }
+    }
+}
+
 //----------------------------------------------------------------------
 BundleRef
 BundleList::front() const
@@ -114,6 +300,7 @@ BundleList::add_bundle(Bundle* b, const iterator& pos)
     
     iterator new_pos = list_.insert(pos, b);
     b->mappings()->push_back(BundleMapping(this, new_pos));
+    index_bundle(b);
     b->add_ref("bundle_list", name_.c_str());
     
 	if (notifier_ != 0) {
@@ -224,7 +411,8 @@ BundleList::del_bundle(const iterator& pos, bool used_notifier)
         b->mappings()->erase(mapping);
     }
     
-    // remove the bundle from the list
+    // remove the bundle from the list and the indexes
+    unindex_bundle(b);
     list_.erase(pos);
     
     // drain one element from the semaphore
@@ -360,6 +548,14 @@ BundleList::find(u_int32_t bundle_id) const
     oasys::ScopeLock l(lock_, "BundleList::find");
     BundleRef ret("BundleList::find() temporary (by bundle_id)");
 
+    if (indexes_ & INDEX_BUNDLEID) {
+        BundleIdIndex::const_iterator iter = id_index_.find(bundle_id);
+        if (iter != id_index_.end() && !(iter->second->is_freed())) {
+            ret = iter->second;
+        }
+        return ret;
+    }
+
     for (iterator iter = begin(); iter != end(); ++iter) {
     	// We need to exclude freed bundles here, otherwise the refcounting
     	// gets really hosed up, as a find after a bundle is freed can cause
@@ -403,6 +599,22 @@ BundleList::find(GbofId& gbof_id) const
 {
     oasys::ScopeLock l(lock_, "BundleList::find");
     BundleRef ret("BundleList::find() temporary (by gbof_id)");
+
+    if (indexes_ & INDEX_GBOFID) {
+        const std::vector<Bundle*>* bundles = find_gbof(gbof_id);
+        if (bundles == NULL) {
+            return ret;
+        }
+
+        std::vector<Bundle*>::const_iterator iter;
+        for (iter = bundles->begin(); iter != bundles->end(); ++iter) {
+            if (!((*iter)->is_freed())) {
+                ret = *iter;
+                return ret;
+            }
+        }
+        return ret;
+    }
     
     for (iterator iter = begin(); iter != end(); ++iter) {
         if (gbof_id.equals((*iter)->source(),
@@ -426,6 +638,24 @@ BundleList::find(const GbofId& gbof_id, const BundleTimestamp& extended_id) cons
 {
     oasys::ScopeLock l(lock_, "BundleList::find");
     BundleRef ret("BundleList::find() temporary (by gbof_id and timestamp)");
+
+    if (indexes_ & INDEX_GBOFID) {
+        const std::vector<Bundle*>* bundles = find_gbof(gbof_id);
+        if (bundles == NULL) {
+            return ret;
+        }
+
+        std::vector<Bundle*>::const_iterator iter;
+        for (iter = bundles->begin(); iter != bundles->end(); ++iter) {
+            if (extended_id == (*iter)->extended_id() &&
+                !((*iter)->is_freed()))
+            {
+                ret = *iter;
+                return ret;
+            }
+        }
+        return ret;
+    }
     
     for (iterator iter = begin(); iter != end(); ++iter) {
         if (extended_id == (*iter)->extended_id() &&
@@ -444,6 +674,73 @@ BundleList::find(const GbofId& gbof_id, const BundleTimestamp& extended_id) cons
     return ret;
 }
 
+//----------------------------------------------------------------------
+const std::vector<Bundle*>*
+BundleList::find_gbof(const GbofId& gbof_id) const
+{
+    ASSERT(lock_->is_locked_by_me());
+    ASSERT(indexes_ & INDEX_GBOFID);
+
+    std::string key;
+    get_gbof_key(gbof_id.source_,
+                 gbof_id.creation_ts_,
+                 gbof_id.is_fragment_,
+                 gbof_id.frag_length_,
+                 gbof_id.frag_offset_,
+                 &key);
+
+    StringIndex::const_iterator iter = gbof_index_.find(key);
+    if (iter == gbof_index_.end()) {
+        return NULL;
+    }
+    return &iter->second;
+}
+
+//----------------------------------------------------------------------
+Bundle*
+BundleList::find_duplicate(const Bundle* b, bool prefer_custody) const
+{
+    ASSERT(lock_->is_locked_by_me());
+
+    Bundle* found = NULL;
+    
+    if (indexes_ & INDEX_DUPLICATE) {
+        std::string key;
+        get_duplicate_key(b, &key);
+        
+        StringIndex::const_iterator iter = dup_index_.find(key);
+        if (iter == dup_index_.end()) {
+            return NULL;
+        }
+
+        const std::vector<Bundle*>& dups = iter->second;
+        std::vector<Bundle*>::const_iterator i;
+        for (i = dups.begin(); i != dups.end(); ++i) {
+            // the key is a string rendering of the fields, so
+            // double-check the match
+            if (!is_duplicate(b, *i)) {
+                continue;
+            }
+            found = *i;
+            if (!prefer_custody || found->local_custody()) {
+                break;
+            }
+        }
+        return found;
+    }
+
+    for (iterator iter = begin(); iter != end(); ++iter) {
+        if (is_duplicate(b, *iter)) {
+            found = *iter;
+            if (!prefer_custody || found->local_custody()) {
+                break;
+            }
+        }
+    }
+    
+    return found;
+}
+
 //----------------------------------------------------------------------
 void
 BundleList::move_contents(BundleList* other)
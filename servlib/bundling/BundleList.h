@@ -18,9 +18,12 @@
 #define _BUNDLE_LIST_H_
 
 #include <list>
+#include <vector>
+#include <ext/hash_map>
 #include <oasys/compat/inttypes.h>
 #include <oasys/thread/Notifier.h>
 #include <oasys/serialize/Serialize.h>
+#include <oasys/util/StringUtils.h>
 
 #include "BundleRef.h"
 #include "naming/EndpointID.h"
@@ -64,6 +67,10 @@ class BundleTimestamp;
  * that forces the caller to use the BundleRef classes as well in
  * order to properly maintain the reference counts.
  *
+ * Lists can optionally maintain secondary hash indexes over their
+ * contents (see enable_index()). The indexes are updated by the same
+ * helper routines that maintain the bundle mappings, so they are
+ * always in sync with the list itself.
  */
 class BundleList : public oasys::Logger,  public oasys::SerializableObject {
 private:
@@ -91,6 +98,33 @@ public:
      */
     virtual ~BundleList();
 
+    /**
+     * Flags for the optional secondary indexes.
+     *
+     * Note that the fields used as index keys must not change while
+     * a bundle is on a list that indexes them.
+     */
+    typedef enum {
+        INDEX_DUPLICATE = 0x1,	///< Index by source, timestamp and
+                                ///  fragment offset / length
+        INDEX_BUNDLEID  = 0x2,	///< Index by (local) bundle id
+        INDEX_GBOFID    = 0x4	///< Index by GBOF id
+    } index_t;
+
+    /**
+     * Enable maintenance of the given secondary index(es), building
+     * them from the current list contents.
+     */
+    void enable_index(u_int32_t indexes);
+
+    /**
+     * Return whether or not the given index is maintained.
+     */
+    bool index_enabled(index_t index) const
+    {
+        return (indexes_ & index) != 0;
+    }
+
     /**
      * Peek at the first bundle on the list.
      *
@@ -220,7 +254,8 @@ public:
     }
     
     /**
-     * Search the list for a bundle with the given id.
+     * Search the list for a bundle with the given id. Constant time
+     * if INDEX_BUNDLEID is enabled.
      *
      * @return a reference to the bundle or a reference to NULL if the
      * list is empty.
@@ -238,7 +273,8 @@ public:
                    const BundleTimestamp& creation_ts) const;
 
     /**
-     * Search the list for a bundle with the given GBOF ID
+     * Search the list for a bundle with the given GBOF ID. Constant
+     * time if INDEX_GBOFID is enabled.
      *
      * @return the bundle or NULL if not found.
      */
@@ -246,13 +282,27 @@ public:
     
     /**
      * Search the list for a bundle with the given GBOF ID and extended
-     * (local) ID
+     * (local) ID. Constant time if INDEX_GBOFID is enabled.
      *
      * @return the bundle or NULL if not found.
      */
     BundleRef find(const GbofId& gbof_id,
                    const BundleTimestamp& extended_id) const;
 
+    /**
+     * Search the list for a duplicate of the given bundle, i.e. one
+     * with the same source eid, creation timestamp, fragment offset
+     * and payload length. If prefer_custody is set and there are
+     * several duplicates, one that is in local custody is returned in
+     * preference to the others.
+     *
+     * Uses the duplicate index if it is enabled, otherwise scans the
+     * list. The list lock must be held by the caller.
+     *
+     * @return the bundle or NULL if not found.
+     */
+    Bundle* find_duplicate(const Bundle* bundle, bool prefer_custody) const;
+
     /**
      * Move all bundles from this list to another.
      */
@@ -325,9 +375,68 @@ private:
      * @returns the bundle that, before this call, was at the position
      */
     Bundle* del_bundle(const iterator& pos, bool used_notifier);
-    
-    std::string      name_;	///< name of the list
-    List             list_;	///< underlying list data structure
+
+    /**
+     * Helper routines to add / remove a bundle from the enabled
+     * secondary indexes.
+     */
+    void index_bundle(Bundle* bundle);
+    void unindex_bundle(Bundle* bundle);
+
+    /**
+     * Calculate the duplicate index key for a bundle.
+     */
+    static void get_duplicate_key(const Bundle* bundle, std::string* key);
+
+    /**
+     * Calculate the GBOF id index key from the GBOF id fields. As in
+     * GbofId::equals, the fragment length and offset are only part
+     * of the key for fragments.
+     */
+    static void get_gbof_key(const EndpointID& source,
+                             const BundleTimestamp& creation_ts,
+                             bool is_fragment,
+                             u_int32_t frag_length,
+                             u_int32_t frag_offset,
+                             std::string* key);
+    static void get_gbof_key(const Bundle* bundle, std::string* key);
+
+    /**
+     * Helper routines to add / remove a bundle from a multi-valued
+     * string index.
+     */
+    typedef oasys::StringHashMap<std::vector<Bundle*> > StringIndex;
+    static void string_index_add(StringIndex* index,
+                                 const std::string& key, Bundle* bundle);
+    static bool string_index_del(StringIndex* index,
+                                 const std::string& key, Bundle* bundle);
+
+    /**
+     * Look up the bundles matching the given GBOF id in the index.
+     *
+     * @return the vector of matching bundles or NULL if none
+     */
+    const std::vector<Bundle*>* find_gbof(const GbofId& gbof_id) const;
+
+    /**
+     * Check whether two bundles are duplicates of each other.
+     */
+    static bool is_duplicate(const Bundle* b1, const Bundle* b2);
+
+    /// Type for the bundle id index. Bundle ids are unique so this is
+    /// a one-to-one map.
+    typedef __gnu_cxx::hash_map<u_int32_t, Bundle*> BundleIdIndex;
+
+    std::string      name_;	  ///< name of the list
+    List             list_;	  ///< underlying list data structure
+    u_int32_t        indexes_;	  ///< bitmask of enabled indexes
+
+    /// Duplicates are permitted on the list (unless suppressed by the
+    /// daemon) so the string keyed indexes map each key to a small
+    /// vector of bundles.
+    StringIndex      dup_index_;  ///< duplicate detection index
+    StringIndex      gbof_index_; ///< GBOF id index
+    BundleIdIndex    id_index_;   ///< bundle id index
     
 protected:
     oasys::SpinLock* lock_;	///< lock for notifier
@@ -19,6 +19,8 @@
 #endif
 
 #include <errno.h>
+#include <stdio.h>
+#include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <oasys/debug/DebugUtils.h>
@@ -39,7 +41,8 @@ bool BundlePayload::test_no_remove_ = false;
 BundlePayload::BundlePayload(oasys::SpinLock* lock)
     : Logger("BundlePayload", "/dtn/bundle/payload"),
       location_(DISK), length_(0), 
-      cur_offset_(0), base_offset_(0), lock_(lock)
+      cur_offset_(0), base_offset_(0), shared_(false), version_(0),
+      lock_(lock)
 {
 }
 
@@ -101,7 +104,11 @@ BundlePayload::init(int bundleid, location_t location)
         PANIC("duplicate entry in open fd cache");
     }
 
-    sync_payload();
+    // in group commit mode the payload is synced along with the rest
+    // of the batch once the bundle is stored, see BundleStore::add
+    if (! bs->group_commit()) {
+        sync_payload();
+    }
 
     unpin_file();
 }
@@ -143,6 +150,21 @@ BundlePayload::init_from_store(int bundleid)
         return;
     }
 
+    // a slice of another payload may still be sharing the file, or
+    // may have been given a file of its own since the bundle was
+    // last stored, in which case the slice is at the start of it
+    struct stat st;
+    if (fstat(file_.fd(), &st) == 0) {
+        if (st.st_nlink > 1) {
+            shared_ = true;
+        }
+        if (base_offset_ != 0 &&
+            (size_t)st.st_size < base_offset_ + length_)
+        {
+            base_offset_ = 0;
+        }
+    }
+
     int fd = bs->payload_fdcache()->put_and_pin(file_.path(), file_.fd());
     if (fd != file_.fd()) {
         PANIC("duplicate entry in open fd cache");
@@ -178,6 +200,7 @@ BundlePayload::set_length(size_t length)
 {
     oasys::ScopeLock l(lock_, "BundlePayload::set_length");
     length_ = length;
+    ++version_;
     if (location_ == MEMORY) {
         data_.reserve(length);
         data_.set_len(length);
@@ -235,15 +258,19 @@ BundlePayload::truncate(size_t length)
     ASSERT(length <= length_);
     length_     = length;
     cur_offset_ = length; // XXX/demmer is this right?
+    ++version_;
     
     switch (location_) {
     case MEMORY:
         data_.set_len(length);
         break;
     case DISK:
-        pin_file();
-        file_.truncate(length);
-        unpin_file();
+        // the rest of a shared file belongs to the other payloads
+        if (! shared_) {
+            pin_file();
+            file_.truncate(base_offset_ + length);
+            unpin_file();
+        }
         break;
     case NODATA:
         NOTREACHED;
@@ -256,7 +283,8 @@ BundlePayload::copy_file(oasys::FileIOClient* dst) const
 {
     ASSERT(location_ == DISK);
     pin_file();
-    file_.lseek(0, SEEK_SET);
+    file_.lseek(base_offset_, SEEK_SET);
+    cur_offset_ = base_offset_ + length();
     file_.copy_contents(dst, length());
     unpin_file();
 }
@@ -319,6 +347,9 @@ BundlePayload::replace_with_file(const char* path)
         src.close();
     }
 
+    cur_offset_  = 0;
+    base_offset_ = 0;
+    shared_      = false;
     set_length(oasys::FileUtils::size(file_.path()));
 
     // now need to re-add the entry to the cache
@@ -331,6 +362,153 @@ BundlePayload::replace_with_file(const char* path)
     return true;
 }
     
+//----------------------------------------------------------------------
+void
+BundlePayload::share_data(const BundlePayload& src, size_t src_offset,
+                          size_t len)
+{
+    oasys::ScopeLock l(lock_, "BundlePayload::share_data");
+
+    ASSERT(length_ == 0);
+    ASSERT(src.length() >= src_offset + len);
+
+    if (location_ != DISK || src.location() != DISK) {
+        set_length(len);
+        write_data(src, src_offset, len, 0);
+        return;
+    }
+
+    // link the source file next to ours and then rename it over ours,
+    // so that if the link can't be made we still have our own file
+    // to copy into
+    std::string path = file_.path();
+    std::string tmp  = path + ".slice";
+    if (::link(src.filename().c_str(), tmp.c_str()) != 0 ||
+        ::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        log_debug("share_data: can't link to %s (%s), copying the data",
+                  src.filename().c_str(), strerror(errno));
+        ::unlink(tmp.c_str());
+        set_length(len);
+        write_data(src, src_offset, len, 0);
+        return;
+    }
+
+    // our old file goes away with its fd
+    BundleStore* bs = BundleStore::instance();
+    bs->payload_fdcache()->close(file_.path());
+    file_.set_fd(-1);
+
+    if (file_.reopen(O_RDWR) < 0) {
+        log_err("share_data: error reopening file: %s", strerror(errno));
+        return;
+    }
+
+    int fd = bs->payload_fdcache()->put_and_pin(file_.path(), file_.fd());
+    if (fd != file_.fd()) {
+        PANIC("duplicate entry in open fd cache");
+    }
+    unpin_file();
+
+    log_debug("share_data: %zu bytes at offset %zu of %s",
+              len, src.base_offset_ + src_offset, src.filename().c_str());
+
+    cur_offset_  = 0;
+    base_offset_ = src.base_offset_ + src_offset;
+    length_      = len;
+    shared_      = true;
+    src.shared_  = true;
+    ++version_;
+}
+
+//----------------------------------------------------------------------
+bool
+BundlePayload::unshare()
+{
+    oasys::ScopeLock l(lock_, "BundlePayload::unshare");
+    
+    if (! shared_ && base_offset_ == 0) {
+        return true;
+    }
+    
+    return internal_unshare(true);
+}
+
+//----------------------------------------------------------------------
+bool
+BundlePayload::internal_unshare(bool rebase)
+{
+    ASSERT(lock_->is_locked_by_me());
+    ASSERT(location_ == DISK);
+
+    pin_file();
+
+    // nothing to copy if the others have all gone away, unless the
+    // slice also has to be moved to the start of the file
+    struct stat st;
+    if (fstat(file_.fd(), &st) == 0 && st.st_nlink == 1 &&
+        (base_offset_ == 0 || !rebase))
+    {
+        log_debug("unshare: file is no longer shared");
+        unpin_file();
+        shared_ = false;
+        return true;
+    }
+
+    // copy the slice to the start of a new file and rename it over
+    // the link (init_from_store notices the new layout if the bundle
+    // isn't stored again before a restart)
+    std::string path = file_.path();
+    std::string tmp  = path + ".copy";
+    
+    oasys::FileIOClient copy;
+    int err = 0;
+    if (copy.open(tmp.c_str(), O_CREAT | O_TRUNC | O_RDWR,
+                  S_IRUSR | S_IWUSR, &err) < 0)
+    {
+        log_err("unshare: error creating %s: %s", tmp.c_str(), strerror(err));
+        unpin_file();
+        return false;
+    }
+
+    file_.lseek(base_offset_, SEEK_SET);
+    cur_offset_ = base_offset_ + length_;
+    if ((length_ != 0 && file_.copy_contents(&copy, length_) < 0) ||
+        ::rename(tmp.c_str(), path.c_str()) != 0)
+    {
+        log_err("unshare: error copying %zu bytes to %s: %s",
+                length_, tmp.c_str(), strerror(errno));
+        copy.unlink();
+        unpin_file();
+        return false;
+    }
+    copy.close();
+
+    log_debug("unshare: copied %zu bytes at offset %zu",
+              length_, base_offset_);
+    
+    BundleStore* bs = BundleStore::instance();
+    unpin_file();
+    bs->payload_fdcache()->close(file_.path());
+    file_.set_fd(-1);
+
+    if (file_.reopen(O_RDWR) < 0) {
+        log_err("unshare: error reopening file: %s", strerror(errno));
+        return false;
+    }
+    
+    int fd = bs->payload_fdcache()->put_and_pin(file_.path(), file_.fd());
+    if (fd != file_.fd()) {
+        PANIC("duplicate entry in open fd cache");
+    }
+    unpin_file();
+    
+    cur_offset_  = 0;
+    base_offset_ = 0;
+    shared_      = false;
+    return true;
+}
+
 //----------------------------------------------------------------------
 void
 BundlePayload::internal_write(const u_char* bp, size_t offset, size_t len)
@@ -341,12 +519,16 @@ BundlePayload::internal_write(const u_char* bp, size_t offset, size_t len)
     }
     ASSERT(lock_->is_locked_by_me());
     ASSERT(length_ >= (offset + len));
+    ++version_;
 
     switch (location_) {
     case MEMORY:
         memcpy(data_.buf() + offset, bp, len);
         break;
     case DISK:
+        ASSERT(! shared_);
+        offset += base_offset_;
+        
         // check if we need to seek
         if (cur_offset_ != offset) {
             file_.lseek(offset, SEEK_SET);
@@ -381,6 +563,10 @@ BundlePayload::append_data(const u_char* bp, size_t len)
 {
     oasys::ScopeLock l(lock_, "BundlePayload::append_data");
 
+    if (shared_ && ! internal_unshare(false)) {
+        return;
+    }
+
     size_t old_length = length_;
     set_length(length_ + len);
     
@@ -396,6 +582,10 @@ BundlePayload::write_data(const u_char* bp, size_t offset, size_t len)
     oasys::ScopeLock l(lock_, "BundlePayload::write_data");
     
     ASSERT(length_ >= (len + offset));
+    if (shared_ && ! internal_unshare(false)) {
+        return;
+    }
+    
     pin_file();
     internal_write(bp, offset, len);
     unpin_file();
@@ -416,9 +606,9 @@ BundlePayload::write_data(const BundlePayload& src, size_t src_offset,
     ASSERT(length_       >= dst_offset + len);
     ASSERT(src.length() >= src_offset + len);
 
-    // XXX/mho: todo - for cases where we're creating a fragment from
-    // an existing bundle, make a hard link for the new fragment and
-    // store the offset in base_offset_
+    if (shared_ && ! internal_unshare(false)) {
+        return;
+    }
 
     // XXX/demmer todo -- we should copy the payload in max-length chunks
     
@@ -449,6 +639,7 @@ BundlePayload::read_data(size_t offset, size_t len, u_char* buf)
 
     case DISK:
         pin_file();
+        offset += base_offset_;
         
         // check if we need to seek first
         if (offset != cur_offset_) {
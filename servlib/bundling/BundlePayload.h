@@ -85,6 +85,24 @@ public:
      * The payload location.
      */
     location_t location() const { return location_; }
+
+    /**
+     * Offset of the payload in its file, which is non-zero for a
+     * slice of another payload.
+     */
+    size_t base_offset() const { return base_offset_; }
+
+    /**
+     * Whether the file may be shared with other payloads.
+     */
+    bool shared() const { return shared_; }
+
+    /**
+     * Count of changes to the payload data or length, so anything
+     * derived from the data can tell whether it is still current.
+     * Only kept in memory.
+     */
+    u_int32_t version() const { return version_; }
     
     /**
      * Set the payload data and length.
@@ -115,6 +133,28 @@ public:
     void write_data(const BundlePayload& src, size_t src_offset,
                     size_t len, size_t dst_offset);
 
+    /**
+     * Set the payload to len bytes of another payload, starting at
+     * src_offset. On disk the source file is hard linked rather than
+     * copied and the slice is read in place at base_offset_, so the
+     * two share the data, which stays around until the last of them
+     * removes its link. The payload must not have been written yet.
+     * Falls back to copying the data if the link can't be made.
+     */
+    void share_data(const BundlePayload& src, size_t src_offset,
+                    size_t len);
+
+    /**
+     * Give a slice of another payload a file holding just its own
+     * data. The write functions make sure a shared file is not
+     * written on their own, but this has to be done before the
+     * filename is handed to anything that expects the file to be
+     * this payload alone.
+     *
+     * @return true on success
+     */
+    bool unshare();
+
     /**
      * Copy (or link) the payload to the given file client object
      */
@@ -182,13 +222,16 @@ protected:
     void pin_file() const;
     void unpin_file() const;
     void internal_write(const u_char* bp, size_t offset, size_t len);
+    bool internal_unshare(bool rebase);
 
     location_t location_;	///< location of the data 
     oasys::ScratchBuffer<u_char*> data_; ///< payload data if in memory
     size_t length_;     	///< the payload length
     mutable oasys::FileIOClient file_;	///< file handle
     mutable size_t cur_offset_;	///< cache of current fd position
-    size_t base_offset_;	///< for fragments, offset into the file (todo)
+    size_t base_offset_;	///< for slices, offset into the file
+    mutable bool shared_;	///< file is linked to other payloads
+    u_int32_t version_;		///< bumped on every change to the data
     oasys::SpinLock* lock_;	///< the lock for the given bundle
 };
 
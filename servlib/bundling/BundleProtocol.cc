@@ -37,6 +37,7 @@
 #include "SDNV.h"
 #include "SessionBlockProcessor.h"
 #include "SequenceIDBlockProcessor.h"
+#include "TraceRing.h"
 #include "UnknownBlockProcessor.h"
 
 #ifdef BSP_ENABLED
@@ -55,7 +56,8 @@ BlockProcessor* BundleProtocol::processors_[256];
 BundleProtocol::Params::Params()
     :  age_outbound_enabled_(false),
        age_inbound_processing_(true),
-       age_zero_creation_ts_time_(true) {}
+       age_zero_creation_ts_time_(true),
+       wire_image_cache_(true) {}
 
 BundleProtocol::Params BundleProtocol::params_;
 
@@ -306,44 +308,53 @@ BundleProtocol::generate_blocks(Bundle*        bundle,
 {
     PrimaryBlockProcessor* pbp;
     size_t total_len = 0;
+    size_t i;
     // now assert there's at least 2 blocks (primary + payload) and
     // that the primary is first
     ASSERT(blocks->size() >= 2);
     ASSERT(blocks->front().type() == PRIMARY_BLOCK);
 
+    // if the bundle was already generated for another link, copy the
+    // link-independent blocks from that rather than regenerating them
+    bool cacheable = params_.wire_image_cache_ &&
+                     WireImage::cacheable(blocks);
+    WireImageRef image("BundleProtocol::generate_blocks");
+    if (cacheable) {
+        image = bundle->xmit_blocks()->find_image();
+    }
+    std::vector<bool> reused(blocks->size(), false);
+    bool dict_same = false;
+
     // now we make another pass through the list and call generate on
     // each block processor
 
-    log_info_p(LOG, "BundleProtocol::generate_blocks: calling generate() on each block processor");
     BlockInfoVec::iterator last_block = blocks->end() - 1;
+    i = 0;
     for (BlockInfoVec::iterator iter = blocks->begin();
          iter != blocks->end();
-         ++iter)
+         ++iter, ++i)
     {
         bool last = (iter == last_block);
+
+        // the primary block is handled below once the dictionary is
+        // complete
+        if (image != NULL && i != 0 &&
+            image->reuse(i, &*iter, last, blocks->dict()))
+        {
+            DTN_TRACE(BLOCK_REUSE, bundle->bundleid(), iter->type(),
+                      iter->contents().len());
+            reused[i] = true;
+            continue;
+        }
+        
         if(BP_FAIL == iter->owner()->generate(bundle, blocks, &*iter, link, last)) {
             log_err_p(LOG, "BundleProtocol::generate_blocks had %d->generate() return BP_FAIL", iter->owner()->block_type());
 
             goto fail;
         }
 
-        log_info_p(LOG, "BundleProtocol::generate_blocks: generated block (owner 0x%x type 0x%x) "
-                    "data_offset %u data_length %u contents length %zu",
-                    iter->owner()->block_type(), iter->type(),
-                    iter->data_offset(), iter->data_length(),
-                    iter->contents().len());
-
-        log_info_p(LOG, "BundleProtocol::generate_blocks: generated block (owner 0x%x type 0x%x) "
-                    "data_offset %u data_length %u contents length %zu",
-                    iter->owner()->block_type(), iter->type(),
-                    iter->data_offset(), iter->data_length(),
-                    iter->contents().len());
-
-        log_debug_p(LOG, "generated block (owner 0x%x type 0x%x) "
-                    "data_offset %u data_length %u contents length %zu",
-                    iter->owner()->block_type(), iter->type(),
-                    iter->data_offset(), iter->data_length(),
-                    iter->contents().len());
+        DTN_TRACE(BLOCK_GENERATE, bundle->bundleid(), iter->type(),
+                  iter->contents().len());
         
         if (last) {
             ASSERT((iter->flags() & BLOCK_FLAG_LAST_BLOCK) != 0);
@@ -352,29 +363,60 @@ BundleProtocol::generate_blocks(Bundle*        bundle,
         }
     }
     
+    // if the blocks generated for this link changed the dictionary,
+    // then the EID offsets in the reused blocks may be wrong, so
+    // generate those after all (their EIDs are already in the
+    // dictionary so this doesn't change it further)
+    if (image != NULL) {
+        dict_same = image->same_dict(blocks->dict());
+        for (i = 1; i < blocks->size() && !dict_same; ++i) {
+            BlockInfo* block = &(*blocks)[i];
+            if (! reused[i] || block->eid_list().empty()) {
+                continue;
+            }
+
+            reused[i] = false;
+            block->writable_contents()->set_len(0);
+            if (BP_FAIL == block->owner()->generate(bundle, blocks, block, link,
+                                                     i == blocks->size() - 1)) {
+                log_err_p(LOG, "BundleProtocol::generate_blocks had %d->generate() return BP_FAIL", block->owner()->block_type());
+                goto fail;
+            }
+        }
+    }
+    
     // Now that all the EID references are added to the dictionary,
     // generate the primary block.
-    log_info_p(LOG, "BundleProtocol::generate_blocks: calling generate() on PRIMARY block");
     pbp =
         (PrimaryBlockProcessor*)find_processor(PRIMARY_BLOCK);
     ASSERT(blocks->front().owner() == pbp);
-    pbp->generate_primary(bundle, blocks, &blocks->front());
+    if (dict_same && image->reuse(0, &blocks->front(), false, NULL)) {
+        reused[0] = true;
+    } else {
+        pbp->generate_primary(bundle, blocks, &blocks->front());
+    }
+    DTN_TRACE(PRIMARY_GENERATE, bundle->bundleid(), reused[0],
+              blocks->front().contents().len());
     
     // make a final pass through, calling finalize() and extracting
     // the block length
     //
     // NOTE: this pass must be in reverse order, from end of the list
     // to the begining, in order for security processing to work.
-    log_info_p(LOG, "BundleProtocol::generate_blocks: calling finalize() on all blocks");
+    i = blocks->size();
     for (BlockInfoVec::reverse_iterator iter = blocks->rbegin();
          iter != blocks->rend();
          ++iter)
     {
-        log_debug_p(LOG, "BundleProtocol::generate_blocks considering block of type %d", iter->type());
+        if (reused[--i]) {
+            continue;
+        }
         if(BP_FAIL == iter->owner()->finalize(bundle, blocks, &*iter, link)) {
             log_err_p(LOG, "BundleProtocol::generate_blocks had %d->finalize() return BP_FAIL", iter->owner()->block_type());
             goto fail;
         }
+        DTN_TRACE(BLOCK_FINALIZE, bundle->bundleid(), iter->type(),
+                  iter->full_length());
     }
     
     for (BlockInfoVec::iterator iter= blocks->begin();
@@ -384,8 +426,15 @@ BundleProtocol::generate_blocks(Bundle*        bundle,
         total_len += iter->full_length();
     }
 
-    log_info_p(LOG, "BundleProtocol::generate_blocks: end");
-    
+    // share the image with the other links, or capture one from this
+    // link if there isn't one yet
+    if (image == NULL && cacheable) {
+        image = new WireImage(blocks);
+    }
+    if (image != NULL) {
+        bundle->xmit_blocks()->set_image(link, image.object());
+    }
+
     return total_len;
 fail:
     bundle->xmit_blocks()->delete_blocks(link);
@@ -273,6 +273,7 @@ public:
         bool age_outbound_enabled_;
         bool age_inbound_processing_;
         bool age_zero_creation_ts_time_;
+        bool wire_image_cache_;	///< share encoded blocks across links
     };
 
     static Params params_;
@@ -0,0 +1,288 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <climits>
+#include <vector>
+#include <oasys/debug/DebugUtils.h>
+
+#include "BundleTimerWheel.h"
+
+namespace dtn {
+
+//----------------------------------------------------------------------
+BundleTimerWheel::BundleTimerWheel(u_int32_t tick_ms,
+                                   const oasys::Time& start)
+    : start_(start),
+      tick_ms_(tick_ms),
+      next_tick_(0),
+      wakeup_tick_(ULLONG_MAX),
+      count_(0),
+      notifier_(NULL)
+{
+    ASSERT(tick_ms_ != 0);
+    for (u_int level = 0; level < NUM_LEVELS; ++level) {
+        level_count_[level] = 0;
+        for (u_int i = 0; i < NUM_SLOTS; ++i) {
+            slots_[level][i].prev_ = &slots_[level][i];
+            slots_[level][i].next_ = &slots_[level][i];
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+u_int64_t
+BundleTimerWheel::elapsed_usec(const oasys::Time& t) const
+{
+    if (t < start_) {
+        return 0;
+    }
+    return (u_int64_t)(t.sec_ - start_.sec_) * 1000000 +
+           t.usec_ - start_.usec_;
+}
+
+//----------------------------------------------------------------------
+u_int64_t
+BundleTimerWheel::to_tick(const oasys::Time& t, bool round_up) const
+{
+    u_int64_t usec = elapsed_usec(t);
+    u_int64_t tick_usec = (u_int64_t)tick_ms_ * 1000;
+    return round_up ? (usec + tick_usec - 1) / tick_usec : usec / tick_usec;
+}
+
+//----------------------------------------------------------------------
+void
+BundleTimerWheel::insert(BundleTimer* timer)
+{
+    if (timer->expiry_ < next_tick_) {
+        timer->expiry_ = next_tick_;
+    }
+
+    u_int64_t delta = timer->expiry_ - next_tick_;
+    u_int level = 0;
+    u_int64_t slot_tick = timer->expiry_;
+    while (level < NUM_LEVELS - 1 &&
+           delta >= (1ULL << (SLOT_BITS * (level + 1))))
+    {
+        ++level;
+    }
+
+    // out of range of the top level, so park it in the farthest slot
+    u_int64_t range = 1ULL << (SLOT_BITS * NUM_LEVELS);
+    if (delta >= range) {
+        slot_tick = next_tick_ + range - 1;
+    }
+
+    BundleTimerLink* head =
+        &slots_[level][(slot_tick >> (SLOT_BITS * level)) & SLOT_MASK];
+    timer->level_      = level;
+    timer->prev_       = head->prev_;
+    timer->next_       = head;
+    head->prev_->next_ = timer;
+    head->prev_        = timer;
+    ++level_count_[level];
+}
+
+//----------------------------------------------------------------------
+void
+BundleTimerWheel::unlink(BundleTimer* timer)
+{
+    timer->prev_->next_ = timer->next_;
+    timer->next_->prev_ = timer->prev_;
+    timer->prev_ = NULL;
+    timer->next_ = NULL;
+    --level_count_[timer->level_];
+}
+
+//----------------------------------------------------------------------
+u_int64_t
+BundleTimerWheel::next_event_tick() const
+{
+    // all levels below the lowest occupied one are empty, so the next
+    // thing to happen is either one of its non-empty slots coming up
+    // or its index wrapping to zero, which cascades the level above
+    u_int level = 0;
+    while (level < NUM_LEVELS - 1 && level_count_[level] == 0) {
+        ++level;
+    }
+
+    u_int shift = SLOT_BITS * level;
+    u_int64_t span = 1ULL << shift;
+    u_int64_t tick = (next_tick_ + span - 1) & ~(span - 1);
+    while (true) {
+        const BundleTimerLink* head = &slots_[level][(tick >> shift) & SLOT_MASK];
+        if (((tick >> shift) & SLOT_MASK) == 0 || head->next_ != head) {
+            return tick;
+        }
+        tick += span;
+    }
+}
+
+//----------------------------------------------------------------------
+void
+BundleTimerWheel::cascade(u_int level, u_int index)
+{
+    BundleTimerLink* head = &slots_[level][index];
+    if (head->next_ == head) {
+        return;
+    }
+
+    // detach the whole list first since the timers may be reinserted
+    // into the same slot
+    BundleTimerLink list;
+    list.next_ = head->next_;
+    list.prev_ = head->prev_;
+    list.next_->prev_ = &list;
+    list.prev_->next_ = &list;
+    head->next_ = head;
+    head->prev_ = head;
+
+    while (list.next_ != &list) {
+        BundleTimer* timer = static_cast<BundleTimer*>(list.next_);
+        unlink(timer);
+        insert(timer);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+BundleTimerWheel::schedule_at(BundleTimer* timer, const oasys::Time& when)
+{
+    oasys::ScopeLock l(&lock_, "BundleTimerWheel::schedule_at");
+
+    ASSERT(!timer->pending());
+    timer->expiry_ = to_tick(when, true);
+    insert(timer);
+    ++count_;
+
+    if (timer->expiry_ < wakeup_tick_) {
+        wakeup_tick_ = timer->expiry_;
+        if (notifier_ != NULL) {
+            notifier_->notify();
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+bool
+BundleTimerWheel::cancel(BundleTimer* timer)
+{
+    oasys::ScopeLock l(&lock_, "BundleTimerWheel::cancel");
+
+    if (!timer->pending()) {
+        return false;
+    }
+
+    unlink(timer);
+    --count_;
+    return true;
+}
+
+//----------------------------------------------------------------------
+int
+BundleTimerWheel::run(const oasys::Time& now)
+{
+    std::vector<BundleTimer*> expired;
+
+    {
+        oasys::ScopeLock l(&lock_, "BundleTimerWheel::run");
+
+        u_int64_t target = to_tick(now, false);
+        while (next_tick_ <= target) {
+            if (count_ == 0) {
+                // nothing to cascade or fire, so just catch up
+                next_tick_ = target + 1;
+                break;
+            }
+
+            // skip straight to the next tick with something to do
+            u_int64_t next = next_event_tick();
+            if (next > target) {
+                next_tick_ = target + 1;
+                break;
+            }
+            next_tick_ = next;
+
+            u_int index = next_tick_ & SLOT_MASK;
+            BundleTimerLink* head = &slots_[0][index];
+            if (index == 0) {
+                for (u_int level = 1; level < NUM_LEVELS; ++level) {
+                    u_int upper = (next_tick_ >> (SLOT_BITS * level)) &
+                                  SLOT_MASK;
+                    cascade(level, upper);
+                    if (upper != 0) {
+                        break;
+                    }
+                }
+            }
+
+            while (head->next_ != head) {
+                BundleTimer* timer = static_cast<BundleTimer*>(head->next_);
+                ASSERT(timer->expiry_ == next_tick_);
+                unlink(timer);
+                --count_;
+                expired.push_back(timer);
+            }
+
+            ++next_tick_;
+        }
+    }
+
+    // the timers are no longer pending, so nobody else can free them
+    // while they are fired without holding the lock
+    for (size_t i = 0; i < expired.size(); ++i) {
+        expired[i]->timeout(now);
+    }
+
+    return next_timeout(now);
+}
+
+//----------------------------------------------------------------------
+int
+BundleTimerWheel::next_timeout(const oasys::Time& now)
+{
+    oasys::ScopeLock l(&lock_, "BundleTimerWheel::next_timeout");
+
+    if (count_ == 0) {
+        wakeup_tick_ = ULLONG_MAX;
+        return -1;
+    }
+
+    u_int64_t tick = next_event_tick();
+    wakeup_tick_ = tick;
+
+    u_int64_t now_ms  = elapsed_usec(now) / 1000;
+    u_int64_t wake_ms = tick * tick_ms_;
+    if (wake_ms <= now_ms) {
+        return 0;
+    }
+
+    u_int64_t ms = wake_ms - now_ms;
+    return ms > INT_MAX ? INT_MAX : (int)ms;
+}
+
+//----------------------------------------------------------------------
+size_t
+BundleTimerWheel::size()
+{
+    oasys::ScopeLock l(&lock_, "BundleTimerWheel::size");
+    return count_;
+}
+
+} // namespace dtn
@@ -0,0 +1,169 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _BUNDLE_TIMER_WHEEL_H_
+#define _BUNDLE_TIMER_WHEEL_H_
+
+#include <oasys/compat/inttypes.h>
+#include <oasys/thread/Notifier.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/util/Time.h>
+
+namespace dtn {
+
+/**
+ * Links for the intrusive, circular per-slot lists of the wheel.
+ */
+struct BundleTimerLink {
+    BundleTimerLink() : prev_(NULL), next_(NULL) {}
+
+    BundleTimerLink* prev_;
+    BundleTimerLink* next_;
+};
+
+/**
+ * Base class for the per-bundle timers (expiration and custody
+ * timers) that are kept in the BundleTimerWheel rather than the oasys
+ * TimerSystem.
+ *
+ * A timer that is successfully cancelled belongs to the caller again
+ * and can be deleted right away. Once cancel() fails the timer has
+ * fired (or is about to), so it is left to the timeout() handler.
+ */
+class BundleTimer : public BundleTimerLink {
+public:
+    BundleTimer() : expiry_(0), level_(0) {}
+    virtual ~BundleTimer() {}
+
+    /**
+     * Whether or not the timer is scheduled in a wheel.
+     */
+    bool pending() const { return next_ != NULL; }
+
+    /**
+     * Called from BundleTimerWheel::run() when the timer fires.
+     */
+    virtual void timeout(const oasys::Time& now) = 0;
+
+private:
+    friend class BundleTimerWheel;
+
+    u_int64_t expiry_;          ///< tick at which the timer fires
+    u_int     level_;           ///< wheel level the timer is in
+};
+
+/**
+ * Hierarchical timing wheel for the bundle timers.
+ *
+ * Time is divided into ticks of a fixed length. Level 0 has one slot
+ * for each of the next NUM_SLOTS ticks, and each higher level has
+ * slots covering NUM_SLOTS times as many ticks as the one below.
+ * Whenever the lower levels wrap around, the timers in the next slot
+ * of the level above are redistributed (cascaded) downwards. Timers
+ * beyond the range of the top level are parked in its farthest slot
+ * and re-examined when it is cascaded.
+ *
+ * Scheduling and cancelling are O(1) and cancelled timers are
+ * removed immediately. Timers fire at most one tick late, never
+ * early. The wheel is driven by calls to run(), which may be made
+ * from a different thread than the one scheduling timers; if a timer
+ * is scheduled before the wakeup time that run() last returned, the
+ * optional notifier is used to wake the caller.
+ */
+class BundleTimerWheel {
+public:
+    static const u_int SLOT_BITS  = 8;
+    static const u_int NUM_SLOTS  = 1 << SLOT_BITS;
+    static const u_int SLOT_MASK  = NUM_SLOTS - 1;
+    static const u_int NUM_LEVELS = 4;
+
+    /**
+     * Constructor, with tick zero starting at the given time.
+     */
+    BundleTimerWheel(u_int32_t tick_ms, const oasys::Time& start);
+
+    /**
+     * Set the notifier to signal when a newly scheduled timer is due
+     * before the caller of run() planned to wake up.
+     */
+    void set_notifier(oasys::Notifier* notifier) { notifier_ = notifier; }
+
+    /**
+     * Schedule the (not yet pending) timer to fire at the given time.
+     * Times in the past fire on the next tick.
+     */
+    void schedule_at(BundleTimer* timer, const oasys::Time& when);
+
+    /**
+     * Remove the timer from the wheel.
+     *
+     * @return true if the timer was pending, false if it has already
+     * fired (in which case its timeout() is or will be running).
+     */
+    bool cancel(BundleTimer* timer);
+
+    /**
+     * Fire all timers that are due at the given time.
+     *
+     * @return the number of milliseconds until run() needs to be
+     * called again, or -1 if there are no timers.
+     */
+    int run(const oasys::Time& now);
+
+    /// Number of pending timers
+    size_t size();
+
+    /// Tick length
+    u_int32_t tick_ms() const { return tick_ms_; }
+
+protected:
+    /// Microseconds from the start of the wheel to the given time
+    u_int64_t elapsed_usec(const oasys::Time& t) const;
+
+    /// Convert a time to a tick count, rounding up or down
+    u_int64_t to_tick(const oasys::Time& t, bool round_up) const;
+
+    /// Link the timer into the slot for its expiry tick
+    void insert(BundleTimer* timer);
+
+    /// Unlink the timer from its slot
+    void unlink(BundleTimer* timer);
+
+    /// Redistribute the timers in the given slot to lower levels
+    void cascade(u_int level, u_int index);
+
+    /// The first tick from next_tick_ on at which a timer fires or
+    /// has to be cascaded (there must be some timers)
+    u_int64_t next_event_tick() const;
+
+    /// Find the next tick that run() has to process and record it
+    int next_timeout(const oasys::Time& now);
+
+    oasys::SpinLock  lock_;
+    oasys::Time      start_;
+    u_int32_t        tick_ms_;
+    u_int64_t        next_tick_;    ///< first tick not yet processed
+    u_int64_t        wakeup_tick_;  ///< tick the caller will wake up at
+    size_t           count_;
+    size_t           level_count_[NUM_LEVELS];
+    oasys::Notifier* notifier_;
+
+    BundleTimerLink  slots_[NUM_LEVELS][NUM_SLOTS];
+};
+
+} // namespace dtn
+
+#endif /* _BUNDLE_TIMER_WHEEL_H_ */
@@ -91,16 +91,12 @@ CustodyTimer::CustodyTimer(const oasys::Time& xmit_time,
              xmit_time.sec_, xmit_time.usec_, delay,
              (time - oasys::Time::now()).in_milliseconds(), bundle);
 
-    // XXX/demmer the Timer interface should be changed to use oasys::Time
-    struct timeval tv;
-    tv.tv_sec  = time.sec_;
-    tv.tv_usec = time.usec_;
-    schedule_at(&tv);
+    BundleDaemon::instance()->timer_wheel()->schedule_at(this, time);
 }
 
 //----------------------------------------------------------------------
 void
-CustodyTimer::timeout(const struct timeval& now)
+CustodyTimer::timeout(const oasys::Time& now)
 {
     (void)now;
     log_info("CustodyTimer::timeout");
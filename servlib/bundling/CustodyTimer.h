@@ -18,9 +18,9 @@
 #define _CUSTODYTIMER_H_
 
 #include <oasys/serialize/Serialize.h>
-#include <oasys/thread/Timer.h>
 #include <oasys/util/Time.h>
 #include "bundling/BundleRef.h"
+#include "bundling/BundleTimerWheel.h"
 #include "contacts/Link.h"
 
 namespace dtn {
@@ -102,7 +102,7 @@ public:
  * is up to the router to initiate a retransmission on one or more
  * links.
  */
-class CustodyTimer : public oasys::Timer, public oasys::Logger {
+class CustodyTimer : public BundleTimer, public oasys::Logger {
 public:
     /** Constructor */
     CustodyTimer(const oasys::Time& xmit_time,
@@ -110,7 +110,7 @@ public:
                  Bundle* bundle, const LinkRef& link);
 
     /** Virtual timeout function */
-    void timeout(const struct timeval& now);
+    void timeout(const oasys::Time& now);
 
     ///< The bundle for whom the the timer refers
     BundleRef bundle_;
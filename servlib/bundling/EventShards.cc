@@ -0,0 +1,158 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include "EventShards.h"
+#include "BundleEvent.h"
+
+namespace dtn {
+
+//----------------------------------------------------------------------
+EventShards::EventShards(Handler* handler, const char* logpath)
+    : Logger("EventShards", "%s", logpath),
+      handler_(handler),
+      outstanding_(0),
+      drain_waiting_(false),
+      drain_notifier_(logpath)
+{
+}
+
+//----------------------------------------------------------------------
+EventShards::~EventShards()
+{
+    stop();
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::start(u_int count)
+{
+    ASSERT(shards_.empty());
+
+    for (u_int i = 0; i < count; ++i) {
+        Shard* shard = new Shard(this, i);
+        shards_.push_back(shard);
+        shard->start();
+    }
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::stop()
+{
+    for (size_t i = 0; i < shards_.size(); ++i) {
+        Shard* shard = shards_[i];
+        shard->set_should_stop();
+        shard->post(NULL);
+        shard->join();
+        delete shard;
+    }
+    shards_.clear();
+
+    // anything still queued was deleted along with the shards
+    oasys::ScopeLock l(&lock_, "EventShards::stop");
+    outstanding_ = 0;
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::post(u_int32_t key, BundleEvent* event)
+{
+    ASSERT(! shards_.empty());
+
+    {
+        oasys::ScopeLock l(&lock_, "EventShards::post");
+        outstanding_++;
+    }
+
+    shards_[key % shards_.size()]->post(event);
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::drain()
+{
+    oasys::ScopeLock l(&lock_, "EventShards::drain");
+    while (outstanding_ != 0) {
+        drain_waiting_ = true;
+        drain_notifier_.wait(&lock_);
+    }
+}
+
+//----------------------------------------------------------------------
+u_int32_t
+EventShards::outstanding()
+{
+    oasys::ScopeLock l(&lock_, "EventShards::outstanding");
+    return outstanding_;
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::completed()
+{
+    oasys::ScopeLock l(&lock_, "EventShards::completed");
+    ASSERT(outstanding_ > 0);
+    outstanding_--;
+    if (outstanding_ == 0 && drain_waiting_) {
+        drain_waiting_ = false;
+        drain_notifier_.notify(&lock_);
+    }
+}
+
+//----------------------------------------------------------------------
+EventShards::Shard::Shard(EventShards* shards, int id)
+    : Thread("EventShards::Shard", CREATE_JOINABLE),
+      Logger("EventShards::Shard", "%s/%d", shards->logpath(), id),
+      shards_(shards)
+{
+    eventq_ = new oasys::MsgQueue<BundleEvent*>(logpath_);
+}
+
+//----------------------------------------------------------------------
+EventShards::Shard::~Shard()
+{
+    BundleEvent* event;
+    while (eventq_->try_pop(&event)) {
+        delete event;
+    }
+    delete eventq_;
+}
+
+//----------------------------------------------------------------------
+void
+EventShards::Shard::run()
+{
+    while (1) {
+        BundleEvent* event = eventq_->pop_blocking();
+        if (should_stop()) {
+            delete event;
+            break;
+        }
+        ASSERT(event != NULL);
+
+        log_debug("handling event %s", event->type_str());
+        shards_->handler_->handle_sharded_event(event);
+        delete event;
+
+        shards_->completed();
+    }
+}
+
+} // namespace dtn
@@ -0,0 +1,122 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _EVENT_SHARDS_H_
+#define _EVENT_SHARDS_H_
+
+#include <vector>
+
+#include <oasys/compat/inttypes.h>
+#include <oasys/debug/Logger.h>
+#include <oasys/thread/MsgQueue.h>
+#include <oasys/thread/Notifier.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/thread/Thread.h>
+
+namespace dtn {
+
+class BundleEvent;
+
+/**
+ * A set of worker threads that handle bundle-scoped events off the
+ * daemon thread. Events are assigned to a shard by a key (the bundle
+ * id), so all events for a given bundle are handled by the same
+ * thread, in the order they were posted.
+ *
+ * The thread that posts the events can wait for all of them to be
+ * handled with drain(), which the daemon does before handling any
+ * event that has to be serialized with the sharded ones.
+ */
+class EventShards : public oasys::Logger {
+public:
+    /**
+     * Interface for the handler of the sharded events, which is
+     * called from the shard threads.
+     */
+    class Handler {
+    public:
+        virtual ~Handler() {}
+        virtual void handle_sharded_event(BundleEvent* event) = 0;
+    };
+
+    EventShards(Handler* handler, const char* logpath);
+    virtual ~EventShards();
+
+    /**
+     * Create and start the given number of shard threads.
+     */
+    void start(u_int count);
+
+    /**
+     * Stop and join the shard threads. Any events still queued on
+     * them are deleted without being handled.
+     */
+    void stop();
+
+    /**
+     * Queue an event on the shard for the given key. The shard
+     * thread takes ownership of the event.
+     */
+    void post(u_int32_t key, BundleEvent* event);
+
+    /**
+     * Block until all events posted to the shards have been handled.
+     */
+    void drain();
+
+    /// Number of events posted but not yet handled
+    u_int32_t outstanding();
+
+    /// Number of shard threads
+    size_t size() const { return shards_.size(); }
+
+    /// Whether or not there are any shard threads
+    bool empty() const { return shards_.empty(); }
+
+protected:
+    /**
+     * Worker thread for one shard.
+     */
+    class Shard : public oasys::Thread, public oasys::Logger {
+    public:
+        Shard(EventShards* shards, int id);
+        virtual ~Shard();
+
+        /// Queue an event (or NULL to wake the thread) on this shard
+        void post(BundleEvent* event) { eventq_->push_back(event); }
+
+    protected:
+        void run();
+
+        EventShards* shards_;                   ///< Owning shard set
+        oasys::MsgQueue<BundleEvent*>* eventq_; ///< The shard's queue
+    };
+    friend class Shard;
+
+    /// Called by a shard thread once it has handled an event
+    void completed();
+
+    Handler*            handler_;        ///< Handler for the events
+    std::vector<Shard*> shards_;         ///< The shard threads
+    oasys::SpinLock     lock_;           ///< Lock for the drain state
+    u_int32_t           outstanding_;    ///< Events not yet handled
+    bool                drain_waiting_;  ///< Whether drain() is waiting
+    oasys::Notifier     drain_notifier_; ///< Wakes drain() once done
+};
+
+} // namespace dtn
+
+#endif /* _EVENT_SHARDS_H_ */
@@ -30,19 +30,28 @@ ExpirationTimer::ExpirationTimer(Bundle* bundle)
 }
 
 void
-ExpirationTimer::timeout(const struct timeval& now)
+ExpirationTimer::timeout(const oasys::Time& now)
 {
     (void)now;
     oasys::ScopeLock l(bundleref_->lock(), "ExpirationTimer::timeout");
 
+    // if the bundle was removed from the pending list while we were
+    // firing, it no longer points to us and there's nothing to do
+    if (bundleref_->expiration_timer() != this) {
+        l.unlock();
+        delete this;
+        return;
+    }
+
     // null out the pointer to ourself in the bundle class
     bundleref_->set_expiration_timer(NULL);
     
-    // post the expiration event
+    // add the expiration to the batch for this tick
     log_debug_p("/timer/expiration", "Bundle %d expired", bundleref_.object()->bundleid());
-    BundleDaemon::post_at_head(new BundleExpiredEvent(bundleref_.object()));
+    BundleDaemon::instance()->add_expired_bundle(bundleref_.object());
 
     // clean ourselves up
+    l.unlock();
     delete this;
 }
 
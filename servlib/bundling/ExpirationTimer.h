@@ -17,8 +17,8 @@
 #ifndef _EXPIRATION_TIMER_H_
 #define _EXPIRATION_TIMER_H_
 
-#include <oasys/thread/Timer.h>
 #include "BundleRef.h"
+#include "BundleTimerWheel.h"
 
 namespace dtn {
 
@@ -27,9 +27,10 @@ namespace dtn {
  *
  * The timer is started when the bundle first arrives at the daemon,
  * and is cancelled when the daemon removes it from the pending list.
- *
+ * It lives in the daemon's BundleTimerWheel, and all the bundles that
+ * expire on the same tick are handed to the daemon as one batch.
  */
-class ExpirationTimer : public oasys::Timer {
+class ExpirationTimer : public BundleTimer {
 public:
     ExpirationTimer(Bundle* bundle);
 
@@ -39,7 +40,7 @@ public:
     BundleRef bundleref_;
     
 protected:
-    void timeout(const struct timeval& now);
+    void timeout(const oasys::Time& now);
 
 };
 
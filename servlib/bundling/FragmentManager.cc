@@ -130,9 +130,9 @@ FragmentManager::create_fragment(Bundle* bundle,
     log_debug("FragmentManager::create_fragment After check for overallocated length, length=%d", length);
 
 
-    // initialize payload
-    fragment->mutable_payload()->set_length(length);
-    fragment->mutable_payload()->write_data(bundle->payload(), offset, length, 0);
+    // initialize payload, sharing the bundle's payload file rather
+    // than copying the data
+    fragment->mutable_payload()->share_data(bundle->payload(), offset, length);
  
     return fragment;
 }
@@ -512,19 +512,26 @@ FragmentManager::process_for_reassembly(Bundle* fragment)
                   hash_key.c_str(), state->fragment_list().size());
     }
 
-    // stick the fragment on the reassembly list
-    state->add_fragment(fragment);
+    // stick the fragment on the reassembly list and record its range
+    size_t added = state->add_fragment(fragment);
     
-    // store the fragment data in the partially reassembled bundle file
+    // store the fragment data in the partially reassembled bundle
+    // file, unless all of it has already arrived in other fragments
     size_t fraglen = fragment->payload().length();
     
-    log_debug("write_data: length_=%zu src_offset=%u dst_offset=%u len %zu",
-              state->bundle()->payload().length(), 
-              0, fragment->frag_offset(), fraglen);
+    if (added == 0) {
+        log_debug("fragment offset %u len %zu is redundant, not writing it",
+                  fragment->frag_offset(), fraglen);
+    } else {
+        log_debug("write_data: length_=%zu src_offset=%u dst_offset=%u "
+                  "len %zu",
+                  state->bundle()->payload().length(), 
+                  0, fragment->frag_offset(), fraglen);
 
-    state->bundle()->mutable_payload()->
-        write_data(fragment->payload(), 0, fraglen,
-                   fragment->frag_offset());
+        state->bundle()->mutable_payload()->
+            write_data(fragment->payload(), 0, fraglen,
+                       fragment->frag_offset());
+    }
     
     // XXX/jmmikkel this ensures that we have a set of blocks in the
     // reassembled bundle, but eventually reassembly will have to do much more
@@ -643,8 +650,8 @@ FragmentManager::delete_fragment(Bundle* fragment)
     }
 
     // note that the old fragment data is still kept in the
-    // partially-reassembled bundle file, but there won't be metadata
-    // to indicate as such
+    // partially-reassembled bundle file, and still counted in the
+    // state's received ranges
     
     // delete reassembly state if no fragments now exist
     if (state->num_fragments() == 0) {
@@ -24,10 +24,91 @@
 namespace dtn {
 
 //----------------------------------------------------------------------
-void
+size_t
+FragmentState::RangeSet::add(size_t offset, size_t len)
+{
+    if (len == 0) {
+        return 0;
+    }
+
+    size_t start = offset;
+    size_t end   = offset + len;
+
+    // if the range before the new one reaches it, extend that one
+    // instead, unless it already covers everything
+    RangeMap::iterator iter = ranges_.upper_bound(start);
+    if (iter != ranges_.begin()) {
+        RangeMap::iterator prev = iter;
+        --prev;
+        if (prev->second >= start) {
+            if (prev->second >= end) {
+                return 0;
+            }
+            start = prev->first;
+            iter  = prev;
+        }
+    }
+
+    // absorb all the ranges that overlap or touch the new one
+    size_t before = covered_;
+    while (iter != ranges_.end() && iter->first <= end) {
+        if (iter->second > end) {
+            end = iter->second;
+        }
+        covered_ -= iter->second - iter->first;
+        ranges_.erase(iter++);
+    }
+
+    ranges_.insert(iter, RangeMap::value_type(start, end));
+    covered_ += end - start;
+
+    return covered_ - before;
+}
+
+//----------------------------------------------------------------------
+size_t
 FragmentState::add_fragment(Bundle* fragment)
 {
-    fragments_.insert_sorted(fragment, BundleList::SORT_FRAG_OFFSET);
+    ASSERT(fragment->is_fragment());
+    fragments_.push_back(fragment);
+
+    // when a fragment is proactively fragmented again, the new
+    // fragments' offsets and length are those of the original bundle
+    size_t total_len = bundle_->payload().length();
+    size_t orig_len  = total_len;
+    size_t base      = 0;
+    if (bundle_->is_fragment()) {
+        orig_len = bundle_->orig_length();
+        base     = bundle_->frag_offset();
+    }
+
+    if (fragment->orig_length() != orig_len ||
+        fragment->frag_offset() < base)
+    {
+        log_err("add_fragment: fragment orig len %u offset %u "
+                "doesn't match bundle orig len %zu offset %zu, "
+                "ignoring its data",
+                fragment->orig_length(), fragment->frag_offset(),
+                orig_len, base);
+        return 0;
+    }
+
+    size_t f_offset = fragment->frag_offset() - base;
+    size_t f_len    = fragment->payload().length();
+
+    if (f_offset > total_len || f_len > total_len - f_offset) {
+        log_err("add_fragment: fragment offset %zu len %zu "
+                "extends past total %zu, ignoring its data",
+                f_offset, f_len, total_len);
+        return 0;
+    }
+
+    size_t added = received_.add(f_offset, f_len);
+    log_debug("add_fragment: offset %zu len %zu added %zu: "
+              "got %zu/%zu in %zu ranges",
+              f_offset, f_len, added, received_.covered(), total_len,
+              received_.num_ranges());
+    return added;
 }
 
 //----------------------------------------------------------------------
@@ -41,106 +122,14 @@ FragmentState::erase_fragment(Bundle* fragment)
 bool
 FragmentState::check_completed() const
 {
-    Bundle* fragment;
-    BundleList::iterator iter;
-    oasys::ScopeLock l(fragments_.lock(),
-                       "FragmentState::check_completed");
-    
-    size_t done_up_to = 0;  // running total of completed reassembly
-    size_t f_len;
-    size_t f_offset;
-    size_t f_origlen;
-
     size_t total_len = bundle_->payload().length();
-    
-    int fragi = 0;
-    int fragn = fragments_.size();
-    (void)fragn; // in case NDEBUG is defined
-
-    for (iter = fragments_.begin();
-         iter != fragments_.end();
-         ++iter, ++fragi)
-    {
-        fragment = *iter;
-
-        f_len = fragment->payload().length();
-        f_offset = fragment->frag_offset();
-        f_origlen = fragment->orig_length();
-        
-        ASSERT(fragment->is_fragment());
-        
-        if (f_origlen != total_len) {
-            PANIC("check_completed: error fragment orig len %zu != total %zu",
-                  f_origlen, total_len);
-            // XXX/demmer deal with this
-        }
-
-        if (done_up_to == f_offset) {
-            /*
-             * fragment is adjacent to the bytes so far
-             * bbbbbbbbbb
-             *           fff
-             */
-            log_debug("check_completed fragment %d/%d: "
-                      "offset %zu len %zu total %zu done_up_to %zu: "
-                      "(perfect fit)",
-                      fragi, fragn, f_offset, f_len, f_origlen, done_up_to);
-            done_up_to += f_len;
-        }
-
-        else if (done_up_to < f_offset) {
-            /*
-             * there's a gap
-             * bbbbbbb ffff
-             */
-            log_debug("check_completed fragment %d/%d: "
-                      "offset %zu len %zu total %zu done_up_to %zu: "
-                      "(found a hole)",
-                      fragi, fragn, f_offset, f_len, f_origlen, done_up_to);
-            return false;
-
-        }
-
-        else if (done_up_to > (f_offset + f_len)) {
-            /* fragment is completely redundant, skip
-             * bbbbbbbbbb
-             *      fffff
-             */
-            log_debug("check_completed fragment %d/%d: "
-                      "offset %zu len %zu total %zu done_up_to %zu: "
-                      "(redundant fragment)",
-                      fragi, fragn, f_offset, f_len, f_origlen, done_up_to);
-            continue;
-        }
-        
-        else if (done_up_to > f_offset) {
-            /*
-             * there's some overlap, so reduce f_len accordingly
-             * bbbbbbbbbb
-             *      fffffff
-             */
-            log_debug("check_completed fragment %d/%d: "
-                      "offset %zu len %zu total %zu done_up_to %zu: "
-                      "(overlapping fragment, reducing len to %zu)",
-                      fragi, fragn, f_offset, f_len, f_origlen, done_up_to,
-                      (f_len - (done_up_to - f_offset)));
-            
-            f_len -= (done_up_to - f_offset);
-            done_up_to += f_len;
-        }
-
-        else {
-            // all cases should be covered above
-            NOTREACHED;
-        }
-    }
 
-    if (done_up_to == total_len) {
+    if (received_.covers(total_len)) {
         log_debug("check_completed reassembly complete!");
         return true;
     } else {
         log_debug("check_completed reassembly not done (got %zu/%zu)",
-                  done_up_to, total_len);
+                  received_.covered(), total_len);
         return false;
     }
 }
@@ -17,6 +17,7 @@
 #ifndef __FRAGMENT_STATE_H__
 #define __FRAGMENT_STATE_H__
 
+#include <map>
 #include <oasys/debug/Log.h>
 
 #include "BundleRef.h"
@@ -27,8 +28,52 @@ namespace dtn {
 class Bundle;
 class BlockInfoPointerList;
 
+/**
+ * Reassembly (or proactive fragmentation) state for one bundle: the
+ * list of fragments, and the set of payload byte ranges they cover.
+ *
+ * Fragments are appended to the list as they arrive, and their data
+ * written straight into the bundle's payload file, so finding out
+ * whether the bundle is complete only needs the range set.
+ */
 class FragmentState : public oasys::Logger {
 public:
+    /**
+     * A set of byte ranges, kept as disjoint, non-adjacent intervals
+     * indexed by their start offset. Adding a range merges it with any
+     * it overlaps or touches, in amortized O(log N) for N ranges.
+     */
+    class RangeSet {
+    public:
+        RangeSet() : covered_(0) {}
+
+        /**
+         * Add the range [offset, offset + len).
+         *
+         * @return the number of bytes that were not already covered
+         */
+        size_t add(size_t offset, size_t len);
+
+        /// Whether [0, len) is entirely covered
+        bool covers(size_t len) const
+        {
+            return len == 0 ||
+                (ranges_.size() == 1 && ranges_.begin()->first == 0 &&
+                 ranges_.begin()->second >= len);
+        }
+
+        /// Total number of bytes covered
+        size_t covered() const { return covered_; }
+
+        /// Number of disjoint ranges
+        size_t num_ranges() const { return ranges_.size(); }
+
+    protected:
+        typedef std::map<size_t, size_t> RangeMap; ///< start -> end
+        RangeMap ranges_;
+        size_t   covered_;
+    };
+
     FragmentState() : 
         Logger("FragmentState", "/dtn/bundle/fragmentation"),
         bundle_(new Bundle(), "fragment_state"), 
@@ -39,9 +84,25 @@ public:
         bundle_(bundle, "fragment_state"), 
         fragments_("fragment_state") { }
     
-    void add_fragment(Bundle* fragment);
+    /**
+     * Append the fragment to the list and add its payload to the
+     * received ranges.
+     *
+     * @return the number of payload bytes it adds to the ranges,
+     * which is zero if the fragment is entirely redundant
+     */
+    size_t add_fragment(Bundle* fragment);
+
+    /**
+     * Remove the fragment from the list. Its data stays in the
+     * payload file, so its range is still counted as received.
+     */
     bool erase_fragment(Bundle* fragment);
+
+    /// Whether the received ranges cover the whole payload, in O(1)
     bool check_completed() const;
+
+    const RangeSet& received() const { return received_; }
     size_t num_fragments() const { return fragments_.size(); }
     BundleRef& bundle() { return bundle_; }
     BundleList& fragment_list() { return fragments_; }
@@ -49,6 +110,7 @@ public:
 private:
     BundleRef  bundle_; ///< The bundle to eb 
     BundleList fragments_;  ///< List of partial fragments
+    RangeSet   received_;   ///< Payload ranges covered by fragments
 };
 
 } // namespace dtn
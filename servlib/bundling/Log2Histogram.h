@@ -0,0 +1,118 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _LOG2_HISTOGRAM_H_
+#define _LOG2_HISTOGRAM_H_
+
+#include <string.h>
+#include <oasys/compat/inttypes.h>
+#include <oasys/util/StringBuffer.h>
+
+namespace dtn {
+
+/**
+ * Simple fixed-size histogram with power of two bucket boundaries,
+ * cheap enough to update on every event. Bucket i counts the values v
+ * with 2^(i-1) <= v < 2^i (bucket 0 counts zeros), and the last
+ * bucket counts everything larger.
+ */
+class Log2Histogram {
+public:
+    static const int NUM_BUCKETS = 24;
+
+    Log2Histogram() { clear(); }
+
+    /// Reset all counts
+    void clear()
+    {
+        memset(buckets_, 0, sizeof(buckets_));
+        count_ = 0;
+        sum_   = 0;
+        max_   = 0;
+    }
+
+    /// Record a value
+    void add(u_int64_t val)
+    {
+        int i = 0;
+        while (i < NUM_BUCKETS - 1 && val >= (1ULL << i)) {
+            ++i;
+        }
+        buckets_[i]++;
+        count_++;
+        sum_ += val;
+        if (val > max_) {
+            max_ = val;
+        }
+    }
+
+    /// @{ Accessors
+    u_int64_t count() const { return count_; }
+    u_int64_t sum()   const { return sum_; }
+    u_int64_t max()   const { return max_; }
+    u_int64_t mean()  const { return count_ == 0 ? 0 : sum_ / count_; }
+    u_int64_t bucket(int i) const { return buckets_[i]; }
+    /// @}
+
+    /**
+     * Format the histogram on one line as the summary values followed
+     * by "<upper bound>:<count>" for each non-empty bucket.
+     */
+    void format(oasys::StringBuffer* buf) const
+    {
+        buf->appendf("count %llu mean %llu max %llu --",
+                     (unsigned long long)count_,
+                     (unsigned long long)mean(),
+                     (unsigned long long)max_);
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            if (buckets_[i] == 0) {
+                continue;
+            }
+            if (i == NUM_BUCKETS - 1) {
+                buf->appendf(" inf:%llu", (unsigned long long)buckets_[i]);
+            } else {
+                buf->appendf(" <%llu:%llu", 1ULL << i,
+                             (unsigned long long)buckets_[i]);
+            }
+        }
+    }
+
+    /**
+     * Format the histogram for scripts as space separated count, sum
+     * and max, followed by all the bucket counts separated by commas.
+     */
+    void format_raw(oasys::StringBuffer* buf) const
+    {
+        buf->appendf("%llu %llu %llu ",
+                     (unsigned long long)count_,
+                     (unsigned long long)sum_,
+                     (unsigned long long)max_);
+        for (int i = 0; i < NUM_BUCKETS; ++i) {
+            buf->appendf("%s%llu", i == 0 ? "" : ",",
+                         (unsigned long long)buckets_[i]);
+        }
+    }
+
+protected:
+    u_int64_t buckets_[NUM_BUCKETS];
+    u_int64_t count_;
+    u_int64_t sum_;
+    u_int64_t max_;
+};
+
+} // namespace dtn
+
+#endif /* _LOG2_HISTOGRAM_H_ */
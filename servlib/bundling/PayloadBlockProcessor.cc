@@ -18,12 +18,16 @@
 #  include <dtn-config.h>
 #endif
 
+#include <oasys/util/ScratchBuffer.h>
+
 #include "PayloadBlockProcessor.h"
 #include "Bundle.h"
 #include "BundleProtocol.h"
 
 namespace dtn {
 
+const size_t PayloadBlockProcessor::WORK_CHUNK_LEN;
+
 //----------------------------------------------------------------------
 PayloadBlockProcessor::PayloadBlockProcessor()
     : BlockProcessor(BundleProtocol::PAYLOAD_BLOCK)
@@ -215,8 +219,7 @@ PayloadBlockProcessor::process(process_func*    func,
                                OpaqueContext*   context)
 {
     const u_char* buf;
-    u_char  work[1024]; // XXX/pl TODO rework buffer usage
-                        // and look at type for the payload data
+    oasys::ScratchBuffer<u_char*> work(WORK_CHUNK_LEN);
     size_t  len_to_do = 0;
     
     // re-do these appropriately for the payload
@@ -245,12 +248,12 @@ PayloadBlockProcessor::process(process_func*    func,
     size_t  remaining = std::min(len, bundle->payload().length() - payload_offset);
     size_t  outlen; 
 
-    buf = work;     // use local buffer
+    buf = work.buf();
 
     while ( remaining > 0 ) {        
         outlen = 0; 
-        len_to_do = std::min(remaining, sizeof(work));   
-        buf = bundle->payload().read_data(payload_offset, len_to_do, work);
+        len_to_do = std::min(remaining, WORK_CHUNK_LEN);   
+        buf = bundle->payload().read_data(payload_offset, len_to_do, work.buf());
         
         // call the processing function to do the work
         (*func)(bundle, caller_block, target_block, buf, len_to_do, context);
@@ -272,8 +275,7 @@ PayloadBlockProcessor::mutate(mutate_func*     func,
 {
     bool changed = false;
     u_char* buf;
-    u_char  work[1024];         // XXX/pl TODO rework buffer usage
-    //    and look at type for the payload data
+    oasys::ScratchBuffer<u_char*> work(WORK_CHUNK_LEN);
     size_t  len_to_do = 0;
     
     // re-do these appropriately for the payload
@@ -300,11 +302,11 @@ PayloadBlockProcessor::mutate(mutate_func*     func,
     size_t remaining = std::min(len, bundle->payload().length() - payload_offset);
     size_t outlen; 
 
-    buf = work;     // use local buffer
+    buf = work.buf();
 
     while ( remaining > 0 ) {        
         outlen = 0; 
-        len_to_do = std::min(remaining, sizeof(work));   
+        len_to_do = std::min(remaining, WORK_CHUNK_LEN);   
         bundle->payload().read_data(payload_offset, len_to_do, buf);
         
         // call the processing function to do the work
@@ -70,7 +70,16 @@ public:
                 OpaqueContext*   context);
 
     int format(oasys::StringBuffer* buf, BlockInfo *b = NULL);
+    bool link_independent() const { return true; }
     /// @}
+
+    /**
+     * Size of the chunks in which process() and mutate() pass the
+     * payload to the processing function. Ciphersuites run over the
+     * whole payload this way, so it is large enough to keep the
+     * per-call overhead of the cipher and the file reads small.
+     */
+    static const size_t WORK_CHUNK_LEN = 64 * 1024;
 };
 
 } // namespace dtn
@@ -64,6 +64,7 @@ public:
                           BlockInfo*    block);
 
     int format(oasys::StringBuffer* buf, BlockInfo *b = NULL);
+    bool link_independent() const { return true; }
     static bool get_ipn(const EndpointID& eid, u_int64_t* iied, u_int64_t* itag);
     static void make_ipn(char *, u_int64_t, u_int64_t);
 
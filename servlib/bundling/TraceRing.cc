@@ -0,0 +1,169 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <string.h>
+#include <sys/time.h>
+
+#include "TraceRing.h"
+
+template <>
+dtn::TraceRing* oasys::Singleton<dtn::TraceRing>::instance_ = 0;
+
+namespace dtn {
+
+bool TraceRing::enabled_ = false;
+
+namespace {
+
+struct PointInfo {
+    const char* name_;
+    const char* args_[3];   ///< argument labels, NULL if unused
+};
+
+const PointInfo point_info[TraceRing::NUM_POINTS] = {
+    { "(none)",           { NULL,        NULL,       NULL       } },
+    { "block_generate",   { "bundle",    "type",     "length"   } },
+    { "block_reuse",      { "bundle",    "type",     "length"   } },
+    { "block_finalize",   { "bundle",    "type",     "length"   } },
+    { "primary_generate", { "bundle",    "reused",   "length"   } },
+    { "segment_send",     { "bundle",    "offset",   "length"   } },
+    { "data_send",        { "bundle",    "offset",   "length"   } },
+    { "data_send_zc",     { "bundle",    "offset",   "length"   } },
+    { "ack_send",         { "bundle",    "acked",    "length"   } },
+    { "segment_recv",     { "flags",     "offset",   "length"   } },
+    { "data_recv",        { "todo",      "offset",   "length"   } },
+    { "ack_recv",         { "bundle",    "acked",    "length"   } },
+};
+
+}
+
+//----------------------------------------------------------------------
+const char*
+TraceRing::point_to_str(u_int16_t point)
+{
+    if (point >= NUM_POINTS) {
+        return "(unknown)";
+    }
+    return point_info[point].name_;
+}
+
+//----------------------------------------------------------------------
+TraceRing::TraceRing()
+    : next_(0)
+{
+    memset(records_, 0, sizeof(records_));
+}
+
+//----------------------------------------------------------------------
+void
+TraceRing::set_enabled(bool enabled)
+{
+    instance();
+    enabled_ = enabled;
+}
+
+//----------------------------------------------------------------------
+void
+TraceRing::record(u_int16_t point, u_int64_t a0, u_int64_t a1, u_int64_t a2)
+{
+    // sequence numbers start at 1 so that 0 marks a record as being
+    // written; if it wraps all the way around, skip 0 as well
+    u_int32_t seq = oasys::atomic_incr_ret(&next_);
+    if (seq == 0) {
+        seq = oasys::atomic_incr_ret(&next_);
+    }
+
+    struct timeval now;
+    ::gettimeofday(&now, 0);
+
+    Record* r = &records_[seq & (SIZE - 1)];
+    r->seq_     = 0;
+    __sync_synchronize();
+    r->point_   = point;
+    r->sec_     = now.tv_sec;
+    r->usec_    = now.tv_usec;
+    r->args_[0] = a0;
+    r->args_[1] = a1;
+    r->args_[2] = a2;
+    __sync_synchronize();
+    r->seq_     = seq;
+}
+
+//----------------------------------------------------------------------
+void
+TraceRing::dump(oasys::StringBuffer* buf, u_int32_t count)
+{
+    u_int32_t last = next_.value;
+    if (count > SIZE) {
+        count = SIZE;
+    }
+    if (count > last) {
+        count = last;
+    }
+
+    buf->appendf("%u trace records (%s), showing %u\n",
+                 last, enabled_ ? "enabled" : "disabled", count);
+
+    for (u_int32_t seq = last - count + 1; seq != last + 1; ++seq) {
+        const Record* r = &records_[seq & (SIZE - 1)];
+
+        // copy the record out and make sure a concurrent record()
+        // didn't claim the slot while we were reading it
+        if (r->seq_ != seq) {
+            continue;
+        }
+        __sync_synchronize();
+        Record copy;
+        copy.point_   = r->point_;
+        copy.sec_     = r->sec_;
+        copy.usec_    = r->usec_;
+        copy.args_[0] = r->args_[0];
+        copy.args_[1] = r->args_[1];
+        copy.args_[2] = r->args_[2];
+        __sync_synchronize();
+        if (r->seq_ != seq || copy.point_ >= NUM_POINTS) {
+            continue;
+        }
+
+        const PointInfo* info = &point_info[copy.point_];
+        buf->appendf("%u %u.%06u %s", seq, copy.sec_, copy.usec_, info->name_);
+        for (int i = 0; i < 3; ++i) {
+            if (info->args_[i] != NULL) {
+                buf->appendf(" %s %llu", info->args_[i],
+                             (unsigned long long)copy.args_[i]);
+            }
+        }
+        buf->append("\n");
+    }
+}
+
+//----------------------------------------------------------------------
+void
+TraceRing::clear()
+{
+    // records in flight during a clear may survive it, which is fine
+    // for a debugging aid
+    next_.value = 0;
+    for (u_int32_t i = 0; i < SIZE; ++i) {
+        records_[i].seq_ = 0;
+    }
+}
+
+} // namespace dtn
@@ -0,0 +1,147 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _TRACE_RING_H_
+#define _TRACE_RING_H_
+
+#include <oasys/compat/inttypes.h>
+#include <oasys/thread/Atomic.h>
+#include <oasys/util/Singleton.h>
+#include <oasys/util/StringBuffer.h>
+
+/**
+ * Per-segment trace points in the convergence layers are compiled in
+ * by default. Building with -DDTN_TRACE_SEGMENTS=0 removes them (and
+ * the per-segment debug logging they replace) entirely.
+ */
+#ifndef DTN_TRACE_SEGMENTS
+#define DTN_TRACE_SEGMENTS 1
+#endif
+
+namespace dtn {
+
+/**
+ * A fixed-size ring of binary trace records for the per-block and
+ * per-segment hot paths, where even a filtered log call costs a log
+ * path lookup per call.
+ *
+ * Recording a trace point is one atomic increment to claim a slot and
+ * a few stores, with no locking or formatting; the records are only
+ * formatted when the ring is dumped. Tracing is off until enabled at
+ * runtime, and a disabled trace point costs a single test of a flag.
+ *
+ * Each record carries the trace point and up to three integer
+ * arguments, whose meaning is given by the point's format string.
+ * When the ring wraps, the oldest records are overwritten.
+ */
+class TraceRing : public oasys::Singleton<TraceRing> {
+public:
+    /**
+     * The trace points.
+     */
+    typedef enum {
+        BLOCK_GENERATE = 1,     ///< generated a block for a link
+        BLOCK_REUSE,            ///< copied a block from the wire image
+        BLOCK_FINALIZE,         ///< finalized a block for a link
+        PRIMARY_GENERATE,       ///< generated or reused the primary block
+        SEGMENT_SEND,           ///< started an outgoing data segment
+        DATA_SEND,              ///< sent data from the block buffers
+        DATA_SEND_ZC,           ///< sent payload data with zero copy
+        ACK_SEND,               ///< sent an ack segment
+        SEGMENT_RECV,           ///< got an incoming data segment header
+        DATA_RECV,              ///< consumed incoming segment data
+        ACK_RECV,               ///< got an ack segment
+        NUM_POINTS
+    } point_t;
+
+    /// Name of a trace point
+    static const char* point_to_str(u_int16_t point);
+
+    /// Number of records in the ring (a power of two)
+    static const u_int32_t SIZE = 1 << 14;
+
+    /**
+     * Whether tracing is on. Checked by the DTN_TRACE macros before
+     * anything else is done.
+     */
+    static bool enabled_;
+
+    /**
+     * Turn tracing on or off. This also creates the ring if needed so
+     * that record() never has to.
+     */
+    static void set_enabled(bool enabled);
+
+    /**
+     * Record a trace point.
+     */
+    void record(u_int16_t point,
+                u_int64_t a0 = 0, u_int64_t a1 = 0, u_int64_t a2 = 0);
+
+    /**
+     * Format (at most) the given number of most recent records, oldest
+     * first. Records that are overwritten while they are being read
+     * are skipped.
+     */
+    void dump(oasys::StringBuffer* buf, u_int32_t count = SIZE);
+
+    /// Total number of records since startup (or the last clear)
+    u_int32_t recorded() const { return next_.value; }
+
+    /// Discard all records
+    void clear();
+
+private:
+    friend class oasys::Singleton<TraceRing>;
+
+    struct Record {
+        volatile u_int32_t seq_;    ///< sequence number, 0 while written
+        u_int16_t          point_;
+        u_int32_t          sec_;
+        u_int32_t          usec_;
+        u_int64_t          args_[3];
+    };
+
+    TraceRing();
+
+    oasys::atomic_t next_;          ///< last sequence number handed out
+    Record          records_[SIZE];
+};
+
+} // namespace dtn
+
+/**
+ * Record a trace point if tracing is enabled.
+ */
+#define DTN_TRACE(_point, _a0, _a1, _a2)                                \
+    do {                                                                \
+        if (::dtn::TraceRing::enabled_) {                               \
+            ::dtn::TraceRing::instance()->record(                       \
+                ::dtn::TraceRing::_point, (_a0), (_a1), (_a2));         \
+        }                                                               \
+    } while (0)
+
+/**
+ * Record a per-segment trace point, unless they are compiled out.
+ */
+#if DTN_TRACE_SEGMENTS
+#define DTN_SEGMENT_TRACE(_point, _a0, _a1, _a2) \
+    DTN_TRACE(_point, _a0, _a1, _a2)
+#else
+#define DTN_SEGMENT_TRACE(_point, _a0, _a1, _a2) do {} while (0)
+#endif
+
+#endif /* _TRACE_RING_H_ */
@@ -52,6 +52,7 @@ public:
                   status_report_reason_t* deletion_reason);
 
     int format(oasys::StringBuffer* buf);
+    bool link_independent() const { return true; }
     /// @}
 };
 
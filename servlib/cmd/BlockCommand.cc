@@ -24,6 +24,12 @@ BlockCommand::BlockCommand()
                                 &BundleProtocol::params_.age_zero_creation_ts_time_,
                                 "Is the Creation Timestamp Time zeroed out "
                                 "(default is true)"));
+
+    bind_var(new oasys::BoolOpt("wire_image_cache",
+                                &BundleProtocol::params_.wire_image_cache_,
+                                "Are link-independent blocks encoded once and "
+                                "shared by all the links a bundle is queued on "
+                                "(default is true)"));
 }
     
 } // namespace dtn
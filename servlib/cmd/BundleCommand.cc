@@ -28,6 +28,7 @@
 #include "bundling/Bundle.h"
 #include "bundling/BundleEvent.h"
 #include "bundling/BundleDaemon.h"
+#include "bundling/TraceRing.h"
 #include "reg/RegistrationTable.h"
 #include "reg/TclRegistration.h"
 
@@ -46,8 +47,11 @@ BundleCommand::BundleCommand()
                 "            deletion_rcpt\n"
                 "            expiration=integer\n"
                 "            length=integer\n");
-    add_to_help("stats", "get statistics on the bundles");
-    add_to_help("daemon_stats", "daemon stats");
+    add_to_help("stats [-memory]", "get statistics on the bundles, or an "
+                "estimate of their memory use by field");
+    add_to_help("daemon_stats [-detailed [-raw]]",
+                "daemon stats, or with -detailed the per event type counts "
+                "and queue / handler time histograms (-raw for scripts)");
     add_to_help("reset_stats", "reset currently maintained statistics");
     add_to_help("list", "list all of the bundles in the system");
     add_to_help("ids", "list the ids of all bundles the system");
@@ -60,6 +64,9 @@ BundleCommand::BundleCommand()
     add_to_help("clear_fwdlog <id>", "clear the forwarding log for a bundle");
     add_to_help("daemon_idle_shutdown <secs>",
                 "shut down the bundle daemon after an idle period");
+    add_to_help("trace <on|off|clear|dump [count]>",
+                "control the binary trace of the per-block and per-segment "
+                "paths, or dump its most recent records");
 }
 
 BundleCommand::InjectOpts::InjectOpts()
@@ -251,14 +258,48 @@ BundleCommand::exec(int objc, Tcl_Obj** objv, Tcl_Interp* interp)
         return TCL_OK;
         
     } else if (!strcmp(cmd, "stats")) {
+        // bundle stats [-memory]
+        if (argc == 3 && !strcmp(argv[2], "-memory")) {
+            oasys::StringBuffer buf("Bundle Memory: ");
+            BundleDaemon::instance()->get_bundle_memory_stats(&buf);
+            set_result(buf.c_str());
+            return TCL_OK;
+        } else if (argc != 2) {
+            wrong_num_args(argc, argv, 2, 2, 3);
+            return TCL_ERROR;
+        }
+        
         oasys::StringBuffer buf("Bundle Statistics: ");
         BundleDaemon::instance()->get_bundle_stats(&buf);
         set_result(buf.c_str());
         return TCL_OK;
 
     } else if (!strcmp(cmd, "daemon_stats")) {
-        oasys::StringBuffer buf("Bundle Daemon Statistics: ");
-        BundleDaemon::instance()->get_daemon_stats(&buf);
+        // bundle daemon_stats [-detailed [-raw]]
+        bool detailed = false, raw = false;
+        for (int i = 2; i < argc; ++i) {
+            if (!strcmp(argv[i], "-detailed")) {
+                detailed = true;
+            } else if (!strcmp(argv[i], "-raw")) {
+                raw = true;
+            } else {
+                resultf("invalid daemon_stats option %s", argv[i]);
+                return TCL_ERROR;
+            }
+        }
+
+        if (raw && !detailed) {
+            resultf("-raw is only valid with -detailed");
+            return TCL_ERROR;
+        }
+        
+        oasys::StringBuffer buf;
+        if (detailed) {
+            BundleDaemon::instance()->get_event_stats(&buf, raw);
+        } else {
+            buf.append("Bundle Daemon Statistics: ");
+            BundleDaemon::instance()->get_daemon_stats(&buf);
+        }
         set_result(buf.c_str());
         return TCL_OK;
     } else if (!strcmp(cmd, "daemon_status")) {
@@ -449,6 +490,39 @@ BundleCommand::exec(int objc, Tcl_Obj** objv, Tcl_Interp* interp)
         BundleDaemon::instance()->init_idle_shutdown(interval);
         return TCL_OK;
         
+    } else if (!strcmp(cmd, "trace")) {
+        // bundle trace <on|off|clear|dump [count]>
+        if (argc < 3 || argc > 4) {
+            wrong_num_args(argc, argv, 2, 3, 4);
+            return TCL_ERROR;
+        }
+
+        const char* op = argv[2];
+        if (argc == 3 && !strcmp(op, "on")) {
+            TraceRing::set_enabled(true);
+        } else if (argc == 3 && !strcmp(op, "off")) {
+            TraceRing::set_enabled(false);
+        } else if (argc == 3 && !strcmp(op, "clear")) {
+            TraceRing::instance()->clear();
+        } else if (!strcmp(op, "dump")) {
+            u_int32_t count = TraceRing::SIZE;
+            if (argc == 4) {
+                char* end;
+                count = strtoul(argv[3], &end, 10);
+                if (*end != '\0') {
+                    resultf("invalid count %s", argv[3]);
+                    return TCL_ERROR;
+                }
+            }
+            oasys::StringBuffer buf;
+            TraceRing::instance()->dump(&buf, count);
+            set_result(buf.c_str());
+        } else {
+            resultf("invalid trace operation %s", op);
+            return TCL_ERROR;
+        }
+        return TCL_OK;
+
     } else {
         resultf("unknown bundle subcommand %s", cmd);
         return TCL_ERROR;
@@ -47,6 +47,11 @@ ECLACommand::ECLACommand()
               "ECLA server port",
               "The port to listen for external CLAs on") );
     
+    bind_var( new oasys::StringOpt("server_path",
+              &ExternalConvergenceLayer::server_path_,
+              "ECLA server socket path",
+              "A Unix domain socket to also listen for external CLAs on") );
+    
     bind_var( new oasys::BoolOpt("create_discovered_links",
               &ExternalConvergenceLayer::create_discovered_links_,
               "Whether external CLAs should create discovered links") );
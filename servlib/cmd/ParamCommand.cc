@@ -22,6 +22,7 @@
 #include "bundling/BundleDaemon.h"
 #include "bundling/BundlePayload.h"
 #include "bundling/CustodyTimer.h"
+#include "conv_layers/CLReactor.h"
 #include "naming/EndpointID.h"
 
 namespace dtn {
@@ -78,6 +79,25 @@ ParamCommand::ParamCommand()
                                 "when restarting "
                                 "(default is true)"));
 
+    bind_var(new oasys::UIntOpt("event_shards",
+                                &BundleDaemon::params_.event_shards_,
+                                "num",
+                                "Number of worker threads for bundle events "
+                                "that the router can handle in parallel, "
+                                "must be set before the daemon starts "
+                                "(default is 0, all events are handled "
+                                "by the daemon thread)"));
+
+    bind_var(new oasys::UIntOpt("cl_reactor_threads",
+                                &CLReactor::threads_,
+                                "num",
+                                "Number of threads that service all the "
+                                "connections of the tcp and other "
+                                "connection-based convergence layers, "
+                                "must be set before any links are opened, "
+                                "later changes are ignored "
+                                "(default is 0, a thread per connection)"));
+
     static oasys::EnumOpt::Case IsSingletonCases[] = {
         {"unknown",   EndpointID::UNKNOWN},
         {"singleton", EndpointID::SINGLETON},
@@ -54,7 +54,8 @@ ProphetCommand::ProphetCommand()
 
     bind_var(new oasys::UIntOpt("kappa", &ProphetRouter::params_.kappa_, 
                                 "val",
-                                "scaling factor for aging equation"));
+                                "milliseconds per time unit for aging "
+                                "equation"));
 
     bind_var(new oasys::UIntOpt("hello_dead", &ProphetRouter::params_.hello_dead_,
                                 "num",
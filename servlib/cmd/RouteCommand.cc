@@ -197,6 +197,35 @@ RouteCommand::RouteCommand()
                                 "so plug-in routers"
                                 "can perform validation (default is false)\n"
 		"	valid options:  true or false\n"));
+
+    static oasys::EnumOpt::Case EncodingCases[] = {
+        {"xml",    ExternalRouter::ENCODING_XML},
+        {"binary", ExternalRouter::ENCODING_BINARY},
+        {0, 0}
+    };
+
+    bind_var(new oasys::EnumOpt("server_encoding",
+                                EncodingCases,
+                                &ExternalRouter::server_encoding,
+                                "<xml|binary>",
+                                "Encoding of messages multicast to "
+                                "external router(s) (default xml)\n"
+		"	valid options:  xml or binary\n"));
+
+    bind_var(new oasys::UInt16Opt("stream_port",
+				&ExternalRouter::stream_port,
+				"port",
+				"TCP port on the loopback interface for "
+				"stream connections from external router(s) "
+				"(default 0, disabled)\n"
+		"	valid options:  number\n"));
+
+    bind_var(new oasys::StringOpt("stream_path",
+				&ExternalRouter::stream_path,
+				"path",
+				"Unix domain socket for stream connections "
+				"from external router(s) (default \"\", disabled)\n"
+		"	valid options:  string\n"));
 #endif
 }
 
@@ -30,6 +30,8 @@
 #include "SecurityCommand.h"
 #include "security/KeyDB.h"
 #include "security/Ciphersuite.h"
+#include "security/DigestCache.h"
+#include "security/GCMContext.h"
 
 
 namespace dtn {
@@ -67,6 +69,13 @@ SecurityCommand::SecurityCommand()
     		    "Don't require any incoming BSP");
     add_to_help("listpolicy",
     		    "Display infomation on the incoming and outgoing ciphersuites");
+    add_to_help("stats [reset]",
+                "Show (or reset) the counts of BA/PI digests reused from\n"
+                "the per-bundle digest cache.");
+    add_to_help("gcm_backend [auto | software | openssl]",
+                "Show or set the AES-GCM implementation used by the confidentiality\n"
+                "ciphersuites. \"auto\" uses OpenSSL if the CPU has AES and\n"
+                "carry-less multiply instructions.");
 }
 
 int
@@ -288,6 +297,44 @@ SecurityCommand::exec(int argc, const char** argv, Tcl_Interp* interp)
         }
     } else if(strcmp(cmd, "listpaths") == 0) {
         set_result(Ciphersuite::config->list_maps().c_str());
+    } else if (strcmp(cmd, "stats") == 0) {
+        // security stats [reset]
+        if (argc > 3) {
+            wrong_num_args(argc, argv, 2, 2, 3);
+            return TCL_ERROR;
+        }
+
+        if (argc == 3) {
+            if (strcmp(argv[2], "reset") != 0) {
+                resultf("invalid stats option \"%s\"", argv[2]);
+                return TCL_ERROR;
+            }
+            DigestCache::reset_stats();
+            return TCL_OK;
+        }
+
+        oasys::StringBuffer buf;
+        DigestCache::get_stats(&buf);
+        set_result(buf.c_str());
+    } else if (strcmp(cmd, "gcm_backend") == 0) {
+        // security gcm_backend [auto | software | openssl]
+        if (argc > 3) {
+            wrong_num_args(argc, argv, 2, 2, 3);
+            return TCL_ERROR;
+        }
+
+        if (argc == 3) {
+            GCMContext::backend_t backend;
+            if (! GCMContext::str_to_backend(argv[2], &backend)) {
+                resultf("invalid gcm backend \"%s\"", argv[2]);
+                return TCL_ERROR;
+            }
+            GCMContext::set_default_backend(backend);
+        }
+
+        GCMContext::backend_t backend = GCMContext::default_backend();
+        resultf("%s (using %s)", GCMContext::backend_to_str(backend),
+                GCMContext::backend_to_str(GCMContext::resolve(backend)));
     } else {
         resultf("no such security subcommand %s", cmd);
         return TCL_ERROR;
@@ -155,6 +155,20 @@ StorageCommand::StorageCommand(DTNStorageConfig* cfg)
                                 "open in a cache (default 32)\n"
 		"	valid options:	number"));
 
+    bind_var(new oasys::UIntOpt("group_commit_batch",
+                                &cfg->group_commit_batch_,
+                                "num", "max number of daemon events whose "
+                                "storage updates and payload syncs are "
+                                "committed together (default 0 - commit "
+                                "after every event)\n"
+		"	valid options:	number"));
+
+    bind_var(new oasys::UIntOpt("group_commit_interval",
+                                &cfg->group_commit_interval_,
+                                "ms", "max time a group commit batch is "
+                                "held open (default 10)\n"
+		"	valid options:	number"));
+
     bind_var(new oasys::UInt16Opt("server_port",
                                   &cfg->server_port_,
                                   "port number",
@@ -189,6 +203,9 @@ StorageCommand::StorageCommand(DTNStorageConfig* cfg)
     		 "	valid options:	positive integer"));
 
     add_to_help("usage", "print the current storage usage");
+    add_to_help("commit_stats [-reset]",
+                "print (or clear) the group commit batch size and "
+                "latency histograms");
 }
 
 //----------------------------------------------------------------------
@@ -210,6 +227,22 @@ StorageCommand::exec(int argc, const char** argv, Tcl_Interp* interp)
         return TCL_OK;
     }
 
+    if (!strcmp(cmd, "commit_stats")) {
+        // storage commit_stats [-reset]
+        if (argc == 3 && !strcmp(argv[2], "-reset")) {
+            BundleStore::instance()->reset_commit_stats();
+            return TCL_OK;
+        } else if (argc != 2) {
+            wrong_num_args(argc, argv, 2, 2, 3);
+            return TCL_ERROR;
+        }
+
+        oasys::StringBuffer buf;
+        BundleStore::instance()->dump_commit_stats(&buf);
+        set_result(buf.c_str());
+        return TCL_OK;
+    }
+
     resultf("unknown storage subcommand %s", cmd);
     return TCL_ERROR;
 }
@@ -353,7 +353,7 @@ AX25CMConvergenceLayer::Listener::accepted(int fd, const std::string& addr)
     Connection* conn =
         new Connection(cl_, &AX25CMConvergenceLayer::default_link_params_,
                        fd, local_call(), addr, axport());
-    conn->start();
+    conn->start_service();
 }
 
 //----------------------------------------------------------------------
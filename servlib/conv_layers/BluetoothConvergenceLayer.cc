@@ -312,7 +312,7 @@ BluetoothConvergenceLayer::Listener::accepted(int fd, bdaddr_t addr,
     Connection *conn =
         new Connection(cl_, &BluetoothConvergenceLayer::default_link_params_,
                        fd, addr, channel);
-    conn->start();
+    conn->start_service();
 }
 
 //----------------------------------------------------------------------
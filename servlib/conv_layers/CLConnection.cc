@@ -22,6 +22,7 @@
 #include <oasys/util/Time.h>
 
 #include "CLConnection.h"
+#include "CLReactor.h"
 #include "bundling/BundleDaemon.h"
 #include "bundling/BundlePayload.h"
 #include "contacts/ContactManager.h"
@@ -45,7 +46,10 @@ CLConnection::CLConnection(const char*       classname,
       active_connector_(active_connector),
       num_pollfds_(0),
       poll_timeout_(-1),
-      contact_broken_(false)
+      contact_broken_(false),
+      next_write_(0, 0),
+      in_reactor_(false),
+      reactor_stopped_(false)
 {
     sendbuf_.reserve(params_->sendbuf_len_);
     recvbuf_.reserve(params_->recvbuf_len_);
@@ -56,16 +60,72 @@ CLConnection::~CLConnection()
 {
 }
 
+//----------------------------------------------------------------------
+void
+CLConnection::start_service()
+{
+    if (CLReactor::enabled()) {
+        in_reactor_ = true;
+        CLReactor::instance()->add(this);
+    } else {
+        Thread::start();
+    }
+}
+
+//----------------------------------------------------------------------
+bool
+CLConnection::service_stopped()
+{
+    if (in_reactor_) {
+        return reactor_stopped_;
+    }
+    return Thread::is_stopped();
+}
+
 //----------------------------------------------------------------------
 void
 CLConnection::run()
+{
+    if (! open_io()) {
+        return;
+    }
+
+    while (true) {
+        int timeout;
+        if (! prepare_poll(&timeout)) {
+            return;
+        }
+
+        // now we poll() to wait for a new command (indicated by the
+        // notifier on the command queue), data arriving from the
+        // remote side, or write-readiness on the socket indicating
+        // that we can send more data.
+        for (int i = 0; i < num_pollfds_ + 1; ++i) {
+            pollfds_[i].revents = 0;
+        }
+
+        log_debug("calling poll on %d fds with timeout %d",
+                  num_pollfds_ + 1, timeout);
+                                                 
+        int cc = oasys::IO::poll_multiple(pollfds_, num_pollfds_ + 1,
+                                          timeout, NULL, logpath_);
+
+        if (! handle_poll_result(cc)) {
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+bool
+CLConnection::open_io()
 {
     struct pollfd* cmdqueue_poll;
 
     initialize_pollfds();
     if (contact_broken_) {
         log_debug("contact_broken set during initialization");
-        return;
+        return false;
     }
 
     cmdqueue_poll         = &pollfds_[num_pollfds_];
@@ -82,110 +142,112 @@ CLConnection::run()
         accept();
     }
 
-    oasys::Time next_write(0,0);
+    next_write_.sec_  = 0;
+    next_write_.usec_ = 0;
     
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+CLConnection::prepare_poll(int* timeout)
+{
+    // check the comand queue coming in from the bundle daemon
+    // if any arrive, we check contact_broken and then process any
+    // other commands before checking for data to/from the remote side
     while (true) {
         if (contact_broken_) {
             log_debug("contact_broken set, exiting main loop");
-            return;
+            return false;
         }
 
-        // check the comand queue coming in from the bundle daemon
-        // if any arrive, we continue to the top of the loop to check
-        // contact_broken and then process any other commands before
-        // checking for data to/from the remote side
-        if (cmdqueue_.size() != 0) {
-            process_command();
-            continue;
+        if (cmdqueue_.size() == 0) {
+            break;
         }
 
-        oasys::Time now = oasys::Time::now();
+        process_command();
+    }
+
+    oasys::Time now = oasys::Time::now();
         
-        int timeout;
-        if (params_->test_write_delay_ == 0)
-        {
-            // send any data there is to send. if something was sent
-            // out and there's still more to go, we'll call poll() with a
-            // zero timeout so we can read any data there is to
-            // consume, then return to send another chunk.
+    if (params_->test_write_delay_ == 0)
+    {
+        // send any data there is to send. if something was sent
+        // out and there's still more to go, we'll call poll() with a
+        // zero timeout so we can read any data there is to
+        // consume, then return to send another chunk.
+        bool more_to_send = send_pending_data();
+        *timeout = more_to_send ? 0 : poll_timeout_;
+    }
+    else
+    {
+        // to implement the test_write_delay we need to track the
+        // time to call write again
+        if (now >= next_write_) {
             bool more_to_send = send_pending_data();
-            timeout = more_to_send ? 0 : poll_timeout_;
-        }
-        else
-        {
-            // to implement the test_write_delay we need to track the
-            // time to call write again
-            if (now >= next_write) {
-                bool more_to_send = send_pending_data();
-                if (more_to_send) {
-                    next_write = now;
-                    next_write.add_milliseconds(params_->test_write_delay_);
-                } else {
-                    next_write.sec_  = 0;
-                    next_write.usec_ = 0;
-                }
-            }
-
-            // if next_write is non-zero, then there's more to send.
-            if (next_write.sec_ != 0) {
-                timeout = std::min((u_int32_t)poll_timeout_,
-                                   (next_write - now).in_milliseconds());
+            if (more_to_send) {
+                next_write_ = now;
+                next_write_.add_milliseconds(params_->test_write_delay_);
             } else {
-                timeout = poll_timeout_;
+                next_write_.sec_  = 0;
+                next_write_.usec_ = 0;
             }
-
-            log_debug("timeout is %u: next_write %u.%u (%u ms from now), poll_timeout %d",
-                      timeout, next_write.sec_, next_write.usec_, 
-                      next_write.sec_ == 0 ? 0 : (next_write - now).in_milliseconds(), poll_timeout_);
-            
         }
-        
-        // check again here for contact broken since we don't want to
-        // poll if the socket's been closed
-        if (contact_broken_) {
-            log_debug("contact_broken set, exiting main loop");
-            return;
+
+        // if next_write is non-zero, then there's more to send.
+        if (next_write_.sec_ != 0) {
+            *timeout = std::min((u_int32_t)poll_timeout_,
+                                (next_write_ - now).in_milliseconds());
+        } else {
+            *timeout = poll_timeout_;
         }
+
+        log_debug("timeout is %u: next_write %u.%u (%u ms from now), poll_timeout %d",
+                  *timeout, next_write_.sec_, next_write_.usec_, 
+                  next_write_.sec_ == 0 ? 0 : (next_write_ - now).in_milliseconds(), poll_timeout_);
+            
+    }
         
-        // now we poll() to wait for a new command (indicated by the
-        // notifier on the command queue), data arriving from the
-        // remote side, or write-readiness on the socket indicating
-        // that we can send more data.
-        for (int i = 0; i < num_pollfds_ + 1; ++i) {
-            pollfds_[i].revents = 0;
-        }
+    // check again here for contact broken since we don't want to
+    // poll if the socket's been closed
+    if (contact_broken_) {
+        log_debug("contact_broken set, exiting main loop");
+        return false;
+    }
 
-        log_debug("calling poll on %d fds with timeout %d",
-                  num_pollfds_ + 1, timeout);
-                                                 
-        int cc = oasys::IO::poll_multiple(pollfds_, num_pollfds_ + 1,
-                                          timeout, NULL, logpath_);
-                                          
-        // check again here for contact broken since we don't want to
-        // act on the poll result if the contact is broken
-        if (contact_broken_) {
-            log_debug("contact_broken set, exiting main loop");
-            return;
-        }
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+CLConnection::handle_poll_result(int cc)
+{
+    // check again here for contact broken since we don't want to
+    // act on the poll result if the contact is broken
+    if (contact_broken_) {
+        log_debug("contact_broken set, exiting main loop");
+        return false;
+    }
         
-        if (cc == oasys::IOTIMEOUT)
-        {
-            handle_poll_timeout();
-        }
-        else if (cc > 0)
-        {
-            if (cc == 1 && cmdqueue_poll->revents != 0) {
-                continue; // activity on the command queue only
-            }
-            handle_poll_activity();
-        }
-        else
-        {
-            log_err("unexpected return from poll_multiple: %d", cc);
-            break_contact(ContactEvent::BROKEN);
-            return;
+    if (cc == oasys::IOTIMEOUT)
+    {
+        handle_poll_timeout();
+    }
+    else if (cc > 0)
+    {
+        if (cc == 1 && pollfds_[num_pollfds_].revents != 0) {
+            return true; // activity on the command queue only
         }
+        handle_poll_activity();
     }
+    else
+    {
+        log_err("unexpected return from poll_multiple: %d", cc);
+        break_contact(ContactEvent::BROKEN);
+        return false;
+    }
+
+    return true;
 }
 
 //----------------------------------------------------------------------
@@ -18,12 +18,14 @@
 #define _CLCONNECTION_H_
 
 #include <list>
+#include <unistd.h>
 #include <oasys/debug/Log.h>
 #include <oasys/thread/Atomic.h>
 #include <oasys/thread/MsgQueue.h>
 #include <oasys/thread/Thread.h>
 #include <oasys/util/SparseBitmap.h>
 #include <oasys/util/StreamBuffer.h>
+#include <oasys/util/Time.h>
 
 #include "ConnectionConvergenceLayer.h"
 #include "bundling/Bundle.h"
@@ -40,6 +42,7 @@ class CLConnection : public CLInfo,
                      public oasys::Logger {
 public:
     friend class ConnectionConvergenceLayer;
+    friend class CLReactor;
     typedef ConnectionConvergenceLayer::LinkParams LinkParams;
     
     /**
@@ -61,12 +64,47 @@ public:
      */
     void set_contact(const ContactRef& contact) { contact_ = contact; }
 
+    /**
+     * Start servicing the connection, either in its own thread or,
+     * if it is enabled, in the shared CLReactor.
+     */
+    void start_service();
+
+    /**
+     * Whether the connection is no longer being serviced (i.e. the
+     * thread has exited or the reactor is done with it).
+     */
+    bool service_stopped();
+
 protected:
     /**
      * Main run loop.
      */
     void run();
 
+    /// @{
+    /// The pieces of the main run loop, shared with the CLReactor
+
+    /**
+     * Set up the pollfds and then connect or accept. Returns false if
+     * the contact was broken along the way.
+     */
+    bool open_io();
+
+    /**
+     * Process any queued commands and send any pending data, then
+     * compute the timeout for the next poll. Returns false if the
+     * contact was broken.
+     */
+    bool prepare_poll(int* timeout);
+
+    /**
+     * Handle the return from poll_multiple. Returns false if the
+     * contact was broken.
+     */
+    bool handle_poll_result(int cc);
+    /// @}
+
     /// @{
     /// Utility functions, all virtual so subclasses could override them
     virtual void contact_up();
@@ -198,8 +236,16 @@ protected:
             : bundle_(b, "CLConnection::InFlightBundle"),
               total_length_(0),
               send_complete_(false),
-              transmit_event_posted_(false)
+              transmit_event_posted_(false),
+              payload_fd_(-1)
         {}
+
+        ~InFlightBundle()
+        {
+            if (payload_fd_ != -1) {
+                ::close(payload_fd_);
+            }
+        }
         
         BundleRef bundle_;
         BlockInfoVec* blocks_;
@@ -207,6 +253,7 @@ protected:
         u_int32_t total_length_;
         bool      send_complete_;
         bool      transmit_event_posted_;
+        int       payload_fd_;	///< Payload file for zero-copy sends
         
         DataBitmap sent_data_;
         DataBitmap ack_data_;
@@ -271,6 +318,9 @@ protected:
     InFlightList	inflight_;	///< Bundles going out the wire
     IncomingList	incoming_;	///< Bundles arriving on the wire
     volatile bool	contact_broken_; ///< Contact has been broken
+    oasys::Time         next_write_;	///< Next write for test_write_delay
+    bool                in_reactor_;	///< Serviced by the CLReactor
+    volatile bool       reactor_stopped_; ///< Reactor is done with us
     oasys::atomic_t     num_pending_;	///< Bundles pending transmission
 };
 
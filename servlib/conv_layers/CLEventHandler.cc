@@ -23,6 +23,8 @@
 #include <oasys/serialize/XMLSerialize.h>
 
 #include "CLEventHandler.h"
+#include "ECLFraming.h"
+#include "clevent-tlv.h"
 
 
 namespace dtn {
@@ -87,6 +89,33 @@ CLEventHandler::process_cl_event(const char* msg_buffer,
     dispatch_cl_event( message.get() );
 }
 
+bool
+CLEventHandler::process_cl_frame(const std::string& payload)
+{
+    RouterTLV::Decoder dec( (const u_char*)payload.data(), payload.size(),
+                            &ECLFraming::clevent_names() );
+    if ( !dec.begin_payload() ) {
+        log_debug_p("/dtn/cl/parse", "Invalid binary frame");
+        return false;
+    }
+
+    // A frame can hold any number of messages. The rest of a frame
+    // can't be trusted after a bad message, and skipping it would
+    // leave the descriptors attached for its bundles to be matched to
+    // later messages, so the caller drops the connection instead.
+    while ( !dec.done() ) {
+        std::auto_ptr<cl_message> message = cl_message_tlv(&dec);
+        if ( !message.get() ) {
+            log_debug_p("/dtn/cl/parse", "Invalid binary message");
+            return false;
+        }
+
+        dispatch_cl_event( message.get() );
+    }
+
+    return true;
+}
+
 /*void
 CLEventHandler::clear_parser(oasys::XMLUnmarshal& parser)
 {
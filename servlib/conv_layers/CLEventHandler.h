@@ -39,6 +39,9 @@ protected:
     virtual ~CLEventHandler() { }
     void process_cl_event(const char* msg_buffer,
                           oasys::XercesXMLUnmarshal& parser);
+    /// Returns false if the frame holds a malformed message, after
+    /// which the connection can't be used
+    bool process_cl_frame(const std::string& payload);
     void dispatch_cl_event(cl_message* message);
     //void clear_parser(oasys::XMLUnmarshal& parser);
     
@@ -0,0 +1,477 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+
+#ifdef __linux__
+#include <sys/epoll.h>
+#endif
+
+#include <oasys/io/IO.h>
+#include <oasys/thread/SpinLock.h>
+
+#include "CLReactor.h"
+#include "CLConnection.h"
+
+template <>
+dtn::CLReactor* oasys::Singleton<dtn::CLReactor>::instance_ = 0;
+
+namespace dtn {
+
+u_int CLReactor::threads_ = 0;
+u_int CLReactor::started_threads_ = 0;
+
+//----------------------------------------------------------------------
+struct CLReactor::Entry {
+    Entry(CLConnection* conn)
+        : conn_(conn), has_deadline_(false), ready_(false)
+    {
+        for (int i = 0; i < CLConnection::MAXPOLL; ++i) {
+            fds_[i]    = -1;
+            events_[i] = 0;
+        }
+    }
+
+    CLConnection*         conn_;
+    int                   fds_[CLConnection::MAXPOLL];    ///< registered fds
+    u_int32_t             events_[CLConnection::MAXPOLL]; ///< and events
+    DeadlineMap::iterator deadline_;
+    bool                  has_deadline_;
+    bool                  ready_;         ///< in the ready list
+};
+
+#ifdef __linux__
+
+//----------------------------------------------------------------------
+static u_int64_t
+now_ms()
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (u_int64_t)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+}
+
+//----------------------------------------------------------------------
+static u_int32_t
+poll_to_epoll(short events)
+{
+    u_int32_t ret = 0;
+    if (events & POLLIN)  ret |= EPOLLIN;
+    if (events & POLLPRI) ret |= EPOLLPRI;
+    if (events & POLLOUT) ret |= EPOLLOUT;
+    return ret;
+}
+
+#endif /* __linux__ */
+
+//----------------------------------------------------------------------
+bool
+CLReactor::enabled()
+{
+#ifdef __linux__
+    // connections are already spread over the running workers, so
+    // the number of threads can't change underneath them
+    if (started_threads_ != 0 && threads_ != started_threads_) {
+        log_err_p("/dtn/cl/reactor",
+                  "cl_reactor_threads can't be changed once the reactor "
+                  "is running, keeping %u threads", started_threads_);
+        threads_ = started_threads_;
+    }
+    return threads_ != 0;
+#else
+    return false;
+#endif
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::shutdown()
+{
+    if (instance_ != NULL) {
+        instance_->stop_workers();
+    }
+}
+
+//----------------------------------------------------------------------
+CLReactor::CLReactor()
+    : Logger("CLReactor", "/dtn/cl/reactor"),
+      stopped_(false),
+      next_(0)
+{
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::start_workers()
+{
+    log_info("starting %u reactor threads", threads_);
+    for (u_int i = 0; i < threads_; ++i) {
+        Worker* w = new Worker(i);
+        workers_.push_back(w);
+        w->start();
+    }
+    started_threads_ = threads_;
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::stop_workers()
+{
+    std::vector<Worker*> workers;
+    {
+        oasys::ScopeLock l(&lock_, "CLReactor::stop_workers");
+        stopped_ = true;
+        workers.swap(workers_);
+    }
+
+    log_info("stopping %zu reactor threads", workers.size());
+    for (size_t i = 0; i < workers.size(); ++i) {
+        Worker* w = workers[i];
+        w->set_should_stop();
+        w->add(NULL);
+        w->join();
+        delete w;
+    }
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::add(CLConnection* conn)
+{
+    oasys::ScopeLock l(&lock_, "CLReactor::add");
+
+    if (stopped_) {
+        log_warn("reactor is shut down, not servicing connection %p", conn);
+        conn->reactor_stopped_ = true;
+        return;
+    }
+
+    if (workers_.empty()) {
+        start_workers();
+    }
+
+    Worker* w = workers_[atomic_incr_ret(&next_) % workers_.size()];
+    log_debug("adding connection %p to worker with %u connections",
+              conn, w->size());
+    w->add(conn);
+}
+
+//----------------------------------------------------------------------
+CLReactor::Worker::Worker(int id)
+    : Thread("CLReactor::Worker", CREATE_JOINABLE),
+      Logger("CLReactor::Worker", "/dtn/cl/reactor/%d", id),
+      epfd_(-1),
+      newq_(logpath_),
+      count_(0)
+{
+#ifdef __linux__
+    epfd_ = epoll_create(1024);
+    if (epfd_ < 0) {
+        log_crit("error in epoll_create: %s", strerror(errno));
+        return;
+    }
+
+    // the new connection queue is registered with a NULL entry
+    struct epoll_event ev;
+    memset(&ev, 0, sizeof(ev));
+    ev.events   = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (epoll_ctl(epfd_, EPOLL_CTL_ADD, newq_.read_fd(), &ev) != 0) {
+        log_crit("error adding queue to epoll set: %s", strerror(errno));
+    }
+#endif
+}
+
+//----------------------------------------------------------------------
+CLReactor::Worker::~Worker()
+{
+    ASSERT(entries_.empty());
+    if (epfd_ >= 0) {
+        close(epfd_);
+    }
+}
+
+#ifdef __linux__
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::run()
+{
+    static const int MAX_EVENTS = 256;
+    struct epoll_event events[MAX_EVENTS];
+
+    while (! should_stop()) {
+        // sleep until the earliest deadline, unless some connections
+        // are already waiting to run
+        int timeout = -1;
+        if (! ready_.empty()) {
+            timeout = 0;
+        } else if (! deadlines_.empty()) {
+            u_int64_t now   = now_ms();
+            u_int64_t first = deadlines_.begin()->first;
+            timeout = (first <= now) ? 0 :
+                      (int)std::min(first - now, (u_int64_t)INT_MAX);
+        }
+
+        int cc = epoll_wait(epfd_, events, MAX_EVENTS, timeout);
+        if (cc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_crit("error in epoll_wait: %s", strerror(errno));
+            break;
+        }
+
+        for (int i = 0; i < cc; ++i) {
+            Entry* entry = (Entry*)events[i].data.ptr;
+            if (entry != NULL) {
+                mark_ready(entry);
+                continue;
+            }
+
+            // a NULL connection is just a wakeup to check should_stop
+            CLConnection* conn;
+            while (newq_.try_pop(&conn)) {
+                if (conn != NULL) {
+                    start_conn(conn);
+                }
+            }
+        }
+
+        if (should_stop()) {
+            break;
+        }
+
+        u_int64_t now = now_ms();
+        while (! deadlines_.empty() && deadlines_.begin()->first <= now) {
+            Entry* entry = deadlines_.begin()->second;
+            deadlines_.erase(deadlines_.begin());
+            entry->has_deadline_ = false;
+            mark_ready(entry);
+        }
+
+        // connections that need to run again right away are added to
+        // ready_ as we go, and picked up on the next time around
+        std::vector<Entry*> ready;
+        ready.swap(ready_);
+        for (size_t i = 0; i < ready.size(); ++i) {
+            ready[i]->ready_ = false;
+            service(ready[i]);
+        }
+    }
+
+    finish_all();
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::start_conn(CLConnection* conn)
+{
+    log_debug("starting connection %p", conn);
+
+    Entry* entry = new Entry(conn);
+    entries_.insert(entry);
+    atomic_incr(&count_);
+
+    if (! conn->open_io() || ! schedule(entry)) {
+        finish(entry);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::service(Entry* entry)
+{
+    CLConnection* conn = entry->conn_;
+
+    // a zero-timeout poll of the connection's own pollfds gives it
+    // the same revents (or timeout) it would see in its own thread
+    for (int i = 0; i < conn->num_pollfds_ + 1; ++i) {
+        conn->pollfds_[i].revents = 0;
+    }
+    int cc = oasys::IO::poll_multiple(conn->pollfds_, conn->num_pollfds_ + 1,
+                                      0, NULL, conn->logpath_);
+
+    if (! conn->handle_poll_result(cc) || ! schedule(entry)) {
+        finish(entry);
+    }
+}
+
+//----------------------------------------------------------------------
+bool
+CLReactor::Worker::schedule(Entry* entry)
+{
+    CLConnection* conn = entry->conn_;
+
+    int timeout;
+    if (! conn->prepare_poll(&timeout)) {
+        return false;
+    }
+
+    // the connection can change its pollfds between iterations, so
+    // bring the epoll registrations up to date
+    for (int i = 0; i < CLConnection::MAXPOLL; ++i) {
+        int       fd     = -1;
+        u_int32_t events = 0;
+        if (i <= conn->num_pollfds_) {
+            fd     = conn->pollfds_[i].fd;
+            events = poll_to_epoll(conn->pollfds_[i].events);
+        }
+
+        if (fd == entry->fds_[i] && events == entry->events_[i]) {
+            continue;
+        }
+
+        if (entry->fds_[i] >= 0 && fd != entry->fds_[i]) {
+            epoll_ctl(epfd_, EPOLL_CTL_DEL, entry->fds_[i], NULL);
+            entry->fds_[i]    = -1;
+            entry->events_[i] = 0;
+        }
+
+        if (fd < 0) {
+            continue;
+        }
+
+        struct epoll_event ev;
+        memset(&ev, 0, sizeof(ev));
+        ev.events   = events;
+        ev.data.ptr = entry;
+        int op = (entry->fds_[i] == fd) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+        if (epoll_ctl(epfd_, op, fd, &ev) != 0) {
+            log_err("error registering fd %d for %p: %s",
+                    fd, conn, strerror(errno));
+            conn->break_contact(ContactEvent::BROKEN);
+            return false;
+        }
+        entry->fds_[i]    = fd;
+        entry->events_[i] = events;
+    }
+
+    set_deadline(entry, timeout);
+    return true;
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::set_deadline(Entry* entry, int timeout)
+{
+    if (entry->has_deadline_) {
+        deadlines_.erase(entry->deadline_);
+        entry->has_deadline_ = false;
+    }
+
+    if (timeout == 0) {
+        mark_ready(entry);
+    } else if (timeout > 0) {
+        entry->deadline_ = deadlines_.insert(
+            DeadlineMap::value_type(now_ms() + timeout, entry));
+        entry->has_deadline_ = true;
+    }
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::mark_ready(Entry* entry)
+{
+    if (! entry->ready_) {
+        entry->ready_ = true;
+        ready_.push_back(entry);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::finish(Entry* entry)
+{
+    CLConnection* conn = entry->conn_;
+    log_debug("done with connection %p", conn);
+
+    ASSERT(! entry->ready_);
+    for (int i = 0; i < CLConnection::MAXPOLL; ++i) {
+        if (entry->fds_[i] >= 0) {
+            // the fd may already be closed, which removes it from the
+            // epoll set on its own
+            epoll_ctl(epfd_, EPOLL_CTL_DEL, entry->fds_[i], NULL);
+        }
+    }
+
+    if (entry->has_deadline_) {
+        deadlines_.erase(entry->deadline_);
+    }
+
+    entries_.erase(entry);
+    delete entry;
+    atomic_decr(&count_);
+
+    // once this is set the connection may be deleted at any time
+    conn->reactor_stopped_ = true;
+}
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::finish_all()
+{
+    log_debug("stopping with %zu connections", entries_.size());
+
+    for (size_t i = 0; i < ready_.size(); ++i) {
+        ready_[i]->ready_ = false;
+    }
+    ready_.clear();
+
+    while (! entries_.empty()) {
+        finish(*entries_.begin());
+    }
+
+    // connections that were queued but never started
+    CLConnection* conn;
+    while (newq_.try_pop(&conn)) {
+        if (conn != NULL) {
+            conn->reactor_stopped_ = true;
+        }
+    }
+}
+
+#else /* __linux__ */
+
+//----------------------------------------------------------------------
+void
+CLReactor::Worker::run()
+{
+    // enabled() is false, so the workers are never started
+    NOTREACHED;
+}
+
+//----------------------------------------------------------------------
+void CLReactor::Worker::start_conn(CLConnection*)     { NOTREACHED; }
+void CLReactor::Worker::service(Entry*)               { NOTREACHED; }
+bool CLReactor::Worker::schedule(Entry*)              { NOTREACHED; }
+void CLReactor::Worker::set_deadline(Entry*, int)     { NOTREACHED; }
+void CLReactor::Worker::mark_ready(Entry*)            { NOTREACHED; }
+void CLReactor::Worker::finish(Entry*)                { NOTREACHED; }
+void CLReactor::Worker::finish_all()                  { NOTREACHED; }
+
+#endif /* __linux__ */
+
+} // namespace dtn
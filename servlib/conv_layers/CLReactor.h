@@ -0,0 +1,161 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _CL_REACTOR_H_
+#define _CL_REACTOR_H_
+
+#include <map>
+#include <set>
+#include <vector>
+#include <oasys/compat/inttypes.h>
+#include <oasys/debug/Log.h>
+#include <oasys/thread/Atomic.h>
+#include <oasys/thread/MsgQueue.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/thread/Thread.h>
+#include <oasys/util/Singleton.h>
+
+namespace dtn {
+
+class CLConnection;
+
+/**
+ * A small, fixed pool of threads that services many CLConnections,
+ * as an alternative to running a thread per connection.
+ *
+ * Each connection is assigned to one worker thread for its lifetime,
+ * so all of its callbacks still run on a single thread. A worker
+ * waits in epoll for activity on the file descriptors of all of its
+ * connections (including their command queues), and keeps the poll
+ * timeout of each connection as a deadline. When a connection's fds
+ * become ready or its deadline passes, the worker runs one iteration
+ * of the same loop as CLConnection::run(), with a non-blocking poll()
+ * standing in for the blocking one, so per-connection behavior
+ * (including keepalives and idle timeouts, which are driven by the
+ * poll timeout) is unchanged.
+ *
+ * The reactor is only used if threads_ is set (with "param set
+ * cl_reactor_threads") before the first connection starts, and is
+ * only available where epoll is (i.e. on Linux). Once the workers
+ * are running the number of threads can't be changed.
+ */
+class CLReactor : public oasys::Singleton<CLReactor>,
+                  public oasys::Logger {
+public:
+    /// Number of worker threads, zero (the default) for a thread per
+    /// connection
+    static u_int threads_;
+
+    /**
+     * Whether connections should be handed to the reactor. If
+     * threads_ was changed after the workers started, the change is
+     * logged and undone.
+     */
+    static bool enabled();
+
+    /**
+     * Stop and join the worker threads, if they were started. Any
+     * connections they were servicing are marked as stopped.
+     */
+    static void shutdown();
+
+    /**
+     * Hand a connection to one of the worker threads, which calls
+     * connect() or accept() on it and then services it until the
+     * contact is broken, at which point the connection is marked as
+     * stopped (but not deleted).
+     */
+    void add(CLConnection* conn);
+
+private:
+    friend class oasys::Singleton<CLReactor>;
+
+    /**
+     * Per-connection state kept by a worker.
+     */
+    struct Entry;
+
+    /// Connection deadlines, in monotonic milliseconds
+    typedef std::multimap<u_int64_t, Entry*> DeadlineMap;
+
+    /**
+     * A worker thread with its own epoll instance.
+     */
+    class Worker : public oasys::Thread, public oasys::Logger {
+    public:
+        Worker(int id);
+        virtual ~Worker();
+
+        /// Queue a new connection (or NULL to wake the thread)
+        void add(CLConnection* conn) { newq_.push_back(conn); }
+
+        /// Number of connections being serviced
+        u_int32_t size() const { return count_.value; }
+
+    protected:
+        void run();
+
+        /// Start servicing a new connection
+        void start_conn(CLConnection* conn);
+
+        /// Run one iteration of a connection's loop
+        void service(Entry* entry);
+
+        /// Prepare for the next iteration, updating the epoll
+        /// registrations and the deadline. Returns false once the
+        /// connection is done.
+        bool schedule(Entry* entry);
+
+        /// Set the deadline for the connection's next iteration
+        void set_deadline(Entry* entry, int timeout);
+
+        /// Queue the connection to be serviced in this iteration
+        void mark_ready(Entry* entry);
+
+        /// Stop servicing the connection
+        void finish(Entry* entry);
+
+        /// Stop servicing all connections, when the thread exits
+        void finish_all();
+
+        int                         epfd_;
+        oasys::MsgQueue<CLConnection*> newq_;
+        std::set<Entry*>            entries_;
+        DeadlineMap                 deadlines_;
+        std::vector<Entry*>         ready_;
+        oasys::atomic_t             count_;
+    };
+
+    CLReactor();
+
+    /// Create and start the worker threads
+    void start_workers();
+
+    /// Stop and join the worker threads
+    void stop_workers();
+
+    /// Number of threads the workers were started with
+    static u_int started_threads_;
+
+    oasys::SpinLock      lock_;
+    std::vector<Worker*> workers_;
+    bool                 stopped_;  ///< workers were shut down
+    oasys::atomic_t      next_;     ///< round robin assignment
+};
+
+} // namespace dtn
+
+#endif /* _CL_REACTOR_H_ */
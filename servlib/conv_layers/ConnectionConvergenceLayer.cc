@@ -270,7 +270,7 @@ ConnectionConvergenceLayer::open_contact(const ContactRef& contact)
     CLConnection* conn = new_connection(link, params);
     conn->set_contact(contact);
     contact->set_cl_info(conn);
-    conn->start();
+    conn->start_service();
 
     return true;
 }
@@ -294,7 +294,7 @@ ConnectionConvergenceLayer::close_contact(const ContactRef& contact)
             CLConnection::CLMsg(CLConnection::CLMSG_BREAK_CONTACT));
     }
     
-    while (!conn->is_stopped()) {
+    while (!conn->service_stopped()) {
         log_debug("waiting for connection thread to stop...");
         usleep(100000);
         oasys::Thread::yield();
@@ -29,6 +29,7 @@
 #include "NORMConvergenceLayer.h"
 #include "LTPConvergenceLayer.h"
 #include "AX25CMConvergenceLayer.h"
+#include "CLReactor.h"
 
 #include "bundling/BundleDaemon.h"
 
@@ -112,6 +113,8 @@ ConvergenceLayer::shutdown_clayers()
     {
         (*iter)->shutdown();
     }
+
+    CLReactor::shutdown();
 }
 
 //----------------------------------------------------------------------
@@ -0,0 +1,285 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <netinet/in.h>
+
+#ifdef __linux__
+#include <sys/syscall.h>
+#endif
+
+#include "ECLFraming.h"
+
+namespace dtn {
+
+/**
+ * The element and attribute names from clevent.xsd, in the order they
+ * first appear in the schema. The index of a name (plus one) is its
+ * code on the wire, so new names must only be added at the end.
+ */
+static const char* names_[] = {
+    "attribute_name", "value", "key_value_pair", "name",
+    "bundle_attributes", "source_eid", "timestamp_seconds",
+    "timestamp_sequence", "is_fragment", "fragment_length",
+    "fragment_offset", "link_attributes", "type", "state", "peer_eid",
+    "is_reachable", "is_usable", "how_reliable", "how_available",
+    "reactive_fragment", "nexthop", "cla_name", "high_water_mark",
+    "low_water_mark", "link_config_parameters", "contact_attributes",
+    "start_time", "duration", "bps", "latency", "packet_loss_prob",
+    "cla_add_request", "cla_delete_request", "cla_set_params_request",
+    "local_eid", "create_discovered_links", "bundle_pass_method",
+    "reactive_fragment_enabled", "cla_params_set_event",
+    "interface_set_defaults_request", "interface_create_request",
+    "interface_name", "interface_created_event",
+    "interface_reconfigure_request", "up", "discovery",
+    "interface_reconfigured_event", "interface_destroy_request",
+    "eid_reachable_event", "link_set_defaults_request",
+    "link_create_request", "link_name", "link_created_event", "reason",
+    "link_open_request", "link_opened_event", "link_close_request",
+    "link_closed_event", "link_state_changed_event", "new_state",
+    "link_reconfigure_request", "link_delete_request", "link_deleted_event",
+    "link_attribute_changed_event", "contact_attribute_changed_event",
+    "link_add_reachable_event", "bundle_send_request", "location",
+    "bundle_receive_started_event", "bundle_received_event",
+    "bytes_received", "bundle_transmitted_event", "bytes_sent",
+    "reliably_sent", "bundle_cancel_request", "bundle_canceled_event",
+    "query_bundle_queued", "query_id", "report_bundle_queued", "is_queued",
+    "query_eid_reachable", "report_eid_reachable", "query_link_attributes",
+    "report_link_attributes", "query_interface_attributes",
+    "report_interface_attributes", "query_cla_parameters",
+    "report_cla_parameters", "cl_message",
+};
+
+//----------------------------------------------------------------------
+const RouterTLV::Dictionary&
+ECLFraming::clevent_names()
+{
+    static RouterTLV::Dictionary dict(names_,
+                                      sizeof(names_) / sizeof(names_[0]));
+    return dict;
+}
+
+//----------------------------------------------------------------------
+int
+ECLFraming::send_frame(int sock, const std::string& payload,
+                       const int* fds, int num_fds)
+{
+    if (payload.size() > MAX_FRAME || num_fds > MAX_FDS) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    u_int32_t len = htonl(payload.size());
+
+    struct iovec iov[2];
+    iov[0].iov_base = &len;
+    iov[0].iov_len  = sizeof(len);
+    iov[1].iov_base = const_cast<char*>(payload.data());
+    iov[1].iov_len  = payload.size();
+
+    union {
+        char           buf[CMSG_SPACE(MAX_FDS * sizeof(int))];
+        struct cmsghdr align;
+    } cbuf;
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov    = iov;
+    msg.msg_iovlen = 2;
+
+    // the descriptors go along with the first chunk that is written
+    if (num_fds > 0) {
+        memset(&cbuf, 0, sizeof(cbuf));
+        msg.msg_control    = cbuf.buf;
+        msg.msg_controllen = CMSG_SPACE(num_fds * sizeof(int));
+
+        struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg);
+        cmsg->cmsg_level = SOL_SOCKET;
+        cmsg->cmsg_type  = SCM_RIGHTS;
+        cmsg->cmsg_len   = CMSG_LEN(num_fds * sizeof(int));
+        memcpy(CMSG_DATA(cmsg), fds, num_fds * sizeof(int));
+    }
+
+    while (msg.msg_iovlen > 0) {
+        ssize_t cc = ::sendmsg(sock, &msg, MSG_NOSIGNAL);
+        if (cc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return -1;
+        }
+
+        msg.msg_control    = NULL;
+        msg.msg_controllen = 0;
+
+        // skip past whatever was written
+        while (msg.msg_iovlen > 0 && (size_t)cc >= msg.msg_iov[0].iov_len) {
+            cc -= msg.msg_iov[0].iov_len;
+            msg.msg_iov++;
+            msg.msg_iovlen--;
+        }
+        if (msg.msg_iovlen > 0) {
+            msg.msg_iov[0].iov_base = (char*)msg.msg_iov[0].iov_base + cc;
+            msg.msg_iov[0].iov_len -= cc;
+        }
+    }
+
+    return 0;
+}
+
+//----------------------------------------------------------------------
+int
+ECLFraming::create_payload_fd(const char* dir, size_t len)
+{
+    int fd = -1;
+
+#if defined(__linux__) && defined(SYS_memfd_create)
+    fd = syscall(SYS_memfd_create, "ecl-bundle", 0);
+#endif
+
+    if (fd < 0) {
+        std::string path = std::string(dir) + "/.bundleXXXXXX";
+        fd = mkstemp(&path[0]);
+        if (fd < 0) {
+            return -1;
+        }
+        ::unlink(path.c_str());
+    }
+
+    if (::ftruncate(fd, len) != 0) {
+        int err = errno;
+        ::close(fd);
+        errno = err;
+        return -1;
+    }
+
+    return fd;
+}
+
+//----------------------------------------------------------------------
+ECLFraming::Reader::~Reader()
+{
+    while (! fds_.empty()) {
+        ::close(fds_.front());
+        fds_.pop_front();
+    }
+}
+
+//----------------------------------------------------------------------
+int
+ECLFraming::Reader::read(int sock)
+{
+    char buf[64 * 1024];
+    union {
+        char           buf[CMSG_SPACE(MAX_FDS * sizeof(int))];
+        struct cmsghdr align;
+    } cbuf;
+
+    struct iovec iov;
+    iov.iov_base = buf;
+    iov.iov_len  = sizeof(buf);
+
+    struct msghdr msg;
+    memset(&msg, 0, sizeof(msg));
+    msg.msg_iov        = &iov;
+    msg.msg_iovlen     = 1;
+    msg.msg_control    = cbuf.buf;
+    msg.msg_controllen = sizeof(cbuf.buf);
+
+    int flags = 0;
+#ifdef MSG_CMSG_CLOEXEC
+    flags |= MSG_CMSG_CLOEXEC;
+#endif
+
+    ssize_t cc;
+    do {
+        cc = ::recvmsg(sock, &msg, flags);
+    } while (cc < 0 && errno == EINTR);
+
+    if (cc < 0) {
+        return -1;
+    }
+
+    for (struct cmsghdr* cmsg = CMSG_FIRSTHDR(&msg); cmsg != NULL;
+         cmsg = CMSG_NXTHDR(&msg, cmsg))
+    {
+        if (cmsg->cmsg_level != SOL_SOCKET || cmsg->cmsg_type != SCM_RIGHTS) {
+            continue;
+        }
+        int n = (cmsg->cmsg_len - CMSG_LEN(0)) / sizeof(int);
+        const int* fdp = (const int*)CMSG_DATA(cmsg);
+        for (int i = 0; i < n; ++i) {
+            fds_.push_back(fdp[i]);
+        }
+    }
+
+    // descriptors that didn't fit were closed by the kernel, so the
+    // rest can't be matched up with their messages any more
+    if (msg.msg_flags & MSG_CTRUNC) {
+        errno = EMSGSIZE;
+        return -1;
+    }
+
+    buf_.append(buf, cc);
+    return cc;
+}
+
+//----------------------------------------------------------------------
+int
+ECLFraming::Reader::next_frame(std::string* payload)
+{
+    if (buf_.size() < sizeof(u_int32_t)) {
+        return 0;
+    }
+
+    u_int32_t len;
+    memcpy(&len, buf_.data(), sizeof(len));
+    len = ntohl(len);
+    if (len > MAX_FRAME) {
+        return -1;
+    }
+
+    if (buf_.size() < sizeof(len) + len) {
+        return 0;
+    }
+
+    payload->assign(buf_, sizeof(len), len);
+    buf_.erase(0, sizeof(len) + len);
+    return 1;
+}
+
+//----------------------------------------------------------------------
+int
+ECLFraming::Reader::next_fd()
+{
+    if (fds_.empty()) {
+        return -1;
+    }
+    int fd = fds_.front();
+    fds_.pop_front();
+    return fd;
+}
+
+} // namespace dtn
@@ -0,0 +1,116 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _ECL_FRAMING_H_
+#define _ECL_FRAMING_H_
+
+#include <deque>
+#include <string>
+#include <oasys/compat/inttypes.h>
+
+#include "routing/RouterTLV.h"
+
+namespace dtn {
+
+/**
+ * Binary framing for the external convergence layer interface, as an
+ * alternative to the stream of XML documents.
+ *
+ * A frame is a four byte length in network byte order followed by a
+ * RouterTLV payload holding one or more clevent.xsd messages, encoded
+ * with the clevent dictionary below. Since frames are limited to
+ * MAX_FRAME bytes, the first byte of a frame is always zero, which
+ * can never start an XML document, so a CLA selects the binary
+ * framing just by sending its first message (cla_add_request) in a
+ * frame. Existing CLAs keep using XML.
+ *
+ * On a Unix domain connection, bundles are handed over as file
+ * descriptors attached to frames (SCM_RIGHTS) rather than through
+ * files in the shared bundle directories. Descriptors are matched to
+ * messages in order: each bundle_send_request from the daemon and
+ * each bundle_received_event with a non-zero bytes_received from the
+ * CLA has one, attached to the frame that carries the message (or to
+ * an earlier frame).
+ */
+class ECLFraming {
+public:
+    /// Largest frame accepted
+    static const u_int32_t MAX_FRAME = 1024 * 1024;
+
+    /// Most descriptors attached to one frame
+    static const int MAX_FDS = 16;
+
+    /**
+     * The dictionary of clevent.xsd names.
+     */
+    static const RouterTLV::Dictionary& clevent_names();
+
+    /**
+     * Send a frame holding the given payload, with the given
+     * descriptors attached, blocking until it is all written.
+     *
+     * @return 0 on success, -1 on error (with errno set)
+     */
+    static int send_frame(int sock, const std::string& payload,
+                          const int* fds = NULL, int num_fds = 0);
+
+    /**
+     * Create an anonymous file of the given length to hand a bundle
+     * to a CLA. Shared memory is used where it is available, otherwise
+     * an unlinked file in the given directory.
+     *
+     * @return the descriptor, or -1 on error (with errno set)
+     */
+    static int create_payload_fd(const char* dir, size_t len);
+
+    /**
+     * Collects frames and attached descriptors read from a socket.
+     */
+    class Reader {
+    public:
+        Reader() {}
+
+        /// Closes any descriptors that were never claimed
+        ~Reader();
+
+        /**
+         * Read whatever is available on the socket.
+         *
+         * @return the number of bytes read, zero at the end of the
+         * stream, or -1 on error
+         */
+        int read(int sock);
+
+        /**
+         * Take the payload of the next complete frame.
+         *
+         * @return 1 if there was a frame, 0 if none is complete yet, or
+         * -1 if the next frame is larger than MAX_FRAME
+         */
+        int next_frame(std::string* payload);
+
+        /// Take the next received descriptor, or -1 if there is none
+        int next_fd();
+
+    protected:
+        std::string     buf_;
+        std::deque<int> fds_;
+    };
+};
+
+} // namespace dtn
+
+#endif /* _ECL_FRAMING_H_ */
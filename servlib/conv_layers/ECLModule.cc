@@ -34,6 +34,7 @@
 #include <xercesc/framework/MemBufFormatTarget.hpp>
 
 #include "ECLModule.h"
+#include "clevent-tlv.h"
 #include "bundling/BundleDaemon.h"
 #include "storage/BundleStore.h"
 #include "storage/GlobalStore.h"
@@ -44,18 +45,24 @@ namespace dtn {
 
 const size_t ECLModule::READ_BUFFER_SIZE;
 const size_t ECLModule::MAX_BUNDLE_IN_MEMORY;
+const int ECLModule::MAX_BATCH_MESSAGES;
+const size_t ECLModule::MAX_BATCH_BYTES;
 
 ECLModule::ECLModule(int fd,
                      in_addr_t remote_addr,
                      u_int16_t remote_port,
-                     ExternalConvergenceLayer& cl) :
+                     ExternalConvergenceLayer& cl,
+                     bool local) :
     CLEventHandler("ECLModule", "/dtn/cl/module"),
     Thread("/dtn/cl/module", Thread::CREATE_JOINABLE),
     cl_(cl),
     iface_list_lock_("/dtn/cl/parts/iface_list_lock"),
     socket_(fd, remote_addr, remote_port, logpath_),
     message_queue_("/dtn/cl/parts/module"),
-    parser_( true, cl.schema_.c_str() )
+    parser_( true, cl.schema_.c_str() ),
+    local_(local),
+    framing_(FRAMING_UNKNOWN),
+    pass_fds_(false)
 {
     name_ = "(unknown)";
     was_shutdown_ = false;
@@ -98,25 +105,9 @@ ECLModule::run()
         }
 
         if (message_poll->revents & POLLIN) {
-            cl_message* message;
-            if ( message_queue_.try_pop(&message) ) {
-                ASSERT(message != NULL);
-                int result;
-                
-                // We need to handle bundle-send messages as a special case,
-                // in order to get the bundle written to disk first.
-                if ( message->bundle_send_request().present() )
-                    result = prepare_bundle_to_send(message);
-                
-                else
-                    result = send_message(message);
-                
-                delete message;
-
-                if (result < 0) {
-                    set_should_stop();
-                    continue;
-                } // if
+            if (send_messages() < 0) {
+                set_should_stop();
+                continue;
             } // if
         } // if
 
@@ -246,6 +237,10 @@ ECLModule::handle(const cla_add_request& message)
     KeyValueSequence params;
     params.push_back( key_value_pair("incoming_bundle_dir", in_dir.c_str() ) );
     params.push_back( key_value_pair("outgoing_bundle_dir", out_dir.c_str() ) );
+    
+    // Tell the module that bundles will be passed as file descriptors.
+    if (pass_fds_)
+        params.push_back( key_value_pair("bundle_pass_fd", "true") );
     request.key_value_pair(params);
     
     POST_MESSAGE(this, cla_set_params_request, request);
@@ -785,6 +780,11 @@ ECLModule::handle(const bundle_canceled_event& message)
 void
 ECLModule::handle(const bundle_receive_started_event& message)
 {
+    // Partial bundles are only recovered from files in bundle_in_path_,
+    // which are not used when bundles are passed as descriptors.
+    if (pass_fds_)
+        return;
+    
     IncomingBundleRecord record;
     record.location = message.location();    
     if ( message.peer_eid().present() )
@@ -815,7 +815,21 @@ ECLModule::handle(const bundle_received_event& message)
         if ( message.peer_eid().present() )
             peer_eid = message.peer_eid().get();
         
-        read_bundle_file(message.location(), peer_eid);
+        // With descriptor passing, the bundle came along with the message.
+        if (pass_fds_) {
+            int bundle_fd = reader_.next_fd();
+            if (bundle_fd < 0) {
+                log_err( "No descriptor for received bundle %s",
+                         message.location().c_str() );
+            }
+            else {
+                read_bundle(bundle_fd, message.location(), peer_eid);
+            }
+        }
+        
+        else {
+            read_bundle_file(message.location(), peer_eid);
+        }
     }
     
     // Remove the bundle from the incoming bundle list (if we got a
@@ -891,27 +905,40 @@ void
 ECLModule::read_bundle_file(const std::string& location,
                             const std::string& peer_eid)
 {
-    int bundle_fd;
-    bool finished = false;
-    off_t file_offset = 0;
-    struct stat file_stat;
-    
     std::string file_path = bundle_in_path_ + "/" + location;
     
     // Open up the file.
-    bundle_fd = oasys::IO::open(file_path.c_str(), O_RDONLY);
+    int bundle_fd = oasys::IO::open(file_path.c_str(), O_RDONLY);
     if (bundle_fd < 0) {
         log_err( "Unable to read bundle file %s: %s", file_path.c_str(),
                  strerror(errno) );
         return;
     }
     
+    if ( !read_bundle(bundle_fd, file_path, peer_eid) )
+        return;
+    
+    // Delete the bundle file now that it has been read.
+    if (::remove( file_path.c_str() ) < 0) {
+        log_err( "Unable to remove bundle file %s: %s", file_path.c_str(),
+                 strerror(errno) );
+    }
+}
+
+bool
+ECLModule::read_bundle(int bundle_fd, const std::string& name,
+                       const std::string& peer_eid)
+{
+    bool finished = false;
+    off_t file_offset = 0;
+    struct stat file_stat;
+    
     // Stat the file so we know how big it is.
-    if (oasys::IO::stat(file_path.c_str(), &file_stat) < 0) {
-        log_err( "Unable to stat bundle file %s: %s", file_path.c_str(),
+    if (::fstat(bundle_fd, &file_stat) < 0) {
+        log_err( "Unable to stat bundle file %s: %s", name.c_str(),
                  strerror(errno) );
         oasys::IO::close(bundle_fd);
-        return;
+        return false;
     }
     
     Bundle* bundle = new Bundle();
@@ -928,11 +955,11 @@ ECLModule::read_bundle_file(const std::string& location,
         void* bundle_ptr = oasys::IO::mmap(bundle_fd, file_offset, map_size,
                                            oasys::IO::MMAP_RO);
         if (bundle_ptr == NULL) {
-            log_err( "Unable to map bundle file %s: %s", file_path.c_str(),
+            log_err( "Unable to map bundle file %s: %s", name.c_str(),
                      strerror(errno) );
             oasys::IO::close(bundle_fd);
             delete bundle;
-            return;
+            return false;
         }
         
         // Feed data to BundleProtocol.
@@ -944,7 +971,7 @@ ECLModule::read_bundle_file(const std::string& location,
             log_err("Unable to unmap bundle file");
             oasys::IO::close(bundle_fd);
             delete bundle;
-            return;
+            return false;
         }
         
         // Check the result of consume().
@@ -952,24 +979,19 @@ ECLModule::read_bundle_file(const std::string& location,
             log_err("Unable to process bundle");
             oasys::IO::close(bundle_fd);
             delete bundle;
-            return;
+            return false;
         }
         
         // Update the file offset.
         file_offset += map_size;
     }
     
-    // Close the bundle file and then delete it.
     oasys::IO::close(bundle_fd);
-    if (::remove( file_path.c_str() ) < 0) {
-        log_err( "Unable to remove bundle file %s: %s", file_path.c_str(),
-                 strerror(errno) );
-    }
     
     if (bundle->recv_blocks().size() < 1) {
         log_err("Received bundle does not contain enough information");
         delete bundle;
-        return;
+        return true;
     }
     
     // If there are unused bytes in the file, log a warning, but
@@ -983,12 +1005,39 @@ ECLModule::read_bundle_file(const std::string& location,
     BundleReceivedEvent* b_event =
             new BundleReceivedEvent(bundle, EVENTSRC_PEER, file_stat.st_size, peer_eid);
     BundleDaemon::post(b_event);
+    return true;
 }
 
 void
 ECLModule::read_cycle() {
     size_t buffer_i = 0;
 
+    // The first byte from the module tells us how it frames its messages:
+    // a binary frame always starts with a zero byte, which can't start
+    // an XML document.
+    if (framing_ == FRAMING_UNKNOWN) {
+        char c;
+        int result = socket_.recv(&c, 1, MSG_PEEK);
+        if (result <= 0) {
+            log_err("Connection to CL %s lost: %s", name_.c_str(),
+                    (result == 0 ? "Closed by other side" : strerror(errno)));
+
+            set_should_stop();
+            return;
+        } // if
+
+        framing_ = (c == 0) ? FRAMING_BINARY : FRAMING_XML;
+        pass_fds_ = (framing_ == FRAMING_BINARY && local_);
+        log_info( "Module is using %s framing%s",
+                  (framing_ == FRAMING_BINARY ? "binary" : "XML"),
+                  (pass_fds_ ? " with descriptor passing" : "") );
+    } // if
+
+    if (framing_ == FRAMING_BINARY) {
+        read_frames();
+        return;
+    }
+
     // Peek at what's available.
     int result = socket_.recv(read_buffer_, READ_BUFFER_SIZE, MSG_PEEK);
 
@@ -1027,6 +1076,120 @@ ECLModule::read_cycle() {
     socket_.recv(read_buffer_, buffer_i, 0);
 }
 
+void
+ECLModule::read_frames()
+{
+    int result = reader_.read( socket_.fd() );
+
+    if (result <= 0) {
+        log_err("Connection to CL %s lost: %s", name_.c_str(),
+                (result == 0 ? "Closed by other side" : strerror(errno)));
+
+        set_should_stop();
+        return;
+    } // if
+
+    // Dispatch the messages in every complete frame.
+    std::string payload;
+    while ( (result = reader_.next_frame(&payload)) > 0 ) {
+        if ( !process_cl_frame(payload) ) {
+            log_err("Malformed frame from CL %s", name_.c_str());
+            set_should_stop();
+            return;
+        }
+    }
+
+    if (result < 0) {
+        log_err("Oversized frame from CL %s", name_.c_str());
+        set_should_stop();
+    }
+}
+
+int
+ECLModule::send_messages()
+{
+    if (framing_ == FRAMING_BINARY)
+        return send_batch();
+
+    cl_message* message;
+    if ( !message_queue_.try_pop(&message) )
+        return 0;
+
+    ASSERT(message != NULL);
+    int result = 1;
+
+    // We need to handle bundle-send messages as a special case,
+    // in order to get the bundle written to disk first.
+    if ( message->bundle_send_request().present() )
+        result = prepare_bundle_to_send(message, NULL);
+
+    if (result > 0)
+        result = send_message(message);
+
+    delete message;
+    return result;
+}
+
+int
+ECLModule::send_batch()
+{
+    std::string payload;
+    RouterTLV::Encoder enc(&payload, &ECLFraming::clevent_names());
+    enc.begin_payload();
+
+    std::vector<int> fds;
+    int count = 0;
+    int result = 0;
+    cl_message* message;
+
+    while (count < MAX_BATCH_MESSAGES && payload.size() < MAX_BATCH_BYTES &&
+           (int)fds.size() < ECLFraming::MAX_FDS &&
+           message_queue_.try_pop(&message)) {
+        ASSERT(message != NULL);
+
+        int ret = 1;
+        if ( message->bundle_send_request().present() ) {
+            int bundle_fd = -1;
+            ret = prepare_bundle_to_send(message,
+                                         pass_fds_ ? &bundle_fd : NULL);
+            if (bundle_fd >= 0)
+                fds.push_back(bundle_fd);
+        }
+
+        if (ret > 0) {
+            cl_message_tlv(*message, &enc);
+            ++count;
+        }
+
+        delete message;
+
+        if (ret < 0) {
+            result = -1;
+            break;
+        }
+    } // while
+
+    if (count > 0) {
+        log_debug_p("/dtn/cl/XML", "Sending %d messages to module %s "
+                    "(%zu bytes, %zu descriptors)", count, name_.c_str(),
+                    payload.size(), fds.size());
+
+        if (ECLFraming::send_frame(socket_.fd(), payload,
+                                   fds.empty() ? NULL : &fds[0],
+                                   fds.size()) < 0) {
+            log_err("Socket error: %s", strerror(errno));
+            log_err("Connection with CL %s lost", name_.c_str());
+            result = -1;
+        }
+    }
+
+    // The module has its own copies of the descriptors now.
+    for (size_t i = 0; i < fds.size(); ++i)
+        oasys::IO::close(fds[i]);
+
+    return result;
+}
+
 int
 ECLModule::send_message(const cl_message* message)
 {
@@ -1069,7 +1232,7 @@ ECLModule::send_message(const cl_message* message)
 }
 
 int 
-ECLModule::prepare_bundle_to_send(cl_message* message)
+ECLModule::prepare_bundle_to_send(cl_message* message, int* bundle_fd_out)
 {
     bundle_send_request request = message->bundle_send_request().get();
     
@@ -1104,9 +1267,15 @@ ECLModule::prepare_bundle_to_send(cl_message* message)
     // Figure out the path to the file.
     std::string abs_path = bundle_out_path_ + "/" + request.location();
     
-    // Create and open the file.
-    int bundle_fd = oasys::IO::open(abs_path.c_str(), O_RDWR | O_CREAT | O_EXCL,
-                                    0644);
+    // Create and open the file, or an anonymous one to pass to the module.
+    int bundle_fd;
+    if (bundle_fd_out != NULL)
+        bundle_fd = ECLFraming::create_payload_fd(bundle_out_path_.c_str(),
+                                                  total_length);
+    else
+        bundle_fd = oasys::IO::open(abs_path.c_str(),
+                                    O_RDWR | O_CREAT | O_EXCL, 0644);
+    
     if (bundle_fd < 0) {
         log_err( "Unable to create bundle file %s: %s",
                  request.location().c_str(), strerror(errno) );
@@ -1148,10 +1317,13 @@ ECLModule::prepare_bundle_to_send(cl_message* message)
         offset += map_size;
     } 
     
-    oasys::IO::close(bundle_fd);
+    // The descriptor goes to the module along with the message.
+    if (bundle_fd_out != NULL)
+        *bundle_fd_out = bundle_fd;
+    else
+        oasys::IO::close(bundle_fd);
     
-    // Send this event to the module.
-    return send_message(message);
+    return 1;
 }
 
 void
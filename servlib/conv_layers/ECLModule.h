@@ -51,6 +51,7 @@
 
 #include "ExternalConvergenceLayer.h"
 #include "CLEventHandler.h"
+#include "ECLFraming.h"
 #include "clevent.h"
 
 #define POST_MESSAGE(module_ptr, message_name, message) do { \
@@ -69,6 +70,11 @@ using __gnu_cxx::hash;
  *
  * There is one ECLModule thread for each external module that connects to DTN2.
  * Messages can be sent to the module with post_event(CLEvent*) method.
+ *
+ * The module picks XML documents or binary frames (see ECLFraming) with
+ * its first message. With binary framing, messages queued for the module
+ * are batched into frames, and on a Unix domain connection bundles are
+ * passed as file descriptors instead of files.
  */
 class ECLModule : public CLInfo,
                   public CLEventHandler,
@@ -85,9 +91,10 @@ public:
      *      localhost).
      * @param remote_port - The port number of the connecting module.
      * @param cl - A reference back to the convergence layer.
+     * @param local - True if the module connected on a Unix domain socket.
      */
     ECLModule(int fd, in_addr_t remote_addr, u_int16_t remote_port,
-              ExternalConvergenceLayer& cl);
+              ExternalConvergenceLayer& cl, bool local = false);
     virtual ~ECLModule();
 
     virtual void run();
@@ -187,6 +194,17 @@ private:
     /// The maximum amount of the bundle that we will map when sending to and
     /// receiving from the module.
     static const size_t MAX_BUNDLE_IN_MEMORY = (256 * 1024);
+
+    /// Limits on the messages batched into one binary frame.
+    static const int MAX_BATCH_MESSAGES = 64;
+    static const size_t MAX_BATCH_BYTES = (64 * 1024);
+
+    /// How messages are framed on the socket.
+    typedef enum {
+        FRAMING_UNKNOWN,    ///< the module hasn't sent anything yet
+        FRAMING_XML,        ///< XML documents
+        FRAMING_BINARY,     ///< length-prefixed binary frames
+    } framing_t;
     
     /** Read a bundle file and create a Bundle* from it.
      * 
@@ -204,6 +222,19 @@ private:
      */
     void read_bundle_file(const std::string& location, const std::string& peer_eid);
 
+    /** Read a bundle from an open file and post a BundleReceivedEvent for it.
+     *
+     * This is the common part of read_bundle_file() and the handling of
+     * bundles passed as file descriptors. The descriptor is closed.
+     *
+     * @param bundle_fd  The descriptor of the bundle file.
+     * @param name  The name of the file, for log messages.
+     *
+     * @return False if the bundle could not be read.
+     */
+    bool read_bundle(int bundle_fd, const std::string& name,
+                     const std::string& peer_eid);
+
     /** Make the next pass when there is input on the socket.
      *
      * As input comes in on the socket, this will make one pass of at most
@@ -214,7 +245,26 @@ private:
      * and it will do the above actions as it needs to and is able to.
      */
     void read_cycle();
-    
+
+    /** Read what is available on the socket with binary framing, and
+     * dispatch the messages in any complete frames.
+     */
+    void read_frames();
+
+    /** Send the messages waiting on message_queue_.
+     *
+     * With XML framing, one message is sent per call. With binary framing,
+     * up to MAX_BATCH_MESSAGES messages are sent as one frame.
+     *
+     * @return 0 if the messages were sent (or dropped), -1 if the connection
+     *      was lost.
+     */
+    int send_messages();
+
+    /** Send a batch of messages as one binary frame.
+     */
+    int send_batch();
+
     /** Send a message to the external module.
      *
      * This will build the XML document from the CLEvent and send it
@@ -235,8 +285,14 @@ private:
      * the CLA. The 'location' attribute of 'event' will be filled with the
      * name of this file (relative to bundle_out_path_).
      * 
+     * If bundle_fd is not NULL, the bundle is instead written to an
+     * anonymous file, whose descriptor is returned in bundle_fd to be passed
+     * to the module.
+     *
+     * @return 1 if the message should be sent, 0 if it should be dropped,
+     *      or -1 on an error that stops the module.
      */
-    int prepare_bundle_to_send(cl_message* message);
+    int prepare_bundle_to_send(cl_message* message, int* bundle_fd);
     
     
     /** Clean up after a bundle when it cannot be sent.
@@ -367,6 +423,19 @@ private:
 
     /// The parser used to parse XML messages from the external module.
     oasys::XercesXMLUnmarshal parser_;
+
+    /// True if the module connected on a Unix domain socket.
+    bool local_;
+
+    /// How messages are framed, as chosen by the module's first message.
+    framing_t framing_;
+
+    /// Whether bundles are passed as file descriptors (binary framing on a
+    /// Unix domain socket).
+    bool pass_fds_;
+
+    /// Frames and descriptors received with binary framing.
+    ECLFraming::Reader reader_;
 };
 
 } // namespace dtn
@@ -20,10 +20,13 @@
 
 #include <stdio.h>
 #include <sys/types.h>
+#include <unistd.h>
 #include <sys/socket.h>
+#include <sys/un.h>
 #include <netinet/in.h>
 #include <arpa/inet.h>
 
+#include <oasys/io/IO.h>
 #include <oasys/io/NetUtils.h>
 #include <oasys/io/FileUtils.h>
 #include <oasys/thread/Lock.h>
@@ -41,6 +44,7 @@ bool ExternalConvergenceLayer::client_validation_ = true;
 std::string ExternalConvergenceLayer::schema_ = "";
 in_addr_t ExternalConvergenceLayer::server_addr_ = inet_addr("127.0.0.1");
 u_int16_t ExternalConvergenceLayer::server_port_ = 5070;
+std::string ExternalConvergenceLayer::server_path_ = "";
 bool ExternalConvergenceLayer::create_discovered_links_ = false;
 bool ExternalConvergenceLayer::discovered_prev_hop_header_ = false;
 xml_schema::namespace_infomap ExternalConvergenceLayer::namespace_map_;
@@ -51,7 +55,8 @@ ConvergenceLayer("ExternalConvergenceLayer", "extcl"),
 global_resource_lock_("/dtn/cl/parts/global_resource_lock"),
 module_mutex_("/dtn/cl/parts/module_mutex"),
 resource_mutex_("/dtn/cl/parts/resource_mutex"),
-listener_(*this)
+listener_(*this),
+local_listener_(*this)
 {
 
 }
@@ -79,8 +84,11 @@ ExternalConvergenceLayer::start()
     if (client_validation_)
         namespace_map_[""].schema = schema_.c_str();
     
-    // Start the listener thread.
+    // Start the listener threads.
     listener_.start();
+    
+    if ( !server_path_.empty() )
+        local_listener_.start();
 }
 
 //----------------------------------------------------------------------
@@ -1363,13 +1371,102 @@ ExternalConvergenceLayer::Listener::accepted(int fd, in_addr_t addr,
     }
     
     log_debug("Accepted connection from a new CLA module");
-    ECLModule* module = new ECLModule(fd, addr, port, cl_);
+    cl_.accept_module(fd, addr, port, false);
+}
+
+//----------------------------------------------------------------------
+void
+ExternalConvergenceLayer::accept_module(int fd, in_addr_t addr,
+                                        u_int16_t port, bool local)
+{
+    ECLModule* module = new ECLModule(fd, addr, port, *this, local);
 
     // Add this module to our list and start its thread.
-    cl_.add_module(module);
+    add_module(module);
     module->start();
 }
 
+//----------------------------------------------------------------------
+ExternalConvergenceLayer::LocalListener::LocalListener(
+        ExternalConvergenceLayer& cl)
+    : Thread("ExternalConvergenceLayer::LocalListener"),
+      Logger("ExternalConvergenceLayer::LocalListener",
+             "/dtn/cl/LocalListener"),
+      cl_(cl)
+{
+}
+
+//----------------------------------------------------------------------
+ExternalConvergenceLayer::LocalListener::~LocalListener()
+{
+
+}
+
+//----------------------------------------------------------------------
+void
+ExternalConvergenceLayer::LocalListener::run()
+{
+    struct sockaddr_un sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sun_family = AF_UNIX;
+    if (server_path_.size() >= sizeof(sa.sun_path)) {
+        log_err("Socket path %s is too long", server_path_.c_str());
+        return;
+    }
+    strcpy(sa.sun_path, server_path_.c_str());
+
+    int listen_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    if (listen_fd < 0) {
+        log_err("Unable to create socket: %s", strerror(errno));
+        return;
+    }
+
+    // Remove a socket left behind by an earlier run.
+    ::unlink(sa.sun_path);
+
+    if (::bind(listen_fd, (struct sockaddr*)&sa, sizeof(sa)) < 0 ||
+        ::listen(listen_fd, 8) < 0) {
+        log_err("Unable to listen on %s: %s", server_path_.c_str(),
+                strerror(errno));
+        ::close(listen_fd);
+        return;
+    }
+
+    log_info("Listening for external CLAs on %s", server_path_.c_str());
+
+    while ( !should_stop() ) {
+        int ret = oasys::IO::poll_single(listen_fd, POLLIN, NULL, 1000,
+                                         NULL, logpath_);
+        if (ret == oasys::IOTIMEOUT || ret == oasys::IOINTR)
+            continue;
+
+        if (ret < 0) {
+            log_err("Error polling listening socket");
+            break;
+        }
+
+        int fd = ::accept(listen_fd, NULL, NULL);
+        if (fd < 0) {
+            if (errno != EINTR && errno != EAGAIN)
+                log_err("Error in accept: %s", strerror(errno));
+            continue;
+        }
+
+        if ( schema_ == std::string() ) {
+            log_err("ECLA module is connecting before the XSD file is "
+                    "specified. Closing the socket");
+            ::close(fd);
+            continue;
+        }
+
+        log_debug("Accepted local connection from a new CLA module");
+        cl_.accept_module(fd, INADDR_NONE, 0, true);
+    }
+
+    ::close(listen_fd);
+    ::unlink(sa.sun_path);
+}
+
 
 //----------------------------------------------------------------------
 void
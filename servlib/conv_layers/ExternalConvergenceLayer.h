@@ -343,6 +343,13 @@ public:
     void remove_module(ECLModule* module);
     
     
+    /** Create and start a module for a new connection.
+     * 
+     * @param local - True if the connection is on the Unix domain socket.
+     */
+    void accept_module(int fd, in_addr_t addr, u_int16_t port, bool local);
+    
+    
     /** Retrieve a module matching the given protocol name.
      * 
      * @param protocol - The name of the protocol to match.
@@ -365,6 +372,12 @@ public:
     /// the command 'ecla set listen_port'
     static u_int16_t server_port_;
     
+    /// The path of a Unix domain socket on which the LocalListener thread
+    /// will also listen, if not empty. Modules connecting there can have
+    /// bundles passed as file descriptors. This is set with the command
+    /// 'ecla set server_path'
+    static std::string server_path_;
+    
     static bool create_discovered_links_;
     
     static bool discovered_prev_hop_header_;
@@ -401,6 +414,23 @@ private:
     }; // class Listener
     
     
+    /** Thread to listen for connections from new external modules on the
+     * Unix domain socket at server_path_.
+     */
+    class LocalListener : public oasys::Thread, public oasys::Logger {
+    public:
+        LocalListener(ExternalConvergenceLayer& cl);
+        virtual ~LocalListener();
+
+    protected:
+        virtual void run();
+
+    private:
+        /// Reference back to the convergence layer.
+        ExternalConvergenceLayer& cl_;
+    }; // class LocalListener
+    
+    
     /** Add a resource to the unclaimed resource list.
      */
     void add_resource(ECLResource* resource);
@@ -440,6 +470,9 @@ private:
     
     /// The thread listening for new modules.
     Listener listener_;
+    
+    /// The thread listening for new modules on the Unix domain socket.
+    LocalListener local_listener_;
 };
 
 
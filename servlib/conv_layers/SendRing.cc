@@ -0,0 +1,140 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <string.h>
+#include <algorithm>
+#include <oasys/debug/DebugUtils.h>
+
+#include "SendRing.h"
+
+namespace dtn {
+
+//----------------------------------------------------------------------
+SendRing::SendRing(size_t size)
+    : buf_(new u_char[size]),
+      size_(size),
+      head_(0),
+      full_(0),
+      written_(0),
+      consumed_(0)
+{
+    ASSERT(size_ != 0);
+}
+
+//----------------------------------------------------------------------
+SendRing::~SendRing()
+{
+    delete[] buf_;
+}
+
+//----------------------------------------------------------------------
+size_t
+SendRing::tailbytes() const
+{
+    if (full_ == size_) {
+        return 0;
+    }
+
+    // the free space either runs to the end of the buffer, or (if the
+    // queued data wraps) up to the head
+    size_t tail = tail_offset();
+    return tail >= head_ ? size_ - tail : head_ - tail;
+}
+
+//----------------------------------------------------------------------
+void
+SendRing::fill(size_t len)
+{
+    ASSERT(len <= tailbytes());
+    full_    += len;
+    written_ += len;
+}
+
+//----------------------------------------------------------------------
+void
+SendRing::append(const void* data, size_t len)
+{
+    ASSERT(len <= freebytes());
+
+    const u_char* bp = (const u_char*)data;
+    while (len != 0) {
+        size_t n = std::min(len, tailbytes());
+        memcpy(tail(), bp, n);
+        fill(n);
+        bp  += n;
+        len -= n;
+    }
+}
+
+//----------------------------------------------------------------------
+void
+SendRing::end_segment()
+{
+    if (segment_ends_.empty() || segment_ends_.back() != written_) {
+        segment_ends_.push_back(written_);
+    }
+}
+
+//----------------------------------------------------------------------
+int
+SendRing::fill_iov(struct iovec* iov, size_t max_len) const
+{
+    size_t len = std::min(full_, max_len);
+    if (len == 0) {
+        return 0;
+    }
+
+    size_t first = std::min(len, size_ - head_);
+    iov[0].iov_base = buf_ + head_;
+    iov[0].iov_len  = first;
+    if (first == len) {
+        return 1;
+    }
+
+    iov[1].iov_base = buf_;
+    iov[1].iov_len  = len - first;
+    return 2;
+}
+
+//----------------------------------------------------------------------
+void
+SendRing::consume(size_t len)
+{
+    ASSERT(len <= full_);
+
+    head_ += len;
+    if (head_ >= size_) {
+        head_ -= size_;
+    }
+    full_     -= len;
+    consumed_ += len;
+
+    // an empty ring starts over at the beginning of the buffer so the
+    // next fill has the whole buffer as one contiguous region
+    if (full_ == 0) {
+        head_ = 0;
+    }
+
+    while (!segment_ends_.empty() && segment_ends_.front() <= consumed_) {
+        segment_ends_.pop_front();
+    }
+}
+
+} // namespace dtn
@@ -0,0 +1,116 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _SEND_RING_H_
+#define _SEND_RING_H_
+
+#include <deque>
+#include <sys/types.h>
+#include <sys/uio.h>
+#include <oasys/compat/inttypes.h>
+
+namespace dtn {
+
+/**
+ * Fixed-size ring buffer used by the stream convergence layers to
+ * queue several segments (and their headers) ahead of the socket.
+ *
+ * Unlike a linear StreamBuffer, data is never moved once written: the
+ * free space wraps around the end of the buffer, and the queued data
+ * is handed to writev() as (at most) two regions. The ring also keeps
+ * track of where the queued data segments end so the pipeline depth
+ * can be bounded and reported.
+ */
+class SendRing {
+public:
+    /**
+     * Constructor, with a fixed capacity in bytes.
+     */
+    SendRing(size_t size);
+
+    /**
+     * Destructor.
+     */
+    ~SendRing();
+
+    /// @{ Accessors
+    size_t size()      const { return size_; }
+    size_t fullbytes() const { return full_; }
+    size_t freebytes() const { return size_ - full_; }
+    /// @}
+
+    /**
+     * The contiguous free space at the write position, which may be
+     * less than freebytes() if the free space wraps.
+     */
+    u_char* tail() { return buf_ + tail_offset(); }
+    size_t tailbytes() const;
+
+    /**
+     * Mark the given number of bytes written at tail() as queued.
+     */
+    void fill(size_t len);
+
+    /**
+     * Copy data into the ring, wrapping as needed. There must be at
+     * least len bytes free.
+     */
+    void append(const void* data, size_t len);
+
+    /**
+     * Note that a data segment ends at the current write position.
+     */
+    void end_segment();
+
+    /**
+     * Number of data segments that still have bytes in the ring.
+     */
+    size_t segments() const { return segment_ends_.size(); }
+
+    /**
+     * Fill in the iovecs (two at most) covering up to max_len bytes
+     * of queued data, oldest first.
+     *
+     * @return the number of iovecs used
+     */
+    int fill_iov(struct iovec* iov, size_t max_len) const;
+
+    /**
+     * Discard the given number of bytes from the front of the ring
+     * once they have been written out.
+     */
+    void consume(size_t len);
+
+private:
+    /// Offset of the write position
+    size_t tail_offset() const
+    {
+        size_t off = head_ + full_;
+        return off >= size_ ? off - size_ : off;
+    }
+
+    u_char*               buf_;
+    size_t                size_;
+    size_t                head_;          ///< offset of the oldest byte
+    size_t                full_;          ///< bytes queued
+    u_int64_t             written_;       ///< total bytes ever queued
+    u_int64_t             consumed_;      ///< total bytes ever consumed
+    std::deque<u_int64_t> segment_ends_;  ///< written_ at each segment end
+};
+
+} // namespace dtn
+
+#endif /* _SEND_RING_H_ */
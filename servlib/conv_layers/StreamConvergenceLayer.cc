@@ -18,11 +18,14 @@
 #  include <dtn-config.h>
 #endif
 
+#include <fcntl.h>
 #include <oasys/util/OptParser.h>
 #include "StreamConvergenceLayer.h"
 #include "bundling/BundleDaemon.h"
+#include "bundling/BundleProtocol.h"
 #include "bundling/SDNV.h"
 #include "bundling/TempBundle.h"
+#include "bundling/TraceRing.h"
 #include "contacts/ContactManager.h"
 
 namespace dtn {
@@ -33,7 +36,15 @@ StreamConvergenceLayer::StreamLinkParams::StreamLinkParams(bool init_defaults)
       segment_ack_enabled_(true),
       negative_ack_enabled_(true),
       keepalive_interval_(10),
-      segment_length_(4096)
+      segment_length_(4096),
+      zero_copy_(false),
+      ring_buffer_(false),
+      pipeline_depth_(8),
+      zero_copy_bytes_(0),
+      ring_bytes_(0),
+      ring_segments_(0),
+      ring_peak_bytes_(0),
+      ring_peak_segments_(0)
 {
 }
 
@@ -47,6 +58,9 @@ StreamConvergenceLayer::StreamLinkParams::serialize(oasys::SerializeAction *a)
 	a->process("negative_ack_enabled", &negative_ack_enabled_);
 	a->process("keepalive_interval", &keepalive_interval_);
 	a->process("segment_length", &segment_length_);
+	a->process("zero_copy", &zero_copy_);
+	a->process("ring_buffer", &ring_buffer_);
+	a->process("pipeline_depth", &pipeline_depth_);
 }
 
 //----------------------------------------------------------------------
@@ -83,6 +97,15 @@ StreamConvergenceLayer::parse_link_params(LinkParams* lparams,
     p.addopt(new oasys::UIntOpt("segment_length",
                                 &params->segment_length_));
     
+    p.addopt(new oasys::BoolOpt("zero_copy",
+                                &params->zero_copy_));
+    
+    p.addopt(new oasys::BoolOpt("ring_buffer",
+                                &params->ring_buffer_));
+    
+    p.addopt(new oasys::UIntOpt("pipeline_depth",
+                                &params->pipeline_depth_));
+    
     p.addopt(new oasys::UInt8Opt("cl_version",
                                  &cl_version_));
     
@@ -92,6 +115,16 @@ StreamConvergenceLayer::parse_link_params(LinkParams* lparams,
     }
     argc -= count;
 
+    if (params->ring_buffer_ && !ring_buffer_supported()) {
+        *invalidp = "ring_buffer is not supported by this convergence layer";
+        return false;
+    }
+
+    if (params->pipeline_depth_ == 0) {
+        *invalidp = "pipeline_depth must not be zero";
+        return false;
+    }
+
     return ConnectionConvergenceLayer::parse_link_params(lparams, argc, argv,
                                                          invalidp);
 }
@@ -130,6 +163,17 @@ StreamConvergenceLayer::dump_link(const LinkRef& link, oasys::StringBuffer* buf)
     buf->appendf("negative_ack_enabled: %u\n", params->negative_ack_enabled_);
     buf->appendf("keepalive_interval: %u\n", params->keepalive_interval_);
     buf->appendf("segment_length: %u\n", params->segment_length_);
+    buf->appendf("zero_copy: %u\n", params->zero_copy_);
+    buf->appendf("zero_copy_bytes: %llu\n",
+                 (unsigned long long)params->zero_copy_bytes_);
+    buf->appendf("ring_buffer: %u\n", params->ring_buffer_);
+    buf->appendf("pipeline_depth: %u\n", params->pipeline_depth_);
+    if (params->ring_buffer_) {
+        buf->appendf("ring_occupancy: %zu bytes, %zu segments "
+                     "(peak %zu bytes, %zu segments)\n",
+                     params->ring_bytes_, params->ring_segments_,
+                     params->ring_peak_bytes_, params->ring_peak_segments_);
+    }
     buf->appendf("cl_version: %u\n", cl_version_);
 }
 
@@ -144,8 +188,117 @@ StreamConvergenceLayer::Connection::Connection(const char* classname,
       send_segment_todo_(0),
       recv_segment_todo_(0),
       breaking_contact_(false),
-      contact_initiated_(false)
+      contact_initiated_(false),
+      zero_copy_failed_(false),
+      send_ring_(NULL)
+{
+    // the ring has a fixed size, so unlike sendbuf_ it isn't resized
+    // when the link is reconfigured
+    if (params->ring_buffer_) {
+        send_ring_ = new SendRing(params->sendbuf_len_);
+    }
+}
+
+//----------------------------------------------------------------------
+StreamConvergenceLayer::Connection::~Connection()
+{
+    delete send_ring_;
+}
+
+//----------------------------------------------------------------------
+int
+StreamConvergenceLayer::Connection::fill_send_iov(struct iovec* iov,
+                                                  size_t max_len)
 {
+    // anything in sendbuf_ (i.e. the contact header) was queued
+    // before the ring was used, so it goes first
+    int iovcnt = 0;
+    size_t len = std::min(sendbuf_.fullbytes(), max_len);
+    if (len != 0) {
+        iov[0].iov_base = sendbuf_.start();
+        iov[0].iov_len  = len;
+        iovcnt = 1;
+        max_len -= len;
+    }
+
+    if (send_ring_ != NULL) {
+        iovcnt += send_ring_->fill_iov(&iov[iovcnt], max_len);
+    }
+
+    return iovcnt;
+}
+
+//----------------------------------------------------------------------
+void
+StreamConvergenceLayer::Connection::consume_sent(size_t len)
+{
+    size_t n = std::min(len, sendbuf_.fullbytes());
+    sendbuf_.consume(n);
+    len -= n;
+
+    if (len != 0) {
+        ASSERT(send_ring_ != NULL);
+        send_ring_->consume(len);
+        note_ring_stats();
+    }
+}
+
+//----------------------------------------------------------------------
+size_t
+StreamConvergenceLayer::Connection::send_space()
+{
+    if (send_ring_ != NULL) {
+        return send_ring_->freebytes();
+    }
+    return sendbuf_.tailbytes();
+}
+
+//----------------------------------------------------------------------
+void
+StreamConvergenceLayer::Connection::send_append(const void* data, size_t len)
+{
+    if (send_ring_ != NULL) {
+        send_ring_->append(data, len);
+        return;
+    }
+
+    ASSERT(len <= sendbuf_.tailbytes());
+    memcpy(sendbuf_.end(), data, len);
+    sendbuf_.fill(len);
+}
+
+//----------------------------------------------------------------------
+void
+StreamConvergenceLayer::Connection::flush_send_ring()
+{
+    note_ring_stats();
+    if (send_buffered() != 0) {
+        send_data();
+    }
+}
+
+//----------------------------------------------------------------------
+void
+StreamConvergenceLayer::Connection::note_ring_stats()
+{
+    StreamLinkParams* params = stream_lparams();
+    params->ring_bytes_    = send_ring_->fullbytes();
+    params->ring_segments_ = send_ring_->segments();
+    params->ring_peak_bytes_ =
+        std::max(params->ring_peak_bytes_, params->ring_bytes_);
+    params->ring_peak_segments_ =
+        std::max(params->ring_peak_segments_, params->ring_segments_);
+}
+
+//----------------------------------------------------------------------
+int
+StreamConvergenceLayer::Connection::send_file_data(int fd, off_t offset,
+                                                   size_t len)
+{
+    (void)fd;
+    (void)offset;
+    (void)len;
+    return -1;
 }
 
 //----------------------------------------------------------------------
@@ -393,7 +546,7 @@ StreamConvergenceLayer::Connection::send_pending_data()
 {
     // if the outgoing data buffer is full, we can't do anything until
     // we poll()
-    if (sendbuf_.tailbytes() == 0) {
+    if (send_space() == 0) {
         return false;
     }
 
@@ -408,6 +561,10 @@ StreamConvergenceLayer::Connection::send_pending_data()
     
     // see if we're broken or write blocked
     if (contact_broken_ || (send_segment_todo_ != 0)) {
+        if (send_ring_ != NULL && !contact_broken_) {
+            flush_send_ring();
+        }
+
         if (params_->test_write_delay_ != 0) {
             return true;
         }
@@ -437,6 +594,29 @@ StreamConvergenceLayer::Connection::send_pending_data()
         sent_data = send_next_segment(current_inflight_);
     }
 
+    // with a send ring, keep queueing whole segments (of this or the
+    // following bundles) while there's room, then write them all out
+    // at once
+    if (send_ring_ != NULL) {
+        StreamLinkParams* params = stream_lparams();
+        while (sent_data && !contact_broken_ &&
+               send_segment_todo_ == 0 &&
+               send_ring_->freebytes() != 0 &&
+               send_ring_->segments() < params->pipeline_depth_ &&
+               params_->test_write_delay_ == 0)
+        {
+            if (current_inflight_ == NULL) {
+                sent_data = start_next_bundle();
+            } else {
+                sent_data = send_next_segment(current_inflight_);
+            }
+        }
+
+        if (!contact_broken_) {
+            flush_send_ring();
+        }
+    }
+
     return sent_ack || sent_data;
 }
 
@@ -484,24 +664,21 @@ StreamConvergenceLayer::Connection::send_pending_acks()
 
             // make sure we have space in the send buffer
             size_t encoding_len = 1 + SDNV::encoding_len(ack_len);
-            if (encoding_len > sendbuf_.tailbytes()) {
+            if (encoding_len > send_space()) {
                 log_debug("send_pending_acks: "
                       "no space for ack in buffer (need %zu, have %zu)",
-                      encoding_len, sendbuf_.tailbytes());
+                      encoding_len, send_space());
                 break;
             }
         
-            log_debug("send_pending_acks: "
-                  "sending ack length %zu for %zu byte segment "
-                  "[range %u..%u] ack_data *%p",
-                  ack_len, segment_len, incoming->acked_length_, *iter,
-                  &incoming->ack_data_);
+            DTN_SEGMENT_TRACE(ACK_SEND, incoming->bundle_->bundleid(),
+                              ack_len, segment_len);
         
-            *sendbuf_.end() = ACK_SEGMENT;
-            int len = SDNV::encode(ack_len, (u_char*)sendbuf_.end() + 1,
-                               sendbuf_.tailbytes() - 1);
-            ASSERT(encoding_len = len + 1);
-            sendbuf_.fill(encoding_len);
+            u_char ack[1 + SDNV::MAX_LENGTH];
+            ack[0] = ACK_SEGMENT;
+            int len = SDNV::encode(ack_len, ack + 1, SDNV::MAX_LENGTH);
+            ASSERT(encoding_len == (size_t)len + 1);
+            send_append(ack, encoding_len);
 
             generated_ack = true;
 	}
@@ -514,13 +691,14 @@ StreamConvergenceLayer::Connection::send_pending_acks()
             // with acks we could send
             break;
         }
-        
-        log_debug("send_pending_acks: "
-                  "found another segment (%u)", *iter);
     }
     
+    // in ring buffer mode, send_pending_data writes the acks out
+    // along with any data segments
     if (generated_ack) {
-        send_data();
+        if (send_ring_ == NULL) {
+            send_data();
+        }
         note_data_sent();
     }
 
@@ -598,7 +776,7 @@ StreamConvergenceLayer::Connection::start_next_bundle()
 bool
 StreamConvergenceLayer::Connection::send_next_segment(InFlightBundle* inflight)
 {
-    if (sendbuf_.tailbytes() == 0) {
+    if (send_space() == 0) {
         return false;
     }
 
@@ -633,24 +811,22 @@ StreamConvergenceLayer::Connection::send_next_segment(InFlightBundle* inflight)
     
     size_t sdnv_len = SDNV::encoding_len(segment_len);
     
-    if (sendbuf_.tailbytes() < 1 + sdnv_len) {
+    if (send_space() < 1 + sdnv_len) {
         log_debug("send_next_segment: "
                   "not enough space for segment header [need %zu, have %zu]",
-                  1 + sdnv_len, sendbuf_.tailbytes());
+                  1 + sdnv_len, send_space());
         return false;
     }
     
-    log_debug("send_next_segment: "
-              "starting %zu byte segment [block byte range %zu..%zu]",
-              segment_len, bytes_sent, bytes_sent + segment_len);
+    DTN_SEGMENT_TRACE(SEGMENT_SEND, inflight->bundle_->bundleid(),
+                      bytes_sent, segment_len);
 
-    u_char* bp = (u_char*)sendbuf_.end();
-    *bp++ = DATA_SEGMENT | flags;
-    int cc = SDNV::encode(segment_len, bp, sendbuf_.tailbytes() - 1);
+    u_char hdr[1 + SDNV::MAX_LENGTH];
+    hdr[0] = DATA_SEGMENT | flags;
+    int cc = SDNV::encode(segment_len, hdr + 1, SDNV::MAX_LENGTH);
     ASSERT(cc == (int)sdnv_len);
-    bp += sdnv_len;
     
-    sendbuf_.fill(1 + sdnv_len);
+    send_append(hdr, 1 + sdnv_len);
     send_segment_todo_ = segment_len;
 
     // send_data_todo actually does the deed
@@ -663,16 +839,101 @@ StreamConvergenceLayer::Connection::send_data_todo(InFlightBundle* inflight)
 {
     ASSERT(send_segment_todo_ != 0);
 
+    StreamLinkParams* params = stream_lparams();
+
     // loop since it may take multiple calls to send on the socket
     // before we can actually drain the todo amount
-    while (send_segment_todo_ != 0 && sendbuf_.tailbytes() != 0) {
+    while (send_segment_todo_ != 0 && send_space() != 0) {
         size_t bytes_sent = inflight->sent_data_.empty() ? 0 :
                             inflight->sent_data_.last() + 1;
-        size_t send_len   = std::min(send_segment_todo_, sendbuf_.tailbytes());
-    
+
+        // if we're in the body of a disk payload, write it straight
+        // from the payload file, but only once everything before it
+        // in the send buffer is out
+        size_t payload_offset = 0;
+        size_t zc_len = 0;
+        if (params->zero_copy_ && !zero_copy_failed_) {
+            zc_len = zero_copy_span(inflight, bytes_sent, &payload_offset);
+        }
+
+        if (zc_len != 0) {
+            if (send_buffered() != 0) {
+                send_data();
+                if (contact_broken_)
+                    return true;
+                if (send_buffered() != 0)
+                    return false;
+            }
+
+            size_t send_len = std::min(send_segment_todo_, zc_len);
+            int cc = send_file_data(inflight->payload_fd_,
+                                    payload_offset, send_len);
+            if (cc < 0) {
+                log_info("send_data_todo: zero copy send not supported, "
+                         "copying payload through the send buffer");
+                zero_copy_failed_ = true;
+                continue;
+            }
+
+            if (contact_broken_)
+                return true;
+
+            if (cc == 0) {
+                log_debug("send_data_todo: zero copy send would block");
+                return false;
+            }
+
+            inflight->sent_data_.set(bytes_sent, cc);
+            if (bytes_sent + cc == inflight->total_length_) {
+                inflight->send_complete_ = true;
+            }
+            params->zero_copy_bytes_ += cc;
+
+            DTN_SEGMENT_TRACE(DATA_SEND_ZC, inflight->bundle_->bundleid(),
+                              bytes_sent, cc);
+            
+            send_segment_todo_ -= cc;
+            note_data_sent();
+            if (send_ring_ != NULL && send_segment_todo_ == 0) {
+                send_ring_->end_segment();
+            }
+
+            if (params_->test_write_delay_ != 0) {
+                return true;
+            }
+            continue;
+        }
+        
         Bundle* bundle       = inflight->bundle_.object();
         BlockInfoVec* blocks = inflight->blocks_;
 
+        // in ring buffer mode, produce straight into the ring (in two
+        // passes if the free space wraps) and leave it to
+        // send_pending_data to write out
+        if (send_ring_ != NULL) {
+            size_t send_len = std::min(send_segment_todo_,
+                                       send_ring_->tailbytes());
+            size_t ret =
+                BundleProtocol::produce(bundle, blocks, send_ring_->tail(),
+                                        bytes_sent, send_len,
+                                        &inflight->send_complete_);
+            ASSERT(ret == send_len);
+            send_ring_->fill(send_len);
+            inflight->sent_data_.set(bytes_sent, send_len);
+
+            DTN_SEGMENT_TRACE(DATA_SEND, bundle->bundleid(),
+                              bytes_sent, send_len);
+
+            send_segment_todo_ -= send_len;
+            if (send_segment_todo_ == 0) {
+                send_ring_->end_segment();
+            }
+            note_data_sent();
+            continue;
+        }
+
+        size_t send_len   = std::min(send_segment_todo_, sendbuf_.tailbytes());
+    
         size_t ret =
             BundleProtocol::produce(bundle, blocks, (u_char*)sendbuf_.end(),
                                     bytes_sent, send_len,
@@ -681,11 +942,8 @@ StreamConvergenceLayer::Connection::send_data_todo(InFlightBundle* inflight)
         sendbuf_.fill(send_len);
         inflight->sent_data_.set(bytes_sent, send_len);
     
-        log_debug("send_data_todo: "
-                  "sent %zu/%zu of current segment from block offset %zu "
-                  "(%zu todo), updated sent_data *%p",
-                  send_len, send_segment_todo_, bytes_sent,
-                  send_segment_todo_ - send_len, &inflight->sent_data_);
+        DTN_SEGMENT_TRACE(DATA_SEND, bundle->bundleid(),
+                          bytes_sent, send_len);
         
         send_segment_todo_ -= send_len;
 
@@ -716,6 +974,60 @@ StreamConvergenceLayer::Connection::send_data_todo(InFlightBundle* inflight)
     return (send_segment_todo_ == 0);
 }
 
+//----------------------------------------------------------------------
+size_t
+StreamConvergenceLayer::Connection::zero_copy_span(InFlightBundle* inflight,
+                                                   size_t offset,
+                                                   size_t* payload_offset)
+{
+    Bundle* bundle = inflight->bundle_.object();
+    const BundlePayload& payload = bundle->payload();
+    if (payload.location() != BundlePayload::DISK) {
+        return 0;
+    }
+
+    // find the payload block, which must be generated by the regular
+    // payload processor (i.e. not transformed by a ciphersuite) so
+    // that its body is exactly the payload file
+    size_t block_start = 0;
+    BlockInfoVec::const_iterator iter;
+    for (iter = inflight->blocks_->begin();
+         iter != inflight->blocks_->end(); ++iter)
+    {
+        if (iter->type() == BundleProtocol::PAYLOAD_BLOCK) {
+            break;
+        }
+        block_start += iter->full_length();
+    }
+
+    if (iter == inflight->blocks_->end() ||
+        iter->owner() !=
+        BundleProtocol::find_processor(BundleProtocol::PAYLOAD_BLOCK) ||
+        iter->data_length() != payload.length())
+    {
+        return 0;
+    }
+
+    size_t body_start = block_start + iter->data_offset();
+    size_t body_end   = block_start + iter->full_length();
+    if (offset < body_start || offset >= body_end) {
+        return 0;
+    }
+
+    if (inflight->payload_fd_ == -1) {
+        inflight->payload_fd_ = ::open(payload.filename().c_str(), O_RDONLY);
+        if (inflight->payload_fd_ == -1) {
+            log_warn("zero_copy_span: can't open payload file %s: %s",
+                     payload.filename().c_str(), strerror(errno));
+            return 0;
+        }
+    }
+
+    // a fragment's payload may be a slice partway into the file
+    *payload_offset = payload.base_offset() + offset - body_start;
+    return body_end - offset;
+}
+
 //----------------------------------------------------------------------
 bool
 StreamConvergenceLayer::Connection::finish_bundle(InFlightBundle* inflight)
@@ -783,13 +1095,13 @@ StreamConvergenceLayer::Connection::send_keepalive()
     // there's already data waiting to go out, since the arrival of
     // that data on the other end will do the same job as the
     // keepalive byte
-    if (sendbuf_.fullbytes() != 0) {
+    if (send_buffered() != 0) {
         log_debug("send_keepalive: "
                   "send buffer has %zu bytes queued, suppressing keepalive",
-                  sendbuf_.fullbytes());
+                  send_buffered());
         return;
     }
-    ASSERT(sendbuf_.tailbytes() > 0);
+    ASSERT(send_space() > 0);
 
     // similarly, we must not send a keepalive if send_segment_todo_ is
     // nonzero, because that would likely insert the keepalive in the middle
@@ -798,8 +1110,8 @@ StreamConvergenceLayer::Connection::send_keepalive()
 
     ::gettimeofday(&keepalive_sent_, 0);
 
-    *(sendbuf_.end()) = KEEPALIVE;
-    sendbuf_.fill(1);
+    u_char keepalive = KEEPALIVE;
+    send_append(&keepalive, 1);
 
     // don't note_data_sent() here since keepalive messages shouldn't
     // be counted for keeping an idle link open
@@ -988,9 +1300,6 @@ StreamConvergenceLayer::Connection::process_data()
         return;
     }
 
-    log_debug("processing up to %zu bytes from receive buffer",
-              recvbuf_.fullbytes());
-
     // all data (keepalives included) should be noted since the last
     // reception time is used to determine when to generate new
     // keepalives
@@ -1027,8 +1336,6 @@ StreamConvergenceLayer::Connection::process_data()
         u_int8_t type  = *recvbuf_.start() & 0xf0;
         u_int8_t flags = *recvbuf_.start() & 0x0f;
 
-        log_debug("recvbuf has %zu full bytes, dispatching to handler routine",
-                  recvbuf_.fullbytes());
         bool ok;
         switch (type) {
         case DATA_SEGMENT:
@@ -1079,7 +1386,6 @@ StreamConvergenceLayer::Connection::process_data()
 void
 StreamConvergenceLayer::Connection::note_data_rcvd()
 {
-    log_debug("noting data_rcvd");
     ::gettimeofday(&data_rcvd_, 0);
 }
 
@@ -1087,7 +1393,6 @@ StreamConvergenceLayer::Connection::note_data_rcvd()
 void
 StreamConvergenceLayer::Connection::note_data_sent()
 {
-    log_debug("noting data_sent");
     ::gettimeofday(&data_sent_, 0);
 }
 
@@ -1162,17 +1467,10 @@ StreamConvergenceLayer::Connection::handle_data_segment(u_int8_t flags)
     }
 
     size_t segment_offset = incoming->rcvd_data_.num_contiguous();
-    log_debug("handle_data_segment: "
-              "got segment of length %u at offset %zu ",
-              segment_len, segment_offset);
+    DTN_SEGMENT_TRACE(SEGMENT_RECV, flags, segment_offset, segment_len);
     
     incoming->ack_data_.set(segment_offset + segment_len - 1);
 
-    log_debug("handle_data_segment: "
-              "updated ack_data (segment_offset %zu) *%p ack_data *%p",
-              segment_offset, &incoming->rcvd_data_, &incoming->ack_data_);
-
-
     // if this is the last segment for the bundle, we calculate and
     // store the total length in the IncomingBundle structure so
     // send_pending_acks knows when we're done.
@@ -1210,9 +1508,7 @@ StreamConvergenceLayer::Connection::handle_data_todo()
         return false; // nothing to do
     }
     
-    log_debug("handle_data_todo: "
-              "reading todo segment %zu/%zu at offset %zu",
-              chunk_len, recv_segment_todo_, rcvd_offset);
+    DTN_SEGMENT_TRACE(DATA_RECV, recv_segment_todo_, rcvd_offset, chunk_len);
 
     bool last;
     int cc = BundleProtocol::consume(incoming->bundle_.object(),
@@ -1231,10 +1527,6 @@ StreamConvergenceLayer::Connection::handle_data_todo()
 
     incoming->rcvd_data_.set(rcvd_offset, chunk_len);
     
-    log_debug("handle_data_todo: "
-              "updated recv_data (rcvd_offset %zu) *%p ack_data *%p",
-              rcvd_offset, &incoming->rcvd_data_, &incoming->ack_data_);
-    
     if (recv_segment_todo_ == 0) {
         check_completed(incoming);
         return true; // completed segment
@@ -1339,6 +1631,8 @@ StreamConvergenceLayer::Connection::handle_ack_segment(u_int8_t flags)
     }
     
     inflight->ack_data_.set(0, acked_len);
+    DTN_SEGMENT_TRACE(ACK_RECV, inflight->bundle_->bundleid(),
+                      acked_len, acked_len - ack_begin);
 
     // now check if this was the last ack for the bundle, in which
     // case we can pop it off the list and post a
@@ -1361,10 +1655,6 @@ StreamConvergenceLayer::Connection::handle_ack_segment(u_int8_t flags)
         // might delete inflight
         check_completed(inflight);
         
-    } else {
-        log_debug("handle_ack_segment: "
-                  "got acked_len %u (%zu byte range) -- ack_data *%p",
-                  acked_len, (size_t)acked_len - ack_begin, &inflight->ack_data_);
     }
 
     return true;
@@ -1456,7 +1746,7 @@ StreamConvergenceLayer::Connection::break_contact(ContactEvent::reason_t reason)
     // we don't have any way of continuing to transmit our own blocks
     // and then shut down afterwards
     if (send_shutdown && 
-        sendbuf_.fullbytes() == 0 &&
+        send_buffered() == 0 &&
         send_segment_todo_ == 0)
     {
         log_debug("break_contact: sending shutdown");
@@ -1467,12 +1757,11 @@ StreamConvergenceLayer::Connection::break_contact(ContactEvent::reason_t reason)
 
         // XXX/demmer should we send a reconnect delay??
 
-        *sendbuf_.end() = typecode;
-        sendbuf_.fill(1);
+        send_append(&typecode, 1);
 
         if (shutdown_reason != SHUTDOWN_NO_REASON) {
-            *sendbuf_.end() = shutdown_reason;
-            sendbuf_.fill(1);
+            u_char reason = shutdown_reason;
+            send_append(&reason, 1);
         }
 
         send_data();
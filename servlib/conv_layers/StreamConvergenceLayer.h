@@ -19,6 +19,7 @@
 
 #include "ConnectionConvergenceLayer.h"
 #include "CLConnection.h"
+#include "SendRing.h"
 
 namespace dtn {
 
@@ -75,6 +76,13 @@ namespace dtn {
  * ack_data_ bitmap. We also separately record the total range of acks
  * that have been previously sent in acked_length_. As we send acks
  * out, we clear away the bits in ack_data_
+ *
+ * With the ring_buffer link option (for CLs that support it), the
+ * outgoing data is queued in a fixed-size SendRing instead of the
+ * linear send buffer. In that mode, send_pending_data keeps filling
+ * the ring with segments (up to pipeline_depth of them) before
+ * draining it with a single vectored write, rather than bouncing
+ * back to poll() after every segment.
  */
 class StreamConvergenceLayer : public ConnectionConvergenceLayer {
 public:
@@ -175,6 +183,22 @@ protected:
         bool  negative_ack_enabled_;	///< Enable negative acks
         u_int keepalive_interval_;	///< Seconds between keepalive packets
         u_int segment_length_;		///< Maximum size of transmitted segments
+        bool  zero_copy_;		///< Send disk payloads straight from
+                                        ///< the payload file
+        bool  ring_buffer_;		///< Queue outgoing data in a ring
+        u_int pipeline_depth_;		///< Max segments queued in the ring
+
+        /// Payload bytes sent from the payload file without passing
+        /// through the send buffer (statistic, not a parameter)
+        u_int64_t zero_copy_bytes_;
+
+        /// @{ Send ring occupancy as of the last write, and the
+        /// peaks since the link was created (statistics)
+        size_t ring_bytes_;
+        size_t ring_segments_;
+        size_t ring_peak_bytes_;
+        size_t ring_peak_segments_;
+        /// @}
 
     protected:
         // See comment in LinkParams for why this should be protected
@@ -200,6 +224,11 @@ protected:
                    StreamLinkParams* params,
                    bool active_connector);
 
+        /**
+         * Destructor.
+         */
+        virtual ~Connection();
+
         /// @{ virtual from CLConnection
         bool send_pending_data();
         void handle_bundles_queued();
@@ -215,20 +244,61 @@ protected:
          */
         virtual void send_data() = 0;
 
+        /**
+         * Hook used by the zero_copy option to write payload data
+         * directly from a file to the connection, after the send
+         * buffer has been drained.
+         *
+         * @return the number of bytes written, zero if the write
+         * would block or the contact was broken, or -1 if the derived
+         * class can't send from a file (the default)
+         */
+        virtual int send_file_data(int fd, off_t offset, size_t len);
+
         /// @{ utility functions used by derived classes
         void initiate_contact();
         void process_data();
         void check_keepalive();
         /// @}
 
+        /// @{ send buffer functions that work in both the linear and
+        /// the ring buffer modes, for derived classes' send_data()
+
+        /// Bytes queued to be written to the connection
+        size_t send_buffered()
+        {
+            return sendbuf_.fullbytes() +
+                (send_ring_ == NULL ? 0 : send_ring_->fullbytes());
+        }
+
+        /**
+         * Fill in the iovecs (three at most) covering up to max_len
+         * queued bytes, oldest first.
+         *
+         * @return the number of iovecs used
+         */
+        int fill_send_iov(struct iovec* iov, size_t max_len);
+
+        /**
+         * Discard the given number of bytes once they are written.
+         */
+        void consume_sent(size_t len);
+        /// @}
+
     private:
         /// @{ utility functions used internally in this class
         void note_data_rcvd();
         void note_data_sent();
+        size_t send_space();
+        void send_append(const void* data, size_t len);
+        void flush_send_ring();
+        void note_ring_stats();
         bool send_pending_acks();
         bool start_next_bundle();
         bool send_next_segment(InFlightBundle* inflight);
         bool send_data_todo(InFlightBundle* inflight);
+        size_t zero_copy_span(InFlightBundle* inflight, size_t offset,
+                              size_t* payload_offset);
         bool finish_bundle(InFlightBundle* inflight);
         void check_completed(InFlightBundle* inflight);
         void send_keepalive();
@@ -265,6 +335,9 @@ protected:
                                         ///< break_contact 
         bool contact_initiated_; //< bit to prevent certain actions before
     	                             //< contact is initiated
+        bool zero_copy_failed_;	///< send_file_data is unsupported
+        SendRing* send_ring_;		///< Ring for outgoing data, or NULL
+                                        ///< to use the linear sendbuf_
     };
 
     /// For some gcc variants, this typedef seems to be needed
@@ -273,6 +346,12 @@ protected:
     /// @{ Virtual from ConvergenceLayer
     void dump_link(const LinkRef& link, oasys::StringBuffer* buf);
     /// @}
+
+    /**
+     * Whether the derived CL's send_data() can drain the send ring
+     * (i.e. uses fill_send_iov and consume_sent).
+     */
+    virtual bool ring_buffer_supported() const { return false; }
     
     /// @{ Virtual from ConnectionConvergenceLayer
     bool parse_link_params(LinkParams* params,
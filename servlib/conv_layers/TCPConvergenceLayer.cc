@@ -19,7 +19,11 @@
 #endif
 
 #include <sys/poll.h>
+#include <sys/uio.h>
 #include <stdlib.h>
+#ifdef __linux__
+#include <sys/sendfile.h>
+#endif
 
 #include <oasys/io/NetUtils.h>
 #include <oasys/util/OptParser.h>
@@ -318,7 +322,7 @@ TCPConvergenceLayer::Listener::accepted(int fd, in_addr_t addr, u_int16_t port)
     Connection* conn =
         new Connection(cl_, &TCPConvergenceLayer::default_link_params_,
                        fd, addr, port);
-    conn->start();
+    conn->start_service();
 }
 
 //----------------------------------------------------------------------
@@ -544,7 +548,11 @@ TCPConvergenceLayer::Connection::handle_poll_activity()
             return;
         }
         
-        send_data();
+        // zero copy sends go straight to the socket, so there may
+        // be nothing in the buffer to drain
+        if (send_buffered() != 0) {
+            send_data();
+        }
     }
     
     //check that the connection was not broken during the data send
@@ -581,28 +589,47 @@ TCPConvergenceLayer::Connection::send_data()
     // socket
     ASSERT(! contact_broken_);
 
-    u_int towrite = sendbuf_.fullbytes();
+    size_t towrite = send_buffered();
     if (params_->test_write_limit_ != 0) {
-        towrite = std::min(towrite, params_->test_write_limit_);
+        towrite = std::min(towrite, (size_t)params_->test_write_limit_);
     }
     
-    log_debug("send_data: trying to drain %u bytes from send buffer...",
+    log_debug("send_data: trying to drain %zu bytes from send buffer...",
               towrite);
     ASSERT(towrite > 0);
 
-    int cc = sock_->write(sendbuf_.start(), towrite);
+    // with the ring buffer, the queued data may be split across
+    // several regions, which go out in a single writev
+    struct iovec iov[3];
+    int iovcnt = fill_send_iov(iov, towrite);
+    int cc;
+    if (iovcnt == 1) {
+        cc = sock_->write((char*)iov[0].iov_base, iov[0].iov_len);
+    } else {
+        // the socket's write() retries on EINTR itself, but a raw
+        // writev has to do so here
+        do {
+            cc = ::writev(sock_->fd(), iov, iovcnt);
+        } while (cc < 0 && errno == EINTR);
+    }
+    
     if (cc > 0) {
         log_debug("send_data: wrote %d/%zu bytes from send buffer",
-                  cc, sendbuf_.fullbytes());
+                  cc, send_buffered());
         if (tcp_lparams()->hexdump_) {
             oasys::HexDumpBuffer hex;
-            hex.append((u_char*)sendbuf_.start(), cc);
+            size_t left = cc;
+            for (int i = 0; i < iovcnt && left != 0; ++i) {
+                size_t len = std::min(left, iov[i].iov_len);
+                hex.append((u_char*)iov[i].iov_base, len);
+                left -= len;
+            }
             log_multiline(oasys::LOG_ALWAYS, hex.hexify().c_str());
         }
         
-        sendbuf_.consume(cc);
+        consume_sent(cc);
         
-        if (sendbuf_.fullbytes() != 0) {
+        if (send_buffered() != 0) {
             log_debug("send_data: incomplete write, setting POLLOUT bit");
             sock_pollfd_->events |= POLLOUT;
 
@@ -623,6 +650,48 @@ TCPConvergenceLayer::Connection::send_data()
     }
 }
 
+//----------------------------------------------------------------------
+int
+TCPConvergenceLayer::Connection::send_file_data(int fd, off_t offset,
+                                                size_t len)
+{
+#ifdef __linux__
+    ASSERT(! contact_broken_);
+    ASSERT(send_buffered() == 0);
+
+    if (params_->test_write_limit_ != 0) {
+        len = std::min(len, (size_t)params_->test_write_limit_);
+    }
+
+    ssize_t cc = ::sendfile(sock_->fd(), fd, &offset, len);
+    if (cc > 0) {
+        log_debug("send_file_data: wrote %zd/%zu bytes from payload file",
+                  cc, len);
+        if (sock_pollfd_->events & POLLOUT) {
+            sock_pollfd_->events &= ~POLLOUT;
+        }
+        return cc;
+
+    } else if (cc < 0 && errno == EWOULDBLOCK) {
+        log_debug("send_file_data: sendfile returned EWOULDBLOCK, "
+                  "setting POLLOUT bit");
+        sock_pollfd_->events |= POLLOUT;
+        return 0;
+
+    } else if (cc < 0 && (errno == EINVAL || errno == ENOSYS)) {
+        // the file or socket doesn't support sendfile
+        return -1;
+    }
+
+    log_info("send_file_data: remote connection unexpectedly closed: %s",
+             cc == 0 ? "short sendfile" : strerror(errno));
+    break_contact(ContactEvent::BROKEN);
+    return 0;
+#else
+    return StreamConvergenceLayer::Connection::send_file_data(fd, offset, len);
+#endif
+}
+
 //----------------------------------------------------------------------
 void
 TCPConvergenceLayer::Connection::recv_data()
@@ -99,6 +99,10 @@ protected:
                                          LinkParams* params);
     /// @}
 
+    /// @{ Virtual from StreamConvergenceLayer
+    bool ring_buffer_supported() const { return true; }
+    /// @}
+
     /**
      * Helper class (and thread) that listens on a registered
      * interface for new connections.
@@ -157,6 +161,7 @@ protected:
 
         /// @{ virtual from StreamConvergenceLayer::Connection
         void send_data();
+        int send_file_data(int fd, off_t offset, size_t len);
         /// @}
         
         /// Hook for handle_poll_activity to receive data
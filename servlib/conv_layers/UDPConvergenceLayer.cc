@@ -19,6 +19,8 @@
 #endif
 
 #include <sys/poll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
 
 #include <oasys/io/NetUtils.h>
 #include <oasys/thread/Timer.h>
@@ -46,6 +48,7 @@ UDPConvergenceLayer::Params::serialize(oasys::SerializeAction *a)
     a->process("remote_port", &remote_port_);
     a->process("rate", &rate_);
     a->process("bucket_depth", &bucket_depth_);
+    a->process("batch_size", &batch_size_);
 }
 
 //----------------------------------------------------------------------
@@ -58,6 +61,7 @@ UDPConvergenceLayer::UDPConvergenceLayer()
     defaults_.remote_port_              = 0;
     defaults_.rate_                     = 0; // unlimited
     defaults_.bucket_depth_             = 0; // default
+    defaults_.batch_size_               = 1; // one datagram per syscall
 }
 
 //----------------------------------------------------------------------
@@ -89,11 +93,16 @@ UDPConvergenceLayer::parse_params(Params* params,
     p.addopt(new oasys::UInt16Opt("remote_port", &params->remote_port_));
     p.addopt(new oasys::UIntOpt("rate", &params->rate_));
     p.addopt(new oasys::UIntOpt("bucket_depth_", &params->bucket_depth_));
+    p.addopt(new oasys::UIntOpt("batch_size", &params->batch_size_));
 
     if (! p.parse(argc, argv, invalidp)) {
         return false;
     }
 
+    if (params->batch_size_ == 0) {
+        params->batch_size_ = 1;
+    }
+
     return true;
 };
 
@@ -186,6 +195,8 @@ UDPConvergenceLayer::dump_interface(Interface* iface,
     } else {
         buf->appendf("\tnot connected\n");
     }
+
+    buf->appendf("\tbatch_size: %u\n", params->batch_size_);
 }
 
 //----------------------------------------------------------------------
@@ -263,6 +274,7 @@ UDPConvergenceLayer::dump_link(const LinkRef& link, oasys::StringBuffer* buf)
                  intoa(params->remote_addr_), params->remote_port_);
     buf->appendf("rate: %u\n", params->rate_);
     buf->appendf("bucket_depth: %u\n", params->bucket_depth_);
+    buf->appendf("batch_size: %u\n", params->batch_size_);
 }
 
 //----------------------------------------------------------------------
@@ -353,6 +365,11 @@ UDPConvergenceLayer::bundle_queued(const LinkRef& link, const BundleRef& bundle)
     }
     ASSERT(contact == sender->contact_);
 
+    if (sender->params_->batch_size_ > 1) {
+        sender->schedule_flush(link);
+        return;
+    }
+
     int len = sender->send_bundle(bundle);
 
     if (len > 0) {
@@ -374,8 +391,8 @@ UDPConvergenceLayer::Receiver::Receiver(UDPConvergenceLayer::Params* params)
 }
 
 //----------------------------------------------------------------------
-void
-UDPConvergenceLayer::Receiver::process_data(u_char* bp, size_t len)
+BundleReceivedEvent*
+UDPConvergenceLayer::Receiver::consume_bundle(u_char* bp, size_t len)
 {
     // the payload should contain a full bundle
     Bundle* bundle = new Bundle();
@@ -386,20 +403,75 @@ UDPConvergenceLayer::Receiver::process_data(u_char* bp, size_t len)
     if (cc < 0) {
         log_err("process_data: bundle protocol error");
         delete bundle;
-        return;
+        return NULL;
     }
 
     if (!complete) {
         log_err("process_data: incomplete bundle");
         delete bundle;
-        return;
+        return NULL;
     }
     
     log_debug("process_data: new bundle id %d arrival, length %zu (payload %zu)",
               bundle->bundleid(), len, bundle->payload().length());
     
-    BundleDaemon::post(
-        new BundleReceivedEvent(bundle, EVENTSRC_PEER, len, EndpointID::NULL_EID()));
+    return new BundleReceivedEvent(bundle, EVENTSRC_PEER, len,
+                                   EndpointID::NULL_EID());
+}
+
+//----------------------------------------------------------------------
+void
+UDPConvergenceLayer::Receiver::process_data(u_char* bp, size_t len)
+{
+    BundleReceivedEvent* event = consume_bundle(bp, len);
+    if (event != NULL) {
+        BundleDaemon::post(event);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+UDPConvergenceLayer::Receiver::run_batched()
+{
+    DatagramRing ring(params_.batch_size_);
+
+    while (1) {
+        if (should_stop())
+            break;
+
+        int n = ring.recv(fd());
+        if (n <= 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            log_err("error in recvmmsg(): %d %s",
+                    errno, strerror(errno));
+            close();
+            break;
+        }
+
+        log_debug("got batch of %d packets", n);
+
+        BundleReceivedBatchEvent* batch = new BundleReceivedBatchEvent();
+        for (int i = 0; i < n; ++i) {
+            BundleReceivedEvent* event = consume_bundle(ring.buf(i),
+                                                        ring.len(i));
+            if (event != NULL) {
+                batch->events_.push_back(event);
+            }
+        }
+
+        // no need for the batch wrapper for a lone bundle
+        if (batch->events_.size() == 1) {
+            BundleDaemon::post(batch->events_[0]);
+            batch->events_.clear();
+            delete batch;
+        } else if (batch->events_.empty()) {
+            delete batch;
+        } else {
+            BundleDaemon::post(batch);
+        }
+    }
 }
 
 //----------------------------------------------------------------------
@@ -411,6 +483,11 @@ UDPConvergenceLayer::Receiver::run()
     u_int16_t port;
     u_char buf[MAX_UDP_PACKET];
 
+    if (params_.batch_size_ > 1) {
+        run_batched();
+        return;
+    }
+
     while (1) {
         if (should_stop())
             break;
@@ -438,8 +515,21 @@ UDPConvergenceLayer::Sender::Sender(const ContactRef& contact)
              "/dtn/cl/udp/sender/%p", this),
       socket_(logpath_),
       rate_socket_(logpath_, 0, 0),
-      contact_(contact.object(), "UDPCovergenceLayer::Sender")
+      contact_(contact.object(), "UDPCovergenceLayer::Sender"),
+      ring_(NULL),
+      flush_timer_(NULL)
+{
+}
+
+//----------------------------------------------------------------------
+UDPConvergenceLayer::Sender::~Sender()
 {
+    // the contact is closed from the daemon thread, which is also
+    // where the timer fires, so it can't be running right now
+    if (flush_timer_ != NULL) {
+        flush_timer_->cancel();
+    }
+    delete ring_;
 }
 
 //----------------------------------------------------------------------
@@ -483,6 +573,10 @@ UDPConvergenceLayer::Sender::init(Params* params,
                   U64FMT(rate_socket_.bucket()->depth()));
     }
 
+    if (params->batch_size_ > 1) {
+        ring_ = new DatagramRing(params->batch_size_);
+    }
+
     return true;
 }
     
@@ -516,4 +610,214 @@ UDPConvergenceLayer::Sender::send_bundle(const BundleRef& bundle)
     }
 }
 
+//----------------------------------------------------------------------
+void
+UDPConvergenceLayer::Sender::schedule_flush(const LinkRef& link)
+{
+    oasys::ScopeLock l(&lock_, "UDPConvergenceLayer::Sender::schedule_flush");
+
+    if (link->queue()->size() >= ring_->count()) {
+        // the timer (if any) is left to find an empty queue
+        send_batch(link);
+        return;
+    }
+
+    if (flush_timer_ == NULL) {
+        flush_timer_ = new FlushTimer(this, link);
+        flush_timer_->schedule_in(0);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+UDPConvergenceLayer::Sender::FlushTimer::timeout(const struct timeval& now)
+{
+    (void)now;
+    {
+        oasys::ScopeLock l(&sender_->lock_,
+                           "UDPConvergenceLayer::Sender::FlushTimer");
+        ASSERT(sender_->flush_timer_ == this);
+        sender_->flush_timer_ = NULL;
+        sender_->send_batch(link_);
+    }
+    delete this;
+}
+
+//----------------------------------------------------------------------
+void
+UDPConvergenceLayer::Sender::send_batch(const LinkRef& link)
+{
+    ASSERT(ring_ != NULL);
+    ASSERT(lock_.is_locked_by_me());
+    
+    std::vector<Bundle*> bundles;
+
+    // format the bundles on the queue into the ring a batch at a
+    // time, holding the queue lock so they stay on the queue (and
+    // hence referenced) until they've been sent. sent bundles are
+    // erased from the queue, which leaves the iterator valid.
+    oasys::ScopeLock l(link->queue()->lock(),
+                       "UDPConvergenceLayer::Sender::send_batch");
+
+    BundleList::iterator iter = link->queue()->begin();
+    while (iter != link->queue()->end()) {
+        bundles.clear();
+        for (; iter != link->queue()->end() &&
+                 bundles.size() < ring_->count(); ++iter)
+        {
+            Bundle* bundle = *iter;
+            BlockInfoVec* blocks = bundle->xmit_blocks()->find_blocks(link);
+            ASSERT(blocks != NULL);
+
+            bool complete = false;
+            size_t len = BundleProtocol::produce(bundle, blocks,
+                                                 ring_->buf(bundles.size()),
+                                                 0, MAX_BUNDLE_LEN, &complete);
+            if (!complete) {
+                log_err("send_batch: bundle too big (%zu > %u)",
+                        BundleProtocol::total_length(blocks),
+                        UDPConvergenceLayer::MAX_BUNDLE_LEN);
+                continue;
+            }
+
+            ring_->set_len(bundles.size(), len);
+            bundles.push_back(bundle);
+        }
+
+        if (bundles.empty()) {
+            return;
+        }
+
+        int sent = ring_->send(socket_.fd(), bundles.size());
+        if (sent < 0) {
+            log_err("send_batch: error sending %zu bundles: %s",
+                    bundles.size(), strerror(errno));
+            return;
+        }
+
+        log_debug("send_batch: sent %d/%zu bundles", sent, bundles.size());
+    
+        for (int i = 0; i < sent; ++i) {
+            BundleRef bundle(bundles[i],
+                             "UDPConvergenceLayer::Sender::send_batch");
+            size_t len = ring_->len(i);
+            link->del_from_queue(bundle, len);
+            link->add_to_inflight(bundle, len);
+            BundleDaemon::post(
+                new BundleTransmittedEvent(bundle.object(), contact_,
+                                           link, len, 0));
+        }
+
+        if (sent < (int)bundles.size()) {
+            log_err("send_batch: error sending %zu bundles: %s",
+                    bundles.size() - sent, strerror(errno));
+            return;
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+UDPConvergenceLayer::DatagramRing::DatagramRing(size_t count)
+    : count_(count),
+      bufs_(count * MAX_BUNDLE_LEN),
+      lens_(count, 0),
+      msgs_(NULL),
+      iovs_(NULL)
+{
+#ifdef __linux__
+    struct mmsghdr* msgs = new struct mmsghdr[count_];
+    struct iovec*   iovs = new struct iovec[count_];
+    memset(msgs, 0, count_ * sizeof(struct mmsghdr));
+    
+    for (size_t i = 0; i < count_; ++i) {
+        iovs[i].iov_base = buf(i);
+        iovs[i].iov_len  = MAX_BUNDLE_LEN;
+        msgs[i].msg_hdr.msg_iov    = &iovs[i];
+        msgs[i].msg_hdr.msg_iovlen = 1;
+    }
+    
+    msgs_ = msgs;
+    iovs_ = iovs;
+#endif
+}
+
+//----------------------------------------------------------------------
+UDPConvergenceLayer::DatagramRing::~DatagramRing()
+{
+#ifdef __linux__
+    delete[] (struct mmsghdr*)msgs_;
+    delete[] (struct iovec*)iovs_;
+#endif
+}
+
+//----------------------------------------------------------------------
+int
+UDPConvergenceLayer::DatagramRing::recv(int fd)
+{
+#ifdef __linux__
+    struct mmsghdr* msgs = (struct mmsghdr*)msgs_;
+    struct iovec*   iovs = (struct iovec*)iovs_;
+    for (size_t i = 0; i < count_; ++i) {
+        iovs[i].iov_len = MAX_BUNDLE_LEN;
+    }
+    
+    int n = ::recvmmsg(fd, msgs, count_, MSG_WAITFORONE, NULL);
+    for (int i = 0; i < n; ++i) {
+        lens_[i] = msgs[i].msg_len;
+    }
+    return n;
+#else
+    // block for the first datagram, then take whatever else is
+    // already queued
+    size_t n = 0;
+    while (n < count_) {
+        int cc = ::recv(fd, buf(n), MAX_BUNDLE_LEN, n == 0 ? 0 : MSG_DONTWAIT);
+        if (cc < 0) {
+            if (n != 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) {
+                break;
+            }
+            return n == 0 ? -1 : (int)n;
+        }
+        lens_[n++] = cc;
+    }
+    return n;
+#endif
+}
+
+//----------------------------------------------------------------------
+int
+UDPConvergenceLayer::DatagramRing::send(int fd, size_t n)
+{
+    ASSERT(n <= count_);
+    
+#ifdef __linux__
+    struct mmsghdr* msgs = (struct mmsghdr*)msgs_;
+    struct iovec*   iovs = (struct iovec*)iovs_;
+    for (size_t i = 0; i < n; ++i) {
+        iovs[i].iov_len = lens_[i];
+    }
+
+    size_t sent = 0;
+    while (sent < n) {
+        int cc = ::sendmmsg(fd, msgs + sent, n - sent, 0);
+        if (cc < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return sent == 0 ? -1 : (int)sent;
+        }
+        sent += cc;
+    }
+    return sent;
+#else
+    for (size_t i = 0; i < n; ++i) {
+        int cc = ::send(fd, buf(i), lens_[i], 0);
+        if (cc != (int)lens_[i]) {
+            return i == 0 ? -1 : (int)i;
+        }
+    }
+    return n;
+#endif
+}
+
 } // namespace dtn
@@ -17,14 +17,19 @@
 #ifndef _UDP_CONVERGENCE_LAYER_H_
 #define _UDP_CONVERGENCE_LAYER_H_
 
+#include <vector>
 #include <oasys/io/UDPClient.h>
+#include <oasys/thread/SpinLock.h>
 #include <oasys/thread/Thread.h>
+#include <oasys/thread/Timer.h>
 #include <oasys/io/RateLimitedSocket.h>
 
 #include "IPConvergenceLayer.h"
 
 namespace dtn {
 
+class BundleReceivedEvent;
+
 class UDPConvergenceLayer : public IPConvergenceLayer {
 public:
     /**
@@ -117,6 +122,8 @@ public:
 
         u_int32_t rate_;		///< Rate (in bps)
         u_int32_t bucket_depth_;	///< Token bucket depth (in bits)
+        u_int32_t batch_size_;		///< Datagrams per batched recv/send
+                                        ///< (1 for one syscall per datagram)
     };
     
     /**
@@ -124,6 +131,53 @@ public:
      */
     static Params defaults_;
 
+    /**
+     * Ring of preallocated datagram buffers used by the batched
+     * datapath. On Linux a batch is read or written with a single
+     * recvmmsg / sendmmsg call, elsewhere it falls back to a loop of
+     * per-datagram calls.
+     */
+    class DatagramRing {
+    public:
+        DatagramRing(size_t count);
+        ~DatagramRing();
+
+        /// Number of buffers in the ring
+        size_t count() const { return count_; }
+
+        /// The i'th buffer (each MAX_BUNDLE_LEN bytes)
+        u_char* buf(size_t i) { return &bufs_[i * MAX_BUNDLE_LEN]; }
+
+        /// Length of the datagram in the i'th buffer
+        size_t len(size_t i) const { return lens_[i]; }
+
+        /// Set the length of the datagram to send from the i'th buffer
+        void set_len(size_t i, size_t len) { lens_[i] = len; }
+
+        /**
+         * Receive up to count() datagrams, blocking until at least
+         * one has arrived.
+         *
+         * @return the number of datagrams received or -1 on error
+         */
+        int recv(int fd);
+
+        /**
+         * Send the first n buffers as individual datagrams on a
+         * connected socket.
+         *
+         * @return the number of datagrams sent or -1 on error
+         */
+        int send(int fd, size_t n);
+
+    private:
+        size_t count_;
+        std::vector<u_char> bufs_;
+        std::vector<size_t> lens_;
+        void* msgs_;	///< struct mmsghdr array (where supported)
+        void* iovs_;	///< struct iovec array (where supported)
+    };
+
 protected:
     bool parse_params(Params* params, int argc, const char** argv,
                       const char** invalidp);
@@ -165,6 +219,18 @@ protected:
          * Handler to process an arrived packet.
          */
         void process_data(u_char* bp, size_t len);
+
+        /**
+         * Parse a bundle out of an arrived packet.
+         * @return the arrival event for the bundle, or NULL on error
+         */
+        BundleReceivedEvent* consume_bundle(u_char* bp, size_t len);
+
+        /**
+         * Main loop used when batch_size_ is greater than one, which
+         * posts each batch of arrivals to the daemon as one event.
+         */
+        void run_batched();
     };
 
     /*
@@ -175,7 +241,7 @@ protected:
         /**
          * Destructor.
          */
-        virtual ~Sender() {}
+        virtual ~Sender();
 
         /**
          * Initialize the sender (the "real" constructor).
@@ -196,6 +262,39 @@ protected:
          */
         int send_bundle(const BundleRef& bundle);
 
+        /**
+         * Called for each bundle queued on the link when batching.
+         * Sends right away if a full batch is waiting, otherwise
+         * defers the send until the daemon is done with the current
+         * event so the bundles it queues go out together.
+         */
+        void schedule_flush(const LinkRef& link);
+
+        /**
+         * Drain the link queue, sending up to batch_size_ bundles
+         * per sendmmsg call and posting a transmitted event for
+         * each. Must be called with lock_ held.
+         */
+        void send_batch(const LinkRef& link);
+
+        /**
+         * Zero-delay timer used for the deferred send, which fires
+         * from the daemon's timer loop once the current event has
+         * been handled.
+         */
+        class FlushTimer : public oasys::Timer {
+        public:
+            FlushTimer(Sender* sender, const LinkRef& link)
+                : sender_(sender), link_(link) {}
+            
+            void timeout(const struct timeval& now);
+
+        protected:
+            Sender* sender_;
+            LinkRef link_;
+        };
+        friend class FlushTimer;
+
         /**
          * Pointer to the link parameters.
          */
@@ -222,6 +321,24 @@ protected:
          * be any bigger than that.
          */
         u_char buf_[UDPConvergenceLayer::MAX_BUNDLE_LEN];
+
+        /**
+         * Buffers for batched sends (only allocated if batch_size_ is
+         * greater than one).
+         */
+        DatagramRing* ring_;
+
+        /**
+         * The pending deferred send, if any.
+         */
+        FlushTimer* flush_timer_;
+
+        /**
+         * Lock protecting ring_ and flush_timer_, since bundles may
+         * be queued from the event shard threads while the flush
+         * timer fires on the daemon thread.
+         */
+        oasys::SpinLock lock_;
     };   
 };
 
@@ -0,0 +1,3767 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Generated by tools/xsd-tlv.py from clevent.xsd, do not edit. Regenerate with
+// "make tlvbindings" in servlib after the xsd bindings change.
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#if defined(XERCES_C_ENABLED) && defined(EXTERNAL_CL_ENABLED)
+
+#include "clevent-tlv.h"
+
+namespace dtn {
+namespace clmessage {
+
+static void encode(const attribute_name& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, attribute_name* x);
+static void encode(const key_value_pair& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, key_value_pair* x);
+static void encode(const bundle_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_attributes* x);
+static void encode(const link_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_attributes* x);
+static void encode(const link_config_parameters& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_config_parameters* x);
+static void encode(const contact_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, contact_attributes* x);
+static void encode(const cla_add_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cla_add_request* x);
+static void encode(const cla_delete_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cla_delete_request* x);
+static void encode(const cla_set_params_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cla_set_params_request* x);
+static void encode(const cla_params_set_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cla_params_set_event* x);
+static void encode(const interface_set_defaults_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_set_defaults_request* x);
+static void encode(const interface_create_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_create_request* x);
+static void encode(const interface_created_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_created_event* x);
+static void encode(const interface_reconfigure_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_reconfigure_request* x);
+static void encode(const interface_reconfigured_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_reconfigured_event* x);
+static void encode(const interface_destroy_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, interface_destroy_request* x);
+static void encode(const eid_reachable_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, eid_reachable_event* x);
+static void encode(const link_set_defaults_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_set_defaults_request* x);
+static void encode(const link_create_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_create_request* x);
+static void encode(const link_created_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_created_event* x);
+static void encode(const link_open_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_open_request* x);
+static void encode(const link_opened_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_opened_event* x);
+static void encode(const link_close_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_close_request* x);
+static void encode(const link_closed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_closed_event* x);
+static void encode(const link_state_changed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_state_changed_event* x);
+static void encode(const link_reconfigure_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_reconfigure_request* x);
+static void encode(const link_delete_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_delete_request* x);
+static void encode(const link_deleted_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_deleted_event* x);
+static void encode(const link_attribute_changed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_attribute_changed_event* x);
+static void encode(const contact_attribute_changed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, contact_attribute_changed_event* x);
+static void encode(const link_add_reachable_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_add_reachable_event* x);
+static void encode(const bundle_send_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_send_request* x);
+static void encode(const bundle_receive_started_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_receive_started_event* x);
+static void encode(const bundle_received_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_received_event* x);
+static void encode(const bundle_transmitted_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_transmitted_event* x);
+static void encode(const bundle_cancel_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_cancel_request* x);
+static void encode(const bundle_canceled_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_canceled_event* x);
+static void encode(const query_bundle_queued& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, query_bundle_queued* x);
+static void encode(const report_bundle_queued& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, report_bundle_queued* x);
+static void encode(const query_eid_reachable& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, query_eid_reachable* x);
+static void encode(const report_eid_reachable& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, report_eid_reachable* x);
+static void encode(const query_link_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, query_link_attributes* x);
+static void encode(const report_link_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, report_link_attributes* x);
+static void encode(const query_interface_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, query_interface_attributes* x);
+static void encode(const report_interface_attributes& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, report_interface_attributes* x);
+static void encode(const query_cla_parameters& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, query_cla_parameters* x);
+static void encode(const report_cla_parameters& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, report_cla_parameters* x);
+static void encode(const cl_message& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cl_message* x);
+
+//----------------------------------------------------------------------
+static void
+encode(const attribute_name& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("value", static_cast< const std::string& >(x.value()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, attribute_name* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "value") {
+                ::xml_schema::string v(text);
+                x->value(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const key_value_pair& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("name", static_cast< const std::string& >(x.name()));
+    enc->attribute("value", static_cast< const std::string& >(x.value()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, key_value_pair* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "name") {
+                ::xml_schema::string v(text);
+                x->name(v);
+                seen |= 0x1ULL;
+            } else if (name == "value") {
+                ::xml_schema::string v(text);
+                x->value(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("source_eid", static_cast< const std::string& >(x.source_eid()));
+    enc->attribute_int("timestamp_seconds", (long long)x.timestamp_seconds());
+    enc->attribute_int("timestamp_sequence", (long long)x.timestamp_sequence());
+    enc->attribute_bool("is_fragment", (bool)x.is_fragment());
+    if (x.fragment_length().present()) {
+        enc->attribute_int("fragment_length", (long long)x.fragment_length().get());
+    }
+    if (x.fragment_offset().present()) {
+        enc->attribute_int("fragment_offset", (long long)x.fragment_offset().get());
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "source_eid") {
+                ::xml_schema::string v(text);
+                x->source_eid(v);
+                seen |= 0x1ULL;
+            } else if (name == "timestamp_seconds") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->timestamp_seconds(v);
+                seen |= 0x2ULL;
+            } else if (name == "timestamp_sequence") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->timestamp_sequence(v);
+                seen |= 0x4ULL;
+            } else if (name == "is_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_fragment(v);
+                seen |= 0x8ULL;
+            } else if (name == "fragment_length") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->fragment_length(v);
+            } else if (name == "fragment_offset") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->fragment_offset(v);
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_attributes& x, RouterTLV::Encoder* enc)
+{
+    if (x.type().present()) {
+        enc->attribute("type", static_cast< const std::string& >(x.type().get()));
+    }
+    if (x.state().present()) {
+        enc->attribute("state", static_cast< const std::string& >(x.state().get()));
+    }
+    if (x.peer_eid().present()) {
+        enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid().get()));
+    }
+    if (x.is_reachable().present()) {
+        enc->attribute_bool("is_reachable", (bool)x.is_reachable().get());
+    }
+    if (x.is_usable().present()) {
+        enc->attribute_bool("is_usable", (bool)x.is_usable().get());
+    }
+    if (x.how_reliable().present()) {
+        enc->attribute_int("how_reliable", (long long)static_cast< ::xml_schema::integer >(x.how_reliable().get()));
+    }
+    if (x.how_available().present()) {
+        enc->attribute_int("how_available", (long long)static_cast< ::xml_schema::integer >(x.how_available().get()));
+    }
+    if (x.reactive_fragment().present()) {
+        enc->attribute_bool("reactive_fragment", (bool)x.reactive_fragment().get());
+    }
+    if (x.nexthop().present()) {
+        enc->attribute("nexthop", static_cast< const std::string& >(x.nexthop().get()));
+    }
+    if (x.cla_name().present()) {
+        enc->attribute("cla_name", static_cast< const std::string& >(x.cla_name().get()));
+    }
+    if (x.high_water_mark().present()) {
+        enc->attribute_int("high_water_mark", (long long)x.high_water_mark().get());
+    }
+    if (x.low_water_mark().present()) {
+        enc->attribute_int("low_water_mark", (long long)x.low_water_mark().get());
+    }
+    for (link_attributes::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_attributes* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "type") {
+                linkTypeType v((::xml_schema::string(text)));
+                (void)static_cast< linkTypeType::_xsd_linkTypeType >(v);
+                x->type(v);
+            } else if (name == "state") {
+                linkStateType v((::xml_schema::string(text)));
+                (void)static_cast< linkStateType::_xsd_linkStateType >(v);
+                x->state(v);
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+            } else if (name == "is_reachable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_reachable(v);
+            } else if (name == "is_usable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_usable(v);
+            } else if (name == "how_reliable") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->how_reliable(v);
+            } else if (name == "how_available") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->how_available(v);
+            } else if (name == "reactive_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reactive_fragment(v);
+            } else if (name == "nexthop") {
+                ::xml_schema::string v(text);
+                x->nexthop(v);
+            } else if (name == "cla_name") {
+                ::xml_schema::string v(text);
+                x->cla_name(v);
+            } else if (name == "high_water_mark") {
+                ::xml_schema::integer v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->high_water_mark(v);
+            } else if (name == "low_water_mark") {
+                ::xml_schema::integer v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->low_water_mark(v);
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_config_parameters& x, RouterTLV::Encoder* enc)
+{
+    if (x.is_usable().present()) {
+        enc->attribute_bool("is_usable", (bool)x.is_usable().get());
+    }
+    if (x.reactive_fragment().present()) {
+        enc->attribute_bool("reactive_fragment", (bool)x.reactive_fragment().get());
+    }
+    if (x.nexthop().present()) {
+        enc->attribute("nexthop", static_cast< const std::string& >(x.nexthop().get()));
+    }
+    for (link_config_parameters::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_config_parameters* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "is_usable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_usable(v);
+            } else if (name == "reactive_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reactive_fragment(v);
+            } else if (name == "nexthop") {
+                ::xml_schema::string v(text);
+                x->nexthop(v);
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const contact_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("start_time", (long long)x.start_time());
+    enc->attribute_int("duration", (long long)x.duration());
+    enc->attribute_int("bps", (long long)x.bps());
+    enc->attribute_int("latency", (long long)x.latency());
+    enc->attribute_int("packet_loss_prob", (long long)static_cast< ::xml_schema::integer >(x.packet_loss_prob()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, contact_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "start_time") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->start_time(v);
+                seen |= 0x1ULL;
+            } else if (name == "duration") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->duration(v);
+                seen |= 0x2ULL;
+            } else if (name == "bps") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bps(v);
+                seen |= 0x4ULL;
+            } else if (name == "latency") {
+                ::xml_schema::integer v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->latency(v);
+                seen |= 0x8ULL;
+            } else if (name == "packet_loss_prob") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->packet_loss_prob(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cla_add_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("name", static_cast< const std::string& >(x.name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cla_add_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "name") {
+                ::xml_schema::string v(text);
+                x->name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cla_delete_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("name", static_cast< const std::string& >(x.name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cla_delete_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "name") {
+                ::xml_schema::string v(text);
+                x->name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cla_set_params_request& x, RouterTLV::Encoder* enc)
+{
+    if (x.local_eid().present()) {
+        enc->attribute("local_eid", static_cast< const std::string& >(x.local_eid().get()));
+    }
+    if (x.create_discovered_links().present()) {
+        enc->attribute_bool("create_discovered_links", (bool)x.create_discovered_links().get());
+    }
+    if (x.bundle_pass_method().present()) {
+        enc->attribute("bundle_pass_method", static_cast< const std::string& >(x.bundle_pass_method().get()));
+    }
+    if (x.reactive_fragment_enabled().present()) {
+        enc->attribute_bool("reactive_fragment_enabled", (bool)x.reactive_fragment_enabled().get());
+    }
+    for (cla_set_params_request::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cla_set_params_request* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_eid") {
+                ::xml_schema::string v(text);
+                x->local_eid(v);
+            } else if (name == "create_discovered_links") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->create_discovered_links(v);
+            } else if (name == "bundle_pass_method") {
+                bundlePassMethodType v((::xml_schema::string(text)));
+                (void)static_cast< bundlePassMethodType::_xsd_bundlePassMethodType >(v);
+                x->bundle_pass_method(v);
+            } else if (name == "reactive_fragment_enabled") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reactive_fragment_enabled(v);
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cla_params_set_event& x, RouterTLV::Encoder* enc)
+{
+    (void)x;
+    (void)enc;
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cla_params_set_event* x)
+{
+    (void)x;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_set_defaults_request& x, RouterTLV::Encoder* enc)
+{
+    for (interface_set_defaults_request::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_set_defaults_request* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_create_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    for (interface_create_request::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_create_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_created_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_created_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_reconfigure_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    if (x.up().present()) {
+        enc->attribute_bool("up", (bool)x.up().get());
+    }
+    if (x.discovery().present()) {
+        enc->attribute_bool("discovery", (bool)x.discovery().get());
+    }
+    for (interface_reconfigure_request::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_reconfigure_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "up") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->up(v);
+            } else if (name == "discovery") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->discovery(v);
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_reconfigured_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_reconfigured_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const interface_destroy_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, interface_destroy_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const eid_reachable_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, eid_reachable_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_set_defaults_request& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("link_config_parameters");
+    encode(x.link_config_parameters(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_set_defaults_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "link_config_parameters") {
+            std::auto_ptr< link_config_parameters > c(new link_config_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_parameters(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_create_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("type", static_cast< const std::string& >(x.type()));
+    if (x.peer_eid().present()) {
+        enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid().get()));
+    }
+    enc->begin_element("link_config_parameters");
+    encode(x.link_config_parameters(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_create_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "type") {
+                linkTypeType v((::xml_schema::string(text)));
+                (void)static_cast< linkTypeType::_xsd_linkTypeType >(v);
+                x->type(v);
+                seen |= 0x4ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+            }
+            continue;
+        }
+
+        if (name == "link_config_parameters") {
+            std::auto_ptr< link_config_parameters > c(new link_config_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_parameters(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_created_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("link_attributes");
+    encode(x.link_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_created_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                linkReasonType v((::xml_schema::string(text)));
+                (void)static_cast< linkReasonType::_xsd_linkReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_attributes") {
+            std::auto_ptr< link_attributes > c(new link_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_open_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_open_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_opened_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("contact_attributes");
+    encode(x.contact_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_opened_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_attributes") {
+            std::auto_ptr< contact_attributes > c(new contact_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_close_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_close_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_closed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("contact_attributes");
+    encode(x.contact_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_closed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_attributes") {
+            std::auto_ptr< contact_attributes > c(new contact_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_state_changed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("new_state", static_cast< const std::string& >(x.new_state()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_state_changed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "new_state") {
+                linkStateType v((::xml_schema::string(text)));
+                (void)static_cast< linkStateType::_xsd_linkStateType >(v);
+                x->new_state(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                linkReasonType v((::xml_schema::string(text)));
+                (void)static_cast< linkReasonType::_xsd_linkReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_reconfigure_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("link_config_parameters");
+    encode(x.link_config_parameters(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_reconfigure_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_config_parameters") {
+            std::auto_ptr< link_config_parameters > c(new link_config_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_parameters(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_delete_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_delete_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_deleted_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_deleted_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "reason") {
+                linkReasonType v((::xml_schema::string(text)));
+                (void)static_cast< linkReasonType::_xsd_linkReasonType >(v);
+                x->reason(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_attribute_changed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("link_attributes");
+    encode(x.link_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_attribute_changed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                linkReasonType v((::xml_schema::string(text)));
+                (void)static_cast< linkReasonType::_xsd_linkReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_attributes") {
+            std::auto_ptr< link_attributes > c(new link_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const contact_attribute_changed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("contact_attributes");
+    encode(x.contact_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, contact_attribute_changed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                linkReasonType v((::xml_schema::string(text)));
+                (void)static_cast< linkReasonType::_xsd_linkReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_attributes") {
+            std::auto_ptr< contact_attributes > c(new contact_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_add_reachable_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid()));
+    enc->begin_element("link_config_parameters");
+    encode(x.link_config_parameters(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_add_reachable_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_config_parameters") {
+            std::auto_ptr< link_config_parameters > c(new link_config_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_parameters(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_send_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("location", static_cast< const std::string& >(x.location()));
+    enc->begin_element("bundle_attributes");
+    encode(x.bundle_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_send_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "location") {
+                ::xml_schema::string v(text);
+                x->location(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "bundle_attributes") {
+            std::auto_ptr< bundle_attributes > c(new bundle_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_receive_started_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("location", static_cast< const std::string& >(x.location()));
+    if (x.peer_eid().present()) {
+        enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid().get()));
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_receive_started_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "location") {
+                ::xml_schema::string v(text);
+                x->location(v);
+                seen |= 0x1ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_received_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("location", static_cast< const std::string& >(x.location()));
+    enc->attribute_int("bytes_received", (long long)x.bytes_received());
+    if (x.peer_eid().present()) {
+        enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid().get()));
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_received_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "location") {
+                ::xml_schema::string v(text);
+                x->location(v);
+                seen |= 0x1ULL;
+            } else if (name == "bytes_received") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bytes_received(v);
+                seen |= 0x2ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_transmitted_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute_int("bytes_sent", (long long)x.bytes_sent());
+    enc->attribute_int("reliably_sent", (long long)x.reliably_sent());
+    enc->begin_element("bundle_attributes");
+    encode(x.bundle_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_transmitted_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "bytes_sent") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bytes_sent(v);
+                seen |= 0x4ULL;
+            } else if (name == "reliably_sent") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reliably_sent(v);
+                seen |= 0x8ULL;
+            }
+            continue;
+        }
+
+        if (name == "bundle_attributes") {
+            std::auto_ptr< bundle_attributes > c(new bundle_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_cancel_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("bundle_attributes");
+    encode(x.bundle_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_cancel_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "bundle_attributes") {
+            std::auto_ptr< bundle_attributes > c(new bundle_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_canceled_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("bundle_attributes");
+    encode(x.bundle_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_canceled_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "bundle_attributes") {
+            std::auto_ptr< bundle_attributes > c(new bundle_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const query_bundle_queued& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->begin_element("bundle_attributes");
+    encode(x.bundle_attributes(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, query_bundle_queued* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "bundle_attributes") {
+            std::auto_ptr< bundle_attributes > c(new bundle_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const report_bundle_queued& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->attribute_bool("is_queued", (bool)x.is_queued());
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, report_bundle_queued* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "is_queued") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_queued(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const query_eid_reachable& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    enc->attribute("peer_eid", static_cast< const std::string& >(x.peer_eid()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, query_eid_reachable* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x2ULL;
+            } else if (name == "peer_eid") {
+                ::xml_schema::string v(text);
+                x->peer_eid(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const report_eid_reachable& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->attribute_bool("is_reachable", (bool)x.is_reachable());
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, report_eid_reachable* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "is_reachable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_reachable(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const query_link_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_name", static_cast< const std::string& >(x.link_name()));
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (query_link_attributes::attribute_name::const_iterator i = x.attribute_name().begin();
+         i != x.attribute_name().end(); ++i)
+    {
+        enc->begin_element("attribute_name");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, query_link_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_name") {
+                ::xml_schema::string v(text);
+                x->link_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "attribute_name") {
+            attribute_name c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->attribute_name().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const report_link_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (report_link_attributes::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, report_link_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const query_interface_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (query_interface_attributes::attribute_name::const_iterator i = x.attribute_name().begin();
+         i != x.attribute_name().end(); ++i)
+    {
+        enc->begin_element("attribute_name");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, query_interface_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x1ULL;
+            } else if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "attribute_name") {
+            attribute_name c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->attribute_name().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const report_interface_attributes& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (report_interface_attributes::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, report_interface_attributes* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const query_cla_parameters& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (query_cla_parameters::attribute_name::const_iterator i = x.attribute_name().begin();
+         i != x.attribute_name().end(); ++i)
+    {
+        enc->begin_element("attribute_name");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, query_cla_parameters* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        if (name == "attribute_name") {
+            attribute_name c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->attribute_name().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const report_cla_parameters& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("query_id", static_cast< const std::string& >(x.query_id()));
+    for (report_cla_parameters::key_value_pair::const_iterator i = x.key_value_pair().begin();
+         i != x.key_value_pair().end(); ++i)
+    {
+        enc->begin_element("key_value_pair");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, report_cla_parameters* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "query_id") {
+                ::xml_schema::string v(text);
+                x->query_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        if (name == "key_value_pair") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->key_value_pair().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cl_message& x, RouterTLV::Encoder* enc)
+{
+    if (x.cla_add_request().present()) {
+        enc->begin_element("cla_add_request");
+        encode(x.cla_add_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.cla_delete_request().present()) {
+        enc->begin_element("cla_delete_request");
+        encode(x.cla_delete_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.cla_set_params_request().present()) {
+        enc->begin_element("cla_set_params_request");
+        encode(x.cla_set_params_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.cla_params_set_event().present()) {
+        enc->begin_element("cla_params_set_event");
+        encode(x.cla_params_set_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_set_defaults_request().present()) {
+        enc->begin_element("interface_set_defaults_request");
+        encode(x.interface_set_defaults_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_create_request().present()) {
+        enc->begin_element("interface_create_request");
+        encode(x.interface_create_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_created_event().present()) {
+        enc->begin_element("interface_created_event");
+        encode(x.interface_created_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_reconfigure_request().present()) {
+        enc->begin_element("interface_reconfigure_request");
+        encode(x.interface_reconfigure_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_reconfigured_event().present()) {
+        enc->begin_element("interface_reconfigured_event");
+        encode(x.interface_reconfigured_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.interface_destroy_request().present()) {
+        enc->begin_element("interface_destroy_request");
+        encode(x.interface_destroy_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.eid_reachable_event().present()) {
+        enc->begin_element("eid_reachable_event");
+        encode(x.eid_reachable_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_set_defaults_request().present()) {
+        enc->begin_element("link_set_defaults_request");
+        encode(x.link_set_defaults_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_create_request().present()) {
+        enc->begin_element("link_create_request");
+        encode(x.link_create_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_created_event().present()) {
+        enc->begin_element("link_created_event");
+        encode(x.link_created_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_open_request().present()) {
+        enc->begin_element("link_open_request");
+        encode(x.link_open_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_opened_event().present()) {
+        enc->begin_element("link_opened_event");
+        encode(x.link_opened_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_close_request().present()) {
+        enc->begin_element("link_close_request");
+        encode(x.link_close_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_closed_event().present()) {
+        enc->begin_element("link_closed_event");
+        encode(x.link_closed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_state_changed_event().present()) {
+        enc->begin_element("link_state_changed_event");
+        encode(x.link_state_changed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_reconfigure_request().present()) {
+        enc->begin_element("link_reconfigure_request");
+        encode(x.link_reconfigure_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_delete_request().present()) {
+        enc->begin_element("link_delete_request");
+        encode(x.link_delete_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_deleted_event().present()) {
+        enc->begin_element("link_deleted_event");
+        encode(x.link_deleted_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_attribute_changed_event().present()) {
+        enc->begin_element("link_attribute_changed_event");
+        encode(x.link_attribute_changed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.contact_attribute_changed_event().present()) {
+        enc->begin_element("contact_attribute_changed_event");
+        encode(x.contact_attribute_changed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_add_reachable_event().present()) {
+        enc->begin_element("link_add_reachable_event");
+        encode(x.link_add_reachable_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_send_request().present()) {
+        enc->begin_element("bundle_send_request");
+        encode(x.bundle_send_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_receive_started_event().present()) {
+        enc->begin_element("bundle_receive_started_event");
+        encode(x.bundle_receive_started_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_received_event().present()) {
+        enc->begin_element("bundle_received_event");
+        encode(x.bundle_received_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_transmitted_event().present()) {
+        enc->begin_element("bundle_transmitted_event");
+        encode(x.bundle_transmitted_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_cancel_request().present()) {
+        enc->begin_element("bundle_cancel_request");
+        encode(x.bundle_cancel_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_canceled_event().present()) {
+        enc->begin_element("bundle_canceled_event");
+        encode(x.bundle_canceled_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.query_bundle_queued().present()) {
+        enc->begin_element("query_bundle_queued");
+        encode(x.query_bundle_queued().get(), enc);
+        enc->end_element();
+    }
+    if (x.report_bundle_queued().present()) {
+        enc->begin_element("report_bundle_queued");
+        encode(x.report_bundle_queued().get(), enc);
+        enc->end_element();
+    }
+    if (x.query_eid_reachable().present()) {
+        enc->begin_element("query_eid_reachable");
+        encode(x.query_eid_reachable().get(), enc);
+        enc->end_element();
+    }
+    if (x.report_eid_reachable().present()) {
+        enc->begin_element("report_eid_reachable");
+        encode(x.report_eid_reachable().get(), enc);
+        enc->end_element();
+    }
+    if (x.query_link_attributes().present()) {
+        enc->begin_element("query_link_attributes");
+        encode(x.query_link_attributes().get(), enc);
+        enc->end_element();
+    }
+    if (x.report_link_attributes().present()) {
+        enc->begin_element("report_link_attributes");
+        encode(x.report_link_attributes().get(), enc);
+        enc->end_element();
+    }
+    if (x.query_interface_attributes().present()) {
+        enc->begin_element("query_interface_attributes");
+        encode(x.query_interface_attributes().get(), enc);
+        enc->end_element();
+    }
+    if (x.report_interface_attributes().present()) {
+        enc->begin_element("report_interface_attributes");
+        encode(x.report_interface_attributes().get(), enc);
+        enc->end_element();
+    }
+    if (x.query_cla_parameters().present()) {
+        enc->begin_element("query_cla_parameters");
+        encode(x.query_cla_parameters().get(), enc);
+        enc->end_element();
+    }
+    if (x.report_cla_parameters().present()) {
+        enc->begin_element("report_cla_parameters");
+        encode(x.report_cla_parameters().get(), enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cl_message* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "cla_add_request") {
+            std::auto_ptr< cla_add_request > c(new cla_add_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->cla_add_request(c);
+        } else if (name == "cla_delete_request") {
+            std::auto_ptr< cla_delete_request > c(new cla_delete_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->cla_delete_request(c);
+        } else if (name == "cla_set_params_request") {
+            std::auto_ptr< cla_set_params_request > c(new cla_set_params_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->cla_set_params_request(c);
+        } else if (name == "cla_params_set_event") {
+            std::auto_ptr< cla_params_set_event > c(new cla_params_set_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->cla_params_set_event(c);
+        } else if (name == "interface_set_defaults_request") {
+            std::auto_ptr< interface_set_defaults_request > c(new interface_set_defaults_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_set_defaults_request(c);
+        } else if (name == "interface_create_request") {
+            std::auto_ptr< interface_create_request > c(new interface_create_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_create_request(c);
+        } else if (name == "interface_created_event") {
+            std::auto_ptr< interface_created_event > c(new interface_created_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_created_event(c);
+        } else if (name == "interface_reconfigure_request") {
+            std::auto_ptr< interface_reconfigure_request > c(new interface_reconfigure_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_reconfigure_request(c);
+        } else if (name == "interface_reconfigured_event") {
+            std::auto_ptr< interface_reconfigured_event > c(new interface_reconfigured_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_reconfigured_event(c);
+        } else if (name == "interface_destroy_request") {
+            std::auto_ptr< interface_destroy_request > c(new interface_destroy_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->interface_destroy_request(c);
+        } else if (name == "eid_reachable_event") {
+            std::auto_ptr< eid_reachable_event > c(new eid_reachable_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->eid_reachable_event(c);
+        } else if (name == "link_set_defaults_request") {
+            std::auto_ptr< link_set_defaults_request > c(new link_set_defaults_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_set_defaults_request(c);
+        } else if (name == "link_create_request") {
+            std::auto_ptr< link_create_request > c(new link_create_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_create_request(c);
+        } else if (name == "link_created_event") {
+            std::auto_ptr< link_created_event > c(new link_created_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_created_event(c);
+        } else if (name == "link_open_request") {
+            std::auto_ptr< link_open_request > c(new link_open_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_open_request(c);
+        } else if (name == "link_opened_event") {
+            std::auto_ptr< link_opened_event > c(new link_opened_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_opened_event(c);
+        } else if (name == "link_close_request") {
+            std::auto_ptr< link_close_request > c(new link_close_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_close_request(c);
+        } else if (name == "link_closed_event") {
+            std::auto_ptr< link_closed_event > c(new link_closed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_closed_event(c);
+        } else if (name == "link_state_changed_event") {
+            std::auto_ptr< link_state_changed_event > c(new link_state_changed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_state_changed_event(c);
+        } else if (name == "link_reconfigure_request") {
+            std::auto_ptr< link_reconfigure_request > c(new link_reconfigure_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_reconfigure_request(c);
+        } else if (name == "link_delete_request") {
+            std::auto_ptr< link_delete_request > c(new link_delete_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_delete_request(c);
+        } else if (name == "link_deleted_event") {
+            std::auto_ptr< link_deleted_event > c(new link_deleted_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_deleted_event(c);
+        } else if (name == "link_attribute_changed_event") {
+            std::auto_ptr< link_attribute_changed_event > c(new link_attribute_changed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attribute_changed_event(c);
+        } else if (name == "contact_attribute_changed_event") {
+            std::auto_ptr< contact_attribute_changed_event > c(new contact_attribute_changed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attribute_changed_event(c);
+        } else if (name == "link_add_reachable_event") {
+            std::auto_ptr< link_add_reachable_event > c(new link_add_reachable_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_add_reachable_event(c);
+        } else if (name == "bundle_send_request") {
+            std::auto_ptr< bundle_send_request > c(new bundle_send_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_send_request(c);
+        } else if (name == "bundle_receive_started_event") {
+            std::auto_ptr< bundle_receive_started_event > c(new bundle_receive_started_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_receive_started_event(c);
+        } else if (name == "bundle_received_event") {
+            std::auto_ptr< bundle_received_event > c(new bundle_received_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_received_event(c);
+        } else if (name == "bundle_transmitted_event") {
+            std::auto_ptr< bundle_transmitted_event > c(new bundle_transmitted_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_transmitted_event(c);
+        } else if (name == "bundle_cancel_request") {
+            std::auto_ptr< bundle_cancel_request > c(new bundle_cancel_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_cancel_request(c);
+        } else if (name == "bundle_canceled_event") {
+            std::auto_ptr< bundle_canceled_event > c(new bundle_canceled_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_canceled_event(c);
+        } else if (name == "query_bundle_queued") {
+            std::auto_ptr< query_bundle_queued > c(new query_bundle_queued());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->query_bundle_queued(c);
+        } else if (name == "report_bundle_queued") {
+            std::auto_ptr< report_bundle_queued > c(new report_bundle_queued());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_bundle_queued(c);
+        } else if (name == "query_eid_reachable") {
+            std::auto_ptr< query_eid_reachable > c(new query_eid_reachable());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->query_eid_reachable(c);
+        } else if (name == "report_eid_reachable") {
+            std::auto_ptr< report_eid_reachable > c(new report_eid_reachable());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_eid_reachable(c);
+        } else if (name == "query_link_attributes") {
+            std::auto_ptr< query_link_attributes > c(new query_link_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->query_link_attributes(c);
+        } else if (name == "report_link_attributes") {
+            std::auto_ptr< report_link_attributes > c(new report_link_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_link_attributes(c);
+        } else if (name == "query_interface_attributes") {
+            std::auto_ptr< query_interface_attributes > c(new query_interface_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->query_interface_attributes(c);
+        } else if (name == "report_interface_attributes") {
+            std::auto_ptr< report_interface_attributes > c(new report_interface_attributes());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_interface_attributes(c);
+        } else if (name == "query_cla_parameters") {
+            std::auto_ptr< query_cla_parameters > c(new query_cla_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->query_cla_parameters(c);
+        } else if (name == "report_cla_parameters") {
+            std::auto_ptr< report_cla_parameters > c(new report_cla_parameters());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_cla_parameters(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+void
+cl_message_tlv(const cl_message& message, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("cl_message");
+    encode(message, enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+std::auto_ptr< cl_message >
+cl_message_tlv(RouterTLV::Decoder* dec)
+{
+    std::auto_ptr< cl_message > message;
+
+    RouterTLV::record_t type;
+    std::string name;
+    if (! dec->get_record(&type) || type != RouterTLV::ELEMENT ||
+        ! dec->get_name(&name) || name != "cl_message")
+    {
+        return message;
+    }
+
+    message.reset(new cl_message());
+    try {
+        if (! decode(dec, message.get())) {
+            message.reset();
+        }
+    } catch (::xml_schema::exception&) {
+        // an unknown enumeration value
+        message.reset();
+    }
+
+    return message;
+}
+
+} // namespace clmessage
+} // namespace dtn
+
+#endif // XERCES_C_ENABLED && EXTERNAL_CL_ENABLED
@@ -0,0 +1,48 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Generated by tools/xsd-tlv.py from clevent.xsd, do not edit. Regenerate with
+// "make tlvbindings" in servlib after the xsd bindings change.
+
+#ifndef _CLEVENT_TLV_BINDINGS_H_
+#define _CLEVENT_TLV_BINDINGS_H_
+
+#if defined(XERCES_C_ENABLED) && defined(EXTERNAL_CL_ENABLED)
+
+#include <memory>
+#include "clevent.h"
+#include "routing/RouterTLV.h"
+
+namespace dtn {
+namespace clmessage {
+
+/**
+ * Append the records for a cl_message message to a binary payload.
+ */
+void cl_message_tlv(const cl_message& message, RouterTLV::Encoder* enc);
+
+/**
+ * Read the next cl_message message of a binary payload. Returns NULL if
+ * the records are malformed or do not match the schema.
+ */
+std::auto_ptr< cl_message > cl_message_tlv(RouterTLV::Decoder* dec);
+
+} // namespace clmessage
+} // namespace dtn
+
+#endif // XERCES_C_ENABLED && EXTERNAL_CL_ENABLED
+
+#endif /* _CLEVENT_TLV_BINDINGS_H_ */
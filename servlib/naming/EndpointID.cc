@@ -43,60 +43,32 @@ bool EndpointID::glob_unknown_schemes_ = true;
 bool
 EndpointID::validate()
 {
-    static const char* log = "/dtn/naming/endpoint/";
-    (void)log;
-    
-    scheme_ = NULL;
-    valid_ = false;
-
-    if (!uri_.valid()) {
-        log_debug_p(log, "EndpointID::validate: invalid URI");
-        return false;
-    }
-    
-    if (scheme_str().length() > MAX_EID_PART_LENGTH) {
-        log_err_p(log, "scheme name is too large (>%zu)", MAX_EID_PART_LENGTH);
-        valid_ = false;
-        return false;
-    }
-    
-    if (ssp().length() > MAX_EID_PART_LENGTH) {
-        log_err_p(log, "ssp is too large (>%zu)", MAX_EID_PART_LENGTH);
-        valid_ = false;
-        return false;
-    }
-
-    valid_ = true;
-
-    if ((scheme_ = SchemeTable::instance()->lookup(uri_.scheme())) != NULL) {
-        valid_ = scheme_->validate(uri_, is_pattern_);
-    }
-
-    return valid_;
+    return set_entry(EndpointIDTable::instance()->intern(str(), is_pattern_));
 }
 
 //----------------------------------------------------------------------
 bool
 EndpointID::append_service_tag(const char* tag)
 {
-    if (!scheme_)
+    if (!scheme())
         return false;
 
-    bool ok = scheme_->append_service_tag(&uri_, tag);
+    // the interned uri is shared, so the scheme edits a copy which
+    // is then interned in its place
+    URI uri(this->uri());
+    bool ok = scheme()->append_service_tag(&uri, tag);
     if (!ok)
         return false;
 
     // rebuild the string
-    if (!uri_.valid()) {
+    if (!uri.valid()) {
         log_err_p("/dtn/naming/endpoint/",
                   "EndpointID::append_service_tag: "
                   "failed to format appended URI");
-        
-        // XXX/demmer this leaves the URI in a bogus state... that
-        // doesn't seem good since this really shouldn't ever happen
         return false;
     }
 
+    assign(uri.uri());
     return true;
 }
 
@@ -104,24 +76,23 @@ EndpointID::append_service_tag(const char* tag)
 bool
 EndpointID::append_service_wildcard()
 {
-    if (!scheme_)
+    if (!scheme())
         return false;
 
-    bool ok = scheme_->append_service_wildcard(&uri_);
+    URI uri(this->uri());
+    bool ok = scheme()->append_service_wildcard(&uri);
     if (!ok)
         return false;
 
     // rebuild the string
-    if (!uri_.valid()) {
+    if (!uri.valid()) {
         log_err_p("/dtn/naming/endpoint/",
                   "EndpointID::append_service_wildcard: "
                   "failed to format appended URI");
-        
-        // XXX/demmer this leaves the URI in a bogus state... that
-        // doesn't seem good since this really shouldn't ever happen
         return false;
     }
 
+    assign(uri.uri());
     return true;
 }
 
@@ -129,23 +100,23 @@ EndpointID::append_service_wildcard()
 bool
 EndpointID::remove_service_tag()
 {
-    if (! scheme_)
+    if (! scheme())
         return false;
 
-    bool ok = scheme_->remove_service_tag(&uri_);
+    URI uri(this->uri());
+    bool ok = scheme()->remove_service_tag(&uri);
     if (!ok)
         return false;
 
     // rebuild the string
-    if (!uri_.valid()) {
+    if (!uri.valid()) {
         log_err_p("/dtn/naming/endpoint/",
                   "EndpointID::remove_service_tag: "
                   "failed to format reduced URI");
-        
-        // see note in append_service_wildcard() ... :(
         return false;
     }
 
+    assign(uri.uri());
     return true;
 }
 
@@ -163,32 +134,34 @@ EndpointID::is_singleton() const
                    scheme_str().c_str());
         return ret;
     }
-    return scheme_->is_singleton(uri_);
+    return scheme()->is_singleton(uri());
 }
 
 //----------------------------------------------------------------------
 bool
 EndpointID::assign(const dtn_endpoint_id_t* eid)
 {
-    uri_.assign(std::string(eid->uri));
-    return validate();
+    return assign(std::string(eid->uri));
 }
     
 //----------------------------------------------------------------------
 void
 EndpointID::copyto(dtn_endpoint_id_t* eid) const
 {
-    ASSERT(uri_.uri().length() <= DTN_MAX_ENDPOINT_ID + 1);
-    strcpy(eid->uri, uri_.uri().c_str());
+    ASSERT(length() <= DTN_MAX_ENDPOINT_ID + 1);
+    strcpy(eid->uri, c_str());
 }
 
 //----------------------------------------------------------------------
 void
 EndpointID::serialize(oasys::SerializeAction* a)
 {
-    a->process("uri", &uri_);
+    // the uri is (un)marshalled through a private copy since the
+    // interned one is shared
+    URI uri(this->uri());
+    a->process("uri", &uri);
     if (a->action_code() == oasys::Serialize::UNMARSHAL) {
-        validate();
+        assign(uri.uri());
     }
 }
 
@@ -197,10 +170,10 @@ bool
 EndpointIDPattern::match(const EndpointID& eid) const
 {
     // only match if we're valid
-    if (!uri_.valid()) {
+    if (!uri().valid()) {
         log_warn_p("/dtn/naming/endpoint",
                    "match error: pattern '%s' not a valid uri",
-                   uri_.c_str());
+                   c_str());
         return false;
     }
     
@@ -216,7 +189,7 @@ EndpointIDPattern::match(const EndpointID& eid) const
         return scheme()->match(*this, eid);
 
     } else if (glob_unknown_schemes_) {
-        return oasys::Glob::fixed_glob(uri_.c_str(), eid.c_str());
+        return oasys::Glob::fixed_glob(c_str(), eid.c_str());
         
     } else {
         return (*this == eid);
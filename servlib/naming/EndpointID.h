@@ -22,6 +22,8 @@
 #include <oasys/serialize/SerializableVector.h>
 #include <oasys/util/URI.h>
 
+#include "EndpointIDTable.h"
+
 struct dtn_endpoint_id_t;
 
 namespace dtn {
@@ -37,54 +39,73 @@ public:
     /**
      * Default constructor
      */
-    EndpointID() : scheme_(NULL), valid_(false), is_pattern_(false) {}
+    EndpointID()
+        : entry_(empty_entry()), valid_(false), is_pattern_(false) {}
 
     /**
      * Constructor for deserialization.
      */
     EndpointID(const oasys::Builder&)
-        : scheme_(NULL), valid_(false), is_pattern_(false) {}
+        : entry_(empty_entry()), valid_(false), is_pattern_(false) {}
 
     /**
      * Construct the endpoint id from the given string.
      */
     EndpointID(const std::string& str)
-        : uri_(str), scheme_(NULL), valid_(false), is_pattern_(false)
+        : entry_(NULL), valid_(false), is_pattern_(false)
     {
-        validate();
+        set_entry(EndpointIDTable::instance()->intern(str, false));
     }
 
     /**
      * Construct the endpoint id from the given string.
      */
     EndpointID(const char* str, size_t len)
-        : uri_(), scheme_(NULL), valid_(false), is_pattern_(false)
+        : entry_(NULL), valid_(false), is_pattern_(false)
     {
-        uri_.assign(str, len);
-        validate();
+        set_entry(EndpointIDTable::instance()->
+                  intern(std::string(str, len), false));
     }
     /**
      * Construct the endpoint id from another.
      */
     EndpointID(const EndpointID& other)
-        : SerializableObject(other)
+        : SerializableObject(other),
+          entry_(other.entry_),
+          valid_(other.valid_),
+          is_pattern_(other.is_pattern_)
     {
-        if (&other != this)
-            assign(other);
+        EndpointIDTable::add_ref(entry_);
     }
 
     /**
      * Destructor.
      */
-    virtual ~EndpointID() {}
+    virtual ~EndpointID()
+    {
+        EndpointIDTable::instance()->release(entry_);
+    }
+
+    /**
+     * Assignment operator, needed to maintain the reference on the
+     * interned string.
+     */
+    EndpointID& operator=(const EndpointID& other)
+    {
+        assign(other);
+        return *this;
+    }
 
     /**
      * Assign this endpoint ID as a copy of the other.
      */
     bool assign(const EndpointID& other)
     {
-        uri_         = other.uri_;
-        scheme_      = other.scheme_;
+        if (entry_ != other.entry_) {
+            EndpointIDTable::add_ref(other.entry_);
+            EndpointIDTable::instance()->release(entry_);
+            entry_ = other.entry_;
+        }
         valid_       = other.valid_;
         is_pattern_  = other.is_pattern_;
         return true;
@@ -96,8 +117,8 @@ public:
      */
     bool assign(const std::string& str)
     {
-        uri_.assign(str);
-        return validate();
+        return set_entry(EndpointIDTable::instance()->
+                         intern(str, is_pattern_));
     }
 
     /**
@@ -106,8 +127,7 @@ public:
      */
     bool assign(const char* str, size_t len)
     {
-        uri_.assign(str, len);
-        return validate();
+        return assign(std::string(str, len));
     }
 
     /**
@@ -116,16 +136,16 @@ public:
      */
     bool assign(const std::string& scheme, const std::string& ssp)
     {
-        uri_.assign(scheme + ":" + ssp);
-        return validate();
+        return assign(scheme + ":" + ssp);
     }
 
     /**
-     * Simple equality test function
+     * Simple equality test function. Since equivalent strings share
+     * a canonical interned entry, this is a pointer comparison.
      */
     bool equals(const EndpointID& other) const
     {
-        return uri_ == other.uri_;
+        return entry_->canonical() == other.entry_->canonical();
     }
 
     /**
@@ -133,7 +153,7 @@ public:
      */
     bool operator==(const EndpointID& other) const
     {
-        return uri_ == other.uri_;
+        return entry_->canonical() == other.entry_->canonical();
     }
     
     /**
@@ -141,16 +161,18 @@ public:
      */
     bool operator!=(const EndpointID& other) const
     {
-        return uri_ != other.uri_;
+        return entry_->canonical() != other.entry_->canonical();
     }
 
     /**
      * Operator overload for STL comparison-based data structures
-     * (such as a std::map).
+     * (such as a std::map). Note that this orders ids by when their
+     * strings were interned, not lexically; use compare() for the
+     * latter.
      */
     bool operator<(const EndpointID& other) const
     {
-        return uri_ < other.uri_;
+        return entry_->canonical()->id() < other.entry_->canonical()->id();
     }
 
     /**
@@ -158,7 +180,10 @@ public:
      */
     int compare(const EndpointID& other) const
     {
-        return uri_.compare(other.uri_);
+        if (equals(other)) {
+            return 0;
+        }
+        return uri().compare(other.uri());
     }
 
     /**
@@ -173,7 +198,7 @@ public:
      *   this EndpointID; otherwise false.
      */
     bool subsume(const EndpointID& other) const
-             { return uri_.subsume(other.uri_); }
+             { return uri().subsume(other.uri()); }
 
     /**
      * Append the specified service tag (in a scheme-specific manner)
@@ -232,7 +257,7 @@ public:
      */
     bool known_scheme() const
     {
-        return (scheme_ != NULL);
+        return (scheme() != NULL);
     }
 
     /**
@@ -254,29 +279,61 @@ public:
     /// @{
     /// Accessors and wrappers around the various fields.
     ///
-    const URI&         uri()        const { return uri_; }
-    const std::string& str()        const { return uri_.uri(); }
-    const std::string  scheme_str() const { return uri_.scheme(); }
-    const std::string  ssp()        const { return uri_.ssp(); }
-    Scheme*            scheme()     const { return scheme_; }
+    const URI&         uri()        const { return view().uri_; }
+    const std::string& str()        const { return entry_->str(); }
+    const std::string  scheme_str() const { return uri().scheme(); }
+    const std::string  ssp()        const { return uri().ssp(); }
+    Scheme*            scheme()     const { return view().scheme_; }
     bool               valid()      const { return valid_; }
     bool               is_pattern() const { return is_pattern_; }
-    const char*        c_str()      const { return uri_.uri().c_str(); } 
-    const char*        data()       const { return uri_.uri().data(); }
-    size_t             length()     const { return uri_.uri().length(); }
+    const char*        c_str()      const { return str().c_str(); } 
+    const char*        data()       const { return str().data(); }
+    size_t             length()     const { return str().length(); }
+    const EndpointIDTable::Entry* entry() const { return entry_; }
     ///@}
 
 protected:
     /**
-     * Extract and look up the scheme and ssp.
+     * Look up the scheme and validate the current string, e.g. after
+     * changing whether or not this is a pattern.
      *
      * @return true if the string is a valid endpoint id, false if not.
      */
     bool validate();
 
-    URI uri_;                   /* endpoint URI */
+    /**
+     * Switch to the given (already referenced) entry, releasing the
+     * current one.
+     *
+     * @return true if the string is a valid endpoint id, false if not.
+     */
+    bool set_entry(EndpointIDTable::Entry* entry)
+    {
+        if (entry_ != NULL) {
+            EndpointIDTable::instance()->release(entry_);
+        }
+        entry_ = entry;
+        valid_ = view().valid_;
+        return valid_;
+    }
+
+    /**
+     * Return a new reference on the entry for the empty string.
+     */
+    static EndpointIDTable::Entry* empty_entry()
+    {
+        EndpointIDTable::Entry* entry = EndpointIDTable::instance()->empty();
+        EndpointIDTable::add_ref(entry);
+        return entry;
+    }
+
+    /// The parsed form of the string for this kind of id
+    const EndpointIDTable::View& view() const
+    {
+        return entry_->view(is_pattern_);
+    }
 
-    Scheme* scheme_;            /* the scheme class (if known) */
+    EndpointIDTable::Entry* entry_; /* the interned endpoint string */
 
     bool valid_;                /* true iff the endpoint id is valid */
     bool is_pattern_;           /* true iff this is an EndpointIDPattern */
@@ -295,7 +352,6 @@ public:
     EndpointIDPattern() : EndpointID()
     {
         is_pattern_ = true;
-        uri_.set_validate(false);
     }
 
     /**
@@ -304,7 +360,6 @@ public:
     EndpointIDPattern(const std::string& str) : EndpointID()
     {
         is_pattern_ = true;
-        uri_.set_validate(false);
         assign(str);
     }
 
@@ -321,7 +376,6 @@ public:
     EndpointIDPattern(const EndpointID& other) : EndpointID(other)
     {
         is_pattern_ = true;
-        uri_.set_validate(false);
         validate();
     }
 
@@ -357,7 +411,7 @@ struct GlobalEndpointIDs {
 inline const EndpointID&
 EndpointID::NULL_EID()
 {
-    if (GlobalEndpointIDs::null_eid_.scheme_ == NULL) {
+    if (GlobalEndpointIDs::null_eid_.scheme() == NULL) {
         GlobalEndpointIDs::null_eid_.assign("dtn:none");
     }
     return GlobalEndpointIDs::null_eid_;
@@ -367,7 +421,7 @@ EndpointID::NULL_EID()
 inline const EndpointIDPattern&
 EndpointIDPattern::WILDCARD_EID()
 {
-    if (GlobalEndpointIDs::wildcard_eid_.scheme_ == NULL) {
+    if (GlobalEndpointIDs::wildcard_eid_.scheme() == NULL) {
         GlobalEndpointIDs::wildcard_eid_.assign("*:*");
     }
     
@@ -0,0 +1,238 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <oasys/debug/Log.h>
+
+#include "EndpointIDTable.h"
+#include "EndpointID.h"
+#include "Scheme.h"
+#include "SchemeTable.h"
+
+template <>
+dtn::EndpointIDTable* oasys::Singleton<dtn::EndpointIDTable>::instance_ = 0;
+
+namespace dtn {
+
+//----------------------------------------------------------------------
+EndpointIDTable::View::View(const std::string& str, bool is_pattern)
+    : scheme_(NULL), valid_(false)
+{
+    static const char* log = "/dtn/naming/endpoint/";
+    (void)log;
+
+    if (is_pattern) {
+        uri_.set_validate(false);
+    }
+    uri_.assign(str);
+
+    if (!uri_.valid()) {
+        log_debug_p(log, "EndpointID::validate: invalid URI");
+        return;
+    }
+
+    if (uri_.scheme().length() > EndpointID::MAX_EID_PART_LENGTH) {
+        log_err_p(log, "scheme name is too large (>%zu)",
+                  EndpointID::MAX_EID_PART_LENGTH);
+        return;
+    }
+
+    if (uri_.ssp().length() > EndpointID::MAX_EID_PART_LENGTH) {
+        log_err_p(log, "ssp is too large (>%zu)",
+                  EndpointID::MAX_EID_PART_LENGTH);
+        return;
+    }
+
+    valid_ = true;
+
+    if ((scheme_ = SchemeTable::instance()->lookup(uri_.scheme())) != NULL) {
+        valid_ = scheme_->validate(uri_, is_pattern);
+    }
+}
+
+//----------------------------------------------------------------------
+EndpointIDTable::Entry::Entry(const std::string& str, u_int32_t id)
+    : refcount_(1), id_(id), eid_(str, false), pattern_(NULL),
+      canonical_(this)
+{
+}
+
+//----------------------------------------------------------------------
+EndpointIDTable::Entry::~Entry()
+{
+    delete pattern_;
+}
+
+//----------------------------------------------------------------------
+size_t
+EndpointIDTable::Entry::bytes() const
+{
+    // the entry itself, the string in the uri and the copy used as
+    // the table key
+    size_t ret = sizeof(*this) + str().capacity() + str().length() + 1;
+    if (pattern_ != NULL) {
+        ret += sizeof(*pattern_) + pattern_->uri_.uri().capacity();
+    }
+    return ret;
+}
+
+//----------------------------------------------------------------------
+EndpointIDTable::EndpointIDTable()
+    : lock_(), next_id_(0), bytes_(0)
+{
+    // the empty string is never released since the table holds a
+    // reference to it, and it is the only entry whose views are both
+    // created up front
+    empty_ = new Entry("", next_id_++);
+    empty_->pattern_ = new View("", true);
+    table_[""] = empty_;
+    bytes_ += empty_->bytes();
+}
+
+//----------------------------------------------------------------------
+EndpointIDTable::Entry*
+EndpointIDTable::intern(const std::string& str, bool is_pattern)
+{
+    Entry* entry = NULL;
+    {
+        oasys::ScopeLock l(&lock_, "EndpointIDTable::intern");
+        EntryMap::iterator iter = table_.find(str);
+        if (iter != table_.end()) {
+            entry = iter->second;
+            add_ref(entry);
+            if (!is_pattern || entry->pattern_ != NULL) {
+                return entry;
+            }
+        }
+    }
+
+    // parsing and validating may be expensive (and calls into the
+    // schemes), so it's done without holding the lock. if another
+    // thread races to create the same entry or view, the loser just
+    // throws its copy away
+    if (entry == NULL) {
+        Entry* new_entry = new Entry(str, 0);
+        if (is_pattern) {
+            new_entry->pattern_ = new View(str, true);
+        }
+
+        // equivalent spellings of a valid uri share the entry of its
+        // normalized form, which is what equality compares
+        if (new_entry->eid_.uri_.valid()) {
+            oasys::URI normalized(new_entry->eid_.uri_);
+            normalized.normalize();
+            if (normalized.uri() != str) {
+                new_entry->canonical_ = intern(normalized.uri(), false);
+            }
+        }
+
+        oasys::ScopeLock l(&lock_, "EndpointIDTable::intern");
+        EntryMap::iterator iter = table_.find(str);
+        if (iter == table_.end()) {
+            new_entry->id_ = next_id_++;
+            table_[str] = new_entry;
+            bytes_ += new_entry->bytes();
+            return new_entry;
+        }
+
+        if (new_entry->canonical_ != new_entry) {
+            release(new_entry->canonical_);
+        }
+        delete new_entry;
+        entry = iter->second;
+        add_ref(entry);
+        if (!is_pattern || entry->pattern_ != NULL) {
+            return entry;
+        }
+    }
+
+    View* view = new View(str, true);
+
+    oasys::ScopeLock l(&lock_, "EndpointIDTable::intern");
+    if (entry->pattern_ == NULL) {
+        entry->pattern_ = view;
+        bytes_ += sizeof(*view) + view->uri_.uri().capacity();
+    } else {
+        delete view;
+    }
+
+    return entry;
+}
+
+//----------------------------------------------------------------------
+void
+EndpointIDTable::release(Entry* entry)
+{
+    // as long as this isn't the last reference, nobody else can be
+    // removing the entry so a plain atomic decrement is enough
+    while (true) {
+        u_int32_t count = entry->refcount_.value;
+        ASSERT(count != 0);
+        if (count == 1) {
+            break;
+        }
+        if (oasys::atomic_cmpxchg32(&entry->refcount_, count, count - 1)
+            == count)
+        {
+            return;
+        }
+    }
+
+    // otherwise the entry has to be removed under the lock, unless a
+    // concurrent intern() revived it in the meantime
+    oasys::ScopeLock l(&lock_, "EndpointIDTable::release");
+    if (oasys::atomic_decr_ret(&entry->refcount_) != 0) {
+        return;
+    }
+
+    ASSERT(entry != empty_);
+    bytes_ -= entry->bytes();
+    table_.erase(entry->str());
+    if (entry->canonical_ != entry) {
+        release(entry->canonical_);
+    }
+    delete entry;
+}
+
+//----------------------------------------------------------------------
+size_t
+EndpointIDTable::size()
+{
+    oasys::ScopeLock l(&lock_, "EndpointIDTable::size");
+    return table_.size();
+}
+
+//----------------------------------------------------------------------
+size_t
+EndpointIDTable::bytes()
+{
+    oasys::ScopeLock l(&lock_, "EndpointIDTable::bytes");
+    return bytes_;
+}
+
+//----------------------------------------------------------------------
+void
+EndpointIDTable::dump(oasys::StringBuffer* buf)
+{
+    oasys::ScopeLock l(&lock_, "EndpointIDTable::dump");
+    buf->appendf("%zu interned eids -- %zu bytes -- %u created",
+                 table_.size(), bytes_, next_id_);
+}
+
+} // namespace dtn
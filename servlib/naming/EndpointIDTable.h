@@ -0,0 +1,151 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _ENDPOINT_ID_TABLE_H_
+#define _ENDPOINT_ID_TABLE_H_
+
+#include <string>
+#include <oasys/thread/Atomic.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/util/Singleton.h>
+#include <oasys/util/StringBuffer.h>
+#include <oasys/util/StringUtils.h>
+#include <oasys/util/URI.h>
+
+namespace dtn {
+
+class Scheme;
+
+/**
+ * The table of interned endpoint id strings.
+ *
+ * Every EndpointID holding a given uri string refers to the same
+ * reference counted Entry, so the string and its parsed URI are
+ * stored once no matter how many bundles, routes and registrations
+ * mention it. Strings that differ but are equivalent URIs (e.g. in
+ * the case of the host name) have separate entries that share one
+ * canonical entry, so two ids are equal exactly when their entries
+ * have the same canonical entry.
+ *
+ * Entries are looked up and created under the table lock. Taking
+ * another reference is a single atomic increment, and dropping one
+ * only takes the lock when it is the last reference so the entry can
+ * be removed from the table.
+ */
+class EndpointIDTable : public oasys::Singleton<EndpointIDTable> {
+public:
+    /**
+     * The parsed and validated form of an interned string. Plain
+     * endpoint ids and patterns are validated differently, so an
+     * entry keeps a separate view for each.
+     */
+    struct View {
+        View(const std::string& str, bool is_pattern);
+
+        oasys::URI uri_;        ///< parsed uri
+        Scheme*    scheme_;     ///< the scheme class (if known)
+        bool       valid_;      ///< true iff the string is valid
+    };
+
+    /**
+     * A single interned endpoint id string.
+     */
+    class Entry {
+    public:
+        /// The interned string
+        const std::string& str() const { return eid_.uri_.uri(); }
+
+        /// Unique identifier, assigned in creation order
+        u_int32_t id() const { return id_; }
+
+        /// The entry for the normalized form of the string
+        const Entry* canonical() const { return canonical_; }
+
+        /// The view for the given kind of endpoint id
+        const View& view(bool is_pattern) const
+        {
+            return is_pattern ? *pattern_ : eid_;
+        }
+
+        /// Approximate number of heap bytes held by the entry
+        size_t bytes() const;
+
+    private:
+        friend class EndpointIDTable;
+
+        Entry(const std::string& str, u_int32_t id);
+        ~Entry();
+
+        oasys::atomic_t refcount_;
+        u_int32_t       id_;
+        View            eid_;
+        View*           pattern_;   ///< created on first use as a pattern
+        Entry*          canonical_; ///< this or a referenced entry
+    };
+
+    /**
+     * Return the entry for the given string, creating it if needed,
+     * with a new reference held for the caller.
+     */
+    Entry* intern(const std::string& str, bool is_pattern);
+
+    /**
+     * Take an additional reference on an entry.
+     */
+    static void add_ref(Entry* entry)
+    {
+        oasys::atomic_incr(&entry->refcount_);
+    }
+
+    /**
+     * Drop a reference, removing the entry once it is unused.
+     */
+    void release(Entry* entry);
+
+    /**
+     * Return the entry shared by all default constructed ids. It is
+     * never removed from the table.
+     */
+    Entry* empty() { return empty_; }
+
+    /// Number of interned strings
+    size_t size();
+
+    /// Approximate heap bytes held by the table and its entries
+    size_t bytes();
+
+    /**
+     * Dump a one line summary of the table.
+     */
+    void dump(oasys::StringBuffer* buf);
+
+private:
+    friend class oasys::Singleton<EndpointIDTable>;
+
+    EndpointIDTable();
+
+    typedef oasys::StringHashMap<Entry*> EntryMap;
+
+    oasys::SpinLock lock_;
+    EntryMap        table_;
+    u_int32_t       next_id_;
+    size_t          bytes_;
+    Entry*          empty_;
+};
+
+} // namespace dtn
+
+#endif /* _ENDPOINT_ID_TABLE_H_ */
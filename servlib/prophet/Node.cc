@@ -17,7 +17,7 @@
 #include "Node.h"
 #include <time.h>       // for time()
 #include <netinet/in.h> // for ntoh*,hton*
-#include <math.h>       // for pow()
+#include <math.h>       // for pow(), log()
 
 namespace prophet {
 
@@ -46,12 +46,14 @@ Node::Node(const NodeParams* params)
 
     // read in current epoch
     age_ = time(0);
+    update_heap_key();
 }
 
 Node::Node(const Node& n)
     : p_value_(n.p_value_), relay_(n.relay_),
       custody_(n.custody_), internet_gateway_(n.internet_gateway_),
-      dest_id_(n.dest_id_), age_(n.age_), heap_pos_(n.heap_pos_)
+      dest_id_(n.dest_id_), age_(n.age_), heap_key_(n.heap_key_),
+      heap_pos_(n.heap_pos_)
 {
     // store local copy of NodeParams
     params_ = new NodeParams(*n.params_);
@@ -73,6 +75,7 @@ Node::Node(const std::string& dest_id,
 
     // read in current epoch
     age_ = time(0);
+    update_heap_key();
 }
 
 Node::~Node()
@@ -87,6 +90,9 @@ Node::update_pvalue()
     if (!(p_value_ >= 0.0 && p_value_ <= 1.0)) return;
     if (params_ == NULL) return;
 
+    // bring the old value up to date before applying the update
+    update_age();
+
     // new p_value is P_(A,B), previous p_value_ is P_(A,B)_old
     // params_->encounter_ is P_encounter
     // A is the local node
@@ -95,6 +101,7 @@ Node::update_pvalue()
 
     // update age to reflect data "freshness"
     age_ = time(0);
+    update_heap_key();
 }
 
 void
@@ -104,9 +111,12 @@ Node::update_transitive(double ab, double bc)
     if (!(p_value_ >= 0.0 && p_value_ <= 1.0)) return;
     if (!(ab >= 0.0 && ab <= 1.0)) return;
     if (!(bc >= 0.0 && bc <= 1.0)) return;
-    if (p_value_ > bc) return;
     if (params_ == NULL) return;
 
+    // bring the old value up to date before applying the update
+    update_age();
+    if (p_value_ > bc) return;
+
     // new p_value_ is P_(A,C), previous p_value is P_(A,C)_old
     // params_->beta_ is beta
     // A is the local node
@@ -116,40 +126,73 @@ Node::update_transitive(double ab, double bc)
 
     // update age to reflect data "freshness"
     age_ = time(0);
+    update_heap_key();
 }
 
-void
-Node::update_age()
+double
+Node::p_value(u_int32_t now) const
 {
     // validate before proceeding
-    if (!(p_value_ >= 0.0 && p_value_ <= 1.0)) return;
-    if (params_ == NULL) return;
+    if (!(p_value_ >= 0.0 && p_value_ <= 1.0)) return p_value_;
+    if (params_ == NULL) return p_value_;
 
-    // new p_value_ is P_(A,B), previous p_value is P_(A,B)_old
+    // aged p_value is P_(A,B), stored p_value_ is P_(A,B)_old
     // params_->gamma_ is gamma
     // timeunits is k
-    u_int32_t now = time(0);
-
     double agefactor = 1.0;
 
-    u_int timeunits = time_to_units(now - age_);
-    if (timeunits > 0)
-        agefactor = pow( params_->gamma_, timeunits );
+    // clock may have been set back since the last update
+    if (now > age_)
+    {
+        double timeunits = time_to_units(now - age_);
+        if (timeunits > 0.0)
+            agefactor = pow( params_->gamma_, timeunits );
+    }
 
-    p_value_ *= agefactor;
+    return p_value_ * agefactor;
+}
+
+void
+Node::update_age()
+{
+    // validate before proceeding
+    if (!(p_value_ >= 0.0 && p_value_ <= 1.0)) return;
+    if (params_ == NULL) return;
+
+    u_int32_t now = time(0);
+    p_value_ = p_value(now);
 
     // update age to reflect data "freshness"
-    age_ = time(0);
+    age_ = now;
+    update_heap_key();
 }
 
-u_int
+double
 Node::time_to_units(u_int32_t timediff) const
 {
     // prevent div by 0
-    if (params_->kappa_ == 0.0) return 0;
+    if (params_->kappa_ == 0.0) return 0.0;
+
+    // kappa is in units of milliseconds per timeunit; the units are
+    // not rounded down, so that aging in several steps (or lazily, in
+    // one) decays every route by exactly gamma^(1000/kappa) a second
+    return (double) timediff * 1000.0 / params_->kappa_;
+}
 
-    // kappa is in units of milliseconds per timeunit
-    return (u_int) (timediff * 1000 / params_->kappa_);
+void
+Node::update_heap_key()
+{
+    // log(0) is -HUGE_VAL, which still sorts below every other route
+    heap_key_ = log(p_value_);
+    if (params_ == NULL || params_->kappa_ == 0 ||
+        !(params_->gamma_ > 0.0 && params_->gamma_ < 1.0))
+        return;
+
+    // p_value(now) = p_value_ * gamma^((now - age_) * 1000 / kappa), so
+    // log(p_value(now)) differs from this by the same amount for all
+    // Nodes, namely now * 1000 / kappa * log(gamma)
+    heap_key_ -= (double) age_ * 1000.0 / params_->kappa_ *
+                 log(params_->gamma_);
 }
 
 }; // namespace prophet
@@ -18,6 +18,7 @@
 #define _PROPHET_NODE_H_
 
 #include <sys/types.h>
+#include <time.h>
 #include <string>
 #include "PointerList.h"
 
@@ -52,7 +53,9 @@ struct NodeParams
 
     /**
      * The kappa variable describes how many 
-     * milliseconds-per-timeunit (for equation 2, p.9, section 2.1.1)
+     * milliseconds-per-timeunit (for equation 2, p.9, section 2.1.1).
+     * Routes are aged in fractional time units, so any kappa decays
+     * every route at the same rate (0 disables aging).
      */
     static const u_int DEFAULT_KAPPA;
 
@@ -75,6 +78,10 @@ struct NodeParams
  * tracks destination endpoint ID and delivery predictability (0 <= p <= 1).
  * Pages and paragraphs refer to the Prophet Internet Draft released
  * March 2006
+ *
+ * The stored predictability is the value as of age(); the aging
+ * algorithm is applied on each read of p_value() rather than by
+ * periodically visiting every Node.
  */
 class Node
 {
@@ -107,7 +114,9 @@ public:
     virtual ~Node();
 
     ///@{ Accessors
-    double      p_value()      const { return p_value_; }
+    double      p_value()      const { return p_value(time(0)); }
+    double      p_value_at_age() const { return p_value_; }
+    double      heap_key()     const { return heap_key_; }
     bool        relay()        const { return relay_; }
     bool        custody()      const { return custody_; }
     bool        internet_gw()  const { return internet_gateway_; }
@@ -130,6 +139,7 @@ public:
         age_     = n.age_;
         delete params_;
         params_  = new NodeParams(*n.params_);
+        heap_key_ = n.heap_key_;
         heap_pos_ = n.heap_pos_;
         return *this;
     }
@@ -145,9 +155,16 @@ public:
      */
     void update_transitive(double ab, double bc);
 
+    /**
+     * Predictability at the given time (seconds since the epoch),
+     * with the aging algorithm applied for the time since age()
+     */
+    double p_value(u_int32_t now) const;
+
     /**
      * Routes must decrease predictability with the passing of time,
-     * p. 9, 2.1.1, eq. 2
+     * p. 9, 2.1.1, eq. 2; fold the aging since age() into the stored
+     * predictability and restart the clock
      */
     void update_age();
 
@@ -164,6 +181,7 @@ protected:
     void set_pvalue( double d )
     {
         if ( d >= 0.0 && d <= 1.0 ) p_value_ = d;
+        update_heap_key();
     };
     void set_relay( bool relay ) { relay_ = relay; }
     void set_custody( bool custody ) { custody_ = custody; }
@@ -172,7 +190,7 @@ protected:
     {
         dest_id_.assign(eid);
     }
-    void set_age( u_int32_t age ) { age_ = age; }
+    void set_age( u_int32_t age ) { age_ = age; update_heap_key(); }
     void set_params( const NodeParams* params )
     {
         delete params_;
@@ -181,14 +199,24 @@ protected:
         else
             // take the defaults
             params_ = new NodeParams();
+        update_heap_key();
     }
     ///@}
 
     /**
      * Use NodeParams::kappa_ milliseconds per unit to convert diff
-     * to time units for use in Equation 2
+     * to (fractional) time units for use in Equation 2
+     */
+    double time_to_units(u_int32_t diff) const;
+
+    /**
+     * Recompute heap_key_ after p_value_, age_ or params_ change.
+     * Aging multiplies every route by gamma^(1000/kappa) per second,
+     * so the log of the predictability projected back to the epoch
+     * orders Nodes just as p_value() does at any single time, without
+     * reading the clock or applying the aging equation per comparison.
      */
-    u_int time_to_units(u_int32_t diff) const;
+    void update_heap_key();
 
     const NodeParams* params_; ///< global settings for all prophet nodes
     double            p_value_; ///< predictability value for this node
@@ -197,6 +225,7 @@ protected:
     bool              internet_gateway_; ///< whether bridge to Internet
     std::string       dest_id_; ///< string representation of route to node
     u_int32_t         age_; ///< age in seconds of last update to p_value
+    double            heap_key_; ///< time-independent ordering key
     size_t            heap_pos_; ///< heap index used by Table
 }; // Node
 
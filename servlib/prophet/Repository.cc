@@ -57,20 +57,13 @@ Repository::del(const Bundle* b)
         return;
     }
 
-    // first get iterator for b
-    iterator i;
-    if (find(b,i))
+    // first get position of b
+    size_t pos;
+    if (find(b,pos))
     {
-        // parameter may only have index set, for find
-        // so grab the reference returned by find
-        b = *i;
-        // decrement utilization by Bundle's size
-        current_ -= b->size();
-        // reorder sequence to preserve eviction ordering, moving
-        // victim to last pos in vector
-        remove_and_reheap(i-list_.begin());
-        // remove victim from vector
-        list_.pop_back();
+        // reorder sequence to preserve eviction ordering, dropping
+        // victim from the heap and decrementing utilization
+        b = remove(pos);
         LOG(LOG_DEBUG,"removed %d from list",b->sequence_num());
     }
 }
@@ -86,15 +79,16 @@ Repository::add(const Bundle* b)
     }
 
     // duplicates not allowed
-    iterator i;
-    if (find(b,i))
+    std::pair<IndexMap::iterator,bool> ins =
+        index_.insert(IndexMap::value_type(b,list_.size()));
+    if (!ins.second)
         return false;
 
     // add to underlying sequence
     list_.push_back(b);
+    slots_.push_back(ins.first);
     // reorder sequence to eviction order
-    size_t last_pos = list_.size() - 1;
-    push_heap(0,last_pos,0,list_[last_pos]);
+    heap_up(list_.size() - 1);
     // increment utilization by this Bundle's size
     current_ += b->size();
     // maintain quota
@@ -115,8 +109,7 @@ Repository::set_comparator(QueueComp* qc)
     delete comp_;
     comp_ = qc;
     // recalculate eviction order based on new comp_
-    if (!list_.empty())
-        make_heap(0, (list_.size() - 1));
+    make_heap();
 }
 
 void
@@ -137,156 +130,136 @@ Repository::change_priority(const Bundle* b)
     if (b == NULL)
         return;
 
-    iterator i = list_.begin();
-    // brute-force search since heap property is violated
-    while (i != list_.end())
-        if (*(*i) == *b)
-            break;
-        else i++;
-
-    if (i != list_.end())
+    // the index still knows where b is, even though the heap
+    // property may be violated at that position
+    size_t pos;
+    if (find(b,pos))
     {
-        // pull bundle out of the heap and stick it at the end of list_
-        remove_and_reheap(i - list_.begin());
-        // pull bundle from end of list_ and put it in heapified pos
-        push_heap(0,list_.size() - 1,0,b);
+        // move b up or down the tree to its new place
+        if (heap_up(pos) == pos)
+            heap_down(pos);
     }
 }
 
 void
 Repository::evict()
 {
-    if (comp_->qp() != QueuePolicy::LEPR)
-    {
-do_evict:
-        size_t last_pos = list_.size() - 1;
-        // re-order so that eviction candidate is now at the end of list_
-        pop_heap(0, last_pos, last_pos, list_[last_pos]);
-        // capture a pointer to the back of list_
-        const Bundle* b = list_.back();
-        // drop the last member off the end of list_
-        list_.pop_back();
-        // callback into Bundle core to request deletion of Bundle
-        core_->drop_bundle(b);
-        // decrement current consumption by Bundle's size
-        current_ -= b->size();
-
-        return;
-    }
-    else
+    size_t pos = 0;
+    if (comp_->qp() == QueuePolicy::LEPR)
     {
         // LEPR adds the burden of checking for NF > min_NF
 
         // search heap tree from top down, left to right (linearly thru vector)
         size_t len = list_.size();
-        for (size_t pos = 0; pos < len; pos++)
-        {
-            const Bundle* b = list_[pos];
-            if (comp_->min_fwd_ < b->num_forward())
-            {
-                // victim is found, now evict
-                // decrement utilization by Bundle's size
-                current_ -= b->size();
-                // reorder sequence to preserve eviction ordering, moving
-                // victim to last pos in vector
-                remove_and_reheap(pos);
-                // remove victim from vector
-                list_.pop_back();
-                return;
-            }
-        }
+        for (pos = 0; pos < len; pos++)
+            if (comp_->min_fwd_ < list_[pos]->num_forward())
+                break;
+
         // Here's where Prophet doesn't say what to do: the entire heap was
         // searched, but no victims qualified, due to the min_NF constraint.
         // Since eviction must happen, then override the min_NF requirement
         // and let's go ahead and evict top()
-        // This stinks; we've already paid linear, now we pay another log on
-        // top of that.
-        goto do_evict;
+        if (pos == len)
+            pos = 0;
     }
-}
 
-void
-Repository::push_heap(size_t first, size_t hole, size_t top, const Bundle* b)
-{
-    size_t parent = (hole - 1) / 2;
-    while (hole > top && (*comp_)(list_[first + parent],b))
-    {
-        list_[first + hole] = list_[first + parent];
-        hole = parent;
-        parent = (hole - 1) / 2;
-    }
-    list_[first + hole] = b;
+    // drop the victim from the heap, decrementing current consumption
+    // by Bundle's size
+    const Bundle* b = remove(pos);
+    // callback into Bundle core to request deletion of Bundle
+    core_->drop_bundle(b);
 }
 
 void
-Repository::pop_heap(size_t first, size_t last, size_t result, const Bundle* b)
+Repository::swap(size_t a, size_t b)
 {
-    list_[result] = list_[first];
-    adjust_heap(first, 0, last - first, b);
+    std::swap(list_[a],list_[b]);
+    std::swap(slots_[a],slots_[b]);
+    slots_[a]->second = a;
+    slots_[b]->second = b;
 }
 
-void
-Repository::adjust_heap(size_t first, size_t hole, size_t len, const Bundle* b)
+size_t
+Repository::heap_up(size_t pos)
 {
-    // size 0 or 1 is already a valid heap!
-    if (list_.size() < 2)
-        return;
-
-    const size_t top = hole;
-    size_t second = 2 * hole + 2;
-    while (second < len)
+    while (pos > 0)
     {
-        if ((*comp_)(list_[first + second], list_[first + (second - 1)]))
-            second--;
-        list_[first + hole] = list_[first + second];
-        hole = second;
-        second = 2 * (second + 1);
-    }
-    if (second == len)
-    {
-        list_[first + hole] = list_[first + (second - 1)];
-        hole = second - 1;
+        size_t parent = (pos - 1) / 2;
+        // check for heap order
+        if (!(*comp_)(list_[parent],list_[pos]))
+            break;
+        swap(parent,pos);
+        pos = parent;
     }
-    push_heap(first, hole, top, b);
+    return pos;
 }
 
-void
-Repository::remove_and_reheap(size_t hole)
+size_t
+Repository::heap_down(size_t pos)
 {
-    // overwrite victim with lowest ranking leaf
-    list_[hole] = list_[list_.size() - 1];
-    // reheap downstream from hole
-    adjust_heap(0, hole, list_.size() - 2, list_[hole]);
+    size_t len = list_.size();
+    while (true)
+    {
+        size_t top = pos;
+        size_t left = 2 * pos + 1;
+        size_t right = left + 1;
+        if (left < len && (*comp_)(list_[top],list_[left]))
+            top = left;
+        if (right < len && (*comp_)(list_[top],list_[right]))
+            top = right;
+        // heap order throughout, we're done
+        if (top == pos)
+            break;
+        swap(top,pos);
+        pos = top;
+    }
+    return pos;
 }
 
 void
-Repository::make_heap(size_t first, size_t last)
+Repository::make_heap()
 {
     // size 0 or 1 is already a valid heap!
-    if (last < first + 2) return;
+    size_t len = list_.size();
+    if (len < 2) return;
 
-    size_t len = last - first;
+    // work upwards from the last parent
     size_t parent = (len - 2) / 2;
     while (true)
     {
-        adjust_heap(first, parent, len, list_[first + parent]);
+        heap_down(parent);
         if (parent == 0) break;
         parent--;
     }
 }
 
-bool
-Repository::find(const Bundle* b, iterator& i)
+const Bundle*
+Repository::remove(size_t pos)
 {
-    if (list_.empty()) return false;
+    const Bundle* b = list_[pos];
+    size_t last = list_.size() - 1;
 
-    i = list_.begin();
-    while (i != list_.end())
-        if (b == *i)
-            break;
-        else
-            i++;
-    return (i != list_.end() && b == *i);
+    // overwrite victim with last leaf, then move that leaf to its
+    // proper place
+    swap(pos,last);
+    index_.erase(slots_[last]);
+    slots_.pop_back();
+    list_.pop_back();
+    if (pos < last && heap_up(pos) == pos)
+        heap_down(pos);
+
+    current_ -= b->size();
+    return b;
+}
+
+bool
+Repository::find(const Bundle* b, size_t& pos) const
+{
+    IndexMap::const_iterator i = index_.find(b);
+    if (i == index_.end())
+        return false;
+    pos = i->second;
+    return true;
 }
 
 }; // namespace prophet
@@ -17,6 +17,9 @@
 #ifndef _PROPHET_REPOSITORY_H_
 #define _PROPHET_REPOSITORY_H_
 
+#include <map>
+#include <vector>
+
 #include "Bundle.h"
 #include "BundleList.h"
 #include "QueuePolicy.h"
@@ -39,6 +42,8 @@ namespace prophet
  * the size change then add() it again after the size is finalized. Any
  * change in policy (ie, a new comparator) will cost n for the pass-thru
  * of reheaping; any change in max will also be at most a linear cost.
+ * Each Bundle's position in the heap is indexed by its pointer, so
+ * del and change_priority cost log n rather than a linear search.
  */
 class Repository
 {
@@ -149,22 +154,35 @@ protected:
      */
     void evict();
 
-    ///@{ Heap operations
-    void make_heap(size_t first, size_t last);
-    void push_heap(size_t first, size_t hole, size_t top, const Bundle* b);
-    void pop_heap(size_t first, size_t last, size_t result, const Bundle* b);
-    void adjust_heap(size_t first, size_t hole, size_t len, const Bundle* b);
-    void remove_and_reheap(size_t hole);
+    /**
+     * Map from Bundle to its position in list_
+     */
+    typedef std::map<const Bundle*,size_t> IndexMap;
+
+    ///@{ Heap operations, each keeping the index up to date
+    void make_heap();
+    size_t heap_up(size_t pos);
+    size_t heap_down(size_t pos);
+    void swap(size_t a, size_t b);
     ///@}
 
     /**
-     * Utility function for find
+     * Remove the Bundle at pos from the heap and the index, decrement
+     * utilization, and return the Bundle
+     */
+    const Bundle* remove(size_t pos);
+
+    /**
+     * Utility function for find; sets pos to b's position in list_
      */
-    bool find(const Bundle* b, iterator& i);
+    bool find(const Bundle* b, size_t& pos) const;
 
     BundleCoreRep* core_; ///< facade interface into Bundle host
     QueueComp* comp_; ///< queue policy Bundle comparator
     BundleList list_; ///< array-based eviction-ordered heap of Bundles
+    IndexMap index_;  ///< position of each Bundle in list_
+    std::vector<IndexMap::iterator> slots_; ///< index entry for each
+                                            ///  position in list_
     u_int current_;   ///< current utilization
 }; // class Repository
 
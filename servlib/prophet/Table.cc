@@ -353,15 +353,15 @@ Table::truncate(double epsilon)
                 i++;
         }
     } else {
-        n = heap_.top();
-        while (n->p_value() < epsilon)
+        // with lazy aging, every route may have decayed below epsilon
+        while (!heap_.empty() && heap_.top()->p_value() < epsilon)
         {
+            n = heap_.top();
             if (find(n->dest_id_ref(),&i)) // if (find(n->dest_id(),&i))
             {
-                // remove this element and clean up its memory
+                // remove this element and clean up its memory;
+                // remove() will pop() from heap, exposing next lowest
                 remove(&i);
-                // remove() will pop() from heap, now advance to next lowest
-                n = heap_.top();
                 // count this removal in the reported total
                 num++;
             }
@@ -423,18 +423,11 @@ void Table::assign(const std::list<const Node*>& list,
 size_t
 Table::age_nodes()
 {
-    size_t num = 0;
-    for (iterator i = table_.begin(); i != table_.end(); i++)
-    {
-        Node *n = (*i).second;
-        n->update_age();
-        heap_del(n);
-        heap_add(n);
-        num++;
-
-        // utilize persistent storage as appropriate
-        if (persistent_) core_->update_node(n);
-    }
+    // each Node's p_value() is already aged as of now, and the heap
+    // order is unaffected by aging (see heap_compare), so there's no
+    // need to visit the Nodes; routes that have decayed away are
+    // picked off the top of the heap by truncate()
+    size_t num = table_.size();
 
     // log if anything happens
     if (num > 0)
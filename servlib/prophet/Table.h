@@ -31,12 +31,19 @@ namespace prophet
 class Dictionary; 
 
 /**
- * Compare object for Heap
+ * Compare object for Heap. Nodes are aged lazily on read, but since
+ * every route decays by the same factor over the same time, the
+ * relative order of two Nodes doesn't change as time passes and the
+ * heap stays valid without being touched. Nodes are compared by
+ * Node::heap_key(), which is computed when the Node is updated, so
+ * comparisons neither read the clock nor apply the aging equation.
+ * This requires every Node in the Table to share the same gamma and
+ * kappa.
  */
 struct heap_compare {
     bool operator() (Node* a, Node* b) {
         if (a == NULL || b == NULL) return false;
-        return ((*a).p_value() > (*b).p_value());
+        return ((*a).heap_key() > (*b).heap_key());
     }
 };
 
@@ -176,8 +183,10 @@ public:
                 const NodeParams* params);
 
     /**
-     * For maintenance routines, visit each Node in table and invoke its
-     * aging algorithm; return the number of Nodes visited.
+     * For maintenance routines, apply the aging algorithm to each Node
+     * in table; return the number of Nodes aged. Aging is computed on
+     * read by Node::p_value(), so this is constant time and neither
+     * reorders the heap nor rewrites persistent storage.
      */
     size_t age_nodes();
 
@@ -18,8 +18,15 @@
 #  include <dtn-config.h>
 #endif
 
+#include <algorithm>
+#include <string.h>
+#include <oasys/compat/inttypes.h>
+#include <oasys/util/Time.h>
+
 #include "APIRegistration.h"
 #include "RegistrationTable.h"
+#include "naming/DTNScheme.h"
+#include "naming/IPNScheme.h"
 #include "bundling/BundleEvent.h"
 #include "bundling/BundleDaemon.h"
 #include "storage/RegistrationStore.h"
@@ -28,8 +35,10 @@ namespace dtn {
 
 //----------------------------------------------------------------------
 RegistrationTable::RegistrationTable()
-    : Logger("RegistrationTable", "/dtn/registration/table")
+    : Logger("RegistrationTable", "/dtn/registration/table"),
+      next_seqno_(0)
 {
+    memset(&stats_, 0, sizeof(stats_));
 }
 
 //----------------------------------------------------------------------
@@ -58,6 +67,143 @@ RegistrationTable::find(u_int32_t regid, RegistrationList::iterator* iter)
     return false;
 }
 
+//----------------------------------------------------------------------
+RegistrationTable::demux_key_t
+RegistrationTable::get_demux_key(const EndpointID& eid, std::string* key)
+{
+    if (eid.scheme() == DTNScheme::instance())
+    {
+        if (eid.ssp() == "none") {
+            return DEMUX_KEY_NONE;
+        }
+
+        // DTNScheme::match globs the host and path in both directions
+        // but compares the port exactly and ignores any query string
+        const std::string& host = eid.uri().host();
+        const std::string& path = eid.uri().path();
+        if (strpbrk(host.c_str(), "*?[]\\") != NULL ||
+            strpbrk(path.c_str(), "*?[]\\") != NULL)
+        {
+            return DEMUX_KEY_WILDCARD;
+        }
+
+        char port[16];
+        snprintf(port, sizeof(port), ":%d", eid.uri().port_num());
+        key->assign("dtn:");
+        key->append(host);
+        key->append(port);
+        key->append(path);
+        return DEMUX_KEY_OK;
+    }
+
+    // IPNScheme::match parses the string directly, so do the same
+    u_int64_t node = 0, service = 0;
+    int n = sscanf(eid.c_str(), "ipn://%" PRIu64 "/%" PRIu64, &node, &service);
+    if (n < 1) {
+        return DEMUX_KEY_NONE;
+    }
+
+    if (strstr(eid.c_str(), "/*") != NULL) {
+        return DEMUX_KEY_WILDCARD;
+    }
+    
+    char buf[64];
+    if (n == 1) {
+        snprintf(buf, sizeof(buf), "ipn:%" PRIu64, node);
+    } else {
+        snprintf(buf, sizeof(buf), "ipn:%" PRIu64 ".%" PRIu64, node, service);
+    }
+    key->assign(buf);
+    return DEMUX_KEY_OK;
+}
+
+//----------------------------------------------------------------------
+void
+RegistrationTable::get_index_key(const Registration* reg, std::string* key)
+{
+    const EndpointIDPattern& endpoint = reg->endpoint();
+    if ((endpoint.scheme() != DTNScheme::instance() &&
+         endpoint.scheme() != IPNScheme::instance()) ||
+        get_demux_key(endpoint, key) != DEMUX_KEY_OK)
+    {
+        key->clear();
+    }
+}
+
+//----------------------------------------------------------------------
+void
+RegistrationTable::index_reg(Registration* reg, u_int32_t seqno)
+{
+    ASSERT(lock_.is_locked_by_me());
+    
+    IndexEntry entry(seqno, reg);
+
+    std::string key;
+    get_index_key(reg, &key);
+    if (key.empty()) {
+        log_debug("adding registration %d to the pattern list",
+                  reg->regid());
+        pattern_regs_.push_back(entry);
+    } else {
+        log_debug("indexing registration %d with demux key %s",
+                  reg->regid(), key.c_str());
+        exact_regs_[key].push_back(entry);
+    }
+    
+    reg_keys_[reg->regid()] = key;
+}
+
+//----------------------------------------------------------------------
+void
+RegistrationTable::unindex_reg(Registration* reg)
+{
+    ASSERT(lock_.is_locked_by_me());
+
+    KeyMap::iterator key_iter = reg_keys_.find(reg->regid());
+    if (key_iter == reg_keys_.end()) {
+        log_err("registration %d not found in the demux index", reg->regid());
+        return;
+    }
+
+    IndexEntryVec* entries = &pattern_regs_;
+    ExactIndex::iterator bucket = exact_regs_.end();
+    if (! key_iter->second.empty()) {
+        bucket = exact_regs_.find(key_iter->second);
+        ASSERT(bucket != exact_regs_.end());
+        entries = &bucket->second;
+    }
+    reg_keys_.erase(key_iter);
+
+    IndexEntryVec::iterator iter;
+    for (iter = entries->begin(); iter != entries->end(); ++iter) {
+        if (iter->reg_ == reg) {
+            entries->erase(iter);
+            break;
+        }
+    }
+
+    if (bucket != exact_regs_.end() && entries->empty()) {
+        exact_regs_.erase(bucket);
+    }
+}
+
+//----------------------------------------------------------------------
+void
+RegistrationTable::rebuild_index()
+{
+    ASSERT(lock_.is_locked_by_me());
+
+    exact_regs_.clear();
+    pattern_regs_.clear();
+    reg_keys_.clear();
+    next_seqno_ = 0;
+
+    RegistrationList::iterator iter;
+    for (iter = reglist_.begin(); iter != reglist_.end(); ++iter) {
+        index_reg(*iter, next_seqno_++);
+    }
+}
+
 //----------------------------------------------------------------------
 Registration*
 RegistrationTable::get(u_int32_t regid) const
@@ -121,8 +267,9 @@ RegistrationTable::add(Registration* reg, bool add_to_store)
 {
     oasys::ScopeLock l(&lock_, "RegistrationTable");
 
-    // put it in the list
+    // put it in the list and the index
     reglist_.push_back(reg);
+    index_reg(reg, next_seqno_++);
 
     // don't store (or log) default registrations 
     if (!add_to_store || reg->regid() <= Registration::MAX_RESERVED_REGID) {
@@ -165,6 +312,7 @@ RegistrationTable::del(u_int32_t regid)
         return false;
     }
 
+    unindex_reg(*iter);
     reglist_.erase(iter);
 
     // Store (or log) default registrations and not pushed to persistent store
@@ -190,6 +338,19 @@ RegistrationTable::update(Registration* reg) const
     log_debug("updating registration %d/%s",
              reg->regid(), reg->endpoint().c_str());
 
+    // this is called on every delivery, so only rebuild the demux
+    // index in the (unusual) case that the endpoint key changed
+    KeyMap::const_iterator key_iter = reg_keys_.find(reg->regid());
+    if (key_iter != reg_keys_.end()) {
+        std::string key;
+        get_index_key(reg, &key);
+        if (key != key_iter->second) {
+            log_debug("registration %d endpoint changed, "
+                      "rebuilding demux index", reg->regid());
+            const_cast<RegistrationTable*>(this)->rebuild_index();
+        }
+    }
+
     APIRegistration* api_reg = dynamic_cast<APIRegistration*>(reg);
     if (api_reg == NULL) {
         log_err("non-api registration %d passed to registration store",
@@ -213,15 +374,42 @@ RegistrationTable::get_matching(const EndpointID& demux,
 {
     oasys::ScopeLock l(&lock_, "RegistrationTable");
 
+    oasys::Time start = oasys::Time::now();
     int count = 0;
-    
-    RegistrationList::const_iterator iter;
     Registration* reg;
 
     log_debug("get_matching %s", demux.c_str());
 
-    for (iter = reglist_.begin(); iter != reglist_.end(); ++iter) {
-        reg = *iter;
+    // collect the candidates: all the pattern registrations plus any
+    // exact match ones for the demux key
+    IndexEntryVec candidates;
+    std::string key;
+    demux_key_t ret = get_demux_key(demux, &key);
+    if (ret == DEMUX_KEY_WILDCARD) {
+        // a wildcard demux string could match any registration
+        RegistrationList::const_iterator iter;
+        u_int32_t seqno = 0;
+        for (iter = reglist_.begin(); iter != reglist_.end(); ++iter) {
+            candidates.push_back(IndexEntry(seqno++, *iter));
+        }
+        stats_.scans_++;
+        
+    } else {
+        candidates = pattern_regs_;
+        if (ret == DEMUX_KEY_OK) {
+            ExactIndex::const_iterator bucket = exact_regs_.find(key);
+            if (bucket != exact_regs_.end()) {
+                candidates.insert(candidates.end(),
+                                  bucket->second.begin(),
+                                  bucket->second.end());
+                std::sort(candidates.begin(), candidates.end());
+            }
+        }
+    }
+    
+    IndexEntryVec::const_iterator iter;
+    for (iter = candidates.begin(); iter != candidates.end(); ++iter) {
+        reg = iter->reg_;
 
         if (reg->endpoint().match(demux)) {
             log_debug("matched registration %d %s",
@@ -231,11 +419,36 @@ RegistrationTable::get_matching(const EndpointID& demux,
         }
     }
 
-    log_debug("get_matching %s: returned %d matches", demux.c_str(), count);
+    oasys::Time elapsed = oasys::Time::now() - start;
+    u_int64_t usec = ((u_int64_t)elapsed.sec_ * 1000000) + elapsed.usec_;
+    stats_.lookups_++;
+    stats_.total_usec_ += usec;
+    if (usec > stats_.max_usec_) {
+        stats_.max_usec_ = usec;
+    }
+
+    log_debug("get_matching %s: returned %d matches (%zu candidates)",
+              demux.c_str(), count, candidates.size());
     return count;
 }
 
+//----------------------------------------------------------------------
+RegistrationTable::DemuxStats
+RegistrationTable::demux_stats() const
+{
+    oasys::ScopeLock l(&lock_, "RegistrationTable");
+    return stats_;
+}
+
+//----------------------------------------------------------------------
+void
+RegistrationTable::reset_demux_stats()
+{
+    oasys::ScopeLock l(&lock_, "RegistrationTable");
+    memset(&stats_, 0, sizeof(stats_));
+}
 
+//----------------------------------------------------------------------
 void
 RegistrationTable::dump(oasys::StringBuffer* buf) const
 {
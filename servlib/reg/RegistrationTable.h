@@ -17,9 +17,12 @@
 #ifndef _REGISTRATION_TABLE_H_
 #define _REGISTRATION_TABLE_H_
 
+#include <map>
 #include <string>
+#include <vector>
 #include <oasys/debug/DebugUtils.h>
 #include <oasys/util/StringBuffer.h>
+#include <oasys/util/StringUtils.h>
 
 #include "Registration.h"
 
@@ -28,6 +31,13 @@ namespace dtn {
 /**
  * Class for the in-memory registration table. All changes to the
  * table are made persistent via the RegistrationStore.
+ *
+ * To keep demux cost independent of the number of registrations,
+ * registrations whose endpoint can only match a single demux string
+ * (dtn and ipn scheme endpoints without wildcards) are also indexed
+ * in a hash table keyed by a canonical form of the endpoint. All
+ * other registrations are kept on a separate pattern list that is
+ * checked for every demux.
  */
 class RegistrationTable : public oasys::Logger {
 public:
@@ -89,6 +99,26 @@ public:
      */
     int get_matching(const EndpointID& eid, RegistrationList* reg_list) const;
     
+    /**
+     * Statistics for the get_matching demux step.
+     */
+    struct DemuxStats {
+        u_int32_t lookups_;	///< number of get_matching calls
+        u_int32_t scans_;	///< lookups that needed a full scan
+        u_int64_t total_usec_;	///< total time spent in get_matching
+        u_int64_t max_usec_;	///< longest get_matching call
+    };
+
+    /**
+     * Return a copy of the demux statistics.
+     */
+    DemuxStats demux_stats() const;
+
+    /**
+     * Reset the demux statistics.
+     */
+    void reset_demux_stats();
+    
     /**
      * Delete any expired registrations
      *
@@ -119,12 +149,70 @@ protected:
     bool find(u_int32_t regid, RegistrationList::iterator* iter);
 
     /**
-     * All registrations are tabled in-memory in a flat list. It's
-     * non-obvious what else would be better since we need to do a
-     * prefix match on demux strings in matching_registrations.
+     * Return values for get_demux_key.
+     */
+    typedef enum {
+        DEMUX_KEY_OK,		///< key is valid
+        DEMUX_KEY_NONE,		///< no indexed registration can match
+        DEMUX_KEY_WILDCARD	///< eid contains wildcards
+    } demux_key_t;
+
+    /**
+     * Compute the canonical exact-match key for an endpoint. The key
+     * includes exactly the parts of the endpoint that the dtn and ipn
+     * scheme match functions compare.
+     */
+    static demux_key_t get_demux_key(const EndpointID& eid, std::string* key);
+
+    /**
+     * Compute the key under which a registration is indexed, or an
+     * empty string if it belongs on the pattern list.
+     */
+    static void get_index_key(const Registration* reg, std::string* key);
+
+    /// @{
+    /// Helpers to maintain the demux index
+    void index_reg(Registration* reg, u_int32_t seqno);
+    void unindex_reg(Registration* reg);
+    void rebuild_index();
+    /// @}
+
+    /**
+     * All registrations are tabled in-memory in a flat list, which
+     * is used for lookups by regid and for full scans. The demux
+     * index below is kept in sync with it.
      */
     RegistrationList reglist_;
 
+    /// An entry in the demux index. The sequence number reflects the
+    /// position in reglist_ so that matches are returned in the same
+    /// order as a scan of the list.
+    struct IndexEntry {
+        IndexEntry(u_int32_t seqno, Registration* reg)
+            : seqno_(seqno), reg_(reg) {}
+
+        bool operator<(const IndexEntry& other) const
+        {
+            return seqno_ < other.seqno_;
+        }
+        
+        u_int32_t     seqno_;
+        Registration* reg_;
+    };
+    typedef std::vector<IndexEntry> IndexEntryVec;
+    typedef oasys::StringHashMap<IndexEntryVec> ExactIndex;
+
+    /// Map from regid to the key the registration is indexed under
+    typedef std::map<u_int32_t, std::string> KeyMap;
+
+    ExactIndex    exact_regs_;	///< exact match registrations by key
+    IndexEntryVec pattern_regs_;	///< all other registrations
+    KeyMap        reg_keys_;	///< index key for each registration
+    u_int32_t     next_seqno_;	///< sequence number for the next add
+
+    /// Demux statistics
+    mutable DemuxStats stats_;
+
     /**
      * Lock to protect internal data structures.
      */
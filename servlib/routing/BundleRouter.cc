@@ -248,6 +248,14 @@ BundleRouter::tcl_dump_state(oasys::StringBuffer* buf)
     buf->append("{}");
 }
 
+//----------------------------------------------------------------------
+bool
+BundleRouter::parallel_safe(const BundleEvent* event) const
+{
+    (void)event;
+    return false;
+}
+
 //----------------------------------------------------------------------
 void
 BundleRouter::recompute_routes()
@@ -173,6 +173,20 @@ public:
      */
     virtual void tcl_dump_state(oasys::StringBuffer* buf);
 
+    /**
+     * Synchronous probe indicating whether the router's handler for
+     * the given bundle-scoped event (bundle received, transmitted,
+     * delivered or expired) may run concurrently with its handlers
+     * for events on other bundles. This is only consulted when the
+     * daemon is configured with event shards (see
+     * BundleDaemon::Params::event_shards_). Events for any one bundle
+     * are always handled in order, and all other events are handled
+     * serially once the shards have drained.
+     *
+     * The default implementation returns false.
+     */
+    virtual bool parallel_safe(const BundleEvent* event) const;
+
     /**
      * Hook to force route recomputation from the command interpreter.
      * The default implementation does nothing.
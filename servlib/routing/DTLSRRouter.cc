@@ -521,7 +521,7 @@ DTLSRRouter::is_dynamic_route(RouteEntry* entry)
 
 //----------------------------------------------------------------------
 void
-DTLSRRouter::recompute_routes()
+DTLSRRouter::recompute_routes(const RoutingGraph::EdgeVector* changed)
 {
 //     // XXX/demmer make this a parameter
 //     u_int32_t elapsed = last_update_.elapsed_ms() / 1000;
@@ -531,8 +531,20 @@ DTLSRRouter::recompute_routes()
 //         return;
 //     }
 
-    log_debug("recomputing all routes");
-    last_update_.get_time();
+    // compute the shortest paths to all nodes at once. if we know
+    // which edges changed, only the affected part of the tree is
+    // recomputed, but periodically (and whenever the routes were
+    // invalidated) recompute it all since the edge weights depend on
+    // more than the advertised link state
+    if (changed != NULL && ! time_to_age_routes()) {
+        log_debug("recomputing routes for %zu changed edges",
+                  changed->size());
+        graph_.update_shortest_path_tree(local_node_, *changed, weight_fn_);
+    } else {
+        log_debug("recomputing all routes");
+        last_update_.get_time();
+        graph_.shortest_path_tree(local_node_, weight_fn_);
+    }
 
     route_table_->del_matching_entries(is_dynamic_route);
 
@@ -553,8 +565,7 @@ DTLSRRouter::recompute_routes()
         // XXX/demmer this should include more criteria for
         // classification, i.e. the priority class, perhaps the size
         // limit, etc
-        RoutingGraph::Edge* edge = graph_.best_next_hop(local_node_, dest,
-                                                        weight_fn_);
+        RoutingGraph::Edge* edge = graph_.tree_next_hop(dest);
         if (edge == NULL) {
 //            log_warn("no route to destination %s", dest->id().c_str());
             continue;
@@ -760,6 +771,7 @@ DTLSRRouter::handle_lsa(Bundle* bundle, LSA* lsa)
     // present in the LSA...
 
     // Handle all the link announcements
+    RoutingGraph::EdgeVector changed;
     for (LinkStateVec::iterator iter = lsa->links_.begin();
          iter != lsa->links_.end(); ++iter)
     {
@@ -813,9 +825,10 @@ DTLSRRouter::handle_lsa(Bundle* bundle, LSA* lsa)
 
         // XXX/demmer fold this into a parameter update method
         e->mutable_info().last_update_.get_time();
+        changed.push_back(e);
     }
 
-    recompute_routes();
+    recompute_routes(&changed);
 }
 
 //----------------------------------------------------------------------
@@ -154,7 +154,7 @@ protected:
 
     bool time_to_age_routes();
     void invalidate_routes();
-    void recompute_routes();
+    void recompute_routes(const RoutingGraph::EdgeVector* changed = NULL);
     /// @}
 
     //--------------------------------------------------------------------
@@ -30,13 +30,21 @@
 #include <map>
 #include <vector>
 #include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <fcntl.h>
 #include <string.h>
 #include <time.h>
+#include <unistd.h>
 #include <netinet/in.h>
+#include <arpa/inet.h>
 #include <sstream>
+#include <xercesc/dom/DOM.hpp>
 #include <xercesc/framework/MemBufFormatTarget.hpp>
+#include <xsd/cxx/xml/string.hxx>
 
 #include "ExternalRouter.h"
+#include "router-tlv.h"
 #include "bundling/GbofId.h"
 #include "bundling/BundleDaemon.h"
 #include "bundling/BundleActions.h"
@@ -50,17 +58,59 @@
 #include <oasys/io/IO.h>
 
 #define SEND(event, data) \
-    rtrmessage::bpa message; \
-    message.event(data); \
+    rtrmessage::bpa *message = new rtrmessage::bpa; \
+    message->event(data); \
     send(message);
 
 #define CATCH(exception) \
     catch (exception &e) { log_warn("%s", e.what()); }
 
+/// Largest message accepted on a stream connection
+#define MAX_STREAM_MESSAGE      (1024 * 1024U)
+
+/// Largest amount of unsent data kept for a stream connection before
+/// it is dropped as unresponsive
+#define MAX_STREAM_BACKLOG      (16 * 1024 * 1024U)
+
+/// Limits on the events batched into one binary stream message
+#define MAX_BATCH_EVENTS        64
+#define MAX_BATCH_BYTES         (64 * 1024U)
+
 namespace dtn {
 
 using namespace rtrmessage;
 
+// Serialize a message to xml text
+static bool
+encode_xml(const bpa &message, std::string *out)
+{
+    xercesc::MemBufFormatTarget buf;
+    xml_schema::namespace_infomap map;
+
+    if (ExternalRouter::client_validation)
+        map[""].schema = ExternalRouter::schema.c_str();
+
+    try {
+        bpa_(buf, message, map, "UTF-8",
+             xml_schema::flags::dont_initialize);
+        out->assign((char *)buf.getRawBuffer(), buf.getLen());
+        return true;
+    }
+    catch (xml_schema::serialization &e) {
+        const xml_schema::errors &elist = e.errors();
+        xml_schema::errors::const_iterator i = elist.begin();
+        xml_schema::errors::const_iterator end = elist.end();
+
+        for (; i < end; ++i) {
+            std::cout << (*i).message() << std::endl;
+        }
+    }
+    catch (xml_schema::exception &e) {
+        log_warn_p("/router/external", "%s", e.what());
+    }
+    return false;
+}
+
 ExternalRouter::ExternalRouter()
     : BundleRouter("ExternalRouter", "external")
 {
@@ -96,9 +146,9 @@ ExternalRouter::initialize()
     srv_ = new ModuleServer();
     srv_->start();
 
-    bpa message;
-    message.alert(dtnStatusType(std::string("justBooted")));
-    message.hello_interval(ExternalRouter::hello_interval);
+    bpa *message = new bpa;
+    message->alert(dtnStatusType(std::string("justBooted")));
+    message->hello_interval(ExternalRouter::hello_interval);
     send(message);
     hello_->schedule_in(ExternalRouter::hello_interval * 1000);
 }
@@ -562,6 +612,9 @@ ExternalRouter::handle_bundle_attributes_report(BundleAttributesReportEvent *eve
         else if (name == "prevhop")
             response.prevhop( br->prevhop() );
         else if (name == "payload_file") {
+            // the router reads the whole file, so a fragment can't
+            // keep sharing it with the bundle it was split from
+            br->mutable_payload()->unshare();
             response.payload_file( br->payload().filename() );
         }
     }
@@ -673,34 +726,13 @@ ExternalRouter::handle_route_report(RouteReportEvent* event)
 }
 
 void
-ExternalRouter::send(bpa &message)
+ExternalRouter::send(bpa *message)
 {
-    xercesc::MemBufFormatTarget buf;
-    xml_schema::namespace_infomap map;
-
-    message.eid(BundleDaemon::instance()->local_eid().c_str());
-
-    if (ExternalRouter::client_validation)
-        map[""].schema = ExternalRouter::schema.c_str();
+    message->eid(BundleDaemon::instance()->local_eid().c_str());
 
-    try {
-        bpa_(buf, message, map, "UTF-8",
-             xml_schema::flags::dont_initialize);
-        srv_->eventq->push_back(new std::string((char *)buf.getRawBuffer()));
-    }
-    catch (xml_schema::serialization &e) {
-        const xml_schema::errors &elist = e.errors();
-        xml_schema::errors::const_iterator i = elist.begin();
-        xml_schema::errors::const_iterator end = elist.end();
-
-        for (; i < end; ++i) {
-            std::cout << (*i).message() << std::endl;
-        }
-    }
-    CATCH(xml_schema::unexpected_element)
-    CATCH(xml_schema::no_namespace_mapping)
-    CATCH(xml_schema::no_prefix_mapping)
-    CATCH(xml_schema::xsi_already_in_use)
+    // the module server thread does the encoding, since which
+    // encodings are needed depends on the connected routers
+    srv_->eventq->push_back(message);
 }
 
 const char *
@@ -763,42 +795,124 @@ ExternalRouter::ModuleServer::ModuleServer()
 
     set_logfd(false);
 
-    eventq = new oasys::MsgQueue< std::string * >(logpath_, lock_);
+    eventq = new oasys::MsgQueue< bpa * >(logpath_, lock_);
+
+    open_listeners();
 }
 
 ExternalRouter::ModuleServer::~ModuleServer()
 {
     // free all pending events
-    std::string *event;
+    bpa *event;
     while (eventq->try_pop(&event))
         delete event;
 
     delete eventq;
+
+    while (!clients_.empty())
+        close_client(clients_.size() - 1);
+
+    for (size_t i = 0; i < listeners_.size(); ++i)
+        ::close(listeners_[i]);
+
+    if (!ExternalRouter::stream_path.empty())
+        unlink(ExternalRouter::stream_path.c_str());
+}
+
+// Open the TCP and Unix domain listening sockets
+void
+ExternalRouter::ModuleServer::open_listeners()
+{
+    if (ExternalRouter::stream_port != 0) {
+        struct sockaddr_in sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sin_family = AF_INET;
+        sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        sa.sin_port = htons(ExternalRouter::stream_port);
+
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        const int on = 1;
+        setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+        if (fd < 0 || ::bind(fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 ||
+            listen(fd, 8) != 0)
+        {
+            log_err("ExternalRouter::ModuleServer::open_listeners():  "
+                    "Failed to listen on port %u:  %s",
+                    ExternalRouter::stream_port, strerror(errno));
+            if (fd >= 0)
+                ::close(fd);
+        } else {
+            log_info("listening for external routers on port %u",
+                     ExternalRouter::stream_port);
+            listeners_.push_back(fd);
+        }
+    }
+
+    if (!ExternalRouter::stream_path.empty()) {
+        struct sockaddr_un sa;
+        memset(&sa, 0, sizeof(sa));
+        sa.sun_family = AF_UNIX;
+        strncpy(sa.sun_path, ExternalRouter::stream_path.c_str(),
+                sizeof(sa.sun_path) - 1);
+
+        unlink(sa.sun_path);
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd < 0 || ::bind(fd, (struct sockaddr *)&sa, sizeof(sa)) != 0 ||
+            listen(fd, 8) != 0)
+        {
+            log_err("ExternalRouter::ModuleServer::open_listeners():  "
+                    "Failed to listen on %s:  %s",
+                    sa.sun_path, strerror(errno));
+            if (fd >= 0)
+                ::close(fd);
+        } else {
+            log_info("listening for external routers on %s", sa.sun_path);
+            listeners_.push_back(fd);
+        }
+    }
 }
 
 // ModuleServer main loop
 void
 ExternalRouter::ModuleServer::run() 
 {
-    // block on input from the socket and
+    // block on input from the socket, the stream connections and
     // on input from the bundle event list
-    struct pollfd pollfds[2];
-
-    struct pollfd* event_poll = &pollfds[0];
-    event_poll->fd = eventq->read_fd();
-    event_poll->events = POLLIN;
-    event_poll->revents = 0;
-
-    struct pollfd* sock_poll = &pollfds[1];
-    sock_poll->fd = fd();
-    sock_poll->events = POLLIN;
-    sock_poll->revents = 0;
+    std::vector<struct pollfd> pollfds;
 
     while (1) {
         if (should_stop()) return;
 
+        pollfds.resize(2 + listeners_.size() + clients_.size());
+
+        struct pollfd* event_poll = &pollfds[0];
+        event_poll->fd = eventq->read_fd();
+        event_poll->events = POLLIN;
+        event_poll->revents = 0;
+
+        struct pollfd* sock_poll = &pollfds[1];
+        sock_poll->fd = fd();
+        sock_poll->events = POLLIN;
+        sock_poll->revents = 0;
+
+        struct pollfd* listen_poll = &pollfds[0] + 2;
+        for (size_t i = 0; i < listeners_.size(); ++i) {
+            listen_poll[i].fd = listeners_[i];
+            listen_poll[i].events = POLLIN;
+            listen_poll[i].revents = 0;
+        }
+
+        struct pollfd* client_poll = listen_poll + listeners_.size();
+        for (size_t i = 0; i < clients_.size(); ++i) {
+            client_poll[i].fd = clients_[i]->fd_;
+            client_poll[i].events = POLLIN;
+            if (!clients_[i]->outbuf_.empty())
+                client_poll[i].events |= POLLOUT;
+            client_poll[i].revents = 0;
+        }
+
         // block waiting...
-        int ret = oasys::IO::poll_multiple(pollfds, 2, -1,
+        int ret = oasys::IO::poll_multiple(&pollfds[0], pollfds.size(), -1,
             get_notifier());
 
         if (ret == oasys::IOINTR) {
@@ -813,30 +927,264 @@ ExternalRouter::ModuleServer::run()
             continue;
         }
 
-        // check for an event
+        if (sock_poll->revents & POLLIN) {
+            u_char buf[MAX_UDP_PACKET];
+            in_addr_t raddr;
+            u_int16_t rport;
+            int bytes;
+
+            bytes = recvfrom((char *)buf, MAX_UDP_PACKET, 0, &raddr, &rport);
+            if (bytes > 0)
+                process_payload(buf, bytes);
+        }
+
+        // service the connections before anything that can add or
+        // close one changes the client indices. closing one only
+        // shifts the clients after it, so go backwards
+        for (size_t i = clients_.size(); i-- > 0; ) {
+            StreamClient *client = clients_[i];
+            short revents = client_poll[i].revents;
+
+            bool ok = true;
+            if (revents & (POLLIN | POLLHUP | POLLERR))
+                ok = read_client(client);
+            if (ok && (revents & POLLOUT))
+                ok = write_client(client);
+            if (!ok)
+                close_client(i);
+        }
+
+        // check for events
         if (event_poll->revents & POLLIN) {
-            std::string *event;
-            if (eventq->try_pop(&event)) {
-                ASSERT(event != NULL)
-                sendto(const_cast< char * >(event->c_str()),
-                    event->size(), 0,
+            send_events();
+        }
+
+        for (size_t i = 0; i < listeners_.size(); ++i) {
+            if (listen_poll[i].revents & POLLIN)
+                accept_client(listeners_[i]);
+        }
+    }
+}
+
+// Encode the queued events and send them out, batching events for
+// binary stream connections
+void
+ExternalRouter::ModuleServer::send_events()
+{
+    bool need_xml = (ExternalRouter::server_encoding == ENCODING_XML);
+    bool need_binary = (ExternalRouter::server_encoding == ENCODING_BINARY);
+    for (size_t i = 0; i < clients_.size(); ++i) {
+        if (!clients_[i]->negotiated_)
+            continue;
+        if (clients_[i]->encoding_ == ENCODING_BINARY)
+            need_binary = true;
+        else
+            need_xml = true;
+    }
+
+    std::string header;
+    RouterTLV::Encoder header_enc(&header);
+    header_enc.begin_payload();
+
+    std::string batch(header);
+    bpa *event;
+    for (int count = 0;
+         count < MAX_BATCH_EVENTS && batch.size() < MAX_BATCH_BYTES &&
+             eventq->try_pop(&event);
+         ++count)
+    {
+        ASSERT(event != NULL);
+
+        if (need_xml) {
+            std::string xml;
+            if (encode_xml(*event, &xml)) {
+                if (ExternalRouter::server_encoding == ENCODING_XML)
+                    sendto(const_cast< char * >(xml.c_str()),
+                        xml.size(), 0,
+                        htonl(INADDR_ALLRTRS_GROUP),
+                        ExternalRouter::server_port);
+
+                for (size_t i = clients_.size(); i-- > 0; ) {
+                    StreamClient *client = clients_[i];
+                    if (client->negotiated_ &&
+                        client->encoding_ == ENCODING_XML &&
+                        !send_client(client, xml))
+                        close_client(i);
+                }
+            }
+        }
+
+        if (need_binary) {
+            size_t start = batch.size();
+            RouterTLV::Encoder enc(&batch);
+            bpa_tlv(*event, &enc);
+            if (ExternalRouter::server_encoding == ENCODING_BINARY) {
+                std::string packet(header);
+                packet.append(batch, start, std::string::npos);
+                sendto(const_cast< char * >(packet.data()),
+                    packet.size(), 0,
                     htonl(INADDR_ALLRTRS_GROUP),
                     ExternalRouter::server_port);
-                delete event;
             }
         }
 
-        if (sock_poll->revents & POLLIN) {
-            char buf[MAX_UDP_PACKET];
-            in_addr_t raddr;
-            u_int16_t rport;
-            int bytes;
+        delete event;
+    }
+
+    if (batch.size() == header.size())
+        return;
+
+    for (size_t i = clients_.size(); i-- > 0; ) {
+        StreamClient *client = clients_[i];
+        if (client->negotiated_ && client->encoding_ == ENCODING_BINARY &&
+            !send_client(client, batch))
+            close_client(i);
+    }
+}
+
+// Accept a stream connection from an external router
+void
+ExternalRouter::ModuleServer::accept_client(int listen_fd)
+{
+    int fd = ::accept(listen_fd, NULL, NULL);
+    if (fd < 0) {
+        log_err("error accepting external router connection: %s",
+                strerror(errno));
+        return;
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    log_info("external router connected on fd %d", fd);
+    clients_.push_back(new StreamClient(fd));
+}
+
+// Read and handle complete messages from a stream connection
+bool
+ExternalRouter::ModuleServer::read_client(StreamClient *client)
+{
+    char buf[64 * 1024];
+    int cc = ::read(client->fd_, buf, sizeof(buf));
+    if (cc < 0 && (errno == EAGAIN || errno == EINTR))
+        return true;
+    if (cc <= 0)
+        return false;
+
+    client->inbuf_.append(buf, cc);
+
+    size_t offset = 0;
+    while (client->inbuf_.size() - offset >= 4) {
+        u_int32_t len;
+        memcpy(&len, client->inbuf_.data() + offset, 4);
+        len = ntohl(len);
+
+        if (len > MAX_STREAM_MESSAGE) {
+            log_err("message length %u too large from external router",
+                    len);
+            return false;
+        }
+
+        if (client->inbuf_.size() - offset - 4 < len)
+            break;
 
-            bytes = recvfrom(buf, MAX_UDP_PACKET, 0, &raddr, &rport);
-            buf[bytes] = '\0';
+        const u_char *payload =
+            (const u_char *)client->inbuf_.data() + offset + 4;
 
-            process_action(buf);
+        if (!client->negotiated_) {
+            client->negotiated_ = true;
+            client->encoding_ = RouterTLV::is_binary(payload, len) ?
+                                ENCODING_BINARY : ENCODING_XML;
+            log_info("external router on fd %d using %s encoding",
+                     client->fd_,
+                     client->encoding_ == ENCODING_BINARY ? "binary" : "xml");
         }
+
+        process_payload(payload, len);
+        offset += 4 + len;
+    }
+
+    client->inbuf_.erase(0, offset);
+    return true;
+}
+
+// Queue a message on a stream connection
+bool
+ExternalRouter::ModuleServer::send_client(StreamClient *client,
+                                          const std::string &payload)
+{
+    if (client->outbuf_.size() > MAX_STREAM_BACKLOG) {
+        log_warn("external router on fd %d is not keeping up, closing",
+                 client->fd_);
+        return false;
+    }
+
+    u_int32_t len = htonl(payload.size());
+    client->outbuf_.append((char *)&len, 4);
+    client->outbuf_.append(payload);
+    return write_client(client);
+}
+
+// Write out as much queued data as the connection will take
+bool
+ExternalRouter::ModuleServer::write_client(StreamClient *client)
+{
+    while (!client->outbuf_.empty()) {
+        int cc = ::write(client->fd_, client->outbuf_.data(),
+                         client->outbuf_.size());
+        if (cc < 0 && errno == EINTR)
+            continue;
+        if (cc < 0 && errno == EAGAIN)
+            return true;
+        if (cc < 0) {
+            log_info("error writing to external router on fd %d: %s",
+                     client->fd_, strerror(errno));
+            return false;
+        }
+        client->outbuf_.erase(0, cc);
+    }
+    return true;
+}
+
+// Close a stream connection
+void
+ExternalRouter::ModuleServer::close_client(size_t i)
+{
+    StreamClient *client = clients_[i];
+    log_info("external router on fd %d disconnected", client->fd_);
+    ::close(client->fd_);
+    delete client;
+    clients_.erase(clients_.begin() + i);
+}
+
+// Handle a message in either encoding
+void
+ExternalRouter::ModuleServer::process_payload(const u_char *buf, size_t len)
+{
+    if (RouterTLV::is_binary(buf, len)) {
+        process_binary(buf, len);
+    } else {
+        std::string payload((const char *)buf, len);
+        process_action(payload.c_str());
+    }
+}
+
+// Handle binary messages from an external router
+void
+ExternalRouter::ModuleServer::process_binary(const u_char *buf, size_t len)
+{
+    RouterTLV::Decoder dec(buf, len);
+    if (!dec.begin_payload()) {
+        log_debug("received invalid binary message");
+        return;
+    }
+
+    while (!dec.done()) {
+        std::auto_ptr<bpa> instance = bpa_tlv(&dec);
+        if (instance.get() == NULL) {
+            log_debug("received invalid binary message");
+            return;
+        }
+
+        process_message(instance.get());
     }
 }
 
@@ -856,6 +1204,13 @@ ExternalRouter::ModuleServer::process_action(const char *payload)
         return;
     }
 
+    process_document(doc);
+}
+
+// Handle a parsed XML message from an external router
+void
+ExternalRouter::ModuleServer::process_document(const xercesc::DOMDocument *doc)
+{
     std::auto_ptr<bpa> instance;
 
     try {
@@ -872,6 +1227,13 @@ ExternalRouter::ModuleServer::process_action(const char *payload)
     if (instance.get() == 0)
         return;
 
+    process_message(instance.get());
+}
+
+// Handle a message from an external router
+void
+ExternalRouter::ModuleServer::process_message(bpa *instance)
+{
     // @@@ Need to add:
     //      broadcast_send_bundle_request
 
@@ -1574,8 +1936,8 @@ ExternalRouter::HelloTimer::~HelloTimer()
 void
 ExternalRouter::HelloTimer::timeout(const struct timeval &)
 {
-    bpa message;
-    message.hello_interval(ExternalRouter::hello_interval);
+    bpa *message = new bpa;
+    message->hello_interval(ExternalRouter::hello_interval);
     router_->send(message);
     schedule_in(ExternalRouter::hello_interval * 1000);
 }
@@ -1599,10 +1961,11 @@ ExternalRouter::ERRegistration::deliver_bundle(Bundle *bundle)
     bundle_delivery_event e(bundle, bundle,
                             bundle_ts_to_long(bundle->extended_id()));
 
+    bundle->mutable_payload()->unshare();
     e.bundle().payload_file( bundle->payload().filename() );
 
-    bpa message;
-    message.bundle_delivery_event(e);
+    bpa *message = new bpa;
+    message->bundle_delivery_event(e);
     router_->send(message);
 
     BundleDaemon::post(new BundleDeliveredEvent(bundle, this));
@@ -1620,6 +1983,9 @@ u_int16_t ExternalRouter::hello_interval    = 30;
 std::string ExternalRouter::schema          = INSTALL_SYSCONFDIR "/router.xsd";
 bool ExternalRouter::server_validation      = true;
 bool ExternalRouter::client_validation      = false;
+int ExternalRouter::server_encoding         = ExternalRouter::ENCODING_XML;
+u_int16_t ExternalRouter::stream_port       = 0;
+std::string ExternalRouter::stream_path     = "";
 
 } // namespace dtn
 #endif // XERCES_C_ENABLED && EXTERNAL_DP_ENABLED
@@ -28,9 +28,11 @@
 
 #if defined(XERCES_C_ENABLED) && defined(EXTERNAL_DP_ENABLED)
 
+#include <vector>
 #include "router-custom.h"
 #include "BundleRouter.h"
 #include "RouteTable.h"
+#include "RouterTLV.h"
 #include <reg/Registration.h>
 #include <oasys/serialize/XercesXMLSerialize.h>
 #include <oasys/io/UDPClient.h>
@@ -47,6 +49,16 @@ namespace dtn {
  * XML messages and UDP multicasted to external bundle router processes.
  * XML actions received on the interface are validated, transformed
  * into events, and placed on the global event queue.
+ *
+ * Messages can also use the compact binary encoding in RouterTLV, and
+ * external routers can connect over TCP (on the loopback interface)
+ * or a Unix domain socket instead of using multicast. On a stream
+ * connection each message is preceded by its length as a 4-byte
+ * network order integer, and the encoding is negotiated by the first
+ * message the external router sends: if it is binary (an empty binary
+ * payload is enough), the connection uses the binary encoding and
+ * several events are batched into each message. No events are sent
+ * on the connection until then.
  */
 class ExternalRouter : public BundleRouter {
 public:
@@ -65,6 +77,24 @@ public:
     /// Include meta info in xml necessary for client validation 
     static bool client_validation;
 
+    /// Message encodings
+    typedef enum {
+        ENCODING_XML    = 0,
+        ENCODING_BINARY = 1,
+    } encoding_t;
+
+    /// Encoding of messages multicast to external routers (incoming
+    /// messages may use either)
+    static int server_encoding;
+
+    /// TCP port on the loopback interface for stream connections
+    /// from external routers, zero to disable
+    static u_int16_t stream_port;
+
+    /// Unix domain socket path for stream connections from external
+    /// routers, empty to disable
+    static std::string stream_path;
+
     /// The static routing table
     static RouteTable *route_table;
 
@@ -122,7 +152,9 @@ public:
     virtual void handle_bundle_attributes_report(BundleAttributesReportEvent *event);
     virtual void handle_route_report(RouteReportEvent* event);
 
-    virtual void send(rtrmessage::bpa &message);
+    /// Queue a message for the external routers, taking ownership of
+    /// it
+    virtual void send(rtrmessage::bpa *message);
 
 protected:
     class ModuleServer;
@@ -161,6 +193,13 @@ public:
      */
     virtual void run();
 
+    /**
+     * Parse an incoming XML or binary payload
+     * @param buf the payload
+     * @param len length of the payload
+     */
+    void process_payload(const u_char *buf, size_t len);
+
     /**
      * Parse incoming actions and place them on the
      * global event queue
@@ -168,8 +207,23 @@ public:
      */
     void process_action(const char *payload);
 
+    /**
+     * Parse the binary encoded actions in the payload
+     */
+    void process_binary(const u_char *buf, size_t len);
+
+    /**
+     * Parse the actions in an XML document
+     */
+    void process_document(const xercesc::DOMDocument *doc);
+
+    /**
+     * Transform an action into events for the global event queue
+     */
+    void process_message(rtrmessage::bpa *instance);
+
     /// Message queue for accepting BundleEvents from ExternalRouter
-    oasys::MsgQueue< std::string * > *eventq;
+    oasys::MsgQueue< rtrmessage::bpa * > *eventq;
 
     /// Xerces XML validating parser for incoming messages
     oasys::XercesXMLUnmarshal *parser_;
@@ -177,6 +231,45 @@ public:
     oasys::SpinLock *lock_;
 
 private:
+    /// An external router connected over TCP or a Unix domain socket
+    struct StreamClient {
+        StreamClient(int fd)
+            : fd_(fd), negotiated_(false), encoding_(ENCODING_XML) {}
+
+        int         fd_;
+        bool        negotiated_;    ///< first message received
+        int         encoding_;      ///< encoding for the connection
+        std::string inbuf_;         ///< partial incoming messages
+        std::string outbuf_;        ///< outgoing data not yet written
+    };
+
+    /// Open the stream listening sockets, if configured
+    void open_listeners();
+
+    /// Encode queued events and send them to all external routers
+    void send_events();
+
+    /// Accept a new stream connection
+    void accept_client(int listen_fd);
+
+    /// Handle incoming data on a stream connection, returning false
+    /// if it should be closed
+    bool read_client(StreamClient *client);
+
+    /// Queue a length prefixed message and try to send it, returning
+    /// false if the connection should be closed
+    bool send_client(StreamClient *client, const std::string &payload);
+
+    /// Write out queued data, returning false if the connection
+    /// should be closed
+    bool write_client(StreamClient *client);
+
+    /// Close the stream connection at the given index
+    void close_client(size_t i);
+
+    std::vector<int>            listeners_;
+    std::vector<StreamClient *> clients_;
+
     Link::link_type_t convert_link_type(rtrmessage::linkTypeType type);
     Bundle::priority_values_t convert_priority(rtrmessage::bundlePriorityType);
 
@@ -17,6 +17,8 @@
 #ifndef _MULTIGRAPH_H_
 #define _MULTIGRAPH_H_
 
+#include <functional>
+#include <queue>
 #include <vector>
 #include <oasys/debug/InlineFormatter.h>
 #include <oasys/debug/Formatter.h>
@@ -80,6 +82,42 @@ public:
     Edge* best_next_hop(const Node* a, const Node* b, WeightFn* weight_fn,
                         Bundle* bundle = NULL);
 
+    /// Compute the tree of shortest paths from the given root to all
+    /// other nodes with a single run of Dijkstra's algorithm. The
+    /// tree state is kept separately from the shortest_path state so
+    /// the two can be used independently.
+    void shortest_path_tree(const Node* root, WeightFn* weight_fn,
+                            Bundle* bundle = NULL);
+
+    /// Incrementally repair the shortest path tree after the given
+    /// edges were added or their weights changed. Only the part of
+    /// the tree that is affected by the changes is recomputed, using
+    /// the weights cached from the previous computation for all
+    /// other edges. Every new or changed edge must be passed in.
+    ///
+    /// Does a full computation from the given root if there is no
+    /// valid tree (e.g. because an edge or node was deleted).
+    void update_shortest_path_tree(const Node* root,
+                                   const EdgeVector& changed,
+                                   WeightFn* weight_fn,
+                                   Bundle* bundle = NULL);
+
+    /// Return the first edge on the path from the tree root to the
+    /// given node, or NULL if it's unreachable (or the root)
+    Edge* tree_next_hop(const Node* b) const
+    {
+        return (this->tree_root_ == NULL) ? NULL : b->tree_first_hop_;
+    }
+
+    /// Return the distance from the tree root to the given node
+    u_int32_t tree_distance(const Node* b) const
+    {
+        return (this->tree_root_ == NULL) ? 0xffffffff : b->tree_distance_;
+    }
+
+    /// Discard the shortest path tree
+    void invalidate_tree() { this->tree_root_ = NULL; }
+
     /// Clear the contents of the graph
     void clear();
 
@@ -120,7 +158,10 @@ public:
     public:
         /// Constructor
         Node(const std::string& id, const _NodeInfo info)
-            : id_(id), info_(info) {}
+            : id_(id), info_(info),
+              tree_distance_(0xffffffff),
+              tree_prev_(NULL),
+              tree_first_hop_(NULL) {}
 
         ~Node();
 
@@ -158,6 +199,12 @@ public:
         
         mutable Edge* prev_;
         /// @} 
+
+        /// @{ Shortest path tree state
+        u_int32_t tree_distance_;
+        Edge*     tree_prev_;
+        Edge*     tree_first_hop_;
+        /// @}
     };
 
     /// XXX/demmer this stupid helper function is needed because
@@ -179,7 +226,7 @@ public:
     public:
         /// Constructor
         Edge(Node* s, Node* d, const _EdgeInfo info)
-            : source_(s), dest_(d), info_(info) {}
+            : source_(s), dest_(d), info_(info), tree_weight_(0xffffffff) {}
 
         /// Destructor clears contents for debugging purposes
         ~Edge() { source_ = NULL; dest_ = NULL; }
@@ -193,9 +240,14 @@ public:
         _EdgeInfo& mutable_info() { return info_; }
 
     protected:
+        friend class MultiGraph;
+        
         Node*     source_;
         Node*     dest_;
         _EdgeInfo info_;
+
+        /// Weight used for the current shortest path tree
+        u_int32_t tree_weight_;
     };
 
     typedef oasys::InlineFormatter<_EdgeInfo> EdgeFormatter;
@@ -231,9 +283,26 @@ protected:
     /// Helper function to follow the prev_ links that result from a
     /// Dijkstra search from a to b and build an EdgeVector
     bool get_reverse_path(const Node* a, const Node* b, EdgeVector* path);
+
+    /// Queue entry for the shortest path tree computation, which
+    /// lazily skips stale entries rather than updating them in place
+    typedef std::pair<u_int32_t, Node*> TreeQueueEntry;
+    typedef std::priority_queue<TreeQueueEntry,
+                                std::vector<TreeQueueEntry>,
+                                std::greater<TreeQueueEntry> > TreeQueue;
+
+    /// Helper function to relax an edge of the shortest path tree
+    void tree_relax(Edge* edge, TreeQueue* q);
+
+    /// Helper function to run Dijkstra's algorithm over the tree
+    /// until the queue is empty
+    void tree_run(TreeQueue* q);
     
     /// The vector of all nodes
     NodeVector nodes_;
+
+    /// Root of the current shortest path tree (NULL if invalid)
+    const Node* tree_root_;
 };
 
 } // namespace dtn
@@ -24,7 +24,8 @@ namespace dtn {
 template <typename _NodeInfo, typename _EdgeInfo>
 inline MultiGraph<_NodeInfo,_EdgeInfo>
 ::MultiGraph()
-    : Logger("MultiGraph", "/dtn/route/graph")
+    : Logger("MultiGraph", "/dtn/route/graph"),
+      tree_root_(NULL)
 {
 }
 
@@ -72,6 +73,7 @@ MultiGraph<_NodeInfo,_EdgeInfo>
         if ((*iter)->id_ == id) {
             delete (*iter);
             this->nodes_.erase(iter);
+            this->tree_root_ = NULL;
             return true;
         }
     }
@@ -91,6 +93,7 @@ MultiGraph<_NodeInfo,_EdgeInfo>
     }
 
     this->nodes_.clear();
+    this->tree_root_ = NULL;
 }
     
 //----------------------------------------------------------------------
@@ -129,7 +132,13 @@ inline bool
 MultiGraph<_NodeInfo,_EdgeInfo>
 ::del_edge(Node* node, Edge* edge)
 {
-    return node->del_edge(edge);
+    if (! node->del_edge(edge)) {
+        return false;
+    }
+    
+    // the tree may have routed through the edge
+    this->tree_root_ = NULL;
+    return true;
 }
 
 
@@ -365,6 +374,175 @@ MultiGraph<_NodeInfo,_EdgeInfo>
     return path.back();
 }
 
+//----------------------------------------------------------------------
+template <typename _NodeInfo, typename _EdgeInfo>
+inline void
+MultiGraph<_NodeInfo,_EdgeInfo>
+::tree_relax(Edge* edge, TreeQueue* q)
+{
+    Node* src  = edge->source_;
+    Node* peer = edge->dest_;
+    
+    if (src->tree_distance_ == 0xffffffff ||
+        edge->tree_weight_ == 0xffffffff)
+    {
+        return;
+    }
+
+    u_int32_t distance = src->tree_distance_ + edge->tree_weight_;
+    if (distance < src->tree_distance_) {
+        distance = 0xffffffff; // overflow
+    }
+    
+    if (distance < peer->tree_distance_) {
+        peer->tree_distance_  = distance;
+        peer->tree_prev_      = edge;
+        peer->tree_first_hop_ = (src == this->tree_root_) ?
+                                edge : src->tree_first_hop_;
+        q->push(TreeQueueEntry(distance, peer));
+    }
+}
+
+//----------------------------------------------------------------------
+template <typename _NodeInfo, typename _EdgeInfo>
+inline void
+MultiGraph<_NodeInfo,_EdgeInfo>
+::tree_run(TreeQueue* q)
+{
+    while (! q->empty()) {
+        TreeQueueEntry top = q->top();
+        q->pop();
+
+        Node* cur = top.second;
+        if (top.first != cur->tree_distance_) {
+            continue; // superseded by a shorter path
+        }
+
+        for (typename EdgeVector::iterator ei = cur->out_edges_.begin();
+             ei != cur->out_edges_.end(); ++ei)
+        {
+            ASSERT((*ei)->dest_ != cur); // no loops
+            tree_relax(*ei, q);
+        }
+    }
+}
+
+//----------------------------------------------------------------------
+template <typename _NodeInfo, typename _EdgeInfo>
+inline void
+MultiGraph<_NodeInfo,_EdgeInfo>
+::shortest_path_tree(const Node* root, WeightFn* weight_fn, Bundle* bundle)
+{
+    ASSERT(root != NULL);
+    log_debug("calculating shortest path tree from %s", root->id_.c_str());
+
+    SearchInfo info(bundle);
+    
+    for (typename NodeVector::iterator i = this->nodes_.begin();
+         i != this->nodes_.end(); ++i)
+    {
+        Node* n = *i;
+        n->tree_distance_  = 0xffffffff;
+        n->tree_prev_      = NULL;
+        n->tree_first_hop_ = NULL;
+
+        for (typename EdgeVector::iterator ei = n->out_edges_.begin();
+             ei != n->out_edges_.end(); ++ei)
+        {
+            (*ei)->tree_weight_ = (*weight_fn)(info, *ei);
+        }
+    }
+
+    this->tree_root_ = root;
+    
+    Node* r = const_cast<Node*>(root);
+    r->tree_distance_ = 0;
+
+    TreeQueue q;
+    q.push(TreeQueueEntry(0, r));
+    tree_run(&q);
+}
+
+//----------------------------------------------------------------------
+template <typename _NodeInfo, typename _EdgeInfo>
+inline void
+MultiGraph<_NodeInfo,_EdgeInfo>
+::update_shortest_path_tree(const Node* root, const EdgeVector& changed,
+                            WeightFn* weight_fn, Bundle* bundle)
+{
+    if (this->tree_root_ != root) {
+        shortest_path_tree(root, weight_fn, bundle);
+        return;
+    }
+
+    log_debug("updating shortest path tree from %s for %zu changed edges",
+              root->id_.c_str(), changed.size());
+
+    SearchInfo info(bundle);
+    TreeQueue  q;
+
+    // first find all the tree edges whose weight went up and detach
+    // the subtrees hanging off them
+    NodeVector orphans;
+    for (typename EdgeVector::const_iterator ei = changed.begin();
+         ei != changed.end(); ++ei)
+    {
+        Edge* edge = *ei;
+        u_int32_t old_weight = edge->tree_weight_;
+        edge->tree_weight_ = (*weight_fn)(info, edge);
+
+        Node* peer = edge->dest_;
+        if (peer->tree_prev_ != edge || edge->tree_weight_ <= old_weight) {
+            continue;
+        }
+
+        size_t first = orphans.size();
+        orphans.push_back(peer);
+        peer->tree_distance_ = 0xffffffff;
+        
+        for (size_t i = first; i < orphans.size(); ++i) {
+            Node* n = orphans[i];
+            n->tree_prev_      = NULL;
+            n->tree_first_hop_ = NULL;
+            
+            for (typename EdgeVector::iterator oi = n->out_edges_.begin();
+                 oi != n->out_edges_.end(); ++oi)
+            {
+                Node* child = (*oi)->dest_;
+                if (child->tree_prev_ == *oi &&
+                    child->tree_distance_ != 0xffffffff)
+                {
+                    child->tree_distance_ = 0xffffffff;
+                    orphans.push_back(child);
+                }
+            }
+        }
+    }
+
+    // reattach the orphans through their best remaining in-edges
+    for (typename NodeVector::iterator ni = orphans.begin();
+         ni != orphans.end(); ++ni)
+    {
+        for (typename EdgeVector::iterator ei = (*ni)->in_edges_.begin();
+             ei != (*ni)->in_edges_.end(); ++ei)
+        {
+            tree_relax(*ei, &q);
+        }
+    }
+    
+    // then let any edges that got cheaper (or are new) shorten paths
+    for (typename EdgeVector::const_iterator ei = changed.begin();
+         ei != changed.end(); ++ei)
+    {
+        tree_relax(*ei, &q);
+    }
+
+    tree_run(&q);
+
+    log_debug("updated shortest path tree: %zu nodes detached",
+              orphans.size());
+}
+
 //----------------------------------------------------------------------
 template <typename _NodeInfo, typename _EdgeInfo>
 inline int
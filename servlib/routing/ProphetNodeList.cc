@@ -75,7 +75,10 @@ ProphetNodeList::update(const prophet::Node* n)
                 "update existing node for %s",n->dest_id());
         // update existing
         ProphetNode* a = static_cast<ProphetNode*>(*i);
-        a->set_pvalue( n->p_value() );
+        // store the predictability as of the node's age, so that
+        // aging is recomputed rather than compounded when reloaded
+        a->set_pvalue( n->p_value_at_age() );
+        a->set_age( n->age() );
         ProphetStore::instance()->update(a);
     }
 }
@@ -18,14 +18,24 @@
 #  include <dtn-config.h>
 #endif
 
+#include <algorithm>
+#include <string.h>
+#include <oasys/compat/inttypes.h>
+
 #include "BundleRouter.h"
 #include "RouteTable.h"
+#include "naming/DTNScheme.h"
+#include "naming/IPNScheme.h"
 
 namespace dtn {
 
 //----------------------------------------------------------------------
 RouteTable::RouteTable(const std::string& router_name)
-    : Logger("RouteTable", "/dtn/routing/%s/table", router_name.c_str())
+    : Logger("RouteTable", "/dtn/routing/%s/table", router_name.c_str()),
+      index_valid_(true),
+      next_seqno_(0),
+      cache_hits_(0),
+      cache_misses_(0)
 {
 }
 
@@ -47,6 +57,13 @@ RouteTable::add_entry(RouteEntry* entry)
     log_debug("add_route *%p", entry);
 
     route_table_.push_back(entry);
+
+    // new entries go at the end of the table, so (unless it's already
+    // stale) the index can be updated in place
+    if (index_valid_) {
+        index_entry(entry);
+    }
+    cache_.clear();
     
     return true;
 }
@@ -68,6 +85,7 @@ RouteTable::del_entry(const EndpointIDPattern& dest, const LinkRef& next_hop)
             
             route_table_.erase(iter);
             delete entry;
+            invalidate_index();
             return true;
         }
     }    
@@ -104,6 +122,148 @@ RouteTable::clear()
         delete *iter;
     }
     route_table_.clear();
+    invalidate_index();
+}
+
+//----------------------------------------------------------------------
+/**
+ * Helper to check whether a host string can contain glob patterns.
+ */
+static inline bool
+is_literal_host(const std::string& host)
+{
+    return (strpbrk(host.c_str(), "*?[]\\") == NULL);
+}
+
+//----------------------------------------------------------------------
+/**
+ * Helper to extract the node number from an ipn scheme eid, parsing
+ * it the same way as IPNScheme::match.
+ */
+static inline bool
+parse_ipn_node(const EndpointID& eid, u_int64_t* node)
+{
+    return (sscanf(eid.c_str(), "ipn://%" PRIu64, node) == 1);
+}
+
+//----------------------------------------------------------------------
+void
+RouteTable::index_entry(RouteEntry* entry) const
+{
+    const EndpointIDPattern& pattern = entry->dest_pattern();
+    IndexEntry ie(next_seqno_++, entry);
+
+    if (pattern.scheme() == DTNScheme::instance() &&
+        pattern.ssp() != "none")
+    {
+        const std::string& host = pattern.uri().host();
+        if (is_literal_host(host)) {
+            dtn_hosts_[host].push_back(ie);
+            return;
+        }
+
+        // host patterns of the form prefix* (including plain *)
+        std::string prefix(host, 0, host.length() - 1);
+        if (host[host.length() - 1] == '*' && is_literal_host(prefix)) {
+            dtn_prefixes_[prefix].push_back(ie);
+            return;
+        }
+    }
+    else if (pattern.scheme() == IPNScheme::instance())
+    {
+        u_int64_t node;
+        if (parse_ipn_node(pattern, &node)) {
+            ipn_nodes_[node].push_back(ie);
+            return;
+        }
+    }
+
+    wildcards_.push_back(ie);
+}
+
+//----------------------------------------------------------------------
+void
+RouteTable::rebuild_index() const
+{
+    dtn_hosts_.clear();
+    dtn_prefixes_.clear();
+    ipn_nodes_.clear();
+    wildcards_.clear();
+    next_seqno_ = 0;
+
+    RouteEntryVec::const_iterator iter;
+    for (iter = route_table_.begin(); iter != route_table_.end(); ++iter) {
+        index_entry(*iter);
+    }
+
+    index_valid_ = true;
+    
+    log_debug("rebuilt route index: %zu hosts, %zu prefixes, "
+              "%zu ipn nodes, %zu wildcards",
+              dtn_hosts_.size(), dtn_prefixes_.size(),
+              ipn_nodes_.size(), wildcards_.size());
+}
+
+//----------------------------------------------------------------------
+void
+RouteTable::invalidate_index()
+{
+    ASSERT(lock_.is_locked_by_me());
+    index_valid_ = false;
+    cache_.clear();
+}
+
+//----------------------------------------------------------------------
+bool
+RouteTable::get_candidates(const EndpointID& eid,
+                           IndexEntryVec* candidates) const
+{
+    ASSERT(index_valid_);
+    
+    candidates->insert(candidates->end(),
+                       wildcards_.begin(), wildcards_.end());
+
+    if (eid.scheme() == DTNScheme::instance())
+    {
+        // DTNScheme::match globs the hosts in both directions, so
+        // for a wildcard host in the eid any entry could match
+        const std::string& host = eid.uri().host();
+        if (! is_literal_host(host)) {
+            return false;
+        }
+
+        HostIndex::const_iterator iter = dtn_hosts_.find(host);
+        if (iter != dtn_hosts_.end()) {
+            candidates->insert(candidates->end(),
+                               iter->second.begin(), iter->second.end());
+        }
+
+        if (! dtn_prefixes_.empty()) {
+            for (size_t len = 0; len <= host.length(); ++len) {
+                iter = dtn_prefixes_.find(host.substr(0, len));
+                if (iter != dtn_prefixes_.end()) {
+                    candidates->insert(candidates->end(),
+                                       iter->second.begin(),
+                                       iter->second.end());
+                }
+            }
+        }
+    }
+    else
+    {
+        u_int64_t node;
+        if (parse_ipn_node(eid, &node)) {
+            NodeIndex::const_iterator iter = ipn_nodes_.find(node);
+            if (iter != ipn_nodes_.end()) {
+                candidates->insert(candidates->end(),
+                                   iter->second.begin(),
+                                   iter->second.end());
+            }
+        }
+    }
+
+    std::sort(candidates->begin(), candidates->end());
+    return true;
 }
 
 //----------------------------------------------------------------------
@@ -114,11 +274,48 @@ RouteTable::get_matching(const EndpointID& eid,
 {
     oasys::ScopeLock l(&lock_, "RouteTable::get_matching");
 
-    bool loop = false;
     log_debug("get_matching %s (link %s)...", eid.c_str(),
               next_hop != NULL ? next_hop->name() : "NULL");
-    size_t ret = get_matching_helper(eid, next_hop, entry_vec, &loop, 0);
-    if (loop) {
+
+    if (! index_valid_) {
+        rebuild_index();
+    }
+
+    MatchCache::iterator iter = cache_.find(eid.str());
+    if (iter != cache_.end()) {
+        ++cache_hits_;
+    } else {
+        ++cache_misses_;
+        if (cache_.size() >= MATCH_CACHE_MAX) {
+            log_debug("get_matching: flushing full lookup cache");
+            cache_.clear();
+        }
+
+        CachedMatch match;
+        match.loop_ = false;
+        LinkRef null_link("RouteTable::get_matching: null");
+        get_matching_helper(eid, null_link, &match.entries_, &match.loop_, 0);
+        iter = cache_.insert(MatchCache::value_type(eid.str(), match)).first;
+    }
+
+    // filter the memoized matches by next hop, skipping any that the
+    // caller already has
+    size_t ret = 0;
+    const RouteEntryVec& matches = iter->second.entries_;
+    RouteEntryVec::const_iterator i;
+    for (i = matches.begin(); i != matches.end(); ++i) {
+        RouteEntry* entry = *i;
+        if (next_hop != NULL && entry->link() != next_hop) {
+            continue;
+        }
+        
+        if (std::find(entry_vec->begin(), entry_vec->end(), entry) == entry_vec->end()) {
+            entry_vec->push_back(entry);
+            ++ret;
+        }
+    }
+    
+    if (iter->second.loop_) {
         log_warn("route destination %s caused route table lookup loop",
                  eid.c_str());
     }
@@ -133,13 +330,21 @@ RouteTable::get_matching_helper(const EndpointID& eid,
                                 bool*             loop,
                                 int               level) const
 {
-    RouteEntryVec::const_iterator iter;
+    IndexEntryVec candidates;
     RouteEntry* entry;
     size_t count = 0;
 
-    for (iter = route_table_.begin(); iter != route_table_.end(); ++iter)
+    if (! get_candidates(eid, &candidates)) {
+        candidates.clear();
+        for (size_t i = 0; i < route_table_.size(); ++i) {
+            candidates.push_back(IndexEntry(i, route_table_[i]));
+        }
+    }
+
+    IndexEntryVec::const_iterator iter;
+    for (iter = candidates.begin(); iter != candidates.end(); ++iter)
     {
-        entry = *iter;
+        entry = iter->entry_;
 
         log_debug("check entry *%p", entry);
 
@@ -222,6 +427,26 @@ RouteTable::dump(oasys::StringBuffer* buf) const
     
     buf->append("\nClass of Service (COS) bits:\n"
                 "\tB: Bulk  N: Normal  E: Expedited\n\n");
+
+    dump_stats(buf);
+}
+
+//----------------------------------------------------------------------
+void
+RouteTable::dump_stats(oasys::StringBuffer* buf) const
+{
+    oasys::ScopeLock l(&lock_, "RouteTable::dump_stats");
+
+    if (! index_valid_) {
+        rebuild_index();
+    }
+
+    buf->appendf("Route index: %zu dtn hosts -- %zu dtn host prefixes -- "
+                 "%zu ipn nodes -- %zu wildcard patterns\n",
+                 dtn_hosts_.size(), dtn_prefixes_.size(),
+                 ipn_nodes_.size(), wildcards_.size());
+    buf->appendf("Lookup cache: %zu destinations -- %u hits -- %u misses\n\n",
+                 cache_.size(), cache_hits_, cache_misses_);
 }
 
 //----------------------------------------------------------------------
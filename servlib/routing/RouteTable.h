@@ -17,6 +17,7 @@
 #ifndef _BUNDLE_ROUTETABLE_H_
 #define _BUNDLE_ROUTETABLE_H_
 
+#include <map>
 #include <set>
 #include <oasys/debug/Log.h>
 #include <oasys/util/StringBuffer.h>
@@ -30,6 +31,18 @@ namespace dtn {
 /**
  * Class that implements the routing table, implemented
  * with an stl vector.
+ *
+ * To avoid matching every entry's pattern against every destination,
+ * the table also keeps a scheme-aware index of the entries: dtn
+ * scheme patterns are indexed by their literal host (or host prefix
+ * for patterns of the form dtn://prefix*), ipn scheme patterns by
+ * node number, and all other patterns are kept on a wildcard list
+ * that is always checked. Index lookups only select candidates; each
+ * candidate is still checked with EndpointIDPattern::match, so the
+ * results are identical to a full scan of the table.
+ *
+ * In addition, the results of get_matching are memoized by
+ * destination and the memo is flushed on any change to the table.
  */
 class RouteTable : public oasys::Logger {
 public:
@@ -105,6 +118,11 @@ public:
      */
     void dump(oasys::StringBuffer* buf) const;
 
+    /**
+     * Dump the index and lookup cache statistics.
+     */
+    void dump_stats(oasys::StringBuffer* buf) const;
+
     /**
      * Return the size of the table.
      */
@@ -129,9 +147,78 @@ protected:
                                bool*             loop,
                                int               level) const;
     
+    /// An entry in the route index, tagged with a sequence number
+    /// reflecting its position in the table so that index lookups
+    /// can return matches in table order.
+    struct IndexEntry {
+        IndexEntry(u_int32_t seqno, RouteEntry* entry)
+            : seqno_(seqno), entry_(entry) {}
+
+        bool operator<(const IndexEntry& other) const
+        {
+            return seqno_ < other.seqno_;
+        }
+        
+        u_int32_t   seqno_;
+        RouteEntry* entry_;
+    };
+    typedef std::vector<IndexEntry> IndexEntryVec;
+
+    /// Add an entry to the index
+    void index_entry(RouteEntry* entry) const;
+
+    /// Rebuild the index from the table contents
+    void rebuild_index() const;
+
+    /// Mark the index as stale and flush the lookup cache. Called
+    /// (with the lock held) whenever entries are removed.
+    void invalidate_index();
+
+    /**
+     * Collect the index entries that could possibly match the given
+     * eid, in table order.
+     *
+     * @return false if the eid can't be resolved through the index
+     * (e.g. it has a wildcard host) so the whole table must be
+     * scanned.
+     */
+    bool get_candidates(const EndpointID& eid,
+                        IndexEntryVec* candidates) const;
+    
     /// The routing table itself
     RouteEntryVec route_table_;
 
+    /// @{
+    /// The route index (rebuilt lazily after deletions)
+    typedef oasys::StringHashMap<IndexEntryVec> HostIndex;
+    typedef std::map<u_int64_t, IndexEntryVec> NodeIndex;
+    
+    mutable bool          index_valid_;	///< index is up to date
+    mutable u_int32_t     next_seqno_;	///< next entry sequence number
+    mutable HostIndex     dtn_hosts_;	///< dtn patterns by host
+    mutable HostIndex     dtn_prefixes_;	///< dtn patterns by host prefix
+    mutable NodeIndex     ipn_nodes_;	///< ipn patterns by node number
+    mutable IndexEntryVec wildcards_;	///< all other patterns
+    /// @}
+
+    /// @{
+    /// Memo of get_matching results, keyed by destination eid. The
+    /// results are for all next hops and are filtered per lookup.
+    struct CachedMatch {
+        RouteEntryVec entries_;
+        bool          loop_;
+    };
+    typedef oasys::StringHashMap<CachedMatch> MatchCache;
+
+    /// Maximum number of cached destinations (the cache is flushed
+    /// when it fills up)
+    static const size_t MATCH_CACHE_MAX = 4096;
+    
+    mutable MatchCache cache_;
+    mutable u_int32_t  cache_hits_;
+    mutable u_int32_t  cache_misses_;
+    /// @}
+
     /**
      * Lock to protect internal data structures.
      */
@@ -162,6 +249,8 @@ RouteTable::del_matching_entries(Predicate pred)
     if (!found) 
         return 0;
 
+    invalidate_index();
+
     size_t old_size = route_table_.size();
 
     // this stl ugliness first sorts the vector so all the null
@@ -0,0 +1,601 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "RouterTLV.h"
+#include "bundling/SDNV.h"
+
+namespace dtn {
+
+/**
+ * The element and attribute names from router.xsd, in the order they
+ * first appear in the schema. The index of a name (plus one) is its
+ * code on the wire, so new names must only be added at the end.
+ */
+static const char* names_[] = {
+    "bundleid", "is_fragment", "is_admin", "do_not_fragment", "priority",
+    "custody_requested", "local_custody", "singleton_dest", "custody_rcpt",
+    "receive_rcpt", "forward_rcpt", "delivery_rcpt", "deletion_rcpt",
+    "app_acked_rcpt", "creation_ts_seconds", "creation_ts_seqno",
+    "expiration", "orig_length", "frag_offset", "owner", "uri", "length",
+    "rcvd_length", "base_offset", "source", "creation_ts", "frag_length",
+    "dest", "custodian", "replyto", "prevhop", "location", "payload_file",
+    "start_time_sec", "start_time_usec", "duration", "bps", "latency",
+    "pkt_loss_prob", "link_attr", "local_addr", "remote_addr",
+    "local_port", "remote_port", "segment_ack_enabled",
+    "negative_ack_enabled", "keepalive_interval", "segment_length",
+    "busy_queue_depth", "reactive_frag_enabled", "sendbuf_length",
+    "recvbuf_length", "data_timeout", "rate", "bucket_depth", "channel",
+    "type", "nexthop", "state", "is_reachable", "is_usable",
+    "how_reliable", "how_available", "clayer", "min_retry_interval",
+    "max_retry_interval", "idle_close_time", "clinfo", "remote_eid",
+    "route_priority", "action", "link", "dest_pattern", "source_pattern",
+    "admin_type", "admin_flags", "succeeded", "reason", "orig_frag_offset",
+    "orig_frag_length", "custody_signal_seconds", "custody_signal_seqno",
+    "orig_creation_seconds", "orig_creation_seqno", "regid", "script",
+    "endpoint", "cl_params", "name", "bool_value", "u_int_value",
+    "int_value", "str_value", "identifier", "query", "meta_blocks",
+    "generated", "contents", "bundle_received_event", "gbof_id",
+    "local_id", "bytes_received", "num_meta_blocks",
+    "data_transmitted_event", "link_id", "bytes_sent", "reliably_sent",
+    "bundle_delivered_event", "bundle_delivery_event", "bundle",
+    "bundle_send_cancelled_event", "bundle_expired_event",
+    "bundle_injected_event", "request_id", "link_opened_event",
+    "contact_attr", "link_closed_event", "link_created_event",
+    "link_deleted_event", "link_available_event", "link_unavailable_event",
+    "link_attribute_changed_event", "contact_attribute_changed_event",
+    "contact_eid", "link_busy_event", "eid_reachable_event", "peer_eid",
+    "interface_name", "route_add_event", "route_entry",
+    "route_delete_event", "custody_signal_event", "custody_signal_attr",
+    "custody_timeout_event", "intentional_name_resolved_event",
+    "response_id", "router_eid", "lb_dp_eid", "intentional_name",
+    "grain_state", "canonical_eids", "app_eids",
+    "registration_added_event", "registration",
+    "registration_removed_event", "registration_expired_event",
+    "open_link_request", "close_link_request", "add_link_request",
+    "link_config_params", "link_type", "delete_link_request",
+    "reconfigure_link_request", "send_bundle_request", "metadata_block",
+    "fwd_action", "frag_size", "send_bundle_broadcast_request",
+    "cancel_bundle_request", "inject_bundle_request",
+    "delete_bundle_request", "set_cl_params_request",
+    "intentional_name_resolution_request", "deliver_bundle_to_app_request",
+    "link_query", "link_report", "link_attributes_query", "query_id",
+    "query_params", "link_attributes_report", "report_params",
+    "contact_query", "contact_report", "contact", "route_query",
+    "route_report", "bundle_query", "bundle_report",
+    "bundle_attributes_query", "bundle_attributes_report", "bpa", "eid",
+    "hello_interval", "alert",
+};
+
+//----------------------------------------------------------------------
+const RouterTLV::Dictionary&
+RouterTLV::router_names()
+{
+    static Dictionary dict(names_, sizeof(names_) / sizeof(names_[0]));
+    return dict;
+}
+
+//----------------------------------------------------------------------
+RouterTLV::Dictionary::Dictionary(const char** names, u_int count)
+    : names_(names), count_(count)
+{
+    for (u_int i = 0; i < count_; ++i) {
+        index_[names_[i]] = i + 1;
+    }
+}
+
+//----------------------------------------------------------------------
+u_int
+RouterTLV::Dictionary::code(const char* name) const
+{
+    std::map<std::string, u_int>::const_iterator iter = index_.find(name);
+    if (iter == index_.end()) {
+        return 0;
+    }
+    return iter->second;
+}
+
+//----------------------------------------------------------------------
+const char*
+RouterTLV::Dictionary::name(u_int code) const
+{
+    if (code == 0 || code > count_) {
+        return NULL;
+    }
+    return names_[code - 1];
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, bool* val)
+{
+    if (text == "true" || text == "1") {
+        *val = true;
+    } else if (text == "false" || text == "0") {
+        *val = false;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+static bool
+parse_signed(const std::string& text, long long min, long long max,
+             long long* val)
+{
+    const char* s = text.c_str();
+    if (! (s[0] == '-' || s[0] == '+' || (s[0] >= '0' && s[0] <= '9'))) {
+        return false;
+    }
+
+    char* end;
+    errno = 0;
+    long long v = strtoll(s, &end, 10);
+    if (end == s || *end != '\0' || errno != 0 || v < min || v > max) {
+        return false;
+    }
+    *val = v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+static bool
+parse_unsigned(const std::string& text, unsigned long long max,
+               unsigned long long* val)
+{
+    // strtoull would quietly negate a leading minus sign
+    const char* s = text.c_str();
+    if (! (s[0] == '+' || (s[0] >= '0' && s[0] <= '9'))) {
+        return false;
+    }
+
+    char* end;
+    errno = 0;
+    unsigned long long v = strtoull(s, &end, 10);
+    if (end == s || *end != '\0' || errno != 0 || v > max) {
+        return false;
+    }
+    *val = v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, signed char* val)
+{
+    long long v;
+    if (! parse_signed(text, SCHAR_MIN, SCHAR_MAX, &v)) {
+        return false;
+    }
+    *val = (signed char)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, short* val)
+{
+    long long v;
+    if (! parse_signed(text, SHRT_MIN, SHRT_MAX, &v)) {
+        return false;
+    }
+    *val = (short)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, int* val)
+{
+    long long v;
+    if (! parse_signed(text, INT_MIN, INT_MAX, &v)) {
+        return false;
+    }
+    *val = (int)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, long long* val)
+{
+    return parse_signed(text, LLONG_MIN, LLONG_MAX, val);
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, unsigned char* val)
+{
+    unsigned long long v;
+    if (! parse_unsigned(text, UCHAR_MAX, &v)) {
+        return false;
+    }
+    *val = (unsigned char)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, unsigned short* val)
+{
+    unsigned long long v;
+    if (! parse_unsigned(text, USHRT_MAX, &v)) {
+        return false;
+    }
+    *val = (unsigned short)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, unsigned int* val)
+{
+    unsigned long long v;
+    if (! parse_unsigned(text, UINT_MAX, &v)) {
+        return false;
+    }
+    *val = (unsigned int)v;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::parse(const std::string& text, unsigned long long* val)
+{
+    return parse_unsigned(text, ULLONG_MAX, val);
+}
+
+static const char base64_chars_[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+//----------------------------------------------------------------------
+std::string
+RouterTLV::base64_encode(const char* data, size_t len)
+{
+    const u_char* bp = (const u_char*)data;
+    std::string text;
+    text.reserve(((len + 2) / 3) * 4);
+
+    for (size_t i = 0; i < len; i += 3) {
+        u_int32_t v = bp[i] << 16;
+        if (i + 1 < len) v |= bp[i + 1] << 8;
+        if (i + 2 < len) v |= bp[i + 2];
+
+        text.push_back(base64_chars_[(v >> 18) & 0x3f]);
+        text.push_back(base64_chars_[(v >> 12) & 0x3f]);
+        text.push_back(i + 1 < len ? base64_chars_[(v >> 6) & 0x3f] : '=');
+        text.push_back(i + 2 < len ? base64_chars_[v & 0x3f] : '=');
+    }
+
+    return text;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::base64_decode(const std::string& text, std::string* data)
+{
+    data->clear();
+
+    u_int32_t v = 0;
+    u_int     bits = 0;
+    u_int     pad = 0;
+    for (size_t i = 0; i < text.size(); ++i) {
+        char c = text[i];
+        if (c == ' ' || c == '\t' || c == '\r' || c == '\n') {
+            continue;
+        }
+
+        // padding may only be followed by more padding
+        if (c == '=') {
+            pad++;
+            continue;
+        }
+        const char* p = (c == '\0') ? NULL : strchr(base64_chars_, c);
+        if (p == NULL || pad != 0) {
+            return false;
+        }
+
+        v = (v << 6) | (p - base64_chars_);
+        bits += 6;
+        if (bits >= 8) {
+            bits -= 8;
+            data->push_back((char)((v >> bits) & 0xff));
+        }
+    }
+
+    // the padding has to fill out the last group of four characters
+    return pad <= 2 && (bits == 0 ? pad == 0 : bits / 2 == pad);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::begin_payload()
+{
+    buf_->push_back((char)MAGIC);
+    buf_->push_back((char)VERSION);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::begin_element(const char* name)
+{
+    buf_->push_back((char)ELEMENT);
+    put_name(name);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::attribute(const char* name, const char* value, size_t len)
+{
+    buf_->push_back((char)ATTRIBUTE);
+    put_name(name);
+    put_string(value, len);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::text(const char* value, size_t len)
+{
+    buf_->push_back((char)TEXT);
+    put_string(value, len);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::end_element()
+{
+    buf_->push_back((char)END);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::attribute_bool(const char* name, bool value)
+{
+    attribute(name, value ? "true" : "false", value ? 4 : 5);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::attribute_int(const char* name, long long value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%lld", value);
+    attribute(name, tmp, len);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::attribute_uint(const char* name, unsigned long long value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%llu", value);
+    attribute(name, tmp, len);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::element(const char* name, const std::string& value)
+{
+    begin_element(name);
+    if (! value.empty()) {
+        text(value.data(), value.size());
+    }
+    end_element();
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::element_bool(const char* name, bool value)
+{
+    begin_element(name);
+    text(value ? "true" : "false", value ? 4 : 5);
+    end_element();
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::element_int(const char* name, long long value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%lld", value);
+    begin_element(name);
+    text(tmp, len);
+    end_element();
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::element_uint(const char* name, unsigned long long value)
+{
+    char tmp[32];
+    int len = snprintf(tmp, sizeof(tmp), "%llu", value);
+    begin_element(name);
+    text(tmp, len);
+    end_element();
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::put_sdnv(u_int64_t val)
+{
+    u_char tmp[SDNV::MAX_LENGTH];
+    int len = SDNV::encode(val, tmp, sizeof(tmp));
+    buf_->append((char*)tmp, len);
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::put_name(const char* name)
+{
+    u_int c = dict_->code(name);
+    put_sdnv(c);
+    if (c == 0) {
+        put_string(name, strlen(name));
+    }
+}
+
+//----------------------------------------------------------------------
+void
+RouterTLV::Encoder::put_string(const char* value, size_t len)
+{
+    put_sdnv(len);
+    buf_->append(value, len);
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::begin_payload()
+{
+    if (len_ < 2 || bp_[0] != MAGIC || bp_[1] != VERSION) {
+        return false;
+    }
+    bp_  += 2;
+    len_ -= 2;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::get_record(record_t* type)
+{
+    if (len_ == 0 || bp_[0] < ELEMENT || bp_[0] > END) {
+        return false;
+    }
+    *type = (record_t)bp_[0];
+    bp_  += 1;
+    len_ -= 1;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::get_name(std::string* name)
+{
+    u_int64_t c;
+    if (! get_sdnv(&c)) {
+        return false;
+    }
+
+    if (c == 0) {
+        return get_value(name) && ! name->empty();
+    }
+
+    const char* n = (c > 0xffffffff) ? NULL : dict_->name((u_int)c);
+    if (n == NULL) {
+        return false;
+    }
+    name->assign(n);
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::get_value(std::string* value)
+{
+    u_int64_t len;
+    if (! get_sdnv(&len) || len > len_) {
+        return false;
+    }
+    value->assign((const char*)bp_, len);
+    bp_  += len;
+    len_ -= len;
+    return true;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::get_text(std::string* text)
+{
+    std::string value;
+    record_t type;
+
+    text->clear();
+    while (get_record(&type)) {
+        if (type == END) {
+            return true;
+        }
+        if (type != TEXT || ! get_value(&value)) {
+            return false;
+        }
+        text->append(value);
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::skip_element()
+{
+    std::string value;
+    record_t type;
+    u_int depth = 1;
+
+    while (get_record(&type)) {
+        switch (type) {
+        case ELEMENT:
+            if (++depth > MAX_DEPTH || ! get_name(&value)) {
+                return false;
+            }
+            break;
+
+        case ATTRIBUTE:
+            if (! get_name(&value) || ! get_value(&value)) {
+                return false;
+            }
+            break;
+
+        case TEXT:
+            if (! get_value(&value)) {
+                return false;
+            }
+            break;
+
+        case END:
+            if (--depth == 0) {
+                return true;
+            }
+            break;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+bool
+RouterTLV::Decoder::get_sdnv(u_int64_t* val)
+{
+    int len = SDNV::decode(bp_, len_, val);
+    if (len <= 0) {
+        return false;
+    }
+    bp_  += len;
+    len_ -= len;
+    return true;
+}
+
+} // namespace dtn
@@ -0,0 +1,229 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _ROUTER_TLV_H_
+#define _ROUTER_TLV_H_
+
+#include <map>
+#include <string>
+#include <oasys/compat/inttypes.h>
+
+namespace dtn {
+
+/**
+ * Compact binary encoding of the router.xsd message set, used by the
+ * ExternalRouter interface as an alternative to XML text. The same
+ * records are used for the clevent.xsd messages of the external
+ * convergence layer interface, with a dictionary of that schema's
+ * names (see ECLFraming).
+ *
+ * Each message is the same element tree the XML form would carry,
+ * written as a sequence of records:
+ *
+ *   ELEMENT   <name>          start of an element
+ *   ATTRIBUTE <name> <value>  attribute of the enclosing element
+ *   TEXT      <value>         character data
+ *   END                       end of the enclosing element
+ *
+ * Record types are single bytes, and all lengths are SDNVs. A name is
+ * the SDNV index of the element or attribute name in a dictionary of
+ * the schema's names (see RouterTLV.cc), or zero followed by the
+ * name as a string if it is not in the dictionary. A value is an SDNV
+ * length followed by the UTF-8 bytes.
+ *
+ * A payload starts with the MAGIC byte (which can never start an XML
+ * document) and the VERSION, followed by any number of messages, so
+ * several messages can be batched into one payload. A payload with no
+ * messages is valid, and is used by an external router to ask for the
+ * binary encoding on a stream connection.
+ *
+ * The records for each message type are written and read straight
+ * from the xsd object model by code generated from the schema (see
+ * router-tlv.h, clevent-tlv.h and tools/xsd-tlv.py), so neither side
+ * builds a DOM. Simple values are written in their XML lexical form.
+ */
+class RouterTLV {
+public:
+    static const u_char MAGIC     = 0xb7;
+    static const u_char VERSION   = 1;
+
+    /// Limit on element nesting accepted by the decoder
+    static const u_int  MAX_DEPTH = 32;
+
+    typedef enum {
+        ELEMENT   = 1,
+        ATTRIBUTE = 2,
+        TEXT      = 3,
+        END       = 4,
+    } record_t;
+
+    /**
+     * A table of element and attribute names. The index of a name
+     * (plus one) is its code on the wire, so new names must only be
+     * added at the end.
+     */
+    class Dictionary {
+    public:
+        Dictionary(const char** names, u_int count);
+
+        /// Return the code for the given name, or zero if the name is
+        /// not in the dictionary
+        u_int code(const char* name) const;
+
+        /// Return the name for the given code, or NULL if the code is
+        /// out of range
+        const char* name(u_int code) const;
+
+    protected:
+        const char**                 names_;
+        u_int                        count_;
+        std::map<std::string, u_int> index_;
+    };
+
+    /**
+     * The dictionary of router.xsd names.
+     */
+    static const Dictionary& router_names();
+
+    /// @{ Lookups in the router.xsd dictionary
+    static u_int code(const char* name)
+    {
+        return router_names().code(name);
+    }
+
+    static const char* name(u_int code)
+    {
+        return router_names().name(code);
+    }
+    /// @}
+
+    /**
+     * Whether the buffer holds a binary (rather than XML) payload.
+     */
+    static bool is_binary(const u_char* buf, size_t len)
+    {
+        return len != 0 && buf[0] == MAGIC;
+    }
+
+    /// @{ Parse the lexical form of a simple value, returning false
+    /// if it is malformed or out of range for the type
+    static bool parse(const std::string& text, bool* val);
+    static bool parse(const std::string& text, signed char* val);
+    static bool parse(const std::string& text, short* val);
+    static bool parse(const std::string& text, int* val);
+    static bool parse(const std::string& text, long long* val);
+    static bool parse(const std::string& text, unsigned char* val);
+    static bool parse(const std::string& text, unsigned short* val);
+    static bool parse(const std::string& text, unsigned int* val);
+    static bool parse(const std::string& text, unsigned long long* val);
+    /// @}
+
+    /// @{ Convert binary data to and from its base64 lexical form
+    static std::string base64_encode(const char* data, size_t len);
+    static bool base64_decode(const std::string& text, std::string* data);
+    /// @}
+
+    /**
+     * Appends records to a string buffer.
+     */
+    class Encoder {
+    public:
+        Encoder(std::string* buf,
+                const Dictionary* dict = &router_names())
+            : buf_(buf), dict_(dict) {}
+
+        /// Write the payload header
+        void begin_payload();
+
+        /// @{ Write the records, attributes first within an element
+        void begin_element(const char* name);
+        void attribute(const char* name, const char* value, size_t len);
+        void text(const char* value, size_t len);
+        void end_element();
+        /// @}
+
+        /// @{ Write an attribute with a simple value
+        void attribute(const char* name, const std::string& value)
+        {
+            attribute(name, value.data(), value.size());
+        }
+        void attribute_bool(const char* name, bool value);
+        void attribute_int(const char* name, long long value);
+        void attribute_uint(const char* name, unsigned long long value);
+        /// @}
+
+        /// @{ Write an element with simple content
+        void element(const char* name, const std::string& value);
+        void element_bool(const char* name, bool value);
+        void element_int(const char* name, long long value);
+        void element_uint(const char* name, unsigned long long value);
+        /// @}
+
+    protected:
+        void put_sdnv(u_int64_t val);
+        void put_name(const char* name);
+        void put_string(const char* value, size_t len);
+
+        std::string*      buf_;
+        const Dictionary* dict_;
+    };
+
+    /**
+     * Reads records from a buffer, which must outlive the decoder.
+     * All functions return false if the buffer is truncated or
+     * malformed.
+     */
+    class Decoder {
+    public:
+        Decoder(const u_char* buf, size_t len,
+                const Dictionary* dict = &router_names())
+            : bp_(buf), len_(len), dict_(dict) {}
+
+        /// Check the payload header
+        bool begin_payload();
+
+        /// Whether the whole buffer has been consumed
+        bool done() const { return len_ == 0; }
+
+        /// Read the type of the next record
+        bool get_record(record_t* type);
+
+        /// Read the name of an ELEMENT or ATTRIBUTE record
+        bool get_name(std::string* name);
+
+        /// Read the value of an ATTRIBUTE or TEXT record
+        bool get_value(std::string* value);
+
+        /// Read the content of an element with simple content, up to
+        /// and including its END record
+        bool get_text(std::string* text);
+
+        /// Skip the rest of an element, up to and including its END
+        /// record
+        bool skip_element();
+
+    protected:
+        bool get_sdnv(u_int64_t* val);
+
+        const u_char*     bp_;
+        size_t            len_;
+        const Dictionary* dict_;
+    };
+};
+
+} // namespace dtn
+
+#endif /* _ROUTER_TLV_H_ */
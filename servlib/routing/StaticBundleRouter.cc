@@ -0,0 +1,65 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include "StaticBundleRouter.h"
+#include "bundling/BundleEvent.h"
+
+namespace dtn {
+
+//----------------------------------------------------------------------
+void
+StaticBundleRouter::handle_event(BundleEvent* event)
+{
+    oasys::ScopeLock l(&lock_, "StaticBundleRouter::handle_event");
+    TableBasedRouter::handle_event(event);
+}
+
+//----------------------------------------------------------------------
+bool
+StaticBundleRouter::can_delete_bundle(const BundleRef& bundle)
+{
+    // called from the daemon's handlers, which may be running on a
+    // different shard than the router's
+    oasys::ScopeLock l(&lock_, "StaticBundleRouter::can_delete_bundle");
+    return TableBasedRouter::can_delete_bundle(bundle);
+}
+
+//----------------------------------------------------------------------
+void
+StaticBundleRouter::delete_bundle(const BundleRef& bundle)
+{
+    oasys::ScopeLock l(&lock_, "StaticBundleRouter::delete_bundle");
+    TableBasedRouter::delete_bundle(bundle);
+}
+
+//----------------------------------------------------------------------
+bool
+StaticBundleRouter::parallel_safe(const BundleEvent* event) const
+{
+    switch (event->type_) {
+    case BUNDLE_RECEIVED:
+    case BUNDLE_TRANSMITTED:
+        return true;
+    default:
+        return false;
+    }
+}
+
+} // namespace dtn
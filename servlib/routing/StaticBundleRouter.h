@@ -17,6 +17,8 @@
 #ifndef _STATIC_BUNDLE_ROUTER_H_
 #define _STATIC_BUNDLE_ROUTER_H_
 
+#include <oasys/thread/SpinLock.h>
+
 #include "TableBasedRouter.h"
 
 namespace dtn {
@@ -31,11 +33,34 @@ class RouteTable;
  *
  * As a result, the class simply uses the default event handlers from
  * the table based router implementation.
+ *
+ * When the daemon runs with event shards, the bundle received and
+ * transmitted handlers are run on the shard threads. They still share
+ * the router's deferred lists, sessions and reception cache, so the
+ * router's own handlers are serialized with a lock; what runs in
+ * parallel with them is the validation of other arriving bundles and
+ * the daemon's part of the handling for other bundles.
  */
  
 class StaticBundleRouter : public TableBasedRouter {
 public:
     StaticBundleRouter() : TableBasedRouter("StaticBundleRouter", "static") {}
+
+    /// @{ Overridden from TableBasedRouter to take the router lock
+    virtual void handle_event(BundleEvent* event);
+    virtual bool can_delete_bundle(const BundleRef& bundle);
+    virtual void delete_bundle(const BundleRef& bundle);
+    /// @}
+
+    /**
+     * The received and transmitted handlers only touch router state
+     * under the router lock, so both can be handled on the shards.
+     */
+    virtual bool parallel_safe(const BundleEvent* event) const;
+
+protected:
+    /// Lock serializing the router's handlers across the shards
+    oasys::SpinLock lock_;
 };
 
 } // namespace dtn
@@ -47,6 +47,11 @@ lowercase(const char *c_str)
 
 // linkType
 
+linkType::linkType()
+    : linkType_base()
+{
+}
+
 linkType::linkType(const remote_eid::type& a,
               const type::type_& b,
               const nexthop::type& c,
@@ -186,6 +191,11 @@ linkType::_clone (::xml_schema::flags a,
 
 // bundleType
 
+bundleType::bundleType ()
+    : bundleType_base ()
+{
+}
+
 bundleType::bundleType (const source::type& a,
                         const dest::type& b,
                         const custodian::type& c,
@@ -285,6 +295,11 @@ bundleType::location_to_str(int location)
 
 // contactType
 
+contactType::contactType ()
+    : contactType_base ()
+{
+}
+
 contactType::contactType (const link_attr::type& a,
                           const start_time_sec::type& b,
                           const start_time_usec::type& c,
@@ -332,6 +347,11 @@ contactType::_clone (::xml_schema::flags a,
 
 // eidType
 
+eidType::eidType ()
+    : eidType_base ()
+{
+}
+
 eidType::eidType (const uri::type& a)
     : eidType_base (a)
 {
@@ -370,6 +390,11 @@ eidType::_clone (::xml_schema::flags a,
 
 // gbofIdType
 
+gbofIdType::gbofIdType ()
+    : gbofIdType_base ()
+{
+}
+
 gbofIdType::gbofIdType (const source::type& a,
                         const creation_ts::type& b,
                         const is_fragment::type& c,
@@ -422,6 +447,11 @@ gbofIdType::_clone (::xml_schema::flags a,
 
 // key_value_pair
 
+key_value_pair::key_value_pair ()
+    : key_value_pair_base ()
+{
+}
+
 key_value_pair::key_value_pair (const name::type& a,
                                 const bool_value::type& b)
     : key_value_pair_base (a)
@@ -503,6 +533,11 @@ key_value_pair::_clone (::xml_schema::flags a,
 
 // routeEntryType
 
+routeEntryType::routeEntryType ()
+    : routeEntryType_base ()
+{
+}
+
 routeEntryType::routeEntryType (const dest_pattern::type& a,
                                 const source_pattern::type& b,
                                 const route_priority::type& c,
@@ -548,6 +583,11 @@ routeEntryType::_clone (::xml_schema::flags a,
 // registrationType
 
 
+registrationType::registrationType ()
+    : registrationType_base ()
+{
+}
+
 registrationType::registrationType (const endpoint::type&,
                                     const regid::type&,
                                     const action::type&,
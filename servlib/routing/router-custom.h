@@ -41,6 +41,8 @@ namespace rtrmessage {
 class linkType : public linkType_base
 {
 public:
+    linkType ();
+
     linkType (const remote_eid::type&,
               const type::type_&,
               const nexthop::type&,
@@ -72,6 +74,8 @@ public:
 class bundleType : public bundleType_base
 {
 public:
+    bundleType ();
+
     bundleType (const source::type&,
                 const dest::type&,
                 const custodian::type&,
@@ -120,6 +124,8 @@ public:
 class contactType : public contactType_base
 {
 public:
+    contactType ();
+
     contactType (const link_attr::type&,
                  const start_time_sec::type&,
                  const start_time_usec::type&,
@@ -146,6 +152,8 @@ public:
 class eidType : public eidType_base
 {
 public:
+    eidType ();
+
     eidType (const uri::type&);
 
     eidType (const ::xercesc::DOMElement&,
@@ -168,6 +176,8 @@ public:
 class gbofIdType : public gbofIdType_base
 {
 public:
+    gbofIdType ();
+
     gbofIdType (const source::type&,
                 const creation_ts::type&,
                 const is_fragment::type&,
@@ -194,6 +204,8 @@ public:
 class key_value_pair : public key_value_pair_base
 {
 public:
+    key_value_pair ();
+
     key_value_pair (const name::type&,
                     const bool_value::type&);
 
@@ -224,6 +236,8 @@ public:
 class routeEntryType : public routeEntryType_base
 {
 public:
+    routeEntryType ();
+
     routeEntryType (const dest_pattern::type&,
                     const source_pattern::type&,
                     const route_priority::type&,
@@ -251,6 +265,8 @@ public:
 class registrationType : public registrationType_base
 {
 public:
+    registrationType ();
+
     registrationType (const endpoint::type&,
                       const regid::type&,
                       const action::type&,
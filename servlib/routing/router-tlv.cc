@@ -0,0 +1,5964 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Generated by tools/xsd-tlv.py from router.xsd, do not edit. Regenerate with
+// "make tlvbindings" in servlib after the xsd bindings change.
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#if defined(XERCES_C_ENABLED) && defined(EXTERNAL_DP_ENABLED)
+
+#include "router-tlv.h"
+
+namespace dtn {
+namespace rtrmessage {
+
+static void encode(const eidType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, eidType* x);
+static void encode(const gbofIdType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, gbofIdType* x);
+static void encode(const bundleType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundleType* x);
+static void encode(const contactType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, contactType* x);
+static void encode(const clInfoType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, clInfoType* x);
+static void encode(const linkType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, linkType* x);
+static void encode(const routeEntryType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, routeEntryType* x);
+static void encode(const custodySignalType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, custodySignalType* x);
+static void encode(const registrationType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, registrationType* x);
+static void encode(const linkConfigType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, linkConfigType* x);
+static void encode(const key_value_pair& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, key_value_pair* x);
+static void encode(const bundleMetaBlockQueryType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundleMetaBlockQueryType* x);
+static void encode(const bundleAttributesQueryType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundleAttributesQueryType* x);
+static void encode(const metadataBlockType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, metadataBlockType* x);
+static void encode(const bundleAttributesReportType& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundleAttributesReportType* x);
+static void encode(const bundle_received_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_received_event* x);
+static void encode(const data_transmitted_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, data_transmitted_event* x);
+static void encode(const bundle_delivered_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_delivered_event* x);
+static void encode(const bundle_delivery_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_delivery_event* x);
+static void encode(const bundle_send_cancelled_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_send_cancelled_event* x);
+static void encode(const bundle_expired_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_expired_event* x);
+static void encode(const bundle_injected_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_injected_event* x);
+static void encode(const link_opened_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_opened_event* x);
+static void encode(const link_closed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_closed_event* x);
+static void encode(const link_created_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_created_event* x);
+static void encode(const link_deleted_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_deleted_event* x);
+static void encode(const link_available_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_available_event* x);
+static void encode(const link_unavailable_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_unavailable_event* x);
+static void encode(const link_attribute_changed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_attribute_changed_event* x);
+static void encode(const contact_attribute_changed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, contact_attribute_changed_event* x);
+static void encode(const link_busy_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_busy_event* x);
+static void encode(const eid_reachable_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, eid_reachable_event* x);
+static void encode(const route_add_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, route_add_event* x);
+static void encode(const route_delete_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, route_delete_event* x);
+static void encode(const custody_signal_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, custody_signal_event* x);
+static void encode(const custody_timeout_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, custody_timeout_event* x);
+static void encode(const intentional_name_resolved_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, intentional_name_resolved_event* x);
+static void encode(const registration_added_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, registration_added_event* x);
+static void encode(const registration_removed_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, registration_removed_event* x);
+static void encode(const registration_expired_event& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, registration_expired_event* x);
+static void encode(const open_link_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, open_link_request* x);
+static void encode(const close_link_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, close_link_request* x);
+static void encode(const add_link_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, add_link_request* x);
+static void encode(const delete_link_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, delete_link_request* x);
+static void encode(const reconfigure_link_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, reconfigure_link_request* x);
+static void encode(const send_bundle_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, send_bundle_request* x);
+static void encode(const send_bundle_broadcast_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, send_bundle_broadcast_request* x);
+static void encode(const cancel_bundle_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, cancel_bundle_request* x);
+static void encode(const inject_bundle_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, inject_bundle_request* x);
+static void encode(const delete_bundle_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, delete_bundle_request* x);
+static void encode(const set_cl_params_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, set_cl_params_request* x);
+static void encode(const intentional_name_resolution_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, intentional_name_resolution_request* x);
+static void encode(const deliver_bundle_to_app_request& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, deliver_bundle_to_app_request* x);
+static void encode(const link_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_report* x);
+static void encode(const link_attributes_query& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_attributes_query* x);
+static void encode(const link_attributes_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, link_attributes_report* x);
+static void encode(const contact_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, contact_report* x);
+static void encode(const route_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, route_report* x);
+static void encode(const bundle_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_report* x);
+static void encode(const bundle_attributes_query& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_attributes_query* x);
+static void encode(const bundle_attributes_report& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bundle_attributes_report* x);
+static void encode(const bpa& x, RouterTLV::Encoder* enc);
+static bool decode(RouterTLV::Decoder* dec, bpa* x);
+
+//----------------------------------------------------------------------
+static void
+encode(const eidType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("uri", static_cast< const std::string& >(x.uri()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, eidType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "uri") {
+                eidTypeType v(text);
+                x->uri(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const gbofIdType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("creation_ts", (long long)x.creation_ts());
+    enc->attribute_bool("is_fragment", (bool)x.is_fragment());
+    enc->attribute_uint("frag_length", (unsigned long long)x.frag_length());
+    enc->attribute_uint("frag_offset", (unsigned long long)x.frag_offset());
+    enc->begin_element("source");
+    encode(x.source(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, gbofIdType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "creation_ts") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->creation_ts(v);
+                seen |= 0x2ULL;
+            } else if (name == "is_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_fragment(v);
+                seen |= 0x4ULL;
+            } else if (name == "frag_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_length(v);
+                seen |= 0x8ULL;
+            } else if (name == "frag_offset") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_offset(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        if (name == "source") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->source(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundleType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("bundleid", (unsigned long long)x.bundleid());
+    enc->attribute_bool("is_fragment", (bool)x.is_fragment());
+    enc->attribute_bool("is_admin", (bool)x.is_admin());
+    enc->attribute_bool("do_not_fragment", (bool)x.do_not_fragment());
+    enc->attribute("priority", static_cast< const std::string& >(x.priority()));
+    enc->attribute_bool("custody_requested", (bool)x.custody_requested());
+    enc->attribute_bool("local_custody", (bool)x.local_custody());
+    enc->attribute_bool("singleton_dest", (bool)x.singleton_dest());
+    enc->attribute_bool("custody_rcpt", (bool)x.custody_rcpt());
+    enc->attribute_bool("receive_rcpt", (bool)x.receive_rcpt());
+    enc->attribute_bool("forward_rcpt", (bool)x.forward_rcpt());
+    enc->attribute_bool("delivery_rcpt", (bool)x.delivery_rcpt());
+    enc->attribute_bool("deletion_rcpt", (bool)x.deletion_rcpt());
+    enc->attribute_bool("app_acked_rcpt", (bool)x.app_acked_rcpt());
+    enc->attribute_uint("creation_ts_seconds", (unsigned long long)x.creation_ts_seconds());
+    enc->attribute_uint("creation_ts_seqno", (unsigned long long)x.creation_ts_seqno());
+    enc->attribute_uint("expiration", (unsigned long long)x.expiration());
+    enc->attribute_uint("orig_length", (unsigned long long)x.orig_length());
+    enc->attribute_uint("frag_offset", (unsigned long long)x.frag_offset());
+    enc->attribute("owner", static_cast< const std::string& >(x.owner()));
+    enc->begin_element("source");
+    encode(x.source(), enc);
+    enc->end_element();
+    enc->begin_element("dest");
+    encode(x.dest(), enc);
+    enc->end_element();
+    enc->begin_element("custodian");
+    encode(x.custodian(), enc);
+    enc->end_element();
+    enc->begin_element("replyto");
+    encode(x.replyto(), enc);
+    enc->end_element();
+    enc->begin_element("prevhop");
+    encode(x.prevhop(), enc);
+    enc->end_element();
+    enc->element_uint("length", (unsigned long long)x.length());
+    enc->element("location", static_cast< const std::string& >(x.location()));
+    if (x.payload_file().present()) {
+        enc->element("payload_file", static_cast< const std::string& >(x.payload_file().get()));
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundleType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ffffffULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "bundleid") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bundleid(v);
+                seen |= 0x80ULL;
+            } else if (name == "is_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_fragment(v);
+                seen |= 0x100ULL;
+            } else if (name == "is_admin") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_admin(v);
+                seen |= 0x200ULL;
+            } else if (name == "do_not_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->do_not_fragment(v);
+                seen |= 0x400ULL;
+            } else if (name == "priority") {
+                bundlePriorityType v((::xml_schema::string(text)));
+                (void)static_cast< bundlePriorityType::_xsd_bundlePriorityType >(v);
+                x->priority(v);
+                seen |= 0x800ULL;
+            } else if (name == "custody_requested") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_requested(v);
+                seen |= 0x1000ULL;
+            } else if (name == "local_custody") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_custody(v);
+                seen |= 0x2000ULL;
+            } else if (name == "singleton_dest") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->singleton_dest(v);
+                seen |= 0x4000ULL;
+            } else if (name == "custody_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_rcpt(v);
+                seen |= 0x8000ULL;
+            } else if (name == "receive_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->receive_rcpt(v);
+                seen |= 0x10000ULL;
+            } else if (name == "forward_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->forward_rcpt(v);
+                seen |= 0x20000ULL;
+            } else if (name == "delivery_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->delivery_rcpt(v);
+                seen |= 0x40000ULL;
+            } else if (name == "deletion_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->deletion_rcpt(v);
+                seen |= 0x80000ULL;
+            } else if (name == "app_acked_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->app_acked_rcpt(v);
+                seen |= 0x100000ULL;
+            } else if (name == "creation_ts_seconds") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->creation_ts_seconds(v);
+                seen |= 0x200000ULL;
+            } else if (name == "creation_ts_seqno") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->creation_ts_seqno(v);
+                seen |= 0x400000ULL;
+            } else if (name == "expiration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->expiration(v);
+                seen |= 0x800000ULL;
+            } else if (name == "orig_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_length(v);
+                seen |= 0x1000000ULL;
+            } else if (name == "frag_offset") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_offset(v);
+                seen |= 0x2000000ULL;
+            } else if (name == "owner") {
+                ::xml_schema::string v(text);
+                x->owner(v);
+                seen |= 0x4000000ULL;
+            }
+            continue;
+        }
+
+        if (name == "source") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->source(c);
+            seen |= 0x1ULL;
+        } else if (name == "dest") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest(c);
+            seen |= 0x2ULL;
+        } else if (name == "custodian") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custodian(c);
+            seen |= 0x4ULL;
+        } else if (name == "replyto") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->replyto(c);
+            seen |= 0x8ULL;
+        } else if (name == "prevhop") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->prevhop(c);
+            seen |= 0x10ULL;
+        } else if (name == "length") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::unsigned_int v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->length(v);
+            seen |= 0x20ULL;
+        } else if (name == "location") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            bundleLocationType v((::xml_schema::string(text)));
+            (void)static_cast< bundleLocationType::_xsd_bundleLocationType >(v);
+            x->location(v);
+            seen |= 0x40ULL;
+        } else if (name == "payload_file") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->payload_file(v);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const contactType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("start_time_sec", (unsigned long long)x.start_time_sec());
+    enc->attribute_uint("start_time_usec", (unsigned long long)x.start_time_usec());
+    enc->attribute_uint("duration", (unsigned long long)x.duration());
+    enc->attribute_uint("bps", (unsigned long long)x.bps());
+    enc->attribute_uint("latency", (unsigned long long)x.latency());
+    enc->attribute_int("pkt_loss_prob", (long long)static_cast< ::xml_schema::integer >(x.pkt_loss_prob()));
+    enc->begin_element("link_attr");
+    encode(x.link_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, contactType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "start_time_sec") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->start_time_sec(v);
+                seen |= 0x2ULL;
+            } else if (name == "start_time_usec") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->start_time_usec(v);
+                seen |= 0x4ULL;
+            } else if (name == "duration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->duration(v);
+                seen |= 0x8ULL;
+            } else if (name == "bps") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bps(v);
+                seen |= 0x10ULL;
+            } else if (name == "latency") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->latency(v);
+                seen |= 0x20ULL;
+            } else if (name == "pkt_loss_prob") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->pkt_loss_prob(v);
+                seen |= 0x40ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_attr") {
+            std::auto_ptr< linkType > c(new linkType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attr(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const clInfoType& x, RouterTLV::Encoder* enc)
+{
+    if (x.local_addr().present()) {
+        enc->attribute("local_addr", static_cast< const std::string& >(x.local_addr().get()));
+    }
+    if (x.remote_addr().present()) {
+        enc->attribute("remote_addr", static_cast< const std::string& >(x.remote_addr().get()));
+    }
+    if (x.local_port().present()) {
+        enc->attribute_uint("local_port", (unsigned long long)x.local_port().get());
+    }
+    if (x.remote_port().present()) {
+        enc->attribute_uint("remote_port", (unsigned long long)x.remote_port().get());
+    }
+    if (x.segment_ack_enabled().present()) {
+        enc->attribute_bool("segment_ack_enabled", (bool)x.segment_ack_enabled().get());
+    }
+    if (x.negative_ack_enabled().present()) {
+        enc->attribute_bool("negative_ack_enabled", (bool)x.negative_ack_enabled().get());
+    }
+    if (x.keepalive_interval().present()) {
+        enc->attribute_uint("keepalive_interval", (unsigned long long)x.keepalive_interval().get());
+    }
+    if (x.segment_length().present()) {
+        enc->attribute_uint("segment_length", (unsigned long long)x.segment_length().get());
+    }
+    if (x.busy_queue_depth().present()) {
+        enc->attribute_uint("busy_queue_depth", (unsigned long long)x.busy_queue_depth().get());
+    }
+    if (x.reactive_frag_enabled().present()) {
+        enc->attribute_bool("reactive_frag_enabled", (bool)x.reactive_frag_enabled().get());
+    }
+    if (x.sendbuf_length().present()) {
+        enc->attribute_uint("sendbuf_length", (unsigned long long)x.sendbuf_length().get());
+    }
+    if (x.recvbuf_length().present()) {
+        enc->attribute_uint("recvbuf_length", (unsigned long long)x.recvbuf_length().get());
+    }
+    if (x.data_timeout().present()) {
+        enc->attribute_uint("data_timeout", (unsigned long long)x.data_timeout().get());
+    }
+    if (x.rate().present()) {
+        enc->attribute_uint("rate", (unsigned long long)x.rate().get());
+    }
+    if (x.bucket_depth().present()) {
+        enc->attribute_uint("bucket_depth", (unsigned long long)x.bucket_depth().get());
+    }
+    if (x.channel().present()) {
+        enc->attribute_uint("channel", (unsigned long long)x.channel().get());
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, clInfoType* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_addr") {
+                ::xml_schema::string v(text);
+                x->local_addr(v);
+            } else if (name == "remote_addr") {
+                ::xml_schema::string v(text);
+                x->remote_addr(v);
+            } else if (name == "local_port") {
+                ::xml_schema::unsigned_short v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_port(v);
+            } else if (name == "remote_port") {
+                ::xml_schema::unsigned_short v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->remote_port(v);
+            } else if (name == "segment_ack_enabled") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->segment_ack_enabled(v);
+            } else if (name == "negative_ack_enabled") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->negative_ack_enabled(v);
+            } else if (name == "keepalive_interval") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->keepalive_interval(v);
+            } else if (name == "segment_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->segment_length(v);
+            } else if (name == "busy_queue_depth") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->busy_queue_depth(v);
+            } else if (name == "reactive_frag_enabled") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reactive_frag_enabled(v);
+            } else if (name == "sendbuf_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->sendbuf_length(v);
+            } else if (name == "recvbuf_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->recvbuf_length(v);
+            } else if (name == "data_timeout") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->data_timeout(v);
+            } else if (name == "rate") {
+                ::xml_schema::unsigned_byte v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->rate(v);
+            } else if (name == "bucket_depth") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bucket_depth(v);
+            } else if (name == "channel") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->channel(v);
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const linkType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("type", static_cast< const std::string& >(x.type()));
+    enc->attribute("nexthop", static_cast< const std::string& >(x.nexthop()));
+    enc->attribute("state", static_cast< const std::string& >(x.state()));
+    enc->attribute_bool("is_reachable", (bool)x.is_reachable());
+    enc->attribute_bool("is_usable", (bool)x.is_usable());
+    enc->attribute_int("how_reliable", (long long)static_cast< ::xml_schema::integer >(x.how_reliable()));
+    enc->attribute_int("how_available", (long long)static_cast< ::xml_schema::integer >(x.how_available()));
+    enc->attribute("clayer", static_cast< const std::string& >(x.clayer()));
+    enc->attribute_uint("min_retry_interval", (unsigned long long)x.min_retry_interval());
+    enc->attribute_uint("max_retry_interval", (unsigned long long)x.max_retry_interval());
+    enc->attribute_uint("idle_close_time", (unsigned long long)x.idle_close_time());
+    if (x.clinfo().present()) {
+        enc->begin_element("clinfo");
+        encode(x.clinfo().get(), enc);
+        enc->end_element();
+    }
+    enc->begin_element("remote_eid");
+    encode(x.remote_eid(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, linkType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfffULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "type") {
+                linkTypeType v((::xml_schema::string(text)));
+                (void)static_cast< linkTypeType::_xsd_linkTypeType >(v);
+                x->type(v);
+                seen |= 0x2ULL;
+            } else if (name == "nexthop") {
+                ::xml_schema::string v(text);
+                x->nexthop(v);
+                seen |= 0x4ULL;
+            } else if (name == "state") {
+                linkStateType v((::xml_schema::string(text)));
+                (void)static_cast< linkStateType::_xsd_linkStateType >(v);
+                x->state(v);
+                seen |= 0x8ULL;
+            } else if (name == "is_reachable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_reachable(v);
+                seen |= 0x10ULL;
+            } else if (name == "is_usable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_usable(v);
+                seen |= 0x20ULL;
+            } else if (name == "how_reliable") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->how_reliable(v);
+                seen |= 0x40ULL;
+            } else if (name == "how_available") {
+                ::xml_schema::integer i;
+                if (! RouterTLV::parse(text, &i)) {
+                    return false;
+                }
+                percentType v(i);
+                x->how_available(v);
+                seen |= 0x80ULL;
+            } else if (name == "clayer") {
+                ::xml_schema::string v(text);
+                x->clayer(v);
+                seen |= 0x100ULL;
+            } else if (name == "min_retry_interval") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->min_retry_interval(v);
+                seen |= 0x200ULL;
+            } else if (name == "max_retry_interval") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->max_retry_interval(v);
+                seen |= 0x400ULL;
+            } else if (name == "idle_close_time") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->idle_close_time(v);
+                seen |= 0x800ULL;
+            }
+            continue;
+        }
+
+        if (name == "clinfo") {
+            std::auto_ptr< clInfoType > c(new clInfoType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->clinfo(c);
+        } else if (name == "remote_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->remote_eid(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const routeEntryType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("route_priority", (long long)x.route_priority());
+    enc->attribute("action", static_cast< const std::string& >(x.action()));
+    enc->attribute("link", static_cast< const std::string& >(x.link()));
+    enc->begin_element("dest_pattern");
+    encode(x.dest_pattern(), enc);
+    enc->end_element();
+    enc->begin_element("source_pattern");
+    encode(x.source_pattern(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, routeEntryType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "route_priority") {
+                ::xml_schema::integer v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->route_priority(v);
+                seen |= 0x4ULL;
+            } else if (name == "action") {
+                bundleForwardActionType v((::xml_schema::string(text)));
+                (void)static_cast< bundleForwardActionType::_xsd_bundleForwardActionType >(v);
+                x->action(v);
+                seen |= 0x8ULL;
+            } else if (name == "link") {
+                ::xml_schema::string v(text);
+                x->link(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        if (name == "dest_pattern") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest_pattern(c);
+            seen |= 0x1ULL;
+        } else if (name == "source_pattern") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->source_pattern(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const custodySignalType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("admin_type", (unsigned long long)x.admin_type());
+    enc->attribute_uint("admin_flags", (unsigned long long)x.admin_flags());
+    enc->attribute_bool("succeeded", (bool)x.succeeded());
+    enc->attribute_uint("reason", (unsigned long long)x.reason());
+    enc->attribute_uint("orig_frag_offset", (unsigned long long)x.orig_frag_offset());
+    enc->attribute_uint("orig_frag_length", (unsigned long long)x.orig_frag_length());
+    enc->attribute_uint("custody_signal_seconds", (unsigned long long)x.custody_signal_seconds());
+    enc->attribute_uint("custody_signal_seqno", (unsigned long long)x.custody_signal_seqno());
+    enc->attribute_uint("orig_creation_seconds", (unsigned long long)x.orig_creation_seconds());
+    enc->attribute_uint("orig_creation_seqno", (unsigned long long)x.orig_creation_seqno());
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, custodySignalType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ffULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "admin_type") {
+                ::xml_schema::unsigned_byte v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->admin_type(v);
+                seen |= 0x1ULL;
+            } else if (name == "admin_flags") {
+                ::xml_schema::unsigned_byte v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->admin_flags(v);
+                seen |= 0x2ULL;
+            } else if (name == "succeeded") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->succeeded(v);
+                seen |= 0x4ULL;
+            } else if (name == "reason") {
+                ::xml_schema::unsigned_byte v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reason(v);
+                seen |= 0x8ULL;
+            } else if (name == "orig_frag_offset") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_frag_offset(v);
+                seen |= 0x10ULL;
+            } else if (name == "orig_frag_length") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_frag_length(v);
+                seen |= 0x20ULL;
+            } else if (name == "custody_signal_seconds") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_signal_seconds(v);
+                seen |= 0x40ULL;
+            } else if (name == "custody_signal_seqno") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_signal_seqno(v);
+                seen |= 0x80ULL;
+            } else if (name == "orig_creation_seconds") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_creation_seconds(v);
+                seen |= 0x100ULL;
+            } else if (name == "orig_creation_seqno") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_creation_seqno(v);
+                seen |= 0x200ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const registrationType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("regid", (unsigned long long)x.regid());
+    enc->attribute("action", static_cast< const std::string& >(x.action()));
+    enc->attribute("script", static_cast< const std::string& >(x.script()));
+    enc->attribute_uint("expiration", (unsigned long long)x.expiration());
+    enc->begin_element("endpoint");
+    encode(x.endpoint(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, registrationType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "regid") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->regid(v);
+                seen |= 0x2ULL;
+            } else if (name == "action") {
+                failureActionType v((::xml_schema::string(text)));
+                (void)static_cast< failureActionType::_xsd_failureActionType >(v);
+                x->action(v);
+                seen |= 0x4ULL;
+            } else if (name == "script") {
+                ::xml_schema::string v(text);
+                x->script(v);
+                seen |= 0x8ULL;
+            } else if (name == "expiration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->expiration(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        if (name == "endpoint") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->endpoint(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const linkConfigType& x, RouterTLV::Encoder* enc)
+{
+    if (x.is_usable().present()) {
+        enc->attribute_bool("is_usable", (bool)x.is_usable().get());
+    }
+    if (x.reactive_frag_enabled().present()) {
+        enc->attribute_bool("reactive_frag_enabled", (bool)x.reactive_frag_enabled().get());
+    }
+    if (x.nexthop().present()) {
+        enc->attribute("nexthop", static_cast< const std::string& >(x.nexthop().get()));
+    }
+    if (x.min_retry_interval().present()) {
+        enc->attribute_uint("min_retry_interval", (unsigned long long)x.min_retry_interval().get());
+    }
+    if (x.max_retry_interval().present()) {
+        enc->attribute_uint("max_retry_interval", (unsigned long long)x.max_retry_interval().get());
+    }
+    if (x.idle_close_time().present()) {
+        enc->attribute_uint("idle_close_time", (unsigned long long)x.idle_close_time().get());
+    }
+    for (linkConfigType::cl_params::const_iterator i = x.cl_params().begin();
+         i != x.cl_params().end(); ++i)
+    {
+        enc->begin_element("cl_params");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, linkConfigType* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "is_usable") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_usable(v);
+            } else if (name == "reactive_frag_enabled") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reactive_frag_enabled(v);
+            } else if (name == "nexthop") {
+                ::xml_schema::string v(text);
+                x->nexthop(v);
+            } else if (name == "min_retry_interval") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->min_retry_interval(v);
+            } else if (name == "max_retry_interval") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->max_retry_interval(v);
+            } else if (name == "idle_close_time") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->idle_close_time(v);
+            }
+            continue;
+        }
+
+        if (name == "cl_params") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->cl_params().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const key_value_pair& x, RouterTLV::Encoder* enc)
+{
+    enc->element("name", static_cast< const std::string& >(x.name()));
+    if (x.bool_value().present()) {
+        enc->element_bool("bool_value", (bool)x.bool_value().get());
+    }
+    if (x.u_int_value().present()) {
+        enc->element_uint("u_int_value", (unsigned long long)x.u_int_value().get());
+    }
+    if (x.int_value().present()) {
+        enc->element_int("int_value", (long long)x.int_value().get());
+    }
+    if (x.str_value().present()) {
+        enc->element("str_value", static_cast< const std::string& >(x.str_value().get()));
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, key_value_pair* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "name") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->name(v);
+            seen |= 0x1ULL;
+        } else if (name == "bool_value") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::boolean v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->bool_value(v);
+        } else if (name == "u_int_value") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::unsigned_int v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->u_int_value(v);
+        } else if (name == "int_value") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::int_ v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->int_value(v);
+        } else if (name == "str_value") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->str_value(v);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundleMetaBlockQueryType& x, RouterTLV::Encoder* enc)
+{
+    if (x.type().present()) {
+        enc->element_int("type", (long long)x.type().get());
+    }
+    if (x.identifier().present()) {
+        enc->element_uint("identifier", (unsigned long long)x.identifier().get());
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundleMetaBlockQueryType* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "type") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::long_ v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->type(v);
+        } else if (name == "identifier") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::unsigned_int v;
+            if (! RouterTLV::parse(text, &v)) {
+                return false;
+            }
+            x->identifier(v);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundleAttributesQueryType& x, RouterTLV::Encoder* enc)
+{
+    if (x.query().present()) {
+        enc->element("query", static_cast< const std::string& >(x.query().get()));
+    }
+    if (x.meta_blocks().present()) {
+        enc->begin_element("meta_blocks");
+        encode(x.meta_blocks().get(), enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundleAttributesQueryType* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "query") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            bundleAttributesSimpleQueryType v((::xml_schema::string(text)));
+            (void)static_cast< bundleAttributesSimpleQueryType::_xsd_bundleAttributesSimpleQueryType >(v);
+            x->query(v);
+        } else if (name == "meta_blocks") {
+            std::auto_ptr< bundleMetaBlockQueryType > c(new bundleMetaBlockQueryType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->meta_blocks(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const metadataBlockType& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("identifier", (unsigned long long)x.identifier());
+    enc->attribute_bool("generated", (bool)x.generated());
+    enc->attribute_uint("type", (unsigned long long)x.type());
+    enc->attribute("contents", RouterTLV::base64_encode(x.contents().data(), x.contents().size()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, metadataBlockType* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "identifier") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->identifier(v);
+                seen |= 0x1ULL;
+            } else if (name == "generated") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->generated(v);
+                seen |= 0x2ULL;
+            } else if (name == "type") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->type(v);
+                seen |= 0x4ULL;
+            } else if (name == "contents") {
+                std::string data;
+                if (! RouterTLV::base64_decode(text, &data)) {
+                    return false;
+                }
+                ::xml_schema::base64_binary v(data.data(), data.size());
+                x->contents(v);
+                seen |= 0x8ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundleAttributesReportType& x, RouterTLV::Encoder* enc)
+{
+    if (x.bundleid().present()) {
+        enc->attribute_uint("bundleid", (unsigned long long)x.bundleid().get());
+    }
+    if (x.is_admin().present()) {
+        enc->attribute_bool("is_admin", (bool)x.is_admin().get());
+    }
+    if (x.do_not_fragment().present()) {
+        enc->attribute_bool("do_not_fragment", (bool)x.do_not_fragment().get());
+    }
+    if (x.priority().present()) {
+        enc->attribute("priority", static_cast< const std::string& >(x.priority().get()));
+    }
+    if (x.custody_requested().present()) {
+        enc->attribute_bool("custody_requested", (bool)x.custody_requested().get());
+    }
+    if (x.local_custody().present()) {
+        enc->attribute_bool("local_custody", (bool)x.local_custody().get());
+    }
+    if (x.singleton_dest().present()) {
+        enc->attribute_bool("singleton_dest", (bool)x.singleton_dest().get());
+    }
+    if (x.custody_rcpt().present()) {
+        enc->attribute_bool("custody_rcpt", (bool)x.custody_rcpt().get());
+    }
+    if (x.receive_rcpt().present()) {
+        enc->attribute_bool("receive_rcpt", (bool)x.receive_rcpt().get());
+    }
+    if (x.forward_rcpt().present()) {
+        enc->attribute_bool("forward_rcpt", (bool)x.forward_rcpt().get());
+    }
+    if (x.delivery_rcpt().present()) {
+        enc->attribute_bool("delivery_rcpt", (bool)x.delivery_rcpt().get());
+    }
+    if (x.deletion_rcpt().present()) {
+        enc->attribute_bool("deletion_rcpt", (bool)x.deletion_rcpt().get());
+    }
+    if (x.app_acked_rcpt().present()) {
+        enc->attribute_bool("app_acked_rcpt", (bool)x.app_acked_rcpt().get());
+    }
+    if (x.expiration().present()) {
+        enc->attribute_uint("expiration", (unsigned long long)x.expiration().get());
+    }
+    if (x.orig_length().present()) {
+        enc->attribute_uint("orig_length", (unsigned long long)x.orig_length().get());
+    }
+    if (x.owner().present()) {
+        enc->attribute("owner", static_cast< const std::string& >(x.owner().get()));
+    }
+    if (x.location().present()) {
+        enc->attribute("location", static_cast< const std::string& >(x.location().get()));
+    }
+    if (x.payload_file().present()) {
+        enc->attribute("payload_file", static_cast< const std::string& >(x.payload_file().get()));
+    }
+    if (x.dest().present()) {
+        enc->begin_element("dest");
+        encode(x.dest().get(), enc);
+        enc->end_element();
+    }
+    if (x.custodian().present()) {
+        enc->begin_element("custodian");
+        encode(x.custodian().get(), enc);
+        enc->end_element();
+    }
+    if (x.replyto().present()) {
+        enc->begin_element("replyto");
+        encode(x.replyto().get(), enc);
+        enc->end_element();
+    }
+    if (x.prevhop().present()) {
+        enc->begin_element("prevhop");
+        encode(x.prevhop().get(), enc);
+        enc->end_element();
+    }
+    for (bundleAttributesReportType::meta_blocks::const_iterator i = x.meta_blocks().begin();
+         i != x.meta_blocks().end(); ++i)
+    {
+        enc->begin_element("meta_blocks");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundleAttributesReportType* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "bundleid") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bundleid(v);
+            } else if (name == "is_admin") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->is_admin(v);
+            } else if (name == "do_not_fragment") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->do_not_fragment(v);
+            } else if (name == "priority") {
+                bundlePriorityType v((::xml_schema::string(text)));
+                (void)static_cast< bundlePriorityType::_xsd_bundlePriorityType >(v);
+                x->priority(v);
+            } else if (name == "custody_requested") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_requested(v);
+            } else if (name == "local_custody") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_custody(v);
+            } else if (name == "singleton_dest") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->singleton_dest(v);
+            } else if (name == "custody_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->custody_rcpt(v);
+            } else if (name == "receive_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->receive_rcpt(v);
+            } else if (name == "forward_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->forward_rcpt(v);
+            } else if (name == "delivery_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->delivery_rcpt(v);
+            } else if (name == "deletion_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->deletion_rcpt(v);
+            } else if (name == "app_acked_rcpt") {
+                ::xml_schema::boolean v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->app_acked_rcpt(v);
+            } else if (name == "expiration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->expiration(v);
+            } else if (name == "orig_length") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->orig_length(v);
+            } else if (name == "owner") {
+                ::xml_schema::string v(text);
+                x->owner(v);
+            } else if (name == "location") {
+                bundleLocationType v((::xml_schema::string(text)));
+                (void)static_cast< bundleLocationType::_xsd_bundleLocationType >(v);
+                x->location(v);
+            } else if (name == "payload_file") {
+                ::xml_schema::string v(text);
+                x->payload_file(v);
+            }
+            continue;
+        }
+
+        if (name == "dest") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest(c);
+        } else if (name == "custodian") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custodian(c);
+        } else if (name == "replyto") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->replyto(c);
+        } else if (name == "prevhop") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->prevhop(c);
+        } else if (name == "meta_blocks") {
+            metadataBlockType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->meta_blocks().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_received_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->attribute_uint("expiration", (unsigned long long)x.expiration());
+    enc->attribute_uint("bytes_received", (unsigned long long)x.bytes_received());
+    if (x.num_meta_blocks().present()) {
+        enc->attribute_uint("num_meta_blocks", (unsigned long long)x.num_meta_blocks().get());
+    }
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    enc->begin_element("dest");
+    encode(x.dest(), enc);
+    enc->end_element();
+    enc->begin_element("custodian");
+    encode(x.custodian(), enc);
+    enc->end_element();
+    enc->begin_element("replyto");
+    encode(x.replyto(), enc);
+    enc->end_element();
+    if (x.prevhop().present()) {
+        enc->begin_element("prevhop");
+        encode(x.prevhop().get(), enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_received_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x10ULL;
+            } else if (name == "expiration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->expiration(v);
+                seen |= 0x20ULL;
+            } else if (name == "bytes_received") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bytes_received(v);
+                seen |= 0x40ULL;
+            } else if (name == "num_meta_blocks") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->num_meta_blocks(v);
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "dest") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest(c);
+            seen |= 0x2ULL;
+        } else if (name == "custodian") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custodian(c);
+            seen |= 0x4ULL;
+        } else if (name == "replyto") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->replyto(c);
+            seen |= 0x8ULL;
+        } else if (name == "prevhop") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->prevhop(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const data_transmitted_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute_uint("bytes_sent", (unsigned long long)x.bytes_sent());
+    enc->attribute_uint("reliably_sent", (unsigned long long)x.reliably_sent());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, data_transmitted_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x4ULL;
+            } else if (name == "bytes_sent") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->bytes_sent(v);
+                seen |= 0x8ULL;
+            } else if (name == "reliably_sent") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->reliably_sent(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_delivered_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_delivered_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_delivery_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    enc->begin_element("bundle");
+    encode(x.bundle(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_delivery_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "bundle") {
+            std::auto_ptr< bundleType > c(new bundleType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_send_cancelled_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    enc->element("link_id", static_cast< const std::string& >(x.link_id()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_send_cancelled_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "link_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->link_id(v);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_expired_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_expired_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_injected_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->element("request_id", static_cast< const std::string& >(x.request_id()));
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_injected_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "request_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->request_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_opened_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->begin_element("contact_attr");
+    encode(x.contact_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_opened_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_attr") {
+            std::auto_ptr< contactType > c(new contactType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attr(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_closed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("contact_attr");
+    encode(x.contact_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_closed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_attr") {
+            std::auto_ptr< contactType > c(new contactType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attr(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_created_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("link_attr");
+    encode(x.link_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_created_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_attr") {
+            std::auto_ptr< linkType > c(new linkType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attr(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_deleted_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_deleted_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_available_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_available_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_unavailable_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_unavailable_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_attribute_changed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("link_attr");
+    encode(x.link_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_attribute_changed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_attr") {
+            std::auto_ptr< linkType > c(new linkType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attr(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const contact_attribute_changed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("reason", static_cast< const std::string& >(x.reason()));
+    enc->begin_element("contact_eid");
+    encode(x.contact_eid(), enc);
+    enc->end_element();
+    enc->begin_element("contact_attr");
+    encode(x.contact_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, contact_attribute_changed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "reason") {
+                contactReasonType v((::xml_schema::string(text)));
+                (void)static_cast< contactReasonType::_xsd_contactReasonType >(v);
+                x->reason(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "contact_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_eid(c);
+            seen |= 0x1ULL;
+        } else if (name == "contact_attr") {
+            std::auto_ptr< contactType > c(new contactType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attr(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_busy_event& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("link");
+    encode(x.link(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_busy_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "link") {
+            std::auto_ptr< linkType > c(new linkType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const eid_reachable_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("interface_name", static_cast< const std::string& >(x.interface_name()));
+    enc->begin_element("peer_eid");
+    encode(x.peer_eid(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, eid_reachable_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "interface_name") {
+                ::xml_schema::string v(text);
+                x->interface_name(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "peer_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->peer_eid(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const route_add_event& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("route_entry");
+    encode(x.route_entry(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, route_add_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "route_entry") {
+            std::auto_ptr< routeEntryType > c(new routeEntryType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->route_entry(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const route_delete_event& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("dest");
+    encode(x.dest(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, route_delete_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "dest") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const custody_signal_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    enc->begin_element("custody_signal_attr");
+    encode(x.custody_signal_attr(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, custody_signal_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "custody_signal_attr") {
+            std::auto_ptr< custodySignalType > c(new custodySignalType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custody_signal_attr(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const custody_timeout_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, custody_timeout_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const intentional_name_resolved_event& x, RouterTLV::Encoder* enc)
+{
+    enc->element("request_id", static_cast< const std::string& >(x.request_id()));
+    enc->element("response_id", static_cast< const std::string& >(x.response_id()));
+    enc->begin_element("router_eid");
+    encode(x.router_eid(), enc);
+    enc->end_element();
+    if (x.lb_dp_eid().present()) {
+        enc->begin_element("lb_dp_eid");
+        encode(x.lb_dp_eid().get(), enc);
+        enc->end_element();
+    }
+    enc->begin_element("intentional_name");
+    encode(x.intentional_name(), enc);
+    enc->end_element();
+    enc->element("grain_state", static_cast< const std::string& >(x.grain_state()));
+    for (intentional_name_resolved_event::canonical_eids::const_iterator i = x.canonical_eids().begin();
+         i != x.canonical_eids().end(); ++i)
+    {
+        enc->begin_element("canonical_eids");
+        encode(*i, enc);
+        enc->end_element();
+    }
+    for (intentional_name_resolved_event::app_eids::const_iterator i = x.app_eids().begin();
+         i != x.app_eids().end(); ++i)
+    {
+        enc->begin_element("app_eids");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, intentional_name_resolved_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "request_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->request_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "response_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->response_id(v);
+            seen |= 0x2ULL;
+        } else if (name == "router_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->router_eid(c);
+            seen |= 0x4ULL;
+        } else if (name == "lb_dp_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->lb_dp_eid(c);
+        } else if (name == "intentional_name") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->intentional_name(c);
+            seen |= 0x8ULL;
+        } else if (name == "grain_state") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->grain_state(v);
+            seen |= 0x10ULL;
+        } else if (name == "canonical_eids") {
+            eidType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->canonical_eids().push_back(c);
+        } else if (name == "app_eids") {
+            eidType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->app_eids().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const registration_added_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("source", static_cast< const std::string& >(x.source()));
+    enc->begin_element("registration");
+    encode(x.registration(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, registration_added_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "source") {
+                eventSourceType v((::xml_schema::string(text)));
+                (void)static_cast< eventSourceType::_xsd_eventSourceType >(v);
+                x->source(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "registration") {
+            std::auto_ptr< registrationType > c(new registrationType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->registration(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const registration_removed_event& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("registration");
+    encode(x.registration(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, registration_removed_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "registration") {
+            std::auto_ptr< registrationType > c(new registrationType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->registration(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const registration_expired_event& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_uint("regid", (unsigned long long)x.regid());
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, registration_expired_event* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "regid") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->regid(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const open_link_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, open_link_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const close_link_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, close_link_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const add_link_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("link_type", static_cast< const std::string& >(x.link_type()));
+    enc->attribute("clayer", static_cast< const std::string& >(x.clayer()));
+    if (x.link_config_params().present()) {
+        enc->begin_element("link_config_params");
+        encode(x.link_config_params().get(), enc);
+        enc->end_element();
+    }
+    enc->begin_element("remote_eid");
+    encode(x.remote_eid(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, add_link_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "link_type") {
+                linkTypeType v((::xml_schema::string(text)));
+                (void)static_cast< linkTypeType::_xsd_linkTypeType >(v);
+                x->link_type(v);
+                seen |= 0x4ULL;
+            } else if (name == "clayer") {
+                ::xml_schema::string v(text);
+                x->clayer(v);
+                seen |= 0x8ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_config_params") {
+            std::auto_ptr< linkConfigType > c(new linkConfigType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_params(c);
+        } else if (name == "remote_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->remote_eid(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const delete_link_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, delete_link_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x1ULL;
+            }
+            continue;
+        }
+
+        return false;
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const reconfigure_link_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->begin_element("link_config_params");
+    encode(x.link_config_params(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, reconfigure_link_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "link_config_params") {
+            std::auto_ptr< linkConfigType > c(new linkConfigType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_config_params(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const send_bundle_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->attribute("fwd_action", static_cast< const std::string& >(x.fwd_action()));
+    if (x.frag_size().present()) {
+        enc->attribute_uint("frag_size", (unsigned long long)x.frag_size().get());
+    }
+    if (x.frag_offset().present()) {
+        enc->attribute_uint("frag_offset", (unsigned long long)x.frag_offset().get());
+    }
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    for (send_bundle_request::metadata_block::const_iterator i = x.metadata_block().begin();
+         i != x.metadata_block().end(); ++i)
+    {
+        enc->begin_element("metadata_block");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, send_bundle_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x4ULL;
+            } else if (name == "fwd_action") {
+                bundleForwardActionType v((::xml_schema::string(text)));
+                (void)static_cast< bundleForwardActionType::_xsd_bundleForwardActionType >(v);
+                x->fwd_action(v);
+                seen |= 0x8ULL;
+            } else if (name == "frag_size") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_size(v);
+            } else if (name == "frag_offset") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_offset(v);
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "metadata_block") {
+            metadataBlockType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->metadata_block().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const send_bundle_broadcast_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->attribute("fwd_action", static_cast< const std::string& >(x.fwd_action()));
+    if (x.frag_size().present()) {
+        enc->attribute_uint("frag_size", (unsigned long long)x.frag_size().get());
+    }
+    if (x.frag_offset().present()) {
+        enc->attribute_uint("frag_offset", (unsigned long long)x.frag_offset().get());
+    }
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    for (send_bundle_broadcast_request::metadata_block::const_iterator i = x.metadata_block().begin();
+         i != x.metadata_block().end(); ++i)
+    {
+        enc->begin_element("metadata_block");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, send_bundle_broadcast_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "fwd_action") {
+                bundleForwardActionType v((::xml_schema::string(text)));
+                (void)static_cast< bundleForwardActionType::_xsd_bundleForwardActionType >(v);
+                x->fwd_action(v);
+                seen |= 0x4ULL;
+            } else if (name == "frag_size") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_size(v);
+            } else if (name == "frag_offset") {
+                ::xml_schema::unsigned_long v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->frag_offset(v);
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "metadata_block") {
+            metadataBlockType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->metadata_block().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const cancel_bundle_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, cancel_bundle_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            } else if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const inject_bundle_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("request_id", static_cast< const std::string& >(x.request_id()));
+    enc->attribute("link_id", static_cast< const std::string& >(x.link_id()));
+    if (x.fwd_action().present()) {
+        enc->attribute("fwd_action", static_cast< const std::string& >(x.fwd_action().get()));
+    }
+    if (x.priority().present()) {
+        enc->attribute("priority", static_cast< const std::string& >(x.priority().get()));
+    }
+    if (x.expiration().present()) {
+        enc->attribute_uint("expiration", (unsigned long long)x.expiration().get());
+    }
+    enc->attribute("payload_file", static_cast< const std::string& >(x.payload_file()));
+    enc->begin_element("source");
+    encode(x.source(), enc);
+    enc->end_element();
+    enc->begin_element("dest");
+    encode(x.dest(), enc);
+    enc->end_element();
+    if (x.replyto().present()) {
+        enc->begin_element("replyto");
+        encode(x.replyto().get(), enc);
+        enc->end_element();
+    }
+    if (x.custodian().present()) {
+        enc->begin_element("custodian");
+        encode(x.custodian().get(), enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, inject_bundle_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "request_id") {
+                ::xml_schema::string v(text);
+                x->request_id(v);
+                seen |= 0x4ULL;
+            } else if (name == "link_id") {
+                ::xml_schema::string v(text);
+                x->link_id(v);
+                seen |= 0x8ULL;
+            } else if (name == "fwd_action") {
+                bundleForwardActionType v((::xml_schema::string(text)));
+                (void)static_cast< bundleForwardActionType::_xsd_bundleForwardActionType >(v);
+                x->fwd_action(v);
+            } else if (name == "priority") {
+                bundlePriorityType v((::xml_schema::string(text)));
+                (void)static_cast< bundlePriorityType::_xsd_bundlePriorityType >(v);
+                x->priority(v);
+            } else if (name == "expiration") {
+                ::xml_schema::unsigned_int v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->expiration(v);
+            } else if (name == "payload_file") {
+                ::xml_schema::string v(text);
+                x->payload_file(v);
+                seen |= 0x10ULL;
+            }
+            continue;
+        }
+
+        if (name == "source") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->source(c);
+            seen |= 0x1ULL;
+        } else if (name == "dest") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->dest(c);
+            seen |= 0x2ULL;
+        } else if (name == "replyto") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->replyto(c);
+        } else if (name == "custodian") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custodian(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const delete_bundle_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, delete_bundle_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const set_cl_params_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute("clayer", static_cast< const std::string& >(x.clayer()));
+    for (set_cl_params_request::cl_params::const_iterator i = x.cl_params().begin();
+         i != x.cl_params().end(); ++i)
+    {
+        enc->begin_element("cl_params");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, set_cl_params_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "clayer") {
+                ::xml_schema::string v(text);
+                x->clayer(v);
+                seen |= 0x2ULL;
+            }
+            continue;
+        }
+
+        if (name == "cl_params") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->cl_params().push_back(c);
+            seen |= 0x1ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const intentional_name_resolution_request& x, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    enc->element("request_id", static_cast< const std::string& >(x.request_id()));
+    enc->begin_element("router_eid");
+    encode(x.router_eid(), enc);
+    enc->end_element();
+    enc->begin_element("intentional_name");
+    encode(x.intentional_name(), enc);
+    enc->end_element();
+    enc->element("grain_state", static_cast< const std::string& >(x.grain_state()));
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, intentional_name_resolution_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x1fULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x1ULL;
+        } else if (name == "request_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->request_id(v);
+            seen |= 0x2ULL;
+        } else if (name == "router_eid") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->router_eid(c);
+            seen |= 0x4ULL;
+        } else if (name == "intentional_name") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->intentional_name(c);
+            seen |= 0x8ULL;
+        } else if (name == "grain_state") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->grain_state(v);
+            seen |= 0x10ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const deliver_bundle_to_app_request& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->begin_element("endpoint");
+    encode(x.endpoint(), enc);
+    enc->end_element();
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, deliver_bundle_to_app_request* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x4ULL;
+            }
+            continue;
+        }
+
+        if (name == "endpoint") {
+            std::auto_ptr< eidType > c(new eidType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->endpoint(c);
+            seen |= 0x1ULL;
+        } else if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_report& x, RouterTLV::Encoder* enc)
+{
+    for (link_report::link::const_iterator i = x.link().begin();
+         i != x.link().end(); ++i)
+    {
+        enc->begin_element("link");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_report* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "link") {
+            linkType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->link().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_attributes_query& x, RouterTLV::Encoder* enc)
+{
+    enc->element("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->element("link_id", static_cast< const std::string& >(x.link_id()));
+    for (link_attributes_query::query_params::const_iterator i = x.query_params().begin();
+         i != x.query_params().end(); ++i)
+    {
+        enc->element("query_params", static_cast< const std::string& >(*i));
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_attributes_query* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x7ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "query_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->query_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "link_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->link_id(v);
+            seen |= 0x2ULL;
+        } else if (name == "query_params") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->query_params().push_back(v);
+            seen |= 0x4ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const link_attributes_report& x, RouterTLV::Encoder* enc)
+{
+    enc->element("query_id", static_cast< const std::string& >(x.query_id()));
+    for (link_attributes_report::report_params::const_iterator i = x.report_params().begin();
+         i != x.report_params().end(); ++i)
+    {
+        enc->begin_element("report_params");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, link_attributes_report* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "query_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->query_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "report_params") {
+            key_value_pair c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->report_params().push_back(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const contact_report& x, RouterTLV::Encoder* enc)
+{
+    for (contact_report::contact::const_iterator i = x.contact().begin();
+         i != x.contact().end(); ++i)
+    {
+        enc->begin_element("contact");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, contact_report* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "contact") {
+            contactType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->contact().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const route_report& x, RouterTLV::Encoder* enc)
+{
+    for (route_report::route_entry::const_iterator i = x.route_entry().begin();
+         i != x.route_entry().end(); ++i)
+    {
+        enc->begin_element("route_entry");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, route_report* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "route_entry") {
+            routeEntryType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->route_entry().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_report& x, RouterTLV::Encoder* enc)
+{
+    for (bundle_report::bundle::const_iterator i = x.bundle().begin();
+         i != x.bundle().end(); ++i)
+    {
+        enc->begin_element("bundle");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_report* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "bundle") {
+            bundleType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->bundle().push_back(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_attributes_query& x, RouterTLV::Encoder* enc)
+{
+    enc->attribute_int("local_id", (long long)x.local_id());
+    enc->element("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->begin_element("gbof_id");
+    encode(x.gbof_id(), enc);
+    enc->end_element();
+    for (bundle_attributes_query::query_params::const_iterator i = x.query_params().begin();
+         i != x.query_params().end(); ++i)
+    {
+        enc->begin_element("query_params");
+        encode(*i, enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_attributes_query* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0xfULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "local_id") {
+                ::xml_schema::long_ v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->local_id(v);
+                seen |= 0x8ULL;
+            }
+            continue;
+        }
+
+        if (name == "query_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->query_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "gbof_id") {
+            std::auto_ptr< gbofIdType > c(new gbofIdType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->gbof_id(c);
+            seen |= 0x2ULL;
+        } else if (name == "query_params") {
+            bundleAttributesQueryType c;
+            if (! decode(dec, &c)) {
+                return false;
+            }
+            x->query_params().push_back(c);
+            seen |= 0x4ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bundle_attributes_report& x, RouterTLV::Encoder* enc)
+{
+    enc->element("query_id", static_cast< const std::string& >(x.query_id()));
+    enc->begin_element("report_params");
+    encode(x.report_params(), enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bundle_attributes_report* x)
+{
+    u_int64_t seen = 0;
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return seen == 0x3ULL;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (name == "query_id") {
+            if (! dec->get_text(&text)) {
+                return false;
+            }
+            ::xml_schema::string v(text);
+            x->query_id(v);
+            seen |= 0x1ULL;
+        } else if (name == "report_params") {
+            std::auto_ptr< bundleAttributesReportType > c(new bundleAttributesReportType());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->report_params(c);
+            seen |= 0x2ULL;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+static void
+encode(const bpa& x, RouterTLV::Encoder* enc)
+{
+    if (x.eid().present()) {
+        enc->attribute("eid", static_cast< const std::string& >(x.eid().get()));
+    }
+    if (x.hello_interval().present()) {
+        enc->attribute_uint("hello_interval", (unsigned long long)x.hello_interval().get());
+    }
+    if (x.alert().present()) {
+        enc->attribute("alert", static_cast< const std::string& >(x.alert().get()));
+    }
+    if (x.bundle_received_event().present()) {
+        enc->begin_element("bundle_received_event");
+        encode(x.bundle_received_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.data_transmitted_event().present()) {
+        enc->begin_element("data_transmitted_event");
+        encode(x.data_transmitted_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_delivered_event().present()) {
+        enc->begin_element("bundle_delivered_event");
+        encode(x.bundle_delivered_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_delivery_event().present()) {
+        enc->begin_element("bundle_delivery_event");
+        encode(x.bundle_delivery_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_expired_event().present()) {
+        enc->begin_element("bundle_expired_event");
+        encode(x.bundle_expired_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_send_cancelled_event().present()) {
+        enc->begin_element("bundle_send_cancelled_event");
+        encode(x.bundle_send_cancelled_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_injected_event().present()) {
+        enc->begin_element("bundle_injected_event");
+        encode(x.bundle_injected_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_opened_event().present()) {
+        enc->begin_element("link_opened_event");
+        encode(x.link_opened_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_closed_event().present()) {
+        enc->begin_element("link_closed_event");
+        encode(x.link_closed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_created_event().present()) {
+        enc->begin_element("link_created_event");
+        encode(x.link_created_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_deleted_event().present()) {
+        enc->begin_element("link_deleted_event");
+        encode(x.link_deleted_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_available_event().present()) {
+        enc->begin_element("link_available_event");
+        encode(x.link_available_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_unavailable_event().present()) {
+        enc->begin_element("link_unavailable_event");
+        encode(x.link_unavailable_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_attribute_changed_event().present()) {
+        enc->begin_element("link_attribute_changed_event");
+        encode(x.link_attribute_changed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.contact_attribute_changed_event().present()) {
+        enc->begin_element("contact_attribute_changed_event");
+        encode(x.contact_attribute_changed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_busy_event().present()) {
+        enc->begin_element("link_busy_event");
+        encode(x.link_busy_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.eid_reachable_event().present()) {
+        enc->begin_element("eid_reachable_event");
+        encode(x.eid_reachable_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.route_add_event().present()) {
+        enc->begin_element("route_add_event");
+        encode(x.route_add_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.route_delete_event().present()) {
+        enc->begin_element("route_delete_event");
+        encode(x.route_delete_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.custody_signal_event().present()) {
+        enc->begin_element("custody_signal_event");
+        encode(x.custody_signal_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.custody_timeout_event().present()) {
+        enc->begin_element("custody_timeout_event");
+        encode(x.custody_timeout_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.intentional_name_resolved_event().present()) {
+        enc->begin_element("intentional_name_resolved_event");
+        encode(x.intentional_name_resolved_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.registration_added_event().present()) {
+        enc->begin_element("registration_added_event");
+        encode(x.registration_added_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.registration_removed_event().present()) {
+        enc->begin_element("registration_removed_event");
+        encode(x.registration_removed_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.registration_expired_event().present()) {
+        enc->begin_element("registration_expired_event");
+        encode(x.registration_expired_event().get(), enc);
+        enc->end_element();
+    }
+    if (x.open_link_request().present()) {
+        enc->begin_element("open_link_request");
+        encode(x.open_link_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.close_link_request().present()) {
+        enc->begin_element("close_link_request");
+        encode(x.close_link_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.add_link_request().present()) {
+        enc->begin_element("add_link_request");
+        encode(x.add_link_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.delete_link_request().present()) {
+        enc->begin_element("delete_link_request");
+        encode(x.delete_link_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.reconfigure_link_request().present()) {
+        enc->begin_element("reconfigure_link_request");
+        encode(x.reconfigure_link_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.send_bundle_request().present()) {
+        enc->begin_element("send_bundle_request");
+        encode(x.send_bundle_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.send_bundle_broadcast_request().present()) {
+        enc->begin_element("send_bundle_broadcast_request");
+        encode(x.send_bundle_broadcast_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.cancel_bundle_request().present()) {
+        enc->begin_element("cancel_bundle_request");
+        encode(x.cancel_bundle_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.inject_bundle_request().present()) {
+        enc->begin_element("inject_bundle_request");
+        encode(x.inject_bundle_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.delete_bundle_request().present()) {
+        enc->begin_element("delete_bundle_request");
+        encode(x.delete_bundle_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.set_cl_params_request().present()) {
+        enc->begin_element("set_cl_params_request");
+        encode(x.set_cl_params_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.intentional_name_resolution_request().present()) {
+        enc->begin_element("intentional_name_resolution_request");
+        encode(x.intentional_name_resolution_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.deliver_bundle_to_app_request().present()) {
+        enc->begin_element("deliver_bundle_to_app_request");
+        encode(x.deliver_bundle_to_app_request().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_query().present()) {
+        enc->begin_element("link_query");
+        enc->end_element();
+    }
+    if (x.link_report().present()) {
+        enc->begin_element("link_report");
+        encode(x.link_report().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_attributes_query().present()) {
+        enc->begin_element("link_attributes_query");
+        encode(x.link_attributes_query().get(), enc);
+        enc->end_element();
+    }
+    if (x.link_attributes_report().present()) {
+        enc->begin_element("link_attributes_report");
+        encode(x.link_attributes_report().get(), enc);
+        enc->end_element();
+    }
+    if (x.contact_query().present()) {
+        enc->begin_element("contact_query");
+        enc->end_element();
+    }
+    if (x.contact_report().present()) {
+        enc->begin_element("contact_report");
+        encode(x.contact_report().get(), enc);
+        enc->end_element();
+    }
+    if (x.route_query().present()) {
+        enc->begin_element("route_query");
+        enc->end_element();
+    }
+    if (x.route_report().present()) {
+        enc->begin_element("route_report");
+        encode(x.route_report().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_query().present()) {
+        enc->begin_element("bundle_query");
+        enc->end_element();
+    }
+    if (x.bundle_report().present()) {
+        enc->begin_element("bundle_report");
+        encode(x.bundle_report().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_attributes_query().present()) {
+        enc->begin_element("bundle_attributes_query");
+        encode(x.bundle_attributes_query().get(), enc);
+        enc->end_element();
+    }
+    if (x.bundle_attributes_report().present()) {
+        enc->begin_element("bundle_attributes_report");
+        encode(x.bundle_attributes_report().get(), enc);
+        enc->end_element();
+    }
+}
+
+//----------------------------------------------------------------------
+static bool
+decode(RouterTLV::Decoder* dec, bpa* x)
+{
+    RouterTLV::record_t type;
+    std::string name, text;
+
+    while (dec->get_record(&type)) {
+        if (type == RouterTLV::END) {
+            return true;
+        }
+
+        // character data around the elements is ignored
+        if (type == RouterTLV::TEXT) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            continue;
+        }
+
+        if (! dec->get_name(&name)) {
+            return false;
+        }
+
+        // as with the xsd parser, unknown attributes are ignored
+        if (type == RouterTLV::ATTRIBUTE) {
+            if (! dec->get_value(&text)) {
+                return false;
+            }
+            if (name == "eid") {
+                ::xml_schema::string v(text);
+                x->eid(v);
+            } else if (name == "hello_interval") {
+                ::xml_schema::unsigned_short v;
+                if (! RouterTLV::parse(text, &v)) {
+                    return false;
+                }
+                x->hello_interval(v);
+            } else if (name == "alert") {
+                dtnStatusType v((::xml_schema::string(text)));
+                (void)static_cast< dtnStatusType::_xsd_dtnStatusType >(v);
+                x->alert(v);
+            }
+            continue;
+        }
+
+        if (name == "bundle_received_event") {
+            std::auto_ptr< bundle_received_event > c(new bundle_received_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_received_event(c);
+        } else if (name == "data_transmitted_event") {
+            std::auto_ptr< data_transmitted_event > c(new data_transmitted_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->data_transmitted_event(c);
+        } else if (name == "bundle_delivered_event") {
+            std::auto_ptr< bundle_delivered_event > c(new bundle_delivered_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_delivered_event(c);
+        } else if (name == "bundle_delivery_event") {
+            std::auto_ptr< bundle_delivery_event > c(new bundle_delivery_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_delivery_event(c);
+        } else if (name == "bundle_expired_event") {
+            std::auto_ptr< bundle_expired_event > c(new bundle_expired_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_expired_event(c);
+        } else if (name == "bundle_send_cancelled_event") {
+            std::auto_ptr< bundle_send_cancelled_event > c(new bundle_send_cancelled_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_send_cancelled_event(c);
+        } else if (name == "bundle_injected_event") {
+            std::auto_ptr< bundle_injected_event > c(new bundle_injected_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_injected_event(c);
+        } else if (name == "link_opened_event") {
+            std::auto_ptr< link_opened_event > c(new link_opened_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_opened_event(c);
+        } else if (name == "link_closed_event") {
+            std::auto_ptr< link_closed_event > c(new link_closed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_closed_event(c);
+        } else if (name == "link_created_event") {
+            std::auto_ptr< link_created_event > c(new link_created_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_created_event(c);
+        } else if (name == "link_deleted_event") {
+            std::auto_ptr< link_deleted_event > c(new link_deleted_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_deleted_event(c);
+        } else if (name == "link_available_event") {
+            std::auto_ptr< link_available_event > c(new link_available_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_available_event(c);
+        } else if (name == "link_unavailable_event") {
+            std::auto_ptr< link_unavailable_event > c(new link_unavailable_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_unavailable_event(c);
+        } else if (name == "link_attribute_changed_event") {
+            std::auto_ptr< link_attribute_changed_event > c(new link_attribute_changed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attribute_changed_event(c);
+        } else if (name == "contact_attribute_changed_event") {
+            std::auto_ptr< contact_attribute_changed_event > c(new contact_attribute_changed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_attribute_changed_event(c);
+        } else if (name == "link_busy_event") {
+            std::auto_ptr< link_busy_event > c(new link_busy_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_busy_event(c);
+        } else if (name == "eid_reachable_event") {
+            std::auto_ptr< eid_reachable_event > c(new eid_reachable_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->eid_reachable_event(c);
+        } else if (name == "route_add_event") {
+            std::auto_ptr< route_add_event > c(new route_add_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->route_add_event(c);
+        } else if (name == "route_delete_event") {
+            std::auto_ptr< route_delete_event > c(new route_delete_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->route_delete_event(c);
+        } else if (name == "custody_signal_event") {
+            std::auto_ptr< custody_signal_event > c(new custody_signal_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custody_signal_event(c);
+        } else if (name == "custody_timeout_event") {
+            std::auto_ptr< custody_timeout_event > c(new custody_timeout_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->custody_timeout_event(c);
+        } else if (name == "intentional_name_resolved_event") {
+            std::auto_ptr< intentional_name_resolved_event > c(new intentional_name_resolved_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->intentional_name_resolved_event(c);
+        } else if (name == "registration_added_event") {
+            std::auto_ptr< registration_added_event > c(new registration_added_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->registration_added_event(c);
+        } else if (name == "registration_removed_event") {
+            std::auto_ptr< registration_removed_event > c(new registration_removed_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->registration_removed_event(c);
+        } else if (name == "registration_expired_event") {
+            std::auto_ptr< registration_expired_event > c(new registration_expired_event());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->registration_expired_event(c);
+        } else if (name == "open_link_request") {
+            std::auto_ptr< open_link_request > c(new open_link_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->open_link_request(c);
+        } else if (name == "close_link_request") {
+            std::auto_ptr< close_link_request > c(new close_link_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->close_link_request(c);
+        } else if (name == "add_link_request") {
+            std::auto_ptr< add_link_request > c(new add_link_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->add_link_request(c);
+        } else if (name == "delete_link_request") {
+            std::auto_ptr< delete_link_request > c(new delete_link_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->delete_link_request(c);
+        } else if (name == "reconfigure_link_request") {
+            std::auto_ptr< reconfigure_link_request > c(new reconfigure_link_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->reconfigure_link_request(c);
+        } else if (name == "send_bundle_request") {
+            std::auto_ptr< send_bundle_request > c(new send_bundle_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->send_bundle_request(c);
+        } else if (name == "send_bundle_broadcast_request") {
+            std::auto_ptr< send_bundle_broadcast_request > c(new send_bundle_broadcast_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->send_bundle_broadcast_request(c);
+        } else if (name == "cancel_bundle_request") {
+            std::auto_ptr< cancel_bundle_request > c(new cancel_bundle_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->cancel_bundle_request(c);
+        } else if (name == "inject_bundle_request") {
+            std::auto_ptr< inject_bundle_request > c(new inject_bundle_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->inject_bundle_request(c);
+        } else if (name == "delete_bundle_request") {
+            std::auto_ptr< delete_bundle_request > c(new delete_bundle_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->delete_bundle_request(c);
+        } else if (name == "set_cl_params_request") {
+            std::auto_ptr< set_cl_params_request > c(new set_cl_params_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->set_cl_params_request(c);
+        } else if (name == "intentional_name_resolution_request") {
+            std::auto_ptr< intentional_name_resolution_request > c(new intentional_name_resolution_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->intentional_name_resolution_request(c);
+        } else if (name == "deliver_bundle_to_app_request") {
+            std::auto_ptr< deliver_bundle_to_app_request > c(new deliver_bundle_to_app_request());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->deliver_bundle_to_app_request(c);
+        } else if (name == "link_query") {
+            if (! dec->skip_element()) {
+                return false;
+            }
+            x->link_query(::xml_schema::type());
+        } else if (name == "link_report") {
+            std::auto_ptr< link_report > c(new link_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_report(c);
+        } else if (name == "link_attributes_query") {
+            std::auto_ptr< link_attributes_query > c(new link_attributes_query());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attributes_query(c);
+        } else if (name == "link_attributes_report") {
+            std::auto_ptr< link_attributes_report > c(new link_attributes_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->link_attributes_report(c);
+        } else if (name == "contact_query") {
+            if (! dec->skip_element()) {
+                return false;
+            }
+            x->contact_query(::xml_schema::type());
+        } else if (name == "contact_report") {
+            std::auto_ptr< contact_report > c(new contact_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->contact_report(c);
+        } else if (name == "route_query") {
+            if (! dec->skip_element()) {
+                return false;
+            }
+            x->route_query(::xml_schema::type());
+        } else if (name == "route_report") {
+            std::auto_ptr< route_report > c(new route_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->route_report(c);
+        } else if (name == "bundle_query") {
+            if (! dec->skip_element()) {
+                return false;
+            }
+            x->bundle_query(::xml_schema::type());
+        } else if (name == "bundle_report") {
+            std::auto_ptr< bundle_report > c(new bundle_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_report(c);
+        } else if (name == "bundle_attributes_query") {
+            std::auto_ptr< bundle_attributes_query > c(new bundle_attributes_query());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes_query(c);
+        } else if (name == "bundle_attributes_report") {
+            std::auto_ptr< bundle_attributes_report > c(new bundle_attributes_report());
+            if (! decode(dec, c.get())) {
+                return false;
+            }
+            x->bundle_attributes_report(c);
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+//----------------------------------------------------------------------
+void
+bpa_tlv(const bpa& message, RouterTLV::Encoder* enc)
+{
+    enc->begin_element("bpa");
+    encode(message, enc);
+    enc->end_element();
+}
+
+//----------------------------------------------------------------------
+std::auto_ptr< bpa >
+bpa_tlv(RouterTLV::Decoder* dec)
+{
+    std::auto_ptr< bpa > message;
+
+    RouterTLV::record_t type;
+    std::string name;
+    if (! dec->get_record(&type) || type != RouterTLV::ELEMENT ||
+        ! dec->get_name(&name) || name != "bpa")
+    {
+        return message;
+    }
+
+    message.reset(new bpa());
+    try {
+        if (! decode(dec, message.get())) {
+            message.reset();
+        }
+    } catch (::xml_schema::exception&) {
+        // an unknown enumeration value
+        message.reset();
+    }
+
+    return message;
+}
+
+} // namespace rtrmessage
+} // namespace dtn
+
+#endif // XERCES_C_ENABLED && EXTERNAL_DP_ENABLED
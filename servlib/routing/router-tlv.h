@@ -0,0 +1,48 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+// Generated by tools/xsd-tlv.py from router.xsd, do not edit. Regenerate with
+// "make tlvbindings" in servlib after the xsd bindings change.
+
+#ifndef _ROUTER_TLV_BINDINGS_H_
+#define _ROUTER_TLV_BINDINGS_H_
+
+#if defined(XERCES_C_ENABLED) && defined(EXTERNAL_DP_ENABLED)
+
+#include <memory>
+#include "router-custom.h"
+#include "routing/RouterTLV.h"
+
+namespace dtn {
+namespace rtrmessage {
+
+/**
+ * Append the records for a bpa message to a binary payload.
+ */
+void bpa_tlv(const bpa& message, RouterTLV::Encoder* enc);
+
+/**
+ * Read the next bpa message of a binary payload. Returns NULL if
+ * the records are malformed or do not match the schema.
+ */
+std::auto_ptr< bpa > bpa_tlv(RouterTLV::Decoder* dec);
+
+} // namespace rtrmessage
+} // namespace dtn
+
+#endif // XERCES_C_ENABLED && EXTERNAL_DP_ENABLED
+
+#endif /* _ROUTER_TLV_BINDINGS_H_ */
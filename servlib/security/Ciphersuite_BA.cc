@@ -24,6 +24,7 @@
 #include "bundling/BundleDaemon.h"
 #include "bundling/SDNV.h"
 #include "KeyDB.h"
+#include "DigestCache.h"
 #include "openssl/hmac.h"
 
 // Need quad versions of hton for manipulating full-length (unpacked) SDNV values
@@ -68,8 +69,12 @@ Ciphersuite_BA::Ciphersuite_BA()
 
 int Ciphersuite_BA::create_digest(const Bundle *bundle, BlockInfo* block, const BlockInfoVec *recv_blocks, const KeyDB::Entry* key_entry, u_char *result) {
     HMAC_CTX        	ctx;
+    const EVP_MD*   	md;
     u_int32_t       	rlen = 0;
-    OpaqueContext*   	r = reinterpret_cast<OpaqueContext*>(&ctx);
+    DigestCache::Image	image(bundle);
+    OpaqueContext*   	r = reinterpret_cast<OpaqueContext*>(&image);
+    std::string     	key_id;
+    std::string     	cached;
     size_t         		offset;
     size_t          	len;
     size_t          	rem;
@@ -77,13 +82,12 @@ int Ciphersuite_BA::create_digest(const Bundle *bundle, BlockInfo* block, const
     u_int64_t       	suite_num;
     int             	sdnv_len = 0;        // use an int to handle -1 return values
 
-        HMAC_CTX_init(&ctx);
         if (result_len() == 20) {
-        	HMAC_Init_ex(&ctx, key_entry->key(), key_entry->key_len(), EVP_sha1(), NULL);
+        	md = EVP_sha1();
         } else if (result_len() == 32) {
-        	HMAC_Init_ex(&ctx, key_entry->key(), key_entry->key_len(), EVP_sha256(), NULL);
+        	md = EVP_sha256();
         } else if (result_len() == 48) {
-        	HMAC_Init_ex(&ctx, key_entry->key(), key_entry->key_len(), EVP_sha384(), NULL);
+        	md = EVP_sha384();
         } else {
         	log_err_p(log, "Ciphersuite_BA::validate: Invalid value for hash length (bytes): %zu (should be 20, 32 or 48)", result_len());
         	goto fail;
@@ -160,19 +164,28 @@ int Ciphersuite_BA::create_digest(const Bundle *bundle, BlockInfo* block, const
                 }
             }
             
-            iter->owner()->process( Ciphersuite_BA::digest,
-                                    bundle,
-                                    block,
-                                    &*iter,
-                                    offset,
-                                    len,
-                                    r);
+            // the payload contents are only read when the image is
+            // hashed, if the result isn't already known
+            image.append_block(block, &*iter, offset, len);
+        }
+
+        // the mac depends on the key as well as the bundle
+        key_id = DigestCache::key_id(key_entry->key(), key_entry->key_len());
+        if (bundle->digest_cache()->lookup(cs_num(), key_id, image, &cached)) {
+            ASSERT(cached.size() == result_len());
+            memcpy(result, cached.data(), cached.size());
+            return BP_SUCCESS;
         }
+
+        HMAC_CTX_init(&ctx);
+        HMAC_Init_ex(&ctx, key_entry->key(), key_entry->key_len(), md, NULL);
+        image.replay(hmac_update, &ctx);
         
         // finalize the digest
         HMAC_Final(&ctx, result, &rlen);
         HMAC_cleanup(&ctx);
         ASSERT(rlen == result_len());
+        bundle->digest_cache()->insert(cs_num(), key_id, image, result, rlen);
     return BP_SUCCESS;
   fail:
     return BP_FAIL;
@@ -480,10 +493,9 @@ Ciphersuite_BA::finalize(const Bundle*  bundle,
 
 
 // This method takes these arguments so that it can be passed to
-// BlockProcessor::process.  When we are digesting the payload, it may
-// be stored on disk rather than in the block contents.  process knows
-// how to handle this.  Otherwise we could just walk through the block
-// contents ourself.
+// BlockProcessor::process.  It adds to the DigestCache::Image being
+// built, which refers to the payload rather than copying it, as it
+// may be stored on disk rather than in the block contents.
 //----------------------------------------------------------------------
 void
 Ciphersuite_BA::digest(const Bundle*    bundle,
@@ -499,9 +511,16 @@ Ciphersuite_BA::digest(const Bundle*    bundle,
     
     log_debug_p(log, "Ciphersuite_BA::digest() %zu", len);
 
-    HMAC_CTX*       pctx = reinterpret_cast<HMAC_CTX*>(r);
+    DigestCache::Image* image = reinterpret_cast<DigestCache::Image*>(r);
     
-    HMAC_Update( pctx, reinterpret_cast<const u_char*>(buf), len );
+    image->append(buf, len);
+}
+
+//----------------------------------------------------------------------
+void
+Ciphersuite_BA::hmac_update(void* ctx, const u_char* buf, size_t len)
+{
+    HMAC_Update(reinterpret_cast<HMAC_CTX*>(ctx), buf, len);
 }
 
 } // namespace dtn
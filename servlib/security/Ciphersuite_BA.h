@@ -66,6 +66,9 @@ public:
                        const void*      buf,
                        size_t           len,
                        OpaqueContext*   r);
+
+    /// DigestCache::update_func for the HMAC context
+    static void hmac_update(void* ctx, const u_char* buf, size_t len);
     
 };
 
@@ -323,7 +323,7 @@ Ciphersuite_ES::finalize(const Bundle*  bundle,
 
 	// prepare context - one time for all usage here
     log_debug_p(log, "Ciphersuite_ES::finalize: calling gcm_init_and_key with key=%s", buf2str(key,get_key_len()).c_str());
-	gcm_init_and_key(key, get_key_len(), &(ctx_ex.c));
+	ctx_ex.c.init_and_key(key, get_key_len());
 	ctx_ex.operation = op_encrypt;
 
     log_debug_p(log, "Ciphersuite_ES::finalize: walk block list");
@@ -131,7 +131,7 @@ Ciphersuite_PC::validate(const Bundle*           bundle,
             goto fail;
         }
     	// prepare context - one time for all usage here
-    	gcm_init_and_key(key, get_key_len(), &(ctx_ex.c));
+    	ctx_ex.c.init_and_key(key, get_key_len());
     	ctx_ex.operation = op_decrypt;
 
     	// we have the necessary pieces from params and result so now
@@ -183,7 +183,6 @@ Ciphersuite_PC::validate(const Bundle*           bundle,
     		case BundleProtocol::PAYLOAD_BLOCK:
     		{
     			log_debug_p(log, "Ciphersuite_PC::validate: PAYLOAD_BLOCK");
-    			u_char          tag_calc[tag_len];
     			// nonce is 12 bytes, first 4 are salt (same for all blocks)
     			// and last 8 bytes are per-block IV. The final 4 bytes in
     			// the full block-sized field are, of course, the counter
@@ -196,7 +195,7 @@ Ciphersuite_PC::validate(const Bundle*           bundle,
 
     			log_debug_p(log, "Ciphersuite_PC::validate: nonce %s", buf2str(nonce, nonce_len).c_str());
     			// prepare context
-    			gcm_init_message(nonce, nonce_len, &(ctx_ex.c));
+    			ctx_ex.c.init_message(nonce, nonce_len);
 
     			offset = iter->data_offset();
     			len = iter->data_length();
@@ -209,11 +208,9 @@ Ciphersuite_PC::validate(const Bundle*           bundle,
     					len,
     					r );
 
-    			// collect the tag (icv) from the context
-    			gcm_compute_tag( tag_calc, tag_len, &(ctx_ex.c) );
+    			// check the tag (icv) against the context
     			log_debug_p(log, "Ciphersuite_PC::validate: tag      %s", buf2str(tag).c_str());
-    			log_debug_p(log, "Ciphersuite_PC::validate: tag_calc %s", buf2str(tag_calc, tag_len).c_str());
-    			if (memcmp(tag.buf(), tag_calc, tag_len) != 0) {
+    			if (ctx_ex.c.check_tag(tag.buf(), tag_len) != RETURN_OK) {
     				log_err_p(log, "Ciphersuite_PC::validate: tag comparison failed");
     				goto fail;
     			}
@@ -451,7 +448,7 @@ Ciphersuite_PC::finalize(const Bundle*  bundle,
     // NEED-BIT-SECURITY-LEVEL
     // prepare context - one time for all usage here
     memcpy(key, locals->key().buf(), get_key_len());
-    gcm_init_and_key(key, get_key_len(), &(ctx_ex.c));
+    ctx_ex.c.init_and_key(key, get_key_len());
     ctx_ex.operation = op_encrypt;
     if(locals->cs_flags() & CS_BLOCK_HAS_DEST) {
         log_debug_p(log, "Ciphersuite::finalize running with destination %s", locals->security_dest().c_str());
@@ -516,7 +513,7 @@ Ciphersuite_PC::finalize(const Bundle*  bundle,
 
     			// prepare context
     			log_debug_p(log, "Ciphersuite_PC::finalize: nonce    %s", buf2str(nonce,12).c_str());
-    			gcm_init_message(nonce, nonce_len, &(ctx_ex.c));
+    			ctx_ex.c.init_message(nonce, nonce_len);
 
     			offset = iter->data_offset();
     			len = iter->data_length();
@@ -529,7 +526,7 @@ Ciphersuite_PC::finalize(const Bundle*  bundle,
     					r);
 
     			// collect the tag (icv) from the context
-    					gcm_compute_tag( tag, tag_len, &(ctx_ex.c) );
+    					ctx_ex.c.compute_tag( tag, tag_len );
     			log_debug_p(log, "Ciphersuite_PC::finalize: tag      %s", buf2str(tag, 16).c_str());
 
     			const_cast<Bundle *>(bundle)->set_payload_tag(tag);
@@ -569,9 +566,9 @@ Ciphersuite_PC::do_crypt(const Bundle*    bundle,
     
     log_debug_p(log, "Ciphersuite_PC::do_crypt: operation %hhu len %zu", pctx->operation, len);
     if (pctx->operation == op_encrypt)
-        gcm_encrypt( reinterpret_cast<u_char*>(buf), len, &(pctx->c) );
+        pctx->c.encrypt( reinterpret_cast<u_char*>(buf), len );
     else    
-        gcm_decrypt( reinterpret_cast<u_char*>(buf), len, &(pctx->c) );
+        pctx->c.decrypt( reinterpret_cast<u_char*>(buf), len );
 
     return (len > 0) ? true : false;
 }
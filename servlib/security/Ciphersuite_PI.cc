@@ -317,6 +317,13 @@ Ciphersuite_PI::finalize(const Bundle*  bundle,
     return BP_FAIL;
 }
 
+//----------------------------------------------------------------------
+void
+Ciphersuite_PI::digest_update(void* ctx, const u_char* buf, size_t len)
+{
+    EVP_DigestUpdate(reinterpret_cast<EVP_MD_CTX*>(ctx), buf, len);
+}
+
 //----------------------------------------------------------------------
 int
 Ciphersuite_PI::create_digest(const Bundle*  bundle, 
@@ -326,34 +333,29 @@ Ciphersuite_PI::create_digest(const Bundle*  bundle,
                                int hash_length = 256)
 {
     EVP_MD_CTX      ctx;
-    OpaqueContext*  r = reinterpret_cast<OpaqueContext*>(&ctx);
+    const EVP_MD*   md;
+    DigestCache::Image image(bundle);
+    OpaqueContext*  r = reinterpret_cast<OpaqueContext*>(&image);
     char*           dict;
     size_t          digest_len;
     u_char          ps_digest[EVP_MAX_MD_SIZE];
     u_int32_t       rlen = 0;
     EndpointID      local_eid = BundleDaemon::instance()->local_eid();
     BlockInfoVec::iterator iter;
+    std::string     cached;
     int             err = 0;
         
     log_debug_p(log, "Ciphersuite_PI::create_digest()");
         
-    // prepare context 
-    EVP_MD_CTX_init(&ctx);
     if (hash_length == 384) {
-        err = EVP_DigestInit_ex(&ctx, EVP_sha384(), NULL);
+        md = EVP_sha384();
     } else {
 		// SHA-256 is the default hash function
-        err = EVP_DigestInit_ex(&ctx, EVP_sha256(), NULL);
+        md = EVP_sha256();
     }
-    if(err == 0) {
-        log_err_p(log, "Ciphersuite_PI::create_digest: Error initing sha digest");
-        return BP_FAIL;
-    }
-    digest_len = EVP_MD_CTX_size(&ctx);
-    // XXX-pl  check error -- zero is failure
         
-    // Walk the list and process each of the blocks.
-    // We only digest PS, C3 and the payload data,
+    // Walk the list and collect the canonical form of each of the
+    // blocks. We only digest PS, C3 and the payload data,
     // all others are ignored
     
     // Note that we can only process PSBs and C3s that follow this block
@@ -411,9 +413,34 @@ Ciphersuite_PI::create_digest(const Bundle*  bundle,
     }       // end of loop-through-all-the-blocks
     
     
+    // the same bundle may well have been digested already, for another
+    // link or when it was received
+    if (bundle->digest_cache()->lookup(cs_num(), EVP_MD_name(md),
+                                       image, &cached))
+    {
+        db.reserve(cached.size());
+        db.set_len(cached.size());
+        memcpy(db.buf(), cached.data(), cached.size());
+        log_debug_p(log, "Ciphersuite_PI::create_digest() used cached digest");
+        return BP_SUCCESS;
+    }
+
+    // prepare context 
+    EVP_MD_CTX_init(&ctx);
+    err = EVP_DigestInit_ex(&ctx, md, NULL);
+    if(err == 0) {
+        log_err_p(log, "Ciphersuite_PI::create_digest: Error initing sha digest");
+        return BP_FAIL;
+    }
+    digest_len = EVP_MD_CTX_size(&ctx);
+    // XXX-pl  check error -- zero is failure
+
+    image.replay(digest_update, &ctx);
+    
     err = EVP_DigestFinal_ex(&ctx, ps_digest, &rlen);
     if(err == 0) {
         log_err_p(log, "Ciphersuite_PI::create_digest: failed to finalize digest");
+        EVP_MD_CTX_cleanup(&ctx);
         return BP_FAIL;
     }
     
@@ -424,6 +451,8 @@ Ciphersuite_PI::create_digest(const Bundle*  bundle,
     db.reserve(digest_len);
     db.set_len(digest_len);
     memcpy(db.buf(), ps_digest, digest_len);
+    bundle->digest_cache()->insert(cs_num(), EVP_MD_name(md), image,
+                                   ps_digest, digest_len);
     log_debug_p(log, "Ciphersuite_PI::create_digest() done");
     
     return BP_SUCCESS;
@@ -24,6 +24,7 @@
 #include "PI_BlockProcessor.h"
 #include "EVP_PK.h"
 #include "Ciphersuite_integ.h"
+#include "DigestCache.h"
 
 #include <stdio.h>
 
@@ -72,6 +73,9 @@ public:
                        int sec_lev);
 
   private:
+    /// DigestCache::update_func for the EVP digest context
+    static void digest_update(void* ctx, const u_char* buf, size_t len);
+
     virtual int verify_wrapper(const Bundle*	b,
                                BlockInfoVec* 	block_list,
                                BlockInfo* 		block,
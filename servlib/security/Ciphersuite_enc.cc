@@ -15,7 +15,7 @@ static const char * log = "/dtn/bundle/ciphersuite";
 
 // This actually encrypts the block in place, so don't expect to use
 // the block itself again.
-int Ciphersuite_enc::encrypt_contents(u_char *salt, u_char *iv, gcm_ctx_ex ctx_ex, BlockInfo *block, LocalBuffer &store_result_here, u_char *tag) {
+int Ciphersuite_enc::encrypt_contents(u_char *salt, u_char *iv, gcm_ctx_ex& ctx_ex, BlockInfo *block, LocalBuffer &store_result_here, u_char *tag) {
     u_char nonce[nonce_len];
     u_char *ptr=nonce;
 
@@ -23,16 +23,12 @@ int Ciphersuite_enc::encrypt_contents(u_char *salt, u_char *iv, gcm_ctx_ex ctx_e
     ptr+=nonce_len-iv_len;
     memcpy(ptr, iv, iv_len);
 
-    gcm_init_message(nonce, nonce_len, &(ctx_ex.c));
-        gcm_encrypt_message(nonce,
+    ctx_ex.c.encrypt_message(nonce,
                 nonce_len,
-                NULL,
-                0,
                 block->writable_contents()->buf(),
                 block->full_length(),
                 tag,
-                tag_len,
-                &(ctx_ex.c));
+                tag_len);
     log_debug_p(log, "Ciphersuite_enc::encapsulate: gcm_encrypt_message returned, encap_block=%s tag=%s",  buf2str(block->contents()).c_str(), buf2str(tag,tag_len).c_str());
 
         log_debug_p(log, "Ciphersuite_enc::encapsulate: body is encrypted");
@@ -69,11 +65,11 @@ int Ciphersuite_enc::add_sec_src_dest_to_eid_refs(BlockInfo *iter, string sec_sr
     return BP_SUCCESS;
 }
 
-int Ciphersuite_enc::encapsulate_subsequent(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex ctx_ex) {
+int Ciphersuite_enc::encapsulate_subsequent(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex& ctx_ex) {
     return encapsulate(iter, xmit_blocks, src_locals, block_type, ctx_ex, LocalBuffer(), false, true);
 }
 
-int Ciphersuite_enc::encapsulate(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex ctx_ex, LocalBuffer encrypted_key, bool first_block, bool use_correlator) {
+int Ciphersuite_enc::encapsulate(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex& ctx_ex, LocalBuffer encrypted_key, bool first_block, bool use_correlator) {
     LocalBuffer encap_block;
     u_int16_t       cs_flags;
     u_char iv[iv_len];
@@ -394,20 +390,17 @@ int Ciphersuite_enc::decapsulate(const Bundle *bundle, BlockInfo* iter, BP_Local
 
     // prepare context
     log_debug_p(log, "Ciphersuite_enc::decapsulate: calling gcm_init_and_key with key=%s", buf2str(key, get_key_len()).c_str());
-    gcm_init_and_key(key, get_key_len(), &(ctx_ex.c));
+    ctx_ex.c.init_and_key(key, get_key_len());
     log_debug_p(log, "Ciphersuite_enc::decapsulate: prepared context");
 
     // decrypt message
     log_debug_p(log, "Ciphersuite_enc::decapsulate: calling gcm_Decrypt_message with nonce=%s, encap_block=%s, tag=%s", buf2str(nonce, nonce_len).c_str(), buf2str(encap_block).c_str(), buf2str(tag_encap, tag_len).c_str());
-    ret = gcm_decrypt_message(nonce,
+    ret = ctx_ex.c.decrypt_message(nonce,
             nonce_len,
-            NULL,
-            0,
             encap_block.buf(),
             encap_block.len(),
             tag_encap,                // tag is input, for validation against calculated tag
-            tag_len,
-            &(ctx_ex.c));
+            tag_len);
 
     // check return value that the block was OK
     if ( ret != 0 ) {
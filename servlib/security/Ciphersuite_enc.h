@@ -4,6 +4,7 @@
 
 #include "Ciphersuite.h"
 #include "gcm/gcm.h"
+#include "GCMContext.h"
 
 namespace dtn {
 
@@ -16,8 +17,8 @@ class Ciphersuite_enc: public Ciphersuite {
 	};
 
 	typedef struct {
-		u_int8_t operation;
-		gcm_ctx  c;
+		u_int8_t   operation;
+		GCMContext c;
 	} gcm_ctx_ex;
 
 
@@ -32,15 +33,15 @@ class Ciphersuite_enc: public Ciphersuite {
     
 
 
-    int encrypt_contents(u_char *salt, u_char *iv, gcm_ctx_ex ctx_ex, BlockInfo *block, LocalBuffer &store_result_here, u_char *tag);
+    int encrypt_contents(u_char *salt, u_char *iv, gcm_ctx_ex& ctx_ex, BlockInfo *block, LocalBuffer &store_result_here, u_char *tag);
     int add_sec_src_dest_to_eid_refs(BlockInfo *iter, string sec_src, string sec_dest, u_int16_t *cs_flags);
 
     u_char nonce[nonce_len];
-    int encapsulate(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type /*of the result, not the src*/, gcm_ctx_ex ctx_ex,LocalBuffer encrypted_key, bool first_block, bool use_correlator);
+    int encapsulate(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type /*of the result, not the src*/, gcm_ctx_ex& ctx_ex,LocalBuffer encrypted_key, bool first_block, bool use_correlator);
 
     // Convenience method for encapsulating subsequent blocks.  It
     // just calls encapsulate with the right parameters
-    int encapsulate_subsequent(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex ctx_ex);
+    int encapsulate_subsequent(BlockInfo *iter, BlockInfoVec *xmit_blocks, BP_Local_CS *src_locals, int block_type, gcm_ctx_ex& ctx_ex);
 
     int decapsulate(const Bundle *bundle, BlockInfo* iter, BP_Local_CS* locals, bool first_block, u_char *key, u_char *salt, u_int64_t &correlator);
     int recreate_block(LocalBuffer encap_block, BlockInfo* iter, const Bundle *bundle, int skip_eid_refs);
@@ -6,8 +6,8 @@
 #include "BP_Local_CS.h"
 #include "bundling/Bundle.h"
 #include "Ciphersuite_integ.h"
+#include "DigestCache.h"
 #include "bundling/SDNV.h"
-#include <openssl/evp.h>
 
 #ifdef BSP_ENABLED
 
@@ -290,13 +290,10 @@ int Ciphersuite_integ::mutable_canonicalization_extension(const Bundle *bundle,
     } else {
            
        log_debug_p(log, "Ciphersuite::mutable_canonicalization_extension() about to call iter->owner()->process with len=%d, offset=%d",len,offset); 
-       iter->owner()->process( Ciphersuite_integ::digest,
-                            bundle,
-                            block,
-                            &*iter,
-                            offset,
-                            len,
-                            r);
+       reinterpret_cast<DigestCache::Image*>(r)->append_block(block,
+                                                              &*iter,
+                                                              offset,
+                                                              len);
     }
    log_debug_p(log, "Ciphersuite::mutable_canonicalization_extension() finished call to iter->owner()->process"); 
     /**********  end of content processing  **********/
@@ -374,16 +371,13 @@ int Ciphersuite_integ::mutable_canonicalization_payload(const Bundle *bundle, Bl
             
     /**********  start content processing  **********/
                                
-   // It is critical to call process here, since the payload may not
-   // be stored on the contents buffer (it may be on disk).  process
-   // can handle that case. 
-    iter->owner()->process( Ciphersuite_integ::digest,
-                            bundle,
-                            block,
-                            &*iter,
-                            offset,
-                            len,
-                            r);
+   // The payload may not be stored on the contents buffer (it may be
+   // on disk), so the image only refers to it, and it is read when the
+   // image is hashed, unless an earlier digest can be reused.
+    reinterpret_cast<DigestCache::Image*>(r)->append_block(block,
+                                                           &*iter,
+                                                           offset,
+                                                           len);
     /**********  end of content processing  **********/
     log_debug_p(log, "Ciphersuite::mutable_canonicalization_payload() PAYLOAD_BLOCK done");
     return BP_SUCCESS;
@@ -404,9 +398,9 @@ Ciphersuite_integ::digest(const Bundle*    bundle,
     
     //log_debug_p(log, "Ciphersuite::digest() %zu bytes %s", len, buf2str((u_char*)buf, len).c_str());
     log_debug_p(log, "Ciphersuite::digest() %zu bytes", len);
-    EVP_MD_CTX*       pctx = reinterpret_cast<EVP_MD_CTX*>(r);
+    DigestCache::Image* image = reinterpret_cast<DigestCache::Image*>(r);
 
-    EVP_DigestUpdate( pctx, buf, len );
+    image->append(buf, len);
 }
 
 //----------------------------------------------------------------------
@@ -10,6 +10,8 @@ struct PrimaryBlock_ex;
 
 class Ciphersuite_integ: public Ciphersuite {
   public:
+    // The canonicalization routines append to the DigestCache::Image
+    // passed as r, which the caller then hashes.
     int mutable_canonicalization_primary(const Bundle *bundle, BlockInfo *block, BlockInfo *iter /*This is a pointer to the primary block*/, OpaqueContext*  r, char **dict);
 
     int mutable_canonicalization_extension(const Bundle *bundle, BlockInfo *block, BlockInfo *iter, OpaqueContext*  r,char *dict);
@@ -0,0 +1,326 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#ifdef BSP_ENABLED
+
+#include <algorithm>
+#include <openssl/evp.h>
+#include <oasys/debug/Log.h>
+#include <oasys/util/ScratchBuffer.h>
+
+#include "DigestCache.h"
+#include "bundling/BlockProcessor.h"
+#include "bundling/Bundle.h"
+#include "bundling/BundleProtocol.h"
+
+namespace dtn {
+
+static const char* log = "/dtn/bundle/ciphersuite/digestcache";
+
+const size_t DigestCache::MAX_ENTRIES;
+const size_t DigestCache::PAYLOAD_CHUNK_LEN;
+
+oasys::SpinLock DigestCache::stats_lock_;
+u_int32_t DigestCache::hits_         = 0;
+u_int32_t DigestCache::misses_       = 0;
+u_int64_t DigestCache::bytes_hashed_ = 0;
+u_int64_t DigestCache::bytes_saved_  = 0;
+
+//----------------------------------------------------------------------
+DigestCache::Image::Image(const Bundle* bundle)
+    : bundle_(bundle),
+      payload_version_(bundle->payload().version()),
+      payload_bytes_(0)
+{
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::Image::append(const void* buf, size_t len)
+{
+    bytes_.append(reinterpret_cast<const char*>(buf), len);
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::Image::append_payload(size_t offset, size_t len)
+{
+    if (len == 0) {
+        return;
+    }
+
+    // extend the previous reference if this range follows on from it
+    if (! refs_.empty()) {
+        PayloadRef& last = refs_.back();
+        if (last.pos_ == bytes_.size() &&
+            last.offset_ + last.len_ == offset)
+        {
+            last.len_      += len;
+            payload_bytes_ += len;
+            return;
+        }
+    }
+
+    PayloadRef ref;
+    ref.pos_    = bytes_.size();
+    ref.offset_ = offset;
+    ref.len_    = len;
+    refs_.push_back(ref);
+    payload_bytes_ += len;
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::Image::append_block(const BlockInfo* caller_block,
+                                 const BlockInfo* target_block,
+                                 size_t offset, size_t len)
+{
+    OpaqueContext* r = reinterpret_cast<OpaqueContext*>(this);
+
+    if (target_block->type() != BundleProtocol::PAYLOAD_BLOCK) {
+        target_block->owner()->process(process_func, bundle_, caller_block,
+                                       target_block, offset, len, r);
+        return;
+    }
+
+    // the preamble is in the block contents, so it goes in as it is
+    if (offset < target_block->data_offset()) {
+        size_t len_to_do = std::min(len, target_block->data_offset() - offset);
+        target_block->owner()->process(process_func, bundle_, caller_block,
+                                       target_block, offset, len_to_do, r);
+        offset += len_to_do;
+        len    -= len_to_do;
+    }
+
+    if (len == 0) {
+        return;
+    }
+
+    // the same limit as PayloadBlockProcessor::process
+    size_t payload_offset = offset - target_block->data_offset();
+    size_t payload_len    = bundle_->payload().length();
+    if (payload_offset >= payload_len) {
+        return;
+    }
+    append_payload(payload_offset, std::min(len, payload_len - payload_offset));
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::Image::process_func(const Bundle*    bundle,
+                                 const BlockInfo* caller_block,
+                                 const BlockInfo* target_block,
+                                 const void*      buf,
+                                 size_t           len,
+                                 OpaqueContext*   r)
+{
+    (void)bundle;
+    (void)caller_block;
+    (void)target_block;
+
+    reinterpret_cast<Image*>(r)->append(buf, len);
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::Image::replay(update_func* update, void* ctx) const
+{
+    const u_char* bytes = reinterpret_cast<const u_char*>(bytes_.data());
+    size_t pos = 0;
+
+    oasys::ScratchBuffer<u_char*> work;
+    if (payload_bytes_ != 0) {
+        work.reserve(std::min(payload_bytes_, PAYLOAD_CHUNK_LEN));
+    }
+
+    for (size_t i = 0; i < refs_.size(); ++i) {
+        const PayloadRef& ref = refs_[i];
+        if (ref.pos_ > pos) {
+            (*update)(ctx, bytes + pos, ref.pos_ - pos);
+            pos = ref.pos_;
+        }
+
+        size_t offset    = ref.offset_;
+        size_t remaining = ref.len_;
+        while (remaining > 0) {
+            size_t len_to_do = std::min(remaining, PAYLOAD_CHUNK_LEN);
+            const u_char* buf =
+                bundle_->payload().read_data(offset, len_to_do, work.buf());
+            (*update)(ctx, buf, len_to_do);
+            offset    += len_to_do;
+            remaining -= len_to_do;
+        }
+    }
+
+    if (pos < bytes_.size()) {
+        (*update)(ctx, bytes + pos, bytes_.size() - pos);
+    }
+}
+
+//----------------------------------------------------------------------
+bool
+DigestCache::Image::operator==(const Image& other) const
+{
+    return bytes_ == other.bytes_ && refs_ == other.refs_;
+}
+
+//----------------------------------------------------------------------
+DigestCache::DigestCache()
+{
+}
+
+//----------------------------------------------------------------------
+bool
+DigestCache::lookup(u_int16_t cs_num, const std::string& key_id,
+                    const Image& image, std::string* result)
+{
+    bool hit = false;
+    {
+        oasys::ScopeLock l(&lock_, "DigestCache::lookup");
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            const Entry& e = entries_[i];
+            if (e.cs_num_ == cs_num &&
+                e.payload_version_ == image.payload_version_ &&
+                e.key_id_ == key_id &&
+                e.refs_ == image.refs_ &&
+                e.bytes_ == image.bytes_)
+            {
+                *result = e.result_;
+                hit = true;
+
+                // keep the entries in order of use
+                if (i + 1 != entries_.size()) {
+                    Entry tmp = e;
+                    entries_.erase(entries_.begin() + i);
+                    entries_.push_back(tmp);
+                }
+                break;
+            }
+        }
+    }
+
+    {
+        oasys::ScopeLock l(&stats_lock_, "DigestCache::lookup");
+        if (hit) {
+            ++hits_;
+            bytes_saved_ += image.payload_bytes();
+        } else {
+            ++misses_;
+        }
+    }
+
+    log_debug_p(log, "%s for cs %u over %zu bytes (%zu of payload)",
+                hit ? "hit" : "miss", cs_num, image.length(),
+                image.payload_bytes());
+    return hit;
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::insert(u_int16_t cs_num, const std::string& key_id,
+                    const Image& image, const u_char* result, size_t len)
+{
+    {
+        oasys::ScopeLock l(&lock_, "DigestCache::insert");
+
+        // entries for an older version of the payload can't match
+        // again, and otherwise the least recently used one goes
+        std::vector<Entry>::iterator iter = entries_.begin();
+        while (iter != entries_.end()) {
+            if (iter->payload_version_ != image.payload_version_) {
+                iter = entries_.erase(iter);
+            } else {
+                ++iter;
+            }
+        }
+        if (entries_.size() >= MAX_ENTRIES) {
+            entries_.erase(entries_.begin());
+        }
+
+        Entry e;
+        e.cs_num_          = cs_num;
+        e.key_id_          = key_id;
+        e.payload_version_ = image.payload_version_;
+        e.bytes_           = image.bytes_;
+        e.refs_            = image.refs_;
+        e.result_.assign(reinterpret_cast<const char*>(result), len);
+        entries_.push_back(e);
+    }
+
+    oasys::ScopeLock l(&stats_lock_, "DigestCache::insert");
+    bytes_hashed_ += image.payload_bytes();
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::clear()
+{
+    oasys::ScopeLock l(&lock_, "DigestCache::clear");
+    entries_.clear();
+}
+
+//----------------------------------------------------------------------
+size_t
+DigestCache::size() const
+{
+    oasys::ScopeLock l(&lock_, "DigestCache::size");
+    return entries_.size();
+}
+
+//----------------------------------------------------------------------
+std::string
+DigestCache::key_id(const u_char* key, size_t len)
+{
+    u_char md[EVP_MAX_MD_SIZE];
+    unsigned int md_len = 0;
+    if (EVP_Digest(key, len, md, &md_len, EVP_sha256(), NULL) != 1) {
+        // the id must still tell keys apart
+        log_err_p(log, "key_id: error computing key digest");
+        return std::string(reinterpret_cast<const char*>(key), len);
+    }
+    return std::string(reinterpret_cast<char*>(md), md_len);
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::get_stats(oasys::StringBuffer* buf)
+{
+    oasys::ScopeLock l(&stats_lock_, "DigestCache::get_stats");
+    buf->appendf("digest cache: %u hits %u misses -- "
+                 "%llu payload bytes hashed, %llu not rehashed",
+                 hits_, misses_,
+                 (unsigned long long)bytes_hashed_,
+                 (unsigned long long)bytes_saved_);
+}
+
+//----------------------------------------------------------------------
+void
+DigestCache::reset_stats()
+{
+    oasys::ScopeLock l(&stats_lock_, "DigestCache::reset_stats");
+    hits_         = 0;
+    misses_       = 0;
+    bytes_hashed_ = 0;
+    bytes_saved_  = 0;
+}
+
+} // namespace dtn
+
+#endif /* BSP_ENABLED */
@@ -0,0 +1,200 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _DIGEST_CACHE_H_
+#define _DIGEST_CACHE_H_
+
+#ifdef BSP_ENABLED
+
+#include <string>
+#include <vector>
+#include <sys/types.h>
+#include <oasys/thread/SpinLock.h>
+#include <oasys/util/StringBuffer.h>
+
+namespace dtn {
+
+class BlockInfo;
+class Bundle;
+class OpaqueContext;
+
+/**
+ * Per-bundle cache of the digests computed by the BA and PI
+ * ciphersuites.
+ *
+ * Rather than hashing the canonicalized bundle as they walk it, the
+ * ciphersuites collect it in an Image, which holds the canonical
+ * bytes of the primary and extension blocks but only refers to the
+ * payload contents by offset and length. Building the image is cheap;
+ * reading and hashing the payload is not. If the image, the payload
+ * version and the ciphersuite all match an earlier digest of the
+ * bundle, that result is used as it is, so forwarding a protected
+ * bundle over several links or retransmitting it hashes the payload
+ * once. Otherwise the image is replayed into the hash, with the
+ * payload streamed through in large chunks.
+ */
+class DigestCache {
+public:
+    /**
+     * Function to feed data into a hash context.
+     */
+    typedef void (update_func)(void* ctx, const u_char* buf, size_t len);
+
+    /**
+     * The canonicalized form of a bundle, as fed to a digest.
+     */
+    class Image {
+    public:
+        Image(const Bundle* bundle);
+
+        /// Append canonical bytes
+        void append(const void* buf, size_t len);
+
+        /// Append a reference to a range of the payload contents
+        void append_payload(size_t offset, size_t len);
+
+        /**
+         * Append a range of a block, as BlockProcessor::process
+         * would pass it to a digest function. The payload contents
+         * are added as a reference.
+         */
+        void append_block(const BlockInfo* caller_block,
+                          const BlockInfo* target_block,
+                          size_t offset, size_t len);
+
+        /**
+         * Callback for BlockProcessor::process that appends to the
+         * Image passed as the context.
+         */
+        static void process_func(const Bundle*    bundle,
+                                 const BlockInfo* caller_block,
+                                 const BlockInfo* target_block,
+                                 const void*      buf,
+                                 size_t           len,
+                                 OpaqueContext*   r);
+
+        /**
+         * Feed the whole image through the given hash function,
+         * reading the payload as it goes.
+         */
+        void replay(update_func* update, void* ctx) const;
+
+        /// Total length of the data the image stands for
+        size_t length() const { return bytes_.size() + payload_bytes_; }
+
+        /// Length of the payload data referenced
+        size_t payload_bytes() const { return payload_bytes_; }
+
+        bool operator==(const Image& other) const;
+
+    protected:
+        friend class DigestCache;
+
+        /// A payload range, found at pos_ in the canonical bytes
+        struct PayloadRef {
+            size_t pos_;
+            size_t offset_;
+            size_t len_;
+
+            bool operator==(const PayloadRef& o) const {
+                return pos_ == o.pos_ && offset_ == o.offset_ &&
+                    len_ == o.len_;
+            }
+        };
+
+        const Bundle*           bundle_;
+        u_int32_t               payload_version_;
+        std::string             bytes_;
+        std::vector<PayloadRef> refs_;
+        size_t                  payload_bytes_;
+    };
+
+    DigestCache();
+
+    /**
+     * Look up an earlier result for the image.
+     *
+     * @param cs_num  the ciphersuite
+     * @param key_id  anything else the result depends on, such as the
+     *                hash function or a key_id() of the MAC key
+     * @param result  set to the digest if it's found
+     * @return true on a hit
+     */
+    bool lookup(u_int16_t cs_num, const std::string& key_id,
+                const Image& image, std::string* result);
+
+    /**
+     * Remember the result computed over the image. Entries for older
+     * versions of the payload are dropped, and if the cache is still
+     * full, so is the least recently used one.
+     */
+    void insert(u_int16_t cs_num, const std::string& key_id,
+                const Image& image, const u_char* result, size_t len);
+
+    /// Drop all entries
+    void clear();
+
+    /// Number of entries
+    size_t size() const;
+
+    /**
+     * A digest of a MAC key for use as a key_id, so that the key
+     * itself isn't kept in the cache.
+     */
+    static std::string key_id(const u_char* key, size_t len);
+
+    /// @{ Counters over all bundles, for "security stats"
+    static void get_stats(oasys::StringBuffer* buf);
+    static void reset_stats();
+    /// @}
+
+    /// Most digests kept for one bundle
+    static const size_t MAX_ENTRIES = 4;
+
+    /// Size of the chunks in which the payload is read and hashed
+    static const size_t PAYLOAD_CHUNK_LEN = 256 * 1024;
+
+protected:
+    struct Entry {
+        u_int16_t   cs_num_;
+        std::string key_id_;
+        u_int32_t   payload_version_;
+        std::string bytes_;
+        std::vector<Image::PayloadRef> refs_;
+        std::string result_;
+    };
+
+    mutable oasys::SpinLock lock_;
+    std::vector<Entry>      entries_;
+
+    static oasys::SpinLock  stats_lock_;
+    static u_int32_t        hits_;
+    static u_int32_t        misses_;
+    static u_int64_t        bytes_hashed_;  ///< payload bytes hashed
+    static u_int64_t        bytes_saved_;   ///< payload bytes not rehashed
+
+private:
+    // the cache belongs to one bundle and its entries aren't copied
+    // along with it
+    DigestCache(const DigestCache&);
+    DigestCache& operator=(const DigestCache&);
+};
+
+} // namespace dtn
+
+#endif /* BSP_ENABLED */
+
+#endif /* _DIGEST_CACHE_H_ */
@@ -0,0 +1,395 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#ifdef BSP_ENABLED
+
+#include <limits.h>
+#include <string.h>
+#include <algorithm>
+#include <oasys/debug/DebugUtils.h>
+#include <oasys/debug/Log.h>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#elif defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#include <asm/hwcap.h>
+#endif
+
+#include "GCMContext.h"
+
+namespace dtn {
+
+static const char* log = "/dtn/bundle/ciphersuite/gcm";
+
+GCMContext::backend_t GCMContext::default_backend_ = GCMContext::GCM_AUTO;
+
+//----------------------------------------------------------------------
+const char*
+GCMContext::backend_to_str(backend_t backend)
+{
+    switch (backend) {
+    case GCM_AUTO:     return "auto";
+    case GCM_SOFTWARE: return "software";
+    case GCM_OPENSSL:  return "openssl";
+    }
+    return "(unknown)";
+}
+
+//----------------------------------------------------------------------
+bool
+GCMContext::str_to_backend(const char* str, backend_t* backend)
+{
+    if (strcmp(str, "auto") == 0) {
+        *backend = GCM_AUTO;
+    } else if (strcmp(str, "software") == 0) {
+        *backend = GCM_SOFTWARE;
+    } else if (strcmp(str, "openssl") == 0) {
+        *backend = GCM_OPENSSL;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------
+void
+GCMContext::set_default_backend(backend_t backend)
+{
+    default_backend_ = backend;
+    log_info_p(log, "gcm backend %s (using %s)", backend_to_str(backend),
+               backend_to_str(resolve(backend)));
+}
+
+//----------------------------------------------------------------------
+bool
+GCMContext::hw_accelerated()
+{
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    unsigned int eax, ebx, ecx, edx;
+    if (__get_cpuid(1, &eax, &ebx, &ecx, &edx) == 0) {
+        return false;
+    }
+    return (ecx & bit_AES) && (ecx & bit_PCLMUL);
+#elif defined(__aarch64__) && defined(__linux__)
+    unsigned long hwcap = getauxval(AT_HWCAP);
+    return (hwcap & HWCAP_AES) && (hwcap & HWCAP_PMULL);
+#else
+    return false;
+#endif
+}
+
+//----------------------------------------------------------------------
+GCMContext::backend_t
+GCMContext::resolve(backend_t backend)
+{
+    if (backend == GCM_AUTO) {
+        backend = default_backend_;
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    if (backend == GCM_AUTO) {
+        static bool hw = hw_accelerated();
+        return hw ? GCM_OPENSSL : GCM_SOFTWARE;
+    }
+    return backend;
+#else
+    return GCM_SOFTWARE;
+#endif
+}
+
+//----------------------------------------------------------------------
+GCMContext::GCMContext(backend_t backend)
+    : backend_(resolve(backend)),
+      soft_(NULL)
+{
+#ifdef GCM_OPENSSL_ENABLED
+    evp_    = NULL;
+    cipher_ = NULL;
+    iv_len_ = 0;
+    op_     = -2;
+
+    if (backend_ == GCM_OPENSSL) {
+        evp_ = EVP_CIPHER_CTX_new();
+        if (evp_ == NULL) {
+            log_err_p(log, "can't allocate cipher context, "
+                      "using the software gcm code");
+            backend_ = GCM_SOFTWARE;
+        }
+    }
+#endif
+
+    if (backend_ == GCM_SOFTWARE) {
+        soft_ = new gcm_ctx;
+    }
+}
+
+//----------------------------------------------------------------------
+GCMContext::~GCMContext()
+{
+    if (soft_ != NULL) {
+        gcm_end(soft_);
+        delete soft_;
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    if (evp_ != NULL) {
+        EVP_CIPHER_CTX_free(evp_);
+    }
+    memset(key_, 0, sizeof(key_));
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::init_and_key(const u_char* key, size_t key_len)
+{
+    if (soft_ != NULL) {
+        return gcm_init_and_key(key, key_len, soft_);
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    switch (key_len) {
+    case 16: cipher_ = EVP_aes_128_gcm(); break;
+    case 24: cipher_ = EVP_aes_192_gcm(); break;
+    case 32: cipher_ = EVP_aes_256_gcm(); break;
+    default:
+        log_err_p(log, "init_and_key: invalid key length %zu", key_len);
+        return RETURN_ERROR;
+    }
+    memcpy(key_, key, key_len);
+    op_ = -2;
+    return RETURN_OK;
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::init_message(const u_char* iv, size_t iv_len)
+{
+    if (soft_ != NULL) {
+        return gcm_init_message(iv, iv_len, soft_);
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    // the cipher is set up once we know which way it runs
+    if (iv_len == 0 || iv_len > MAX_IV_LEN) {
+        log_err_p(log, "init_message: invalid iv length %zu", iv_len);
+        return RETURN_ERROR;
+    }
+    memcpy(iv_, iv, iv_len);
+    iv_len_ = iv_len;
+    op_     = -1;
+    return RETURN_OK;
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::encrypt(u_char* data, size_t len)
+{
+    if (soft_ != NULL) {
+        return gcm_encrypt(data, len, soft_);
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    if (evp_start(1) != RETURN_OK) {
+        return RETURN_ERROR;
+    }
+    return evp_update(data, len);
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::decrypt(u_char* data, size_t len)
+{
+    if (soft_ != NULL) {
+        return gcm_decrypt(data, len, soft_);
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    if (evp_start(0) != RETURN_OK) {
+        return RETURN_ERROR;
+    }
+    return evp_update(data, len);
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::compute_tag(u_char* tag, size_t tag_len)
+{
+    if (soft_ != NULL) {
+        return gcm_compute_tag(tag, tag_len, soft_);
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    u_char final[EVP_MAX_BLOCK_LENGTH];
+    int    outlen = 0;
+    if (evp_start(1) != RETURN_OK ||
+        EVP_EncryptFinal_ex(evp_, final, &outlen) != 1 ||
+        EVP_CIPHER_CTX_ctrl(evp_, EVP_CTRL_GCM_GET_TAG, tag_len, tag) != 1)
+    {
+        log_err_p(log, "compute_tag: error finishing message");
+        op_ = -2;
+        return RETURN_ERROR;
+    }
+    op_ = -2;
+    return RETURN_OK;
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::check_tag(const u_char* tag, size_t tag_len)
+{
+    if (soft_ != NULL) {
+        u_char calc[GCM_BLOCK_SIZE];
+        if (tag_len > sizeof(calc) ||
+            gcm_compute_tag(calc, tag_len, soft_) == RETURN_ERROR)
+        {
+            return RETURN_ERROR;
+        }
+        return (memcmp(calc, tag, tag_len) == 0) ? RETURN_OK : RETURN_ERROR;
+    }
+
+#ifdef GCM_OPENSSL_ENABLED
+    u_char expected[GCM_BLOCK_SIZE];
+    u_char final[EVP_MAX_BLOCK_LENGTH];
+    int    outlen = 0;
+    if (tag_len > sizeof(expected) || evp_start(0) != RETURN_OK) {
+        op_ = -2;
+        return RETURN_ERROR;
+    }
+    memcpy(expected, tag, tag_len);
+
+    int ok = EVP_CIPHER_CTX_ctrl(evp_, EVP_CTRL_GCM_SET_TAG,
+                                 tag_len, expected) == 1 &&
+             EVP_DecryptFinal_ex(evp_, final, &outlen) > 0;
+    op_ = -2;
+    return ok ? RETURN_OK : RETURN_ERROR;
+#else
+    NOTREACHED;
+#endif
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::encrypt_message(const u_char* iv, size_t iv_len,
+                            u_char* msg, size_t msg_len,
+                            u_char* tag, size_t tag_len)
+{
+    if (soft_ != NULL) {
+        return gcm_encrypt_message(iv, iv_len, NULL, 0, msg, msg_len,
+                                   tag, tag_len, soft_);
+    }
+
+    if (init_message(iv, iv_len) != RETURN_OK ||
+        encrypt(msg, msg_len) != RETURN_OK)
+    {
+        return RETURN_ERROR;
+    }
+    return compute_tag(tag, tag_len);
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::decrypt_message(const u_char* iv, size_t iv_len,
+                            u_char* msg, size_t msg_len,
+                            const u_char* tag, size_t tag_len)
+{
+    if (soft_ != NULL) {
+        return gcm_decrypt_message(iv, iv_len, NULL, 0, msg, msg_len,
+                                   tag, tag_len, soft_);
+    }
+
+    if (init_message(iv, iv_len) != RETURN_OK ||
+        decrypt(msg, msg_len) != RETURN_OK)
+    {
+        return RETURN_ERROR;
+    }
+    return check_tag(tag, tag_len);
+}
+
+#ifdef GCM_OPENSSL_ENABLED
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::evp_start(int enc)
+{
+    if (op_ == enc) {
+        return RETURN_OK;
+    }
+
+    if (op_ != -1 || cipher_ == NULL) {
+        log_err_p(log, "gcm context used out of order");
+        return RETURN_ERROR;
+    }
+
+    if (EVP_CipherInit_ex(evp_, cipher_, NULL, NULL, NULL, enc) != 1 ||
+        EVP_CIPHER_CTX_ctrl(evp_, EVP_CTRL_GCM_SET_IVLEN,
+                            iv_len_, NULL) != 1 ||
+        EVP_CipherInit_ex(evp_, NULL, NULL, key_, iv_, enc) != 1)
+    {
+        log_err_p(log, "error initializing cipher");
+        return RETURN_ERROR;
+    }
+
+    op_ = enc;
+    return RETURN_OK;
+}
+
+//----------------------------------------------------------------------
+ret_type
+GCMContext::evp_update(u_char* data, size_t len)
+{
+    // EVP lengths are ints, and GCM output is the same length as the
+    // input, so it can be done in place
+    while (len > 0) {
+        int todo   = (int)std::min(len, (size_t)(INT_MAX & ~0xf));
+        int outlen = 0;
+        if (EVP_CipherUpdate(evp_, data, &outlen, data, todo) != 1 ||
+            outlen != todo)
+        {
+            log_err_p(log, "error in EVP_CipherUpdate");
+            return RETURN_ERROR;
+        }
+        data += todo;
+        len  -= todo;
+    }
+    return RETURN_OK;
+}
+
+#endif /* GCM_OPENSSL_ENABLED */
+
+} // namespace dtn
+
+#endif /* BSP_ENABLED */
@@ -0,0 +1,141 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _GCM_CONTEXT_H_
+#define _GCM_CONTEXT_H_
+
+#ifdef BSP_ENABLED
+
+#include <sys/types.h>
+#include <openssl/evp.h>
+#include <openssl/opensslv.h>
+
+#include "gcm/gcm.h"
+
+// the EVP GCM ciphers appeared in OpenSSL 1.0.1
+#if OPENSSL_VERSION_NUMBER >= 0x10001000L && !defined(OPENSSL_NO_AES)
+#define GCM_OPENSSL_ENABLED
+#endif
+
+namespace dtn {
+
+/**
+ * AES-GCM encryption context used by the confidentiality ciphersuites,
+ * with a choice of implementation: the bundled software code in
+ * servlib/gcm, or the OpenSSL EVP GCM ciphers, which use the AES and
+ * carry-less multiply instructions where the CPU has them.
+ *
+ * The interface follows the gcm.h message calls. On decryption, the
+ * tag has to be checked with check_tag rather than computed, since
+ * OpenSSL only verifies it.
+ */
+class GCMContext {
+public:
+    typedef enum {
+        GCM_AUTO = 0,       ///< OpenSSL if the CPU accelerates GCM
+        GCM_SOFTWARE,       ///< servlib/gcm
+        GCM_OPENSSL,        ///< OpenSSL EVP
+    } backend_t;
+
+    static const char* backend_to_str(backend_t backend);
+    static bool str_to_backend(const char* str, backend_t* backend);
+
+    /**
+     * Set the backend for contexts created from now on.
+     */
+    static void set_default_backend(backend_t backend);
+    static backend_t default_backend() { return default_backend_; }
+
+    /**
+     * Whether the CPU has instructions for both AES and the GHASH
+     * multiplication.
+     */
+    static bool hw_accelerated();
+
+    /**
+     * Return the backend that will actually be used when the given
+     * one is asked for.
+     */
+    static backend_t resolve(backend_t backend);
+
+    GCMContext(backend_t backend = GCM_AUTO);
+    ~GCMContext();
+
+    /// The backend in use
+    backend_t backend() const { return backend_; }
+
+    /// @{ Keying and message calls, returning RETURN_OK or RETURN_ERROR
+    ret_type init_and_key(const u_char* key, size_t key_len);
+    ret_type init_message(const u_char* iv, size_t iv_len);
+    ret_type encrypt(u_char* data, size_t len);
+    ret_type decrypt(u_char* data, size_t len);
+    /// @}
+
+    /**
+     * Finish an encrypted message and return its tag.
+     */
+    ret_type compute_tag(u_char* tag, size_t tag_len);
+
+    /**
+     * Finish a decrypted message and check its tag.
+     *
+     * @return RETURN_OK if the tag matches
+     */
+    ret_type check_tag(const u_char* tag, size_t tag_len);
+
+    /// @{ Complete messages in memory, with no header
+    ret_type encrypt_message(const u_char* iv, size_t iv_len,
+                             u_char* msg, size_t msg_len,
+                             u_char* tag, size_t tag_len);
+    ret_type decrypt_message(const u_char* iv, size_t iv_len,
+                             u_char* msg, size_t msg_len,
+                             const u_char* tag, size_t tag_len);
+    /// @}
+
+protected:
+    static backend_t default_backend_;
+
+    backend_t backend_;
+    gcm_ctx*  soft_;        ///< software context
+
+#ifdef GCM_OPENSSL_ENABLED
+    ret_type evp_start(int enc);
+    ret_type evp_update(u_char* data, size_t len);
+
+    /// The longest IV kept for the OpenSSL backend
+    static const size_t MAX_IV_LEN = 64;
+
+    EVP_CIPHER_CTX*   evp_;
+    const EVP_CIPHER* cipher_;
+    u_char            key_[32];
+    u_char            iv_[MAX_IV_LEN];
+    size_t            iv_len_;
+    int               op_;  ///< 1 encrypting, 0 decrypting, -1 message
+                            ///< initialized, -2 none (so an IV is
+                            ///< never used twice)
+#endif
+
+private:
+    // contexts hold keys and OpenSSL state, so they aren't copied
+    GCMContext(const GCMContext&);
+    GCMContext& operator=(const GCMContext&);
+};
+
+} // namespace dtn
+
+#endif /* BSP_ENABLED */
+
+#endif /* _GCM_CONTEXT_H_ */
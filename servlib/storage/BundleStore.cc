@@ -41,7 +41,8 @@ BundleStore::BundleStore(const DTNStorageConfig& cfg)
       bundle_details_("BundleStoreExtra", "/dtn/storage/bundle_details",
                "BundleDetail", "bundles_aux"),
 #endif
-                       total_size_(0)
+                       total_size_(0),
+      commits_(0)
 {
 }
 
@@ -88,6 +89,12 @@ BundleStore::add(Bundle* bundle)
         }
 #endif
     }
+
+    // the payload file isn't synced when it's created in group commit
+    // mode, so it has to go out with the batch that stores the bundle
+    if (ret && group_commit()) {
+        sync_payload(bundle);
+    }
     return ret;
 }
 
@@ -168,5 +175,90 @@ BundleStore::close()
 }
 
 
+//----------------------------------------------------------------------
+void
+BundleStore::sync_payload(Bundle* bundle)
+{
+    if (! group_commit()) {
+        bundle->mutable_payload()->sync_payload();
+        return;
+    }
+
+    // bundles are stored from the API and shard threads as well as
+    // the daemon thread
+    oasys::ScopeLock l(&pending_lock_, "BundleStore::sync_payload");
+    pending_syncs_.push_back(BundleRef(bundle, "BundleStore::sync_payload"));
+}
+
+//----------------------------------------------------------------------
+void
+BundleStore::commit(u_int events, const oasys::Time& opened)
+{
+    oasys::Time start;
+    start.get_time();
+
+    // the payloads have to be on disk before the metadata that
+    // refers to them
+    std::vector<BundleRef> pending;
+    {
+        oasys::ScopeLock l(&pending_lock_, "BundleStore::commit");
+        pending.swap(pending_syncs_);
+    }
+    
+    size_t syncs = pending.size();
+    for (size_t i = 0; i < syncs; ++i) {
+        pending[i]->mutable_payload()->sync_payload();
+    }
+
+    oasys::DurableStore* ds = oasys::DurableStore::instance();
+    if (ds->is_transaction_open()) {
+        ds->end_transaction();
+    }
+
+    oasys::Time now;
+    now.get_time();
+
+    commits_++;
+    batch_events_.add(events);
+    batch_syncs_.add(syncs);
+    commit_usec_.add((now - start).in_microseconds());
+    wait_usec_.add((now - opened).in_microseconds());
+
+    log_debug_p("/dtn/storage/commit",
+                "committed batch of %u events and %zu payload syncs",
+                events, syncs);
+}
+
+//----------------------------------------------------------------------
+void
+BundleStore::dump_commit_stats(oasys::StringBuffer* buf)
+{
+    buf->appendf("group commit: %s (batch %u, interval %u ms), "
+                 "%llu commits\n",
+                 group_commit() ? "enabled" : "disabled",
+                 cfg_.group_commit_batch_, cfg_.group_commit_interval_,
+                 U64FMT(commits_));
+    buf->append("batch events: ");
+    batch_events_.format(buf);
+    buf->append("\nbatch payload syncs: ");
+    batch_syncs_.format(buf);
+    buf->append("\ncommit latency usec: ");
+    commit_usec_.format(buf);
+    buf->append("\nack delay usec: ");
+    wait_usec_.format(buf);
+    buf->append("\n");
+}
+
+//----------------------------------------------------------------------
+void
+BundleStore::reset_commit_stats()
+{
+    commits_ = 0;
+    batch_events_.clear();
+    batch_syncs_.clear();
+    commit_usec_.clear();
+    wait_usec_.clear();
+}
+
 } // namespace dtn
 
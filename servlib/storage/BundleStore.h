@@ -21,10 +21,15 @@
 #include <oasys/serialize/TypeShims.h>
 #include <oasys/storage/DurableStore.h>
 #include <oasys/storage/InternalKeyDurableTable.h>
+#include <oasys/thread/SpinLock.h>
 #include <oasys/util/OpenFdCache.h>
 #include <oasys/util/Singleton.h>
+#include <oasys/util/StringBuffer.h>
+#include <oasys/util/Time.h>
 #include "DTNStorageConfig.h"
 #include "bundling/BundleDetail.h"
+#include "bundling/BundleRef.h"
+#include "bundling/Log2Histogram.h"
 
 
 namespace dtn {
@@ -84,6 +89,41 @@ public:
     FdCache*           payload_fdcache() { return &payload_fdcache_; }
     u_int64_t          total_size()      { return total_size_; }
     /// @}
+
+    /// @{ Group commit support, driven by the BundleDaemon
+
+    /// Whether storage updates are being coalesced into batches
+    bool group_commit() const { return cfg_.group_commit_batch_ > 1; }
+
+    /// Maximum number of events per batch
+    u_int group_commit_batch() const { return cfg_.group_commit_batch_; }
+
+    /// Maximum time (in ms) a batch is held open
+    u_int group_commit_interval() const { return cfg_.group_commit_interval_; }
+
+    /**
+     * Sync the bundle's payload to disk, either now or (in group
+     * commit mode) as part of the next commit. In group commit mode
+     * this is done by add() for every stored bundle.
+     */
+    void sync_payload(Bundle* bundle);
+
+    /**
+     * Commit a batch: sync all the deferred payloads, then close the
+     * open durable store transaction (if any), and record the batch
+     * statistics.
+     *
+     * @param events  number of daemon events in the batch
+     * @param opened  time the first event in the batch was handled
+     */
+    void commit(u_int events, const oasys::Time& opened);
+
+    /// Format the group commit statistics
+    void dump_commit_stats(oasys::StringBuffer* buf);
+
+    /// Clear the group commit statistics
+    void reset_commit_stats();
+    /// @}
     
 protected:
     friend class BundleDaemon;
@@ -100,6 +140,14 @@ protected:
     BundleDetailTable bundle_details_;   ///< Auxiliary table for bundle unserialized details
 #endif
     u_int64_t total_size_;	///M Total size in the data store
+
+    oasys::SpinLock pending_lock_;	///< Lock for pending_syncs_
+    std::vector<BundleRef> pending_syncs_; ///< Payloads to sync at commit
+    u_int64_t commits_;			///< Number of batches committed
+    Log2Histogram batch_events_;	///< Events per batch
+    Log2Histogram batch_syncs_;		///< Payload syncs per batch
+    Log2Histogram commit_usec_;		///< Time to sync and commit
+    Log2Histogram wait_usec_;		///< Time from first event to commit
 };
 
 } // namespace dtn
@@ -35,7 +35,9 @@ public:
         : StorageConfig(cmd, type, dbname, dbdir),
           payload_dir_(""),
           payload_quota_(0),
-          payload_fd_cache_size_(32)
+          payload_fd_cache_size_(32),
+          group_commit_batch_(0),
+          group_commit_interval_(10)
     {}
 
     /// Directory to store payload files
@@ -46,6 +48,14 @@ public:
 
     /// Number of payload file descriptors to keep open in a cache.
     u_int payload_fd_cache_size_;
+
+    /// Maximum number of daemon events whose storage updates and
+    /// payload syncs are coalesced into one durable commit (0 or 1
+    /// commits after every event).
+    u_int group_commit_batch_;
+
+    /// Maximum time (in ms) a group commit batch is held open.
+    u_int group_commit_interval_;
 };
 
 } // namespace dtn
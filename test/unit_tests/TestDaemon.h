@@ -0,0 +1,84 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifndef _TEST_DAEMON_H_
+#define _TEST_DAEMON_H_
+
+#include <unistd.h>
+
+#include <oasys/debug/DebugUtils.h>
+#include <oasys/thread/MsgQueue.h>
+
+#include "bundling/Bundle.h"
+#include "bundling/BundleDaemon.h"
+#include "bundling/BundleEvent.h"
+
+namespace dtn {
+
+/**
+ * Daemon for the unit tests that collects the events posted to it
+ * instead of handling them, so the tests can check them. The tests
+ * own their bundles, so the free events are dropped.
+ */
+class TestDaemon : public BundleDaemon {
+public:
+    TestDaemon() : events_("/test/events")
+    {
+        instance_ = this;
+        do_init();
+    }
+
+    void post_event(BundleEvent* event, bool at_back = true)
+    {
+        (void)at_back;
+        if (event->type_ == BUNDLE_FREE) {
+            delete event;
+            return;
+        }
+        events_.push_back(event);
+    }
+
+    /// Wait up to a second for the next event
+    BundleEvent* next_event()
+    {
+        BundleEvent* event;
+        for (int i = 0; i < 1000; ++i) {
+            if (events_.try_pop(&event)) {
+                return event;
+            }
+            usleep(1000);
+        }
+        return NULL;
+    }
+
+    oasys::MsgQueue<BundleEvent*> events_;
+};
+
+/**
+ * Free a bundle once the test and its events are done with it. The
+ * free event posted when the references drop to one is dropped by the
+ * TestDaemon, so it is deleted directly.
+ */
+inline void
+free_bundle(Bundle* b)
+{
+    ASSERT(b->num_mappings() == 0);
+    delete b;
+}
+
+} // namespace dtn
+
+#endif /* _TEST_DAEMON_H_ */
@@ -18,12 +18,16 @@
 #  include <dtn-config.h>
 #endif
 
+#include <stdlib.h>
+#include <vector>
+
 #include <oasys/util/UnitTest.h>
 #include <oasys/util/Time.h>
 #include <oasys/util/Random.h>
 
 #include "bundling/Bundle.h"
 #include "bundling/BundleList.h"
+#include "bundling/GbofId.h"
 
 using namespace oasys;
 using namespace dtn;
@@ -31,6 +35,12 @@ using namespace dtn;
 #define COUNT 10
 #define MANY  10000
 
+// largest list size used by the lookup scaling benchmark, which can
+// be raised (e.g. to 1000000) with BUNDLE_LIST_BENCH_MAX in the
+// environment for a full sweep
+#define BENCH_MAX     10000
+#define BENCH_LOOKUPS 100000
+
 Bundle* bundles[MANY];
 BundleList::iterator iter;
 BundleMappings::iterator map_iter;
@@ -300,6 +310,174 @@ DECLARE_TEST(MoveContents) {
     return UNIT_TEST_PASSED;
 }
 
+DECLARE_TEST(DuplicateIndex) {
+    BundleList l("dup_list");
+    l.enable_index(BundleList::INDEX_DUPLICATE);
+    CHECK(l.index_enabled(BundleList::INDEX_DUPLICATE));
+
+    // two bundles with the same source, timestamp and payload length
+    // (so they're duplicates), the rest unique
+    Bundle* dups[COUNT];
+    for (int i = 0; i < COUNT; ++i) {
+        dups[i] = new Bundle(oasys::Builder::builder());
+        dups[i]->test_set_bundleid(MANY + i);
+        dups[i]->mutable_source()->assign("dtn://source.dtn/test");
+        dups[i]->set_creation_ts(BundleTimestamp(1000, (i == 1) ? 0 : i));
+        dups[i]->mutable_payload()->init(MANY + i, BundlePayload::NODATA);
+        dups[i]->mutable_payload()->set_length(10);
+        dups[i]->add_ref("test");
+    }
+
+    for (int i = 1; i < COUNT; ++i) {
+        l.push_back(dups[i]);
+    }
+
+    l.lock()->lock("test lock");
+    CHECK(l.find_duplicate(dups[0], false) == dups[1]);
+    CHECK(l.find_duplicate(dups[2], false) == dups[2]);
+    l.lock()->unlock();
+
+    // custody preference
+    dups[0]->set_local_custody(true);
+    l.push_back(dups[0]);
+    l.lock()->lock("test lock");
+    CHECK(l.find_duplicate(dups[1], false) == dups[1]);
+    CHECK(l.find_duplicate(dups[1], true)  == dups[0]);
+    l.lock()->unlock();
+
+    // the index follows erasure
+    CHECK(l.erase(dups[0]));
+    CHECK(l.erase(dups[1]));
+    l.lock()->lock("test lock");
+    CHECK(l.find_duplicate(dups[0], true) == NULL);
+    CHECK(l.find_duplicate(dups[3], true) == dups[3]);
+    l.lock()->unlock();
+
+    // an index enabled on a non-empty list is built from the contents
+    BundleList l2("dup_list2");
+    for (int i = 2; i < COUNT; ++i) {
+        l2.push_back(dups[i]);
+    }
+    l2.enable_index(BundleList::INDEX_DUPLICATE);
+    l2.lock()->lock("test lock");
+    for (int i = 2; i < COUNT; ++i) {
+        CHECK(l2.find_duplicate(dups[i], false) == dups[i]);
+    }
+    l2.lock()->unlock();
+
+    l.clear();
+    l2.clear();
+    for (int i = 0; i < COUNT; ++i) {
+        CHECK_EQUAL(dups[i]->num_mappings(), 0);
+        delete dups[i];
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(IndexedFind) {
+    BundleList l("indexed_list");
+    l.enable_index(BundleList::INDEX_BUNDLEID | BundleList::INDEX_GBOFID);
+
+    for (int i = 0; i < COUNT; ++i) {
+        bundles[i]->mutable_source()->assign("dtn://source.dtn/test");
+        bundles[i]->set_creation_ts(BundleTimestamp(2000, i));
+        l.push_back(bundles[i]);
+    }
+
+    for (int i = 0; i < COUNT; ++i) {
+        CHECK(l.find(i) == bundles[i]);
+
+        GbofId gbof_id(bundles[i]->source(), bundles[i]->creation_ts(),
+                       false, 0, 0);
+        CHECK(l.find(gbof_id) == bundles[i]);
+        CHECK(l.find(gbof_id, bundles[i]->extended_id()) == bundles[i]);
+    }
+
+    GbofId missing(EndpointID("dtn://source.dtn/test"),
+                   BundleTimestamp(2000, COUNT), false, 0, 0);
+    CHECK(l.find(missing) == NULL);
+    CHECK(l.find(COUNT) == NULL);
+
+    // a fragment is only found by its own offset / length
+    GbofId frag(bundles[0]->source(), bundles[0]->creation_ts(),
+                true, bundles[0]->payload().length(), 0);
+    CHECK(l.find(frag) == NULL);
+
+    CHECK(l.erase(bundles[3]));
+    CHECK(l.find(3) == NULL);
+    GbofId erased(bundles[3]->source(), bundles[3]->creation_ts(),
+                  false, 0, 0);
+    CHECK(l.find(erased) == NULL);
+
+    l.clear();
+    CHECK(l.find(0) == NULL);
+    
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(IndexedLookupScaling) {
+    int bench_max = BENCH_MAX;
+    const char* env = getenv("BUNDLE_LIST_BENCH_MAX");
+    if (env != NULL && atoi(env) > 0) {
+        bench_max = atoi(env);
+    }
+
+    // the bundles for the benchmark are allocated once and reused
+    // for each list size
+    std::vector<Bundle*> bench(bench_max);
+    for (int i = 0; i < bench_max; ++i) {
+        bench[i] = new Bundle(oasys::Builder::builder());
+        bench[i]->test_set_bundleid(MANY + COUNT + i);
+        bench[i]->mutable_source()->assign("dtn://bench.dtn/test");
+        bench[i]->set_creation_ts(BundleTimestamp(3000, i));
+        bench[i]->mutable_payload()->init(MANY + COUNT + i,
+                                          BundlePayload::NODATA);
+        bench[i]->add_ref("test");
+    }
+
+    oasys::Time t;
+    for (int n = 1000; n <= bench_max; n *= 10) {
+        BundleList l("bench_list");
+        l.enable_index(BundleList::INDEX_BUNDLEID | BundleList::INDEX_GBOFID);
+        for (int i = 0; i < n; ++i) {
+            l.push_back(bench[i]);
+        }
+
+        bool ok = true;
+        t.get_time();
+        for (int i = 0; i < BENCH_LOOKUPS; ++i) {
+            int j = random() % n;
+            ok = ok && (l.find(MANY + COUNT + j) == bench[j]);
+        }
+        u_int32_t id_ms = t.elapsed_ms();
+        CHECK(ok);
+
+        t.get_time();
+        for (int i = 0; i < BENCH_LOOKUPS; ++i) {
+            int j = random() % n;
+            GbofId gbof_id(bench[j]->source(), bench[j]->creation_ts(),
+                           false, 0, 0);
+            ok = ok && (l.find(gbof_id) == bench[j]);
+        }
+        u_int32_t gbof_ms = t.elapsed_ms();
+        CHECK(ok);
+        
+        log_always_p("/test", "%d bundles: %u lookups by id in %u ms, "
+                     "by gbof id in %u ms",
+                     n, BENCH_LOOKUPS, id_ms, gbof_ms);
+
+        l.clear();
+    }
+
+    for (int i = 0; i < bench_max; ++i) {
+        CHECK_EQUAL(bench[i]->num_mappings(), 0);
+        delete bench[i];
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TEST(ManyBundles) {
     for (int i = 0; i < MANY; ++i) {
         l1->push_back(bundles[i]);
@@ -348,6 +526,9 @@ DECLARE_TESTER(BundleListTest) {
     ADD_TEST(MultipleLists);
     ADD_TEST(MultipleListRemoval);
     ADD_TEST(MoveContents);
+    ADD_TEST(DuplicateIndex);
+    ADD_TEST(IndexedFind);
+    ADD_TEST(IndexedLookupScaling);
     ADD_TEST(ManyBundles);
 }
 
@@ -18,6 +18,7 @@
 #  include <dtn-config.h>
 #endif
 
+#include <oasys/io/FileUtils.h>
 #include <oasys/util/UnitTest.h>
 
 #include "bundling/Bundle.h"
@@ -99,9 +100,72 @@ DECLARE_TEST(DiskPayloadTest) {
     return payload_test(BundlePayload::DISK);
 }
 
+DECLARE_TEST(SharedPayloadTest) {
+    u_char buf[64];
+    const u_char* data;
+    SpinLock l1, l2, l3, l4;
+    BundlePayload* p = new BundlePayload(&l1);
+    BundlePayload s1(&l2), s2(&l3), s3(&l4);
+
+    p->init(10, BundlePayload::DISK);
+    p->set_data((const u_char*)"abcdefghijklmnopqrstuvwxyz", 26);
+
+    log_debug_p("/test", "checking share_data");
+    s1.init(11, BundlePayload::DISK);
+    s1.share_data(*p, 5, 10);
+    CHECK(s1.shared());
+    CHECK(p->shared());
+    CHECK_EQUAL(s1.length(), 10);
+    CHECK_EQUAL(s1.base_offset(), 5);
+    data = s1.read_data(0, 10, buf);
+    CHECK_EQUALSTRN((char*)data, "fghijklmno", 10);
+
+    // a slice of a slice refers to the same file
+    s2.init(12, BundlePayload::DISK);
+    s2.share_data(s1, 2, 3);
+    CHECK_EQUAL(s2.base_offset(), 7);
+    data = s2.read_data(0, 3, buf);
+    CHECK_EQUALSTRN((char*)data, "hij", 3);
+
+    log_debug_p("/test", "checking copy on write");
+    s2.write_data((const u_char*)"X", 1, 1);
+    CHECK(! s2.shared());
+    data = s2.read_data(0, 3, buf);
+    CHECK_EQUALSTRN((char*)data, "hXj", 3);
+    data = s1.read_data(0, 10, buf);
+    CHECK_EQUALSTRN((char*)data, "fghijklmno", 10);
+
+    // truncating the shared parent leaves the slices alone
+    p->truncate(20);
+    data = s1.read_data(0, 10, buf);
+    CHECK_EQUALSTRN((char*)data, "fghijklmno", 10);
+
+    log_debug_p("/test", "checking removal of the parent");
+    delete p;
+    data = s1.read_data(0, 10, buf);
+    CHECK_EQUALSTRN((char*)data, "fghijklmno", 10);
+
+    CHECK(s1.unshare());
+    CHECK(! s1.shared());
+    CHECK_EQUAL(s1.base_offset(), 0);
+    CHECK_EQUAL(oasys::FileUtils::size(s1.filename().c_str()), 10);
+    data = s1.read_data(0, 10, buf);
+    CHECK_EQUALSTRN((char*)data, "fghijklmno", 10);
+
+    log_debug_p("/test", "checking memory payloads are copied");
+    s3.init(13, BundlePayload::MEMORY);
+    s3.share_data(s1, 3, 4);
+    CHECK(! s3.shared());
+    data = s3.read_data(0, 4, buf);
+    CHECK_EQUALSTRN((char*)data, "ijkl", 4);
+
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TESTER(BundlePayloadTester) {
     ADD_TEST(MemoryPayloadTest);
     ADD_TEST(DiskPayloadTest);
+    ADD_TEST(SharedPayloadTest);
 }
 
 int
@@ -23,6 +23,8 @@
 #include "bundling/Bundle.h"
 #include "bundling/BundleProtocol.h"
 #include "bundling/UnknownBlockProcessor.h"
+#include "contacts/Link.h"
+#include "conv_layers/NullConvergenceLayer.h"
 #include "storage/BundleStore.h"
 #include "storage/DTNStorageConfig.h"
 
@@ -538,6 +540,87 @@ Bundle* init_SequenceAndObsoletesID()
 
 DECLARE_BP_TESTS(SequenceAndObsoletesID);
 
+/**
+ * Generate the blocks for the bundle on the given link and produce
+ * the whole encoded bundle into the buffer.
+ */
+void
+encode_for_link(Bundle* b, const LinkRef& link, std::string* buf)
+{
+    BlockInfoVec* blocks = BundleProtocol::prepare_blocks(b, link);
+    size_t len = BundleProtocol::generate_blocks(b, blocks, link);
+    buf->resize(len);
+
+    bool complete = false;
+    size_t cc = BundleProtocol::produce(b, blocks, (u_char*)&(*buf)[0],
+                                        0, len, &complete);
+    ASSERT(cc == len);
+    ASSERT(complete);
+}
+
+/**
+ * Encode the bundle for two links with the wire image cache off and
+ * then on, in which case the second link's blocks are copied from the
+ * image captured for the first. Both ways must produce the same bytes.
+ */
+NullConvergenceLayer* cl = NULL;
+LinkRef link1;
+LinkRef link2;
+
+int
+wire_image_test(Bundle* b)
+{
+    if (cl == NULL) {
+        cl = new NullConvergenceLayer();
+        link1 = Link::create_link("link1", Link::OPPORTUNISTIC, cl,
+                                  "link1-dest", 0, NULL);
+        link2 = Link::create_link("link2", Link::OPPORTUNISTIC, cl,
+                                  "link2-dest", 0, NULL);
+    }
+    
+    std::string uncached1, uncached2, cached1, cached2;
+
+    BundleProtocol::params_.wire_image_cache_ = false;
+    encode_for_link(b, link1, &uncached1);
+    encode_for_link(b, link2, &uncached2);
+    CHECK(b->xmit_blocks()->find_image() == NULL);
+    BundleProtocol::delete_blocks(b, link1);
+    BundleProtocol::delete_blocks(b, link2);
+
+    BundleProtocol::params_.wire_image_cache_ = true;
+    encode_for_link(b, link1, &cached1);
+    CHECK(b->xmit_blocks()->find_image() != NULL);
+    encode_for_link(b, link2, &cached2);
+    BundleProtocol::delete_blocks(b, link1);
+    BundleProtocol::delete_blocks(b, link2);
+
+    CHECK(uncached1.length() > 0);
+    CHECK_EQUAL(cached1.length(), uncached1.length());
+    CHECK_EQUAL(cached2.length(), uncached2.length());
+    CHECK(cached1 == uncached1);
+    CHECK(cached2 == uncached2);
+
+    delete b;
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(WireImageBasic) {
+    return wire_image_test(init_Basic());
+}
+
+DECLARE_TEST(WireImageUnknownBlocks) {
+    return wire_image_test(init_UnknownBlocks());
+}
+
+DECLARE_TEST(WireImageBigDictionary) {
+    return wire_image_test(init_BigDictionary());
+}
+
+DECLARE_TEST(WireImageSequenceID) {
+    return wire_image_test(init_SequenceAndObsoletesID());
+}
+
 DECLARE_TESTER(BundleProtocolTest) {
     ADD_TEST(Init);
     ADD_BP_TESTS(Basic);
@@ -549,6 +632,10 @@ DECLARE_TESTER(BundleProtocolTest) {
     ADD_BP_TESTS(SequenceID);
     ADD_BP_TESTS(ObsoletesID);
     ADD_BP_TESTS(SequenceAndObsoletesID);
+    ADD_TEST(WireImageBasic);
+    ADD_TEST(WireImageUnknownBlocks);
+    ADD_TEST(WireImageBigDictionary);
+    ADD_TEST(WireImageSequenceID);
 
     // XXX/demmer add tests for malformed / mangled headers, too long
     // sdnv's, etc
@@ -0,0 +1,239 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <stdlib.h>
+#include <vector>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "bundling/BundleTimerWheel.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define RANDOM_TIMERS   10000
+#define RANDOM_RANGE    (1 << 26)
+#define BENCH_TIMERS    1000000
+
+// the wheels start at this second so tests can use absolute offsets
+#define START_SEC       1000
+
+oasys::Time
+at(u_int64_t ms)
+{
+    return oasys::Time(START_SEC + ms / 1000, (ms % 1000) * 1000);
+}
+
+class TestTimer : public BundleTimer {
+public:
+    TestTimer() : due_(0), fired_(0) {}
+
+    void timeout(const oasys::Time& now)
+    {
+        fired_at_ = now;
+        fired_++;
+    }
+
+    u_int64_t   due_;
+    int         fired_;
+    oasys::Time fired_at_;
+};
+
+DECLARE_TEST(Basic) {
+    BundleTimerWheel wheel(10, at(0));
+    TestTimer t1, t2;
+
+    CHECK_EQUAL(wheel.run(at(0)), -1);
+
+    // 25ms rounds up to the tick at 30ms
+    wheel.schedule_at(&t1, at(25));
+    wheel.schedule_at(&t2, at(100));
+    CHECK(t1.pending());
+    CHECK_EQUAL(wheel.size(), 2);
+
+    CHECK_EQUAL(wheel.run(at(5)), 25);
+    CHECK_EQUAL(wheel.run(at(29)), 1);
+    CHECK_EQUAL(t1.fired_, 0);
+
+    CHECK_EQUAL(wheel.run(at(30)), 70);
+    CHECK_EQUAL(t1.fired_, 1);
+    CHECK(!t1.pending());
+    CHECK_EQUAL(wheel.size(), 1);
+
+    CHECK_EQUAL(wheel.run(at(500)), -1);
+    CHECK_EQUAL(t2.fired_, 1);
+    CHECK(t2.fired_at_ == at(500));
+
+    // times in the past fire on the next run
+    wheel.schedule_at(&t1, at(0));
+    CHECK_EQUAL(wheel.run(at(510)), -1);
+    CHECK_EQUAL(t1.fired_, 2);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Cancel) {
+    BundleTimerWheel wheel(10, at(0));
+    TestTimer t1, t2;
+
+    wheel.schedule_at(&t1, at(50));
+    wheel.schedule_at(&t2, at(50));
+    CHECK(wheel.cancel(&t1));
+    CHECK(!t1.pending());
+    CHECK(!wheel.cancel(&t1));
+    CHECK_EQUAL(wheel.size(), 1);
+
+    wheel.run(at(100));
+    CHECK_EQUAL(t1.fired_, 0);
+    CHECK_EQUAL(t2.fired_, 1);
+
+    // a fired timer can't be cancelled
+    CHECK(!wheel.cancel(&t2));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Random) {
+    BundleTimerWheel wheel(1, at(0));
+    std::vector<TestTimer> timers(RANDOM_TIMERS);
+
+    srandom(7);
+    for (size_t i = 0; i < timers.size(); ++i) {
+        timers[i].due_ = random() % RANDOM_RANGE;
+        wheel.schedule_at(&timers[i], at(timers[i].due_));
+    }
+
+    // cancel every third timer
+    size_t cancelled = 0;
+    for (size_t i = 0; i < timers.size(); i += 3) {
+        CHECK(wheel.cancel(&timers[i]));
+        ++cancelled;
+    }
+    CHECK_EQUAL(wheel.size(), timers.size() - cancelled);
+
+    // advance in random steps, checking that each timer fires in the
+    // first run at or after its due time
+    u_int64_t last = 0, now = 0;
+    while (now < RANDOM_RANGE) {
+        now += 1 + random() % 100000;
+        wheel.run(at(now));
+
+        for (size_t i = 0; i < timers.size(); ++i) {
+            TestTimer* t = &timers[i];
+            if (i % 3 == 0) {
+                CHECK_EQUAL(t->fired_, 0);
+            } else if (t->due_ <= last) {
+                CHECK_EQUAL(t->fired_, 1);
+            } else if (t->due_ <= now) {
+                CHECK_EQUAL(t->fired_, 1);
+                CHECK(t->fired_at_ == at(now));
+            } else {
+                CHECK_EQUAL(t->fired_, 0);
+            }
+        }
+        last = now;
+    }
+    CHECK_EQUAL(wheel.size(), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(WakeupTime) {
+    BundleTimerWheel wheel(1, at(0));
+    TestTimer t;
+
+    // the wheel asks to be run in time for the timer or for the
+    // cascade that moves it down to level 0
+    wheel.schedule_at(&t, at(100000));
+    u_int64_t now = 0;
+    int runs = 0;
+    while (true) {
+        CHECK(now <= 100000);
+        int timeout = wheel.run(at(now));
+        ++runs;
+        if (t.fired_ != 0) {
+            CHECK_EQUAL(timeout, -1);
+            break;
+        }
+        CHECK(timeout > 0);
+        now += timeout;
+    }
+    CHECK(t.fired_at_ == at(100000));
+    log_always_p("/test", "fired after %d runs", runs);
+    CHECK(runs < 10);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(OutOfRange) {
+    BundleTimerWheel wheel(1, at(0));
+    TestTimer t;
+
+    // beyond the range of the top level
+    u_int64_t due = (1ULL << 32) + 12345;
+    wheel.schedule_at(&t, at(due));
+
+    wheel.run(at(due / 2));
+    wheel.run(at(due - 1));
+    CHECK_EQUAL(t.fired_, 0);
+    CHECK(t.pending());
+
+    wheel.run(at(due));
+    CHECK_EQUAL(t.fired_, 1);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Benchmark) {
+    BundleTimerWheel wheel(100, at(0));
+    std::vector<TestTimer> timers(BENCH_TIMERS);
+
+    srandom(11);
+    oasys::Time t0;
+    t0.get_time();
+    for (size_t i = 0; i < timers.size(); ++i) {
+        wheel.schedule_at(&timers[i], at(random() % (86400 * 1000)));
+    }
+    u_int32_t schedule_ms = t0.elapsed_ms();
+
+    t0.get_time();
+    for (size_t i = 0; i < timers.size(); ++i) {
+        CHECK(wheel.cancel(&timers[i]));
+    }
+    u_int32_t cancel_ms = t0.elapsed_ms();
+
+    log_always_p("/test", "%u timers: schedule %u ms, cancel %u ms",
+                 BENCH_TIMERS, schedule_ms, cancel_ms);
+    CHECK_EQUAL(wheel.size(), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(BundleTimerWheelTest) {
+    ADD_TEST(Basic);
+    ADD_TEST(Cancel);
+    ADD_TEST(Random);
+    ADD_TEST(WakeupTime);
+    ADD_TEST(OutOfRange);
+    ADD_TEST(Benchmark);
+}
+
+DECLARE_TEST_FILE(BundleTimerWheelTest, "bundle timer wheel test");
@@ -0,0 +1,273 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <vector>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "conv_layers/CLConnection.h"
+#include "conv_layers/CLReactor.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define THREAD_CONNECTIONS      100
+#define REACTOR_CONNECTIONS     5000
+#define REACTOR_THREADS         4
+#define ROUNDS                  20
+
+/**
+ * Parameters for the benchmark connections, which only need the
+ * defaults.
+ */
+class BenchParams : public ConnectionConvergenceLayer::LinkParams {
+public:
+    BenchParams() : LinkParams(true) {}
+};
+
+BenchParams     params;
+oasys::atomic_t completed(0);
+
+/**
+ * One end of a loopback tcp connection. The active end sends a byte
+ * and waits for the passive end to echo it, for a number of rounds.
+ */
+class BenchConnection : public CLConnection {
+public:
+    BenchConnection(int fd, bool active)
+        : CLConnection("BenchConnection", "/test/bench", NULL,
+                       &params, active),
+          fd_(fd), rounds_(0) {}
+
+    /// Ask the connection to shut down, as close_contact would
+    void shutdown() { cmdqueue_.push_back(CLMsg(CLMSG_BREAK_CONTACT)); }
+
+protected:
+    void initialize_pollfds()
+    {
+        pollfds_[0].fd     = fd_;
+        pollfds_[0].events = POLLIN;
+        num_pollfds_       = 1;
+        poll_timeout_      = 1000;
+    }
+
+    void connect() { send_byte(); }
+    void accept()  {}
+
+    void disconnect()
+    {
+        if (fd_ >= 0) {
+            close(fd_);
+            fd_ = -1;
+        }
+    }
+
+    void break_contact(ContactEvent::reason_t reason)
+    {
+        (void)reason;
+        contact_broken_ = true;
+        disconnect();
+    }
+
+    void handle_bundles_queued()        { NOTREACHED; }
+    void handle_cancel_bundle(Bundle*)  { NOTREACHED; }
+    bool send_pending_data()            { return false; }
+    void handle_poll_timeout()          {}
+
+    void handle_poll_activity()
+    {
+        char c;
+        if (read(fd_, &c, 1) != 1) {
+            break_contact(ContactEvent::BROKEN);
+            return;
+        }
+
+        if (! active_connector_) {
+            send_byte();
+        } else if (++rounds_ < ROUNDS) {
+            send_byte();
+        } else {
+            atomic_incr(&completed);
+        }
+    }
+
+    void send_byte()
+    {
+        char c = 'p';
+        if (write(fd_, &c, 1) != 1) {
+            break_contact(ContactEvent::BROKEN);
+        }
+    }
+
+    int fd_;
+    int rounds_;
+};
+
+/**
+ * Make sure there are enough file descriptors for the given number of
+ * loopback connections: two sockets plus two command queue pipes for
+ * each end. Returns the number of connections that fit.
+ */
+int
+raise_fd_limit(int count)
+{
+    struct rlimit rl;
+    if (getrlimit(RLIMIT_NOFILE, &rl) != 0) {
+        return count;
+    }
+
+    rl.rlim_cur = rl.rlim_max;
+    setrlimit(RLIMIT_NOFILE, &rl);
+    getrlimit(RLIMIT_NOFILE, &rl);
+
+    int fit = (rl.rlim_cur - 100) / 6;
+    if (fit < count) {
+        log_warn_p("/test", "only room for %d connections (limit %u)",
+                   fit, (u_int)rl.rlim_cur);
+        return fit;
+    }
+    return count;
+}
+
+/**
+ * Open the given number of loopback connections, run the ping rounds
+ * on all of them at once and return the elapsed time, or -1 on error.
+ */
+int
+run_bench(int count)
+{
+    int listen_fd = socket(AF_INET, SOCK_STREAM, 0);
+    struct sockaddr_in sa;
+    memset(&sa, 0, sizeof(sa));
+    sa.sin_family      = AF_INET;
+    sa.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    sa.sin_port        = 0;
+    socklen_t sl = sizeof(sa);
+    if (bind(listen_fd, (struct sockaddr*)&sa, sizeof(sa)) != 0 ||
+        listen(listen_fd, 1024) != 0 ||
+        getsockname(listen_fd, (struct sockaddr*)&sa, &sl) != 0)
+    {
+        log_err_p("/test", "error setting up listener: %s", strerror(errno));
+        return -1;
+    }
+
+    std::vector<BenchConnection*> conns;
+    for (int i = 0; i < count; ++i) {
+        int one = 1;
+        int fd = socket(AF_INET, SOCK_STREAM, 0);
+        if (fd < 0 || ::connect(fd, (struct sockaddr*)&sa, sizeof(sa)) != 0) {
+            log_err_p("/test", "error in connect: %s", strerror(errno));
+            return -1;
+        }
+        int peer = ::accept(listen_fd, NULL, NULL);
+        if (peer < 0) {
+            log_err_p("/test", "error in accept: %s", strerror(errno));
+            return -1;
+        }
+        setsockopt(fd,   IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+        setsockopt(peer, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+
+        conns.push_back(new BenchConnection(peer, false));
+        conns.push_back(new BenchConnection(fd, true));
+    }
+    close(listen_fd);
+
+    completed.value = 0;
+    oasys::Time t0;
+    t0.get_time();
+
+    for (size_t i = 0; i < conns.size(); ++i) {
+        conns[i]->start_service();
+    }
+
+    while ((int)completed.value < count && t0.elapsed_ms() < 120000) {
+        usleep(1000);
+    }
+    int elapsed = t0.elapsed_ms();
+
+    bool ok = ((int)completed.value == count);
+    if (! ok) {
+        log_err_p("/test", "only %u of %d connections completed",
+                  completed.value, count);
+    }
+
+    for (size_t i = 0; i < conns.size(); ++i) {
+        conns[i]->shutdown();
+    }
+    for (size_t i = 0; i < conns.size(); ++i) {
+        while (! conns[i]->service_stopped()) {
+            usleep(1000);
+        }
+        delete conns[i];
+    }
+
+    return ok ? elapsed : -1;
+}
+
+DECLARE_TEST(Threads) {
+    CLReactor::threads_ = 0;
+
+    int count = raise_fd_limit(THREAD_CONNECTIONS);
+    int elapsed = run_bench(count);
+    CHECK(elapsed >= 0);
+    log_always_p("/test", "thread per connection: %d connections, "
+                 "%d rounds in %d ms", count, ROUNDS, elapsed);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Reactor) {
+    CLReactor::threads_ = REACTOR_THREADS;
+    if (! CLReactor::enabled()) {
+        log_always_p("/test", "reactor not supported, skipping");
+        return UNIT_TEST_PASSED;
+    }
+
+    int count = raise_fd_limit(REACTOR_CONNECTIONS);
+    int elapsed = run_bench(count);
+    CHECK(elapsed >= 0);
+    log_always_p("/test", "%d reactor threads: %d connections, "
+                 "%d rounds in %d ms", REACTOR_THREADS, count, ROUNDS,
+                 elapsed);
+
+    // the number of threads is fixed once the workers are running
+    CLReactor::threads_ = REACTOR_THREADS + 1;
+    CHECK(CLReactor::enabled());
+    CHECK_EQUAL(CLReactor::threads_, REACTOR_THREADS);
+
+    CLReactor::shutdown();
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(CLReactorTest) {
+    ADD_TEST(Threads);
+    ADD_TEST(Reactor);
+}
+
+DECLARE_TEST_FILE(CLReactorTest, "cl reactor test");
@@ -0,0 +1,251 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "conv_layers/ECLFraming.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define NUM_MESSAGES    100000
+#define BATCH           64
+
+int socks[2];
+
+/**
+ * Encode the records of a typical bundle_transmitted_event.
+ */
+void
+encode_transmitted(RouterTLV::Encoder* enc, int id)
+{
+    char buf[32];
+    int len = snprintf(buf, sizeof(buf), "%d", id);
+
+    enc->begin_element("cl_message");
+    enc->begin_element("bundle_transmitted_event");
+    enc->attribute("link_name", "link-tcp0", 9);
+    enc->attribute("bytes_sent", "1048576", 7);
+    enc->attribute("reliably_sent", "1048576", 7);
+    enc->begin_element("bundle_attributes");
+    enc->attribute("source_eid", "dtn://src.dtn/app", 17);
+    enc->attribute("timestamp_seconds", "531248100", 9);
+    enc->attribute("timestamp_sequence", buf, len);
+    enc->attribute("is_fragment", "false", 5);
+    enc->end_element();
+    enc->end_element();
+    enc->end_element();
+}
+
+DECLARE_TEST(Init) {
+    CHECK(socketpair(AF_UNIX, SOCK_STREAM, 0, socks) == 0);
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Dictionary) {
+    const RouterTLV::Dictionary& dict = ECLFraming::clevent_names();
+    CHECK(dict.code("cl_message") != 0);
+    CHECK(dict.code("bundle_send_request") != 0);
+    CHECK(dict.code("location") != 0);
+    CHECK_EQUAL(dict.code("bpa"), 0);
+    CHECK_EQUALSTR(dict.name(dict.code("bytes_received")), "bytes_received");
+
+    // the same name generally has a different code in each dictionary
+    std::string buf;
+    RouterTLV::Encoder enc(&buf, &dict);
+    enc.begin_payload();
+    encode_transmitted(&enc, 1);
+
+    RouterTLV::Decoder dec((u_char*)buf.data(), buf.size(), &dict);
+    std::string name;
+    RouterTLV::record_t type;
+    CHECK(dec.begin_payload());
+    CHECK(dec.get_record(&type));
+    CHECK(dec.get_name(&name));
+    CHECK_EQUALSTR(name, "cl_message");
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Frames) {
+    std::string p1("first"), p2(1000, 'x'), p3;
+    CHECK(ECLFraming::send_frame(socks[0], p1) == 0);
+    CHECK(ECLFraming::send_frame(socks[0], p2) == 0);
+    CHECK(ECLFraming::send_frame(socks[0], p3) == 0);
+
+    ECLFraming::Reader reader;
+    std::string payload;
+    size_t total = 3 * 4 + p1.size() + p2.size();
+    size_t got = 0;
+    while (got < total) {
+        int cc = reader.read(socks[1]);
+        CHECK(cc > 0);
+        got += cc;
+    }
+
+    CHECK_EQUAL(reader.next_frame(&payload), 1);
+    CHECK_EQUALSTR(payload, p1);
+    CHECK_EQUAL(reader.next_frame(&payload), 1);
+    CHECK(payload == p2);
+    CHECK_EQUAL(reader.next_frame(&payload), 1);
+    CHECK(payload.empty());
+    CHECK_EQUAL(reader.next_frame(&payload), 0);
+    CHECK_EQUAL(reader.next_fd(), -1);
+
+    // a partial frame stays buffered
+    u_char partial[] = { 0, 0, 0, 10, 'a', 'b' };
+    CHECK(write(socks[0], partial, sizeof(partial)) == sizeof(partial));
+    CHECK_EQUAL(reader.read(socks[1]), (int)sizeof(partial));
+    CHECK_EQUAL(reader.next_frame(&payload), 0);
+
+    // and an oversized one is an error
+    ECLFraming::Reader reader2;
+    u_char big[] = { 0x7f, 0, 0, 0 };
+    CHECK(write(socks[0], big, sizeof(big)) == sizeof(big));
+    CHECK_EQUAL(reader2.read(socks[1]), (int)sizeof(big));
+    CHECK_EQUAL(reader2.next_frame(&payload), -1);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(PassFds) {
+    const char* data = "bundle bytes";
+    size_t len = strlen(data);
+
+    int fds[2];
+    for (int i = 0; i < 2; ++i) {
+        fds[i] = ECLFraming::create_payload_fd("/tmp", len);
+        CHECK(fds[i] >= 0);
+        void* p = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_SHARED,
+                       fds[i], 0);
+        CHECK(p != MAP_FAILED);
+        memcpy(p, data, len);
+        ((char*)p)[0] = '0' + i;
+        munmap(p, len);
+    }
+
+    std::string payload("two bundles");
+    CHECK(ECLFraming::send_frame(socks[0], payload, fds, 2) == 0);
+    close(fds[0]);
+    close(fds[1]);
+
+    ECLFraming::Reader reader;
+    CHECK(reader.read(socks[1]) > 0);
+    std::string got;
+    CHECK_EQUAL(reader.next_frame(&got), 1);
+    CHECK_EQUALSTR(got, payload);
+
+    for (int i = 0; i < 2; ++i) {
+        int fd = reader.next_fd();
+        CHECK(fd >= 0);
+
+        struct stat st;
+        CHECK(fstat(fd, &st) == 0);
+        CHECK_EQUAL((size_t)st.st_size, len);
+
+        char buf[64];
+        CHECK_EQUAL(pread(fd, buf, len, 0), (ssize_t)len);
+        CHECK_EQUAL(buf[0], '0' + i);
+        CHECK(memcmp(buf + 1, data + 1, len - 1) == 0);
+        close(fd);
+    }
+    CHECK_EQUAL(reader.next_fd(), -1);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Throughput) {
+    // batches of encoded events through the socket and back, as the
+    // daemon and a CLA would exchange them
+    const RouterTLV::Dictionary& dict = ECLFraming::clevent_names();
+    ECLFraming::Reader reader;
+    std::string payload;
+    int sent = 0, received = 0;
+    size_t frame_bytes = 0;
+
+    oasys::Time t0;
+    t0.get_time();
+
+    while (received < NUM_MESSAGES) {
+        std::string buf;
+        RouterTLV::Encoder enc(&buf, &dict);
+        enc.begin_payload();
+        for (int i = 0; i < BATCH && sent < NUM_MESSAGES; ++i) {
+            encode_transmitted(&enc, sent++);
+        }
+        frame_bytes = buf.size();
+        CHECK(ECLFraming::send_frame(socks[0], buf) == 0);
+
+        while (reader.next_frame(&payload) != 1) {
+            CHECK(reader.read(socks[1]) > 0);
+        }
+
+        RouterTLV::Decoder dec((u_char*)payload.data(), payload.size(),
+                               &dict);
+        CHECK(dec.begin_payload());
+        while (! dec.done()) {
+            RouterTLV::record_t type;
+            std::string name, value;
+            CHECK(dec.get_record(&type));
+            if (type == RouterTLV::ELEMENT) {
+                CHECK(dec.get_name(&name));
+                if (name == "bundle_transmitted_event") {
+                    ++received;
+                }
+            } else if (type == RouterTLV::ATTRIBUTE) {
+                CHECK(dec.get_name(&name));
+                CHECK(dec.get_value(&value));
+            }
+        }
+    }
+
+    u_int32_t elapsed = t0.elapsed_ms();
+    log_always_p("/test", "%d events in %u ms (%u bytes per %d event frame)",
+                 received, elapsed, (u_int)frame_bytes, BATCH);
+    CHECK_EQUAL(received, NUM_MESSAGES);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Fini) {
+    close(socks[0]);
+    close(socks[1]);
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(ECLFramingTest) {
+    ADD_TEST(Init);
+    ADD_TEST(Dictionary);
+    ADD_TEST(Frames);
+    ADD_TEST(PassFds);
+    ADD_TEST(Throughput);
+    ADD_TEST(Fini);
+}
+
+DECLARE_TEST_FILE(ECLFramingTest, "ecl framing test");
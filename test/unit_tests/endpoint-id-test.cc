@@ -605,6 +605,59 @@ DECLARE_TEST(URIEquality) {
     return UNIT_TEST_PASSED;
 }
 
+DECLARE_TEST(Interning) {
+    EndpointIDTable* table = EndpointIDTable::instance();
+    size_t size = table->size();
+
+    {
+        EndpointID a("dtn://host/app");
+        EndpointID b(std::string("dtn://host/app"));
+        EndpointID c("dtn://other/app");
+
+        // equal strings share one entry
+        CHECK(a.entry() == b.entry());
+        CHECK(a == b);
+        CHECK(a != c);
+        CHECK(!(a < b) && !(b < a));
+        CHECK((a < c) != (c < a));
+        CHECK_EQUAL(table->size(), size + 2);
+
+        // an equivalent spelling keeps its own string but compares
+        // equal through the shared canonical entry
+        EndpointID d("DTN://HOST/app");
+        CHECK(d.entry() != a.entry());
+        CHECK(d == a);
+        CHECK(!(a < d) && !(d < a));
+        CHECK_EQUALSTR(d.c_str(), "DTN://HOST/app");
+
+        // copies and assignment share the entry too
+        EndpointID e;
+        CHECK(!e.valid());
+        e = c;
+        CHECK(e.entry() == c.entry());
+        CHECK(e.valid());
+
+        // modifying a copy doesn't affect the interned original
+        EndpointID f(a);
+        CHECK(f.append_service_tag("tag"));
+        CHECK_EQUALSTR(a.c_str(), "dtn://host/app");
+        CHECK(f != a);
+
+        // the same string is validated separately as an id and as a
+        // pattern
+        EndpointID wild("*:*");
+        EndpointIDPattern pattern("*:*");
+        CHECK(wild == pattern);
+        CHECK(pattern.valid());
+        CHECK(pattern.match(a));
+    }
+
+    // the entries created above are released with the last reference
+    CHECK_EQUAL(table->size(), size);
+
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TESTER(EndpointIDTester) {
     ADD_TEST(Invalid);
     ADD_TEST(Unknown);
@@ -622,6 +675,7 @@ DECLARE_TESTER(EndpointIDTester) {
     ADD_TEST(SessionMatch);
     ADD_TEST(URIGenericSyntax);
     ADD_TEST(URIEquality);
+    ADD_TEST(Interning);
 }
 
 DECLARE_TEST_FILE(EndpointIDTester, "endpoint id test");
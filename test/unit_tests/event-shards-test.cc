@@ -0,0 +1,266 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <pthread.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+#include <oasys/thread/Atomic.h>
+#include <oasys/thread/SpinLock.h>
+
+#include "bundling/BundleEvent.h"
+#include "bundling/EventShards.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define SHARDS          4
+#define KEYS            64
+#define EVENTS          100000
+
+oasys::atomic_t deleted(0);
+
+/**
+ * Event carrying the key (standing in for the bundle id) that picks
+ * its shard and its sequence number among the events for that key.
+ */
+class TestEvent : public BundleEvent {
+public:
+    TestEvent(u_int32_t key, u_int32_t seq)
+        : BundleEvent(BUNDLE_RECEIVED), key_(key), seq_(seq) {}
+    ~TestEvent() { oasys::atomic_incr(&deleted); }
+
+    u_int32_t key_;
+    u_int32_t seq_;
+};
+
+/**
+ * Handler that checks that the events for each key are seen in the
+ * order they were posted, and all by the same thread. Each key only
+ * ever goes to one shard, so the per-key state needs no locking.
+ */
+class TestHandler : public EventShards::Handler {
+public:
+    TestHandler(int delay_usec = 0)
+        : delay_usec_(delay_usec), handled_(0), out_of_order_(0),
+          wrong_thread_(0)
+    {
+        for (int i = 0; i < KEYS; ++i) {
+            next_[i] = 0;
+            thread_[i] = 0;
+        }
+    }
+
+    void handle_sharded_event(BundleEvent* event)
+    {
+        TestEvent* e = (TestEvent*)event;
+
+        if (e->seq_ != next_[e->key_]) {
+            oasys::atomic_incr(&out_of_order_);
+        }
+        next_[e->key_] = e->seq_ + 1;
+
+        if (thread_[e->key_] == 0) {
+            thread_[e->key_] = pthread_self();
+        } else if (! pthread_equal(thread_[e->key_], pthread_self())) {
+            oasys::atomic_incr(&wrong_thread_);
+        }
+
+        if (delay_usec_ != 0) {
+            usleep(random() % delay_usec_);
+        }
+
+        oasys::atomic_incr(&handled_);
+    }
+
+    int             delay_usec_;
+    u_int32_t       next_[KEYS];
+    pthread_t       thread_[KEYS];
+    oasys::atomic_t handled_;
+    oasys::atomic_t out_of_order_;
+    oasys::atomic_t wrong_thread_;
+};
+
+/**
+ * Post events for randomly chosen keys, numbering each key's events
+ * in the order they are posted.
+ */
+void
+post_events(EventShards* shards, u_int32_t* seqs, int count)
+{
+    for (int i = 0; i < count; ++i) {
+        u_int32_t key = random() % KEYS;
+        shards->post(key, new TestEvent(key, seqs[key]++));
+    }
+}
+
+DECLARE_TEST(Ordering) {
+    TestHandler handler;
+    EventShards shards(&handler, "/test/shards");
+    shards.start(SHARDS);
+    CHECK_EQUAL(shards.size(), SHARDS);
+
+    u_int32_t seqs[KEYS] = { 0 };
+    post_events(&shards, seqs, EVENTS);
+    shards.drain();
+
+    CHECK_EQUAL(shards.outstanding(), 0);
+    CHECK_EQUAL(handler.handled_.value, EVENTS);
+    CHECK_EQUAL(handler.out_of_order_.value, 0);
+    CHECK_EQUAL(handler.wrong_thread_.value, 0);
+    for (int i = 0; i < KEYS; ++i) {
+        CHECK_EQUAL(handler.next_[i], seqs[i]);
+    }
+
+    // keys that map to different shards are handled by different
+    // threads
+    CHECK(! pthread_equal(handler.thread_[0], handler.thread_[1]));
+    CHECK(pthread_equal(handler.thread_[0], handler.thread_[SHARDS]));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Drain) {
+    TestHandler handler(100);
+    EventShards shards(&handler, "/test/shards");
+    shards.start(SHARDS);
+
+    // drain has to wait for the slow handlers, and then the shards
+    // can be reused for another round
+    u_int32_t seqs[KEYS] = { 0 };
+    for (int round = 0; round < 10; ++round) {
+        post_events(&shards, seqs, 200);
+        shards.drain();
+        CHECK_EQUAL(shards.outstanding(), 0);
+        CHECK_EQUAL(handler.handled_.value, (round + 1) * 200);
+    }
+    CHECK_EQUAL(handler.out_of_order_.value, 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Stop) {
+    TestHandler handler(100);
+    EventShards shards(&handler, "/test/shards");
+    shards.start(SHARDS);
+
+    // stopping with events still queued joins the threads and
+    // deletes the unhandled events
+    deleted.value = 0;
+    u_int32_t seqs[KEYS] = { 0 };
+    post_events(&shards, seqs, 1000);
+    shards.stop();
+
+    CHECK(shards.empty());
+    CHECK_EQUAL(shards.outstanding(), 0);
+    CHECK_EQUAL(deleted.value, 1000);
+    CHECK(handler.handled_.value <= 1000);
+    CHECK_EQUAL(handler.out_of_order_.value, 0);
+
+    // stopping again (as the destructor does) is harmless
+    shards.stop();
+
+    return UNIT_TEST_PASSED;
+}
+
+/**
+ * Handler standing in for the daemon's: most of the work for each
+ * event (the validation of an arriving bundle) only touches that
+ * event, while the rest (the daemon's and router's state) is done
+ * under a lock shared by all the shards.
+ */
+class WorkHandler : public EventShards::Handler {
+public:
+    WorkHandler(int unlocked, int locked)
+        : unlocked_(unlocked), locked_(locked), handled_(0), sum_(0) {}
+
+    static u_int32_t work(u_int32_t seed, int rounds)
+    {
+        for (int i = 0; i < rounds; ++i) {
+            seed = seed * 1103515245 + 12345;
+        }
+        return seed;
+    }
+
+    void handle_sharded_event(BundleEvent* event)
+    {
+        TestEvent* e = (TestEvent*)event;
+        u_int32_t v = work(e->seq_, unlocked_);
+
+        oasys::ScopeLock l(&lock_, "WorkHandler");
+        sum_ += work(v, locked_);
+        handled_++;
+    }
+
+    int                unlocked_;
+    int                locked_;
+    oasys::SpinLock    lock_;
+    u_int32_t          handled_;
+    volatile u_int32_t sum_; ///< keeps the work from being optimized out
+};
+
+/**
+ * Time a tenth of EVENTS events through the given number of shards.
+ */
+u_int32_t
+time_shards(u_int count, u_int32_t* handled)
+{
+    WorkHandler handler(20000, 5000);
+    EventShards shards(&handler, "/test/shards");
+    shards.start(count);
+
+    oasys::Time t0;
+    t0.get_time();
+
+    u_int32_t seqs[KEYS] = { 0 };
+    post_events(&shards, seqs, EVENTS / 10);
+    shards.drain();
+
+    u_int32_t elapsed = t0.elapsed_ms();
+    *handled = handler.handled_;
+    return elapsed;
+}
+
+DECLARE_TEST(Throughput) {
+    // the speedup is bounded by the locked fifth of the work and by
+    // the number of cpus, so this only reports it
+    u_int32_t handled1, handledN;
+    u_int32_t one  = time_shards(1, &handled1);
+    u_int32_t many = time_shards(SHARDS, &handledN);
+    log_always_p("/test", "%d events: %u ms on 1 shard, %u ms on %d shards "
+                 "(%.2fx)", EVENTS / 10, one, many, SHARDS,
+                 many == 0 ? 0.0 : (double)one / many);
+
+    CHECK_EQUAL(handled1, EVENTS / 10);
+    CHECK_EQUAL(handledN, EVENTS / 10);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(EventShardsTest) {
+    ADD_TEST(Ordering);
+    ADD_TEST(Drain);
+    ADD_TEST(Stop);
+    ADD_TEST(Throughput);
+}
+
+DECLARE_TEST_FILE(EventShardsTest, "event shards test");
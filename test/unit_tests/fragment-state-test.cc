@@ -0,0 +1,292 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <stdlib.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#include <oasys/storage/DurableStore.h>
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "bundling/Bundle.h"
+#include "bundling/BundleDaemon.h"
+#include "bundling/BundleEvent.h"
+#include "bundling/FragmentManager.h"
+#include "bundling/FragmentState.h"
+#include "storage/BundleStore.h"
+#include "storage/DTNStorageConfig.h"
+#include "storage/GlobalStore.h"
+
+#include "TestDaemon.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define NUM_FRAGMENTS   100000
+#define NUM_BUNDLES     1000
+
+TestDaemon* daemon_ = NULL;
+
+struct Fragment {
+    size_t offset_;
+    size_t len_;
+};
+
+/**
+ * Split a payload of the given length into fragments of one to
+ * max_len bytes, some of which overlap the next one, and shuffle them.
+ */
+size_t
+make_fragments(std::vector<Fragment>* frags, size_t count, size_t max_len)
+{
+    size_t offset = 0;
+    for (size_t i = 0; i < count; ++i) {
+        Fragment f;
+        f.offset_ = offset;
+        f.len_    = 1 + random() % max_len;
+        offset   += f.len_;
+        frags->push_back(f);
+    }
+
+    for (size_t i = 0; i + 1 < count; ++i) {
+        if (random() % 4 == 0) {
+            (*frags)[i].len_ += random() % ((*frags)[i + 1].len_);
+        }
+    }
+
+    std::random_shuffle(frags->begin(), frags->end());
+    return offset;
+}
+
+DECLARE_TEST(Init) {
+    daemon_ = new TestDaemon();
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Ranges) {
+    FragmentState::RangeSet s;
+    CHECK(s.covers(0));
+    CHECK(! s.covers(10));
+
+    CHECK_EQUAL(s.add(20, 10), 10);
+    CHECK_EQUAL(s.add(0, 10), 10);
+    CHECK_EQUAL(s.num_ranges(), 2);
+    CHECK(! s.covers(30));
+
+    // redundant, overlapping and adjacent ranges
+    CHECK_EQUAL(s.add(22, 5), 0);
+    CHECK_EQUAL(s.add(5, 0), 0);
+    CHECK_EQUAL(s.add(8, 4), 2);
+    CHECK_EQUAL(s.add(12, 3), 3);
+    CHECK_EQUAL(s.num_ranges(), 2);
+    CHECK_EQUAL(s.covered(), 25);
+
+    // one range spanning the gap and both neighbours
+    CHECK_EQUAL(s.add(5, 40), 20);
+    CHECK_EQUAL(s.num_ranges(), 1);
+    CHECK_EQUAL(s.covered(), 45);
+    CHECK(s.covers(45));
+    CHECK(s.covers(30));
+    CHECK(! s.covers(46));
+
+    FragmentState::RangeSet s2;
+    CHECK_EQUAL(s2.add(10, 5), 5);
+    CHECK_EQUAL(s2.add(30, 5), 5);
+    CHECK_EQUAL(s2.add(50, 5), 5);
+    CHECK_EQUAL(s2.add(0, 60), 45);
+    CHECK_EQUAL(s2.num_ranges(), 1);
+    CHECK(s2.covers(60));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(ManyFragments) {
+    std::vector<Fragment> frags;
+    size_t total = make_fragments(&frags, NUM_FRAGMENTS, 64);
+
+    // hold back the only fragment that covers the start, so the
+    // bundle is completed by the very last one to arrive
+    for (size_t i = 0; i < frags.size(); ++i) {
+        if (frags[i].offset_ == 0) {
+            std::swap(frags[i], frags.back());
+            break;
+        }
+    }
+
+    std::string orig(total, '\0');
+    for (size_t i = 0; i < total; ++i) {
+        orig[i] = 'a' + random() % 26;
+    }
+
+    std::vector<Bundle*> fragments;
+    for (size_t i = 0; i < frags.size(); ++i) {
+        const Fragment& f = frags[i];
+        size_t len = std::min(f.len_, total - f.offset_);
+
+        Bundle* fragment = new Bundle(BundlePayload::MEMORY);
+        fragment->mutable_source()->assign("dtn://source.dtn/test");
+        fragment->mutable_dest()->assign("dtn://dest.dtn/test");
+        fragment->set_creation_ts(BundleTimestamp(1000, 1));
+        fragment->set_is_fragment(true);
+        fragment->set_frag_offset(f.offset_);
+        fragment->set_orig_length(total);
+        fragment->mutable_payload()->
+            set_data((const u_char*)orig.data() + f.offset_, len);
+        fragment->add_ref("test");
+        fragments.push_back(fragment);
+    }
+
+    FragmentManager* fragmentmgr = daemon_->fragmentmgr();
+
+    oasys::Time t0;
+    t0.get_time();
+
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        fragmentmgr->process_for_reassembly(fragments[i]);
+        if (i + 1 < fragments.size()) {
+            CHECK_EQUAL(daemon_->events_.size(), 0);
+        }
+    }
+
+    u_int32_t elapsed = t0.elapsed_ms();
+    log_always_p("/test", "reassembled %zu bytes from %d fragments in %u ms",
+                 total, NUM_FRAGMENTS, elapsed);
+
+    CHECK_EQUAL(daemon_->events_.size(), 1);
+    BundleEvent* e = daemon_->next_event();
+    CHECK(e != NULL);
+    CHECK_EQUAL(e->type_, REASSEMBLY_COMPLETED);
+    ReassemblyCompletedEvent* event = (ReassemblyCompletedEvent*)e;
+    CHECK_EQUAL(event->fragments_.size(), fragments.size());
+
+    Bundle* bundle = event->bundle_.object();
+    CHECK(! bundle->is_fragment());
+    CHECK_EQUAL(bundle->payload().length(), total);
+
+    std::string buf(total, '\0');
+    bundle->payload().read_data(0, total, (u_char*)&buf[0]);
+    CHECK(buf == orig);
+
+    // releasing the event drops the last references to the bundles
+    event->fragments_.clear();
+    delete event;
+    free_bundle(bundle);
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        free_bundle(fragments[i]);
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Reassembly) {
+    std::vector<Fragment> frags;
+    size_t total = make_fragments(&frags, NUM_BUNDLES, 1000);
+
+    Bundle* bundle = new Bundle(oasys::Builder::builder());
+    bundle->mutable_payload()->init(0, BundlePayload::NODATA);
+    bundle->mutable_payload()->set_length(total);
+    bundle->add_ref("test");
+    FragmentState* state = new FragmentState(bundle);
+
+    // a duplicate of the last fragment, after the bundle is complete
+    frags.push_back(frags.back());
+
+    std::vector<Bundle*> fragments;
+    bool completed = false;
+    for (size_t i = 0; i < frags.size(); ++i) {
+        const Fragment& f = frags[i];
+        size_t len = std::min(f.len_, total - f.offset_);
+
+        Bundle* fragment = new Bundle(oasys::Builder::builder());
+        fragment->test_set_bundleid(i + 1);
+        fragment->set_is_fragment(true);
+        fragment->set_frag_offset(f.offset_);
+        fragment->set_orig_length(total);
+        fragment->mutable_payload()->init(i + 1, BundlePayload::NODATA);
+        fragment->mutable_payload()->set_length(len);
+        fragment->add_ref("test");
+        fragments.push_back(fragment);
+
+        size_t added = state->add_fragment(fragment);
+        if (completed) {
+            CHECK_EQUAL(added, 0);
+        }
+        completed = state->check_completed();
+    }
+
+    CHECK(completed);
+    CHECK_EQUAL(state->num_fragments(), frags.size());
+    CHECK_EQUAL(state->received().covered(), total);
+
+    // a fragment of some other bundle is kept but adds nothing
+    Bundle* other = new Bundle(oasys::Builder::builder());
+    other->set_is_fragment(true);
+    other->set_orig_length(total + 1);
+    other->mutable_payload()->init(0, BundlePayload::NODATA);
+    other->mutable_payload()->set_length(1);
+    other->add_ref("test");
+    CHECK_EQUAL(state->add_fragment(other), 0);
+    CHECK_EQUAL(state->num_fragments(), frags.size() + 1);
+
+    // erasing a fragment leaves its data counted
+    CHECK(state->erase_fragment(other));
+    CHECK(state->check_completed());
+
+    // deleting the state leaves only the test's references
+    delete state;
+    free_bundle(other);
+    for (size_t i = 0; i < fragments.size(); ++i) {
+        free_bundle(fragments[i]);
+    }
+    free_bundle(bundle);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(FragmentStateTest) {
+    ADD_TEST(Init);
+    ADD_TEST(Ranges);
+    ADD_TEST(ManyFragments);
+    ADD_TEST(Reassembly);
+}
+
+int
+main(int argc, const char** argv)
+{
+    FragmentStateTest t("fragment state test");
+    t.init(argc, argv, true);
+
+    system("rm -rf .fragment-state-test");
+    system("mkdir  .fragment-state-test");
+    DTNStorageConfig cfg("", "memorydb", "", "");
+    cfg.init_ = true;
+    cfg.payload_dir_.assign(".fragment-state-test");
+    cfg.leave_clean_file_ = false;
+    oasys::DurableStore ds("/test/ds");
+    ds.create_store(cfg);
+    GlobalStore::init(cfg, &ds);
+    BundleStore::init(cfg, &ds);
+
+    t.run_tests();
+
+    system("rm -rf .fragment-state-test");
+}
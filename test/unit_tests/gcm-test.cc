@@ -0,0 +1,220 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "security/GCMContext.h"
+
+using namespace dtn;
+using namespace oasys;
+
+#define BENCH_BYTES     (64 * 1024 * 1024)
+#define BENCH_CHUNK     (64 * 1024)
+
+// test case 3 of the GCM specification (McGrew and Viega)
+static const u_char tc3_key[] = {
+    0xfe, 0xff, 0xe9, 0x92, 0x86, 0x65, 0x73, 0x1c,
+    0x6d, 0x6a, 0x8f, 0x94, 0x67, 0x30, 0x83, 0x08,
+};
+
+static const u_char tc3_iv[] = {
+    0xca, 0xfe, 0xba, 0xbe, 0xfa, 0xce, 0xdb, 0xad,
+    0xde, 0xca, 0xf8, 0x88,
+};
+
+static const u_char tc3_plain[] = {
+    0xd9, 0x31, 0x32, 0x25, 0xf8, 0x84, 0x06, 0xe5,
+    0xa5, 0x59, 0x09, 0xc5, 0xaf, 0xf5, 0x26, 0x9a,
+    0x86, 0xa7, 0xa9, 0x53, 0x15, 0x34, 0xf7, 0xda,
+    0x2e, 0x4c, 0x30, 0x3d, 0x8a, 0x31, 0x8a, 0x72,
+    0x1c, 0x3c, 0x0c, 0x95, 0x95, 0x68, 0x09, 0x53,
+    0x2f, 0xcf, 0x0e, 0x24, 0x49, 0xa6, 0xb5, 0x25,
+    0xb1, 0x6a, 0xed, 0xf5, 0xaa, 0x0d, 0xe6, 0x57,
+    0xba, 0x63, 0x7b, 0x39, 0x1a, 0xaf, 0xd2, 0x55,
+};
+
+static const u_char tc3_cipher[] = {
+    0x42, 0x83, 0x1e, 0xc2, 0x21, 0x77, 0x74, 0x24,
+    0x4b, 0x72, 0x21, 0xb7, 0x84, 0xd0, 0xd4, 0x9c,
+    0xe3, 0xaa, 0x21, 0x2f, 0x2c, 0x02, 0xa4, 0xe0,
+    0x35, 0xc1, 0x7e, 0x23, 0x29, 0xac, 0xa1, 0x2e,
+    0x21, 0xd5, 0x14, 0xb2, 0x54, 0x66, 0x93, 0x1c,
+    0x7d, 0x8f, 0x6a, 0x5a, 0xac, 0x84, 0xaa, 0x05,
+    0x1b, 0xa3, 0x0b, 0x39, 0x6a, 0x0a, 0xac, 0x97,
+    0x3d, 0x58, 0xe0, 0x91, 0x47, 0x3f, 0x59, 0x85,
+};
+
+static const u_char tc3_tag[] = {
+    0x4d, 0x5c, 0x2a, 0xf3, 0x27, 0xcd, 0x64, 0xa6,
+    0x2c, 0xf3, 0x5a, 0xbd, 0x2b, 0xa6, 0xfa, 0xb4,
+};
+
+std::vector<GCMContext::backend_t> backends;
+
+/**
+ * Encrypt or decrypt the buffer in pieces of varying size, as the
+ * payload block processor hands it over.
+ */
+int
+crypt_stream(GCMContext* ctx, bool enc, u_char* buf, size_t len,
+             const u_char* iv, u_char* tag)
+{
+    CHECK_EQUAL(ctx->init_message(iv, 12), RETURN_OK);
+
+    size_t off = 0, chunk = 1;
+    while (off < len) {
+        size_t n = std::min(chunk, len - off);
+        if (enc) {
+            CHECK_EQUAL(ctx->encrypt(buf + off, n), RETURN_OK);
+        } else {
+            CHECK_EQUAL(ctx->decrypt(buf + off, n), RETURN_OK);
+        }
+        off  += n;
+        chunk = chunk * 3 + 7;
+    }
+
+    if (enc) {
+        CHECK_EQUAL(ctx->compute_tag(tag, 16), RETURN_OK);
+    } else {
+        CHECK_EQUAL(ctx->check_tag(tag, 16), RETURN_OK);
+    }
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Init) {
+    backends.push_back(GCMContext::GCM_SOFTWARE);
+    if (GCMContext::resolve(GCMContext::GCM_OPENSSL) ==
+        GCMContext::GCM_OPENSSL)
+    {
+        backends.push_back(GCMContext::GCM_OPENSSL);
+    }
+
+    log_always_p("/test", "cpu acceleration %s, auto backend is %s",
+                 GCMContext::hw_accelerated() ? "yes" : "no",
+                 GCMContext::backend_to_str(
+                     GCMContext::resolve(GCMContext::GCM_AUTO)));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(KnownAnswer) {
+    for (size_t i = 0; i < backends.size(); ++i) {
+        GCMContext ctx(backends[i]);
+        CHECK_EQUAL(ctx.backend(), backends[i]);
+        CHECK_EQUAL(ctx.init_and_key(tc3_key, sizeof(tc3_key)), RETURN_OK);
+
+        u_char buf[sizeof(tc3_plain)];
+        u_char tag[16];
+        memcpy(buf, tc3_plain, sizeof(buf));
+        CHECK_EQUAL(ctx.encrypt_message(tc3_iv, sizeof(tc3_iv),
+                                        buf, sizeof(buf), tag, sizeof(tag)),
+                    RETURN_OK);
+        CHECK(memcmp(buf, tc3_cipher, sizeof(buf)) == 0);
+        CHECK(memcmp(tag, tc3_tag, sizeof(tag)) == 0);
+
+        CHECK_EQUAL(ctx.decrypt_message(tc3_iv, sizeof(tc3_iv),
+                                        buf, sizeof(buf), tag, sizeof(tag)),
+                    RETURN_OK);
+        CHECK(memcmp(buf, tc3_plain, sizeof(buf)) == 0);
+
+        // a corrupted message fails the tag check
+        memcpy(buf, tc3_cipher, sizeof(buf));
+        buf[10] ^= 1;
+        CHECK_EQUAL(ctx.decrypt_message(tc3_iv, sizeof(tc3_iv),
+                                        buf, sizeof(buf), tag, sizeof(tag)),
+                    RETURN_ERROR);
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Streaming) {
+    // each backend decrypts what the others encrypted in pieces
+    size_t len = 100000;
+    std::vector<u_char> plain(len), buf(len);
+    for (size_t i = 0; i < len; ++i) {
+        plain[i] = random() & 0xff;
+    }
+
+    for (size_t i = 0; i < backends.size(); ++i) {
+        for (size_t j = 0; j < backends.size(); ++j) {
+            GCMContext enc(backends[i]), dec(backends[j]);
+            CHECK_EQUAL(enc.init_and_key(tc3_key, 16), RETURN_OK);
+            CHECK_EQUAL(dec.init_and_key(tc3_key, 16), RETURN_OK);
+
+            u_char tag[16];
+            buf = plain;
+            CHECK(crypt_stream(&enc, true, &buf[0], len, tc3_iv, tag)
+                  == UNIT_TEST_PASSED);
+            CHECK(buf != plain);
+            CHECK(crypt_stream(&dec, false, &buf[0], len, tc3_iv, tag)
+                  == UNIT_TEST_PASSED);
+            CHECK(buf == plain);
+        }
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Throughput) {
+    std::vector<u_char> buf(BENCH_CHUNK, 0x5a);
+    u_char key[32];
+    memset(key, 0x11, sizeof(key));
+
+    for (size_t i = 0; i < backends.size(); ++i) {
+        for (size_t key_len = 16; key_len <= 32; key_len += 16) {
+            GCMContext ctx(backends[i]);
+            CHECK_EQUAL(ctx.init_and_key(key, key_len), RETURN_OK);
+            CHECK_EQUAL(ctx.init_message(tc3_iv, sizeof(tc3_iv)), RETURN_OK);
+
+            oasys::Time t0;
+            t0.get_time();
+            for (size_t done = 0; done < BENCH_BYTES; done += BENCH_CHUNK) {
+                CHECK_EQUAL(ctx.encrypt(&buf[0], BENCH_CHUNK), RETURN_OK);
+            }
+            u_char tag[16];
+            CHECK_EQUAL(ctx.compute_tag(tag, sizeof(tag)), RETURN_OK);
+            u_int32_t elapsed = t0.elapsed_ms();
+
+            log_always_p("/test", "%s aes-%zu-gcm: %d MB in %u ms "
+                         "(%.1f MB/s)",
+                         GCMContext::backend_to_str(backends[i]),
+                         key_len * 8, BENCH_BYTES >> 20, elapsed,
+                         elapsed ? (BENCH_BYTES >> 20) * 1000.0 / elapsed
+                                 : 0.0);
+        }
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(GCMTest) {
+    ADD_TEST(Init);
+    ADD_TEST(KnownAnswer);
+    ADD_TEST(Streaming);
+    ADD_TEST(Throughput);
+}
+
+DECLARE_TEST_FILE(GCMTest, "gcm test");
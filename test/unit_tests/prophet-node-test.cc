@@ -3,7 +3,10 @@
 #endif
 #include <oasys/util/UnitTest.h>
 #include <netinet/in.h>
+#include <math.h>
+#include <time.h>
 #include "prophet/Node.h"
+#include "prophet/Table.h"
 #include "prophet/BundleTLVEntry.h"
 #include "prophet/Ack.h"
 #include <sys/types.h>
@@ -50,6 +53,127 @@ DECLARE_TEST(NodeTest) {
     return UNIT_TEST_PASSED;
 }
 
+// exposes the protected mutators to set up aged routes
+class AgedNode : public prophet::Node {
+public:
+    AgedNode(const std::string& dest_id, double p, u_int32_t age,
+             const prophet::NodeParams* params = NULL)
+        : prophet::Node(dest_id)
+    {
+        if (params != NULL)
+            set_params(params);
+        set_pvalue(p);
+        set_age(age);
+    }
+};
+
+DECLARE_TEST(LazyAgingTest) {
+    u_int32_t now = time(0);
+    AgedNode a("dtn://test", 0.5, now - 10);
+
+    // 10 seconds is 100 time units with the default kappa
+    double aged = 0.5 * pow(prophet::NodeParams::DEFAULT_GAMMA, 100);
+    CHECK(fabs(a.p_value(now) - aged) < 1e-9);
+    CHECK(a.p_value() <= a.p_value(now));
+    CHECK(a.p_value(now - 10) == 0.5);
+
+    // reading the value doesn't modify the node
+    CHECK(a.p_value_at_age() == 0.5);
+    CHECK_EQUAL(a.age(), now - 10);
+
+    // but aging folds the decay into the stored value
+    a.update_age();
+    CHECK(a.age() >= now);
+    CHECK(a.p_value_at_age() <= aged + 1e-9);
+    CHECK(a.p_value() == a.p_value_at_age());
+
+    // updates start from the aged value
+    AgedNode b("dtn://test", 0.5, now - 10);
+    b.update_pvalue();
+    CHECK(b.p_value_at_age() <= aged + (1.0 - aged) *
+          prophet::NodeParams::DEFAULT_P_ENCOUNTER + 1e-9);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(TableAgingTest) {
+    prophet::BundleCoreTestImpl core;
+    prophet::Table t(&core, "aging");
+    u_int32_t now = time(0);
+
+    // the newest route isn't the highest stored value once aged
+    t.update(new AgedNode("dtn://test-x", 0.9, now - 100));
+    t.update(new AgedNode("dtn://test-y", 0.5, now));
+    t.update(new AgedNode("dtn://test-z", 0.2, now - 1));
+
+    // aging touches nothing, but the heap is in aged order
+    CHECK_EQUAL(t.age_nodes(), 3);
+    CHECK_EQUALSTR((*t.heap_begin())->dest_id(), "dtn://test-x");
+    CHECK(t.p_value("dtn://test-x") < 0.001);
+    CHECK(t.p_value("dtn://test-z") < 0.2);
+    CHECK(t.p_value("dtn://test-y") <= 0.5);
+
+    // and the decayed route is removed
+    CHECK_EQUAL(t.truncate(0.01), 1);
+    CHECK(t.find("dtn://test-x") == NULL);
+    CHECK_EQUALSTR((*t.heap_begin())->dest_id(), "dtn://test-z");
+    CHECK_EQUAL(t.size(), 2);
+
+    // everything can decay away without running off the heap
+    CHECK_EQUAL(t.truncate(0.99), 2);
+    CHECK_EQUAL(t.size(), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(HeapKeyTest) {
+    u_int32_t now = time(0);
+    AgedNode a("dtn://test-a", 0.9, now - 100);
+    AgedNode b("dtn://test-b", 0.5, now);
+    AgedNode c("dtn://test-c", 0.6, now - 5);
+    AgedNode d("dtn://test-d", 0.0, now);
+
+    // the keys are in the same order as the aged predictabilities
+    prophet::Node* nodes[] = { &a, &b, &c, &d };
+    for (int i = 0; i < 4; ++i) {
+        for (int j = 0; j < 4; ++j) {
+            CHECK((nodes[i]->p_value(now) < nodes[j]->p_value(now)) ==
+                  (nodes[i]->heap_key() < nodes[j]->heap_key()));
+        }
+    }
+
+    // and aging the stored value doesn't move the key
+    double key = c.heap_key();
+    c.update_age();
+    CHECK(fabs(c.heap_key() - key) < 1e-6);
+
+    // nor does a kappa that doesn't divide a second, such as 300 ms,
+    // change the order over time
+    prophet::NodeParams params;
+    params.kappa_ = 300;
+    AgedNode e("dtn://test-e", 0.9, now - 7, &params);
+    AgedNode f("dtn://test-f", 0.5, now - 1, &params);
+    AgedNode g("dtn://test-g", 0.8, now - 4, &params);
+    prophet::Node* slow[] = { &e, &f, &g };
+    for (u_int32_t t = now; t < now + 10; ++t) {
+        for (int i = 0; i < 3; ++i) {
+            for (int j = 0; j < 3; ++j) {
+                CHECK((slow[i]->p_value(t) < slow[j]->p_value(t)) ==
+                      (slow[i]->heap_key() < slow[j]->heap_key()));
+            }
+        }
+    }
+
+    // 7 seconds is 23 1/3 time units
+    double aged = 0.9 * pow(prophet::NodeParams::DEFAULT_GAMMA, 7000.0 / 300);
+    CHECK(fabs(e.p_value(now) - aged) < 1e-9);
+    key = e.heap_key();
+    e.update_age();
+    CHECK(fabs(e.heap_key() - key) < 1e-6);
+
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TEST(BundleTLVEntryTest) {
     prophet::BundleTLVEntry* a =
         prophet::BundleTLVEntry::create_entry(0xffffffff,0,0xffff,
@@ -106,6 +230,9 @@ DECLARE_TEST(AckTest) {
 
 DECLARE_TESTER(ProphetNodeTest) {
     ADD_TEST(NodeTest);
+    ADD_TEST(LazyAgingTest);
+    ADD_TEST(TableAgingTest);
+    ADD_TEST(HeapKeyTest);
     ADD_TEST(BundleTLVEntryTest);
     ADD_TEST(AckTest);
 }
@@ -1,5 +1,8 @@
 #include <dtn-config.h>
+#include <stdlib.h>
+#include <vector>
 #include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
 #include <oasys/debug/Log.h>
 
 #include "prophet/Params.h"
@@ -445,6 +448,68 @@ DECLARE_TEST(LEPR) {
     return UNIT_TEST_PASSED;
 }
 
+// same as RepCoreImpl, minus the per-operation logging
+class QuietCoreImpl : public prophet::Repository::BundleCoreRep
+{
+public:
+    void print_log(const char*, int, const char*, ...) {}
+    void drop_bundle(const prophet::Bundle*) {}
+    u_int64_t max_bundle_quota() const { return 0; }
+};
+
+#define SCALING_MAX 100000
+
+DECLARE_TEST(Scaling) {
+    QuietCoreImpl quiet;
+
+    srandom(17);
+    for (size_t n = 1000; n <= SCALING_MAX; n *= 10)
+    {
+        std::vector<prophet::BundleImpl> bundles;
+        bundles.reserve(n);
+        for (size_t i = 0; i < n; i++)
+            bundles.push_back(prophet::BundleImpl("dtn://test-scale",
+                                                  i, i, 60, 1,
+                                                  random() % 100));
+
+        prophet::Repository rep(&quiet,
+                prophet::QueuePolicy::policy(prophet::QueuePolicy::MOFO));
+        oasys::Time t;
+
+        t.get_time();
+        for (size_t i = 0; i < n; i++)
+            rep.add(&bundles[i]);
+        u_int32_t add_ms = t.elapsed_ms();
+        CHECK_EQUAL(rep.size(), n);
+        CHECK( is_heap(rep.get_bundles(), rep.get_comparator()) );
+
+        t.get_time();
+        for (size_t i = 0; i < n; i++)
+        {
+            bundles[i].set_num_forward(random() % 100);
+            rep.change_priority(&bundles[i]);
+        }
+        u_int32_t change_ms = t.elapsed_ms();
+        CHECK( is_heap(rep.get_bundles(), rep.get_comparator()) );
+
+        // delete half in random order, then the rest front to back
+        t.get_time();
+        for (size_t i = 0; i < n / 2; i++)
+            rep.del(&bundles[random() % n]);
+        CHECK( is_heap(rep.get_bundles(), rep.get_comparator()) );
+        for (size_t i = 0; i < n; i++)
+            rep.del(&bundles[i]);
+        u_int32_t del_ms = t.elapsed_ms();
+        CHECK( rep.empty() );
+        CHECK_EQUAL(rep.get_current(), 0);
+
+        log_always_p("/test", "%zu bundles: add %u ms, change_priority %u ms, "
+                     "del %u ms", n, add_ms, change_ms, del_ms);
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TESTER(Repository) {
     ADD_TEST(FIFO);
     ADD_TEST(MOFO);
@@ -452,6 +517,7 @@ DECLARE_TESTER(Repository) {
     ADD_TEST(LMOPR);
     ADD_TEST(SHLI);
     ADD_TEST(LEPR);
+    ADD_TEST(Scaling);
 }
 
 DECLARE_TEST_FILE(Repository, "prophet bundle repository test");
@@ -19,6 +19,7 @@
 #endif
 
 #include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
 #include "routing/MultiGraph.h"
 
 using namespace oasys;
@@ -243,10 +244,216 @@ DECLARE_TEST(ShortestPath) {
     return UNIT_TEST_PASSED;
 }
 
+DECLARE_TEST(ShortestPathTree) {
+    MultiGraph<int, int> g;
+    MultiGraph<int, int>::Node* nodes[16];
+    char name[256];
+
+    for (int i = 0; i < 16; ++i) {
+        snprintf(name, sizeof(name), "%d", i);
+        nodes[i] = g.add_node(name, i);
+    }
+    
+    // two rings in opposite directions, the backwards one being
+    // more expensive
+    for (int i = 0; i < 16; ++i) {
+        g.add_edge(nodes[i], nodes[(i + 1) % 16], 1);
+        g.add_edge(nodes[(i + 1) % 16], nodes[i], 2);
+    }
+
+    HopWeightFn hop_weight_fn;
+    InfiniteWeightFn infinite_fn;
+
+    DO(g.shortest_path_tree(nodes[0], &hop_weight_fn));
+    CHECK(g.tree_next_hop(nodes[0]) == NULL);
+    CHECK_EQUAL(g.tree_distance(nodes[0]), 0);
+    for (int i = 1; i < 16; ++i) {
+        CHECK(g.tree_next_hop(nodes[i]) ==
+              g.best_next_hop(nodes[0], nodes[i], &hop_weight_fn));
+    }
+    CHECK_EQUAL(g.tree_distance(nodes[4]), 4);
+    CHECK_EQUAL(g.tree_distance(nodes[10]), 10);
+    CHECK_EQUAL(g.tree_distance(nodes[11]), 10);
+    CHECK_EQUAL(g.tree_distance(nodes[13]), 6);
+    CHECK_EQUAL(g.tree_next_hop(nodes[13])->dest()->info(), 15);
+
+    // make the forward edge 0 -> 1 expensive and check that the
+    // incremental update routes everything around the other way
+    MultiGraph<int, int>::EdgeVector changed;
+    MultiGraph<int, int>::Edge* e01 = nodes[0]->out_edges()[0];
+    CHECK_EQUAL(e01->dest()->info(), 1);
+    e01->mutable_info() = 100;
+    changed.push_back(e01);
+    DO(g.update_shortest_path_tree(nodes[0], changed, &hop_weight_fn));
+    CHECK_EQUAL(g.tree_distance(nodes[1]), 30);
+    CHECK_EQUAL(g.tree_distance(nodes[2]), 28);
+    for (int i = 1; i < 16; ++i) {
+        CHECK_EQUAL(g.tree_next_hop(nodes[i])->dest()->info(), 15);
+    }
+
+    // and back again
+    e01->mutable_info() = 1;
+    DO(g.update_shortest_path_tree(nodes[0], changed, &hop_weight_fn));
+    CHECK_EQUAL(g.tree_distance(nodes[1]), 1);
+    CHECK_EQUAL(g.tree_distance(nodes[12]), 8);
+    CHECK_EQUAL(g.tree_next_hop(nodes[8])->dest()->info(), 1);
+
+    // deleting a tree edge invalidates the tree
+    CHECK(g.del_edge(nodes[0], e01));
+    CHECK(g.tree_next_hop(nodes[1]) == NULL);
+    changed.clear();
+    DO(g.update_shortest_path_tree(nodes[0], changed, &hop_weight_fn));
+    CHECK_EQUAL(g.tree_distance(nodes[1]), 30);
+
+    // nothing is reachable past the first hop with infinite weights
+    DO(g.add_edge(nodes[0], nodes[1], 1));
+    DO(g.shortest_path_tree(nodes[0], &infinite_fn));
+    CHECK_EQUAL(g.tree_distance(nodes[1]), 1);
+    for (int i = 2; i < 16; ++i) {
+        CHECK(g.tree_next_hop(nodes[i]) == NULL);
+    }
+
+    g.clear();
+    
+    return UNIT_TEST_PASSED;
+}
+
+// random graph with roughly BENCH_DEGREE outgoing edges per node, on
+// top of a ring so everything is reachable
+#define BENCH_NODES   10000
+#define BENCH_DEGREE  4
+#define BENCH_UPDATES 100
+#define BENCH_SAMPLES 10
+
+void
+build_random_graph(MultiGraph<int, int>* g,
+                   std::vector<MultiGraph<int, int>::Node*>* nodes,
+                   int count)
+{
+    char name[256];
+    for (int i = 0; i < count; ++i) {
+        snprintf(name, sizeof(name), "dtn://node-%d", i);
+        nodes->push_back(g->add_node(name, i));
+    }
+
+    for (int i = 0; i < count; ++i) {
+        g->add_edge((*nodes)[i], (*nodes)[(i + 1) % count],
+                    1 + (random() % 100));
+        for (int j = 1; j < BENCH_DEGREE; ++j) {
+            int peer = random() % count;
+            if (peer != i) {
+                g->add_edge((*nodes)[i], (*nodes)[peer], 1 + (random() % 100));
+            }
+        }
+    }
+}
+
+DECLARE_TEST(IncrementalTree) {
+    MultiGraph<int, int> g;
+    std::vector<MultiGraph<int, int>::Node*> nodes;
+    HopWeightFn hop_weight_fn;
+
+    srandom(1234);
+    build_random_graph(&g, &nodes, 500);
+    DO(g.shortest_path_tree(nodes[0], &hop_weight_fn));
+    
+    // apply a bunch of random weight changes, checking that the
+    // incremental results match a full computation
+    MultiGraph<int, int> g2;
+    for (int round = 0; round < 50; ++round) {
+        MultiGraph<int, int>::EdgeVector changed;
+        for (int j = 0; j < 5; ++j) {
+            MultiGraph<int, int>::Node* n = nodes[random() % nodes.size()];
+            MultiGraph<int, int>::Edge* e =
+                n->out_edges()[random() % n->out_edges().size()];
+            e->mutable_info() = 1 + (random() % 100);
+            changed.push_back(e);
+        }
+        
+        g.update_shortest_path_tree(nodes[0], changed, &hop_weight_fn);
+
+        std::vector<u_int32_t> distances;
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            distances.push_back(g.tree_distance(nodes[i]));
+        }
+        
+        g.shortest_path_tree(nodes[0], &hop_weight_fn);
+        for (size_t i = 0; i < nodes.size(); ++i) {
+            CHECK_EQUAL(distances[i], g.tree_distance(nodes[i]));
+        }
+    }
+
+    g.clear();
+    
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(TreeBenchmark) {
+    MultiGraph<int, int> g;
+    std::vector<MultiGraph<int, int>::Node*> nodes;
+    HopWeightFn hop_weight_fn;
+
+    srandom(5678);
+    build_random_graph(&g, &nodes, BENCH_NODES);
+
+    // one Dijkstra per destination (only a sample of them, since
+    // doing all of them takes far too long)
+    oasys::Time t;
+    t.get_time();
+    for (int i = 1; i <= BENCH_SAMPLES; ++i) {
+        g.best_next_hop(nodes[0],
+                        nodes[i * (BENCH_NODES / (BENCH_SAMPLES + 1))],
+                        &hop_weight_fn);
+    }
+    u_int32_t per_dest_ms = t.elapsed_ms();
+    log_always_p("/test", "best_next_hop: %u of %u destinations in %u ms",
+                 BENCH_SAMPLES, BENCH_NODES, per_dest_ms);
+
+    t.get_time();
+    g.shortest_path_tree(nodes[0], &hop_weight_fn);
+    u_int32_t tree_ms = t.elapsed_ms();
+    log_always_p("/test", "shortest_path_tree: %u destinations in %u ms",
+                 BENCH_NODES, tree_ms);
+
+    for (int i = 1; i <= BENCH_SAMPLES; ++i) {
+        MultiGraph<int, int>::Node* dest =
+            nodes[i * (BENCH_NODES / (BENCH_SAMPLES + 1))];
+        MultiGraph<int, int>::EdgeVector path;
+        g.shortest_path(nodes[0], dest, &path, &hop_weight_fn);
+        u_int32_t distance = 0;
+        for (size_t j = 0; j < path.size(); ++j) {
+            distance += path[j]->info();
+        }
+        CHECK_EQUAL(distance, g.tree_distance(dest));
+    }
+
+    // a few edges changing per update, as with an incoming LSA
+    t.get_time();
+    for (int i = 0; i < BENCH_UPDATES; ++i) {
+        MultiGraph<int, int>::EdgeVector changed;
+        for (int j = 0; j < 4; ++j) {
+            MultiGraph<int, int>::Node* n = nodes[random() % BENCH_NODES];
+            MultiGraph<int, int>::Edge* e = n->out_edges()[0];
+            e->mutable_info() = 1 + (random() % 100);
+            changed.push_back(e);
+        }
+        g.update_shortest_path_tree(nodes[0], changed, &hop_weight_fn);
+    }
+    log_always_p("/test", "update_shortest_path_tree: %u updates in %u ms",
+                 BENCH_UPDATES, t.elapsed_ms());
+
+    g.clear();
+    
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TESTER(RouteMultiGraphTest) {
     ADD_TEST(NodeOps);
     ADD_TEST(EdgeOps);
     ADD_TEST(ShortestPath);
+    ADD_TEST(ShortestPathTree);
+    ADD_TEST(IncrementalTree);
+    ADD_TEST(TreeBenchmark);
 }
 
 DECLARE_TEST_FILE(RouteMultiGraphTest, "route multigraph test");
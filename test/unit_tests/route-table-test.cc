@@ -19,6 +19,7 @@
 #endif
 
 #include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
 
 #include "bundling/BundleActions.h"
 #include "contacts/Link.h"
@@ -313,6 +314,126 @@ DECLARE_TEST(Recursive) {
     return UNIT_TEST_PASSED;
 }
 
+DECLARE_TEST(IndexedMatching) {
+    RouteTable t("test");
+    RouteEntryVec v;
+
+    // one of each kind of index entry
+    CHECK(add_entry(&t, "dtn://d1", l1));
+    CHECK(add_entry(&t, "dtn://d*", l2));
+    CHECK(add_entry(&t, "ipn://1/*", l3));
+    CHECK(add_entry(&t, "*:*", l1));
+    CHECK(add_entry(&t, "dtn://d1.dtn/*", l3));
+    CHECK(add_entry(&t, "ipn://2/*", l2));
+
+    // matches come back in table order across the index buckets
+    CHECK_EQUAL(t.get_matching(EndpointID("dtn://d1"), &v), 3);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "dtn://d1");
+    CHECK_EQUALSTR(v[1]->dest_pattern().c_str(), "dtn://d*");
+    CHECK_EQUALSTR(v[2]->dest_pattern().c_str(), "*:*");
+    v.clear();
+
+    // dtn://d* is a candidate by host prefix but doesn't match the path
+    CHECK_EQUAL(t.get_matching(EndpointID("dtn://d1.dtn/app"), &v), 2);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "*:*");
+    CHECK_EQUALSTR(v[1]->dest_pattern().c_str(), "dtn://d1.dtn/*");
+    v.clear();
+
+    CHECK_EQUAL(t.get_matching(EndpointID("ipn://1/0"), &v), 2);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "ipn://1/*");
+    CHECK_EQUALSTR(v[1]->dest_pattern().c_str(), "*:*");
+    v.clear();
+
+    // repeated (memoized) lookup filtered by next hop
+    CHECK_EQUAL(t.get_matching(EndpointID("ipn://1/0"), l3, &v), 1);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "ipn://1/*");
+    v.clear();
+
+    // the memo is flushed when the table changes
+    CHECK(t.del_entry(EndpointIDPattern("ipn://1/*"), l3));
+    CHECK_EQUAL(t.get_matching(EndpointID("ipn://1/0"), &v), 1);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "*:*");
+    v.clear();
+
+    CHECK(add_entry(&t, "ipn://1/*", l1));
+    CHECK_EQUAL(t.get_matching(EndpointID("ipn://1/0"), &v), 2);
+    CHECK_EQUALSTR(v[0]->dest_pattern().c_str(), "*:*");
+    CHECK_EQUALSTR(v[1]->dest_pattern().c_str(), "ipn://1/*");
+    v.clear();
+
+    // wildcard host in the destination falls back to a full scan
+    CHECK_EQUAL(t.get_matching(EndpointID("dtn://*"), &v), 4);
+    v.clear();
+
+    t.clear();
+    CHECK_EQUAL(t.get_matching(EndpointID("dtn://d1"), &v), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+#define BENCH_ROUTES  10000
+#define BENCH_BUNDLES 1000000
+#define BENCH_HOT     1000
+
+DECLARE_TEST(RoutingBenchmark) {
+    RouteTable t("bench");
+    RouteEntryVec v;
+    char buf[64];
+
+    // half dtn host routes, half ipn node routes
+    for (int i = 0; i < BENCH_ROUTES / 2; ++i) {
+        snprintf(buf, sizeof(buf), "dtn://node-%d.dtn/*", i);
+        add_entry(&t, buf, (i % 2) ? l1 : l2);
+        snprintf(buf, sizeof(buf), "ipn://%d/*", i);
+        add_entry(&t, buf, (i % 2) ? l2 : l3);
+    }
+    add_entry(&t, "dtn://gateway-*", l3);
+    CHECK_EQUAL(t.size(), BENCH_ROUTES + 1);
+
+    std::vector<EndpointID> dests;
+    for (int i = 0; i < BENCH_ROUTES / 2; ++i) {
+        snprintf(buf, sizeof(buf), "dtn://node-%d.dtn/app", i);
+        dests.push_back(EndpointID(buf));
+        snprintf(buf, sizeof(buf), "ipn://%d/1", i);
+        dests.push_back(EndpointID(buf));
+    }
+
+    // every lookup misses the memo when cycling through all the
+    // destinations, so this measures the index alone
+    oasys::Time t0;
+    t0.get_time();
+    bool ok = true;
+    for (int i = 0; i < BENCH_BUNDLES; ++i) {
+        v.clear();
+        ok = ok && (t.get_matching(dests[i % dests.size()], &v) == 1);
+    }
+    CHECK(ok);
+    log_always_p("/test", "routed %u bundles to %zu destinations "
+                 "against %u routes in %u ms",
+                 BENCH_BUNDLES, dests.size(), BENCH_ROUTES + 1,
+                 t0.elapsed_ms());
+
+    // a smaller hot set of destinations is served from the memo
+    t0.get_time();
+    for (int i = 0; i < BENCH_BUNDLES; ++i) {
+        v.clear();
+        ok = ok && (t.get_matching(dests[i % BENCH_HOT], &v) == 1);
+    }
+    CHECK(ok);
+    log_always_p("/test", "routed %u bundles to %u destinations "
+                 "against %u routes in %u ms",
+                 BENCH_BUNDLES, BENCH_HOT, BENCH_ROUTES + 1,
+                 t0.elapsed_ms());
+
+    oasys::StringBuffer stats;
+    t.dump_stats(&stats);
+    log_always_p("/test", "%s", stats.c_str());
+    
+    t.clear();
+    
+    return UNIT_TEST_PASSED;
+}
+
 DECLARE_TEST(Cleanup) {
 
     l1->delete_link();
@@ -333,6 +454,8 @@ DECLARE_TESTER(RouteTableTest) {
     ADD_TEST(DelEntries);
     ADD_TEST(DelEntriesForNextHop);
     ADD_TEST(Recursive);
+    ADD_TEST(IndexedMatching);
+    ADD_TEST(RoutingBenchmark);
     ADD_TEST(Cleanup);
 }
 
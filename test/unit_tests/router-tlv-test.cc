@@ -0,0 +1,272 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <string.h>
+#include <string>
+
+#include <oasys/util/UnitTest.h>
+
+#include "routing/RouterTLV.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define CHECK_RECORD(_dec, _type)                       \
+    do {                                                \
+        RouterTLV::record_t type;                       \
+        CHECK((_dec).get_record(&type));                \
+        CHECK_EQUAL(type, _type);                       \
+    } while (0)
+
+DECLARE_TEST(Dictionary) {
+    CHECK(RouterTLV::code("bpa") != 0);
+    CHECK(RouterTLV::code("bundle_received_event") != 0);
+    CHECK_EQUAL(RouterTLV::code("not_in_router_xsd"), 0);
+    CHECK_EQUALSTR(RouterTLV::name(RouterTLV::code("hello_interval")),
+                   "hello_interval");
+    CHECK(RouterTLV::name(0) == NULL);
+    CHECK(RouterTLV::name(100000) == NULL);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(RoundTrip) {
+    std::string buf;
+    RouterTLV::Encoder enc(&buf);
+
+    // two messages batched in one payload, one using a name that is
+    // not in the dictionary
+    enc.begin_payload();
+    enc.begin_element("bpa");
+    enc.attribute("eid", "dtn://a", 7);
+    enc.begin_element("bundle_delivered_event");
+    enc.attribute("local_id", "42", 2);
+    enc.end_element();
+    enc.end_element();
+
+    enc.begin_element("bpa");
+    enc.begin_element("x_extension");
+    enc.text("hello", 5);
+    enc.end_element();
+    enc.end_element();
+
+    CHECK(RouterTLV::is_binary((u_char*)buf.data(), buf.size()));
+    CHECK(! RouterTLV::is_binary((u_char*)"<bpa/>", 6));
+
+    RouterTLV::Decoder dec((u_char*)buf.data(), buf.size());
+    std::string name, value;
+    CHECK(dec.begin_payload());
+
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_EQUALSTR(name, "bpa");
+    CHECK_RECORD(dec, RouterTLV::ATTRIBUTE);
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_value(&value));
+    CHECK_EQUALSTR(name, "eid");
+    CHECK_EQUALSTR(value, "dtn://a");
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_EQUALSTR(name, "bundle_delivered_event");
+    CHECK_RECORD(dec, RouterTLV::ATTRIBUTE);
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_value(&value));
+    CHECK_EQUALSTR(value, "42");
+    CHECK_RECORD(dec, RouterTLV::END);
+    CHECK_RECORD(dec, RouterTLV::END);
+    CHECK(! dec.done());
+
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_EQUALSTR(name, "x_extension");
+    CHECK_RECORD(dec, RouterTLV::TEXT);
+    CHECK(dec.get_value(&value));
+    CHECK_EQUALSTR(value, "hello");
+    CHECK_RECORD(dec, RouterTLV::END);
+    CHECK_RECORD(dec, RouterTLV::END);
+    CHECK(dec.done());
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Size) {
+    // a typical event is much smaller than its xml form
+    const char* xml =
+        "<bpa eid=\"dtn://host.dtn\"><bundle_delivered_event local_id="
+        "\"5181011492626546688\"><gbof_id creation_ts=\"5181011492626546688\""
+        " is_fragment=\"false\" frag_length=\"0\" frag_offset=\"0\">"
+        "<source uri=\"dtn://other.dtn/app\"/></gbof_id>"
+        "</bundle_delivered_event></bpa>";
+
+    std::string buf;
+    RouterTLV::Encoder enc(&buf);
+    enc.begin_payload();
+    enc.begin_element("bpa");
+    enc.attribute("eid", "dtn://host.dtn", 14);
+    enc.begin_element("bundle_delivered_event");
+    enc.attribute("local_id", "5181011492626546688", 19);
+    enc.begin_element("gbof_id");
+    enc.attribute("creation_ts", "5181011492626546688", 19);
+    enc.attribute("is_fragment", "false", 5);
+    enc.attribute("frag_length", "0", 1);
+    enc.attribute("frag_offset", "0", 1);
+    enc.begin_element("source");
+    enc.attribute("uri", "dtn://other.dtn/app", 19);
+    enc.end_element();
+    enc.end_element();
+    enc.end_element();
+    enc.end_element();
+
+    log_always_p("/test", "xml %zu bytes, binary %zu bytes",
+                 strlen(xml), buf.size());
+    CHECK(buf.size() * 2 < strlen(xml));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Malformed) {
+    std::string buf;
+    RouterTLV::Encoder enc(&buf);
+    enc.begin_payload();
+    enc.begin_element("bpa");
+    enc.attribute("eid", "dtn://a", 7);
+
+    std::string name, value;
+    RouterTLV::record_t type;
+
+    // truncated in the middle of the attribute value
+    RouterTLV::Decoder dec((u_char*)buf.data(), buf.size() - 2);
+    CHECK(dec.begin_payload());
+    CHECK(dec.get_record(&type));
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_record(&type));
+    CHECK(dec.get_name(&name));
+    CHECK(! dec.get_value(&value));
+
+    // wrong version
+    buf[1] = RouterTLV::VERSION + 1;
+    RouterTLV::Decoder dec2((u_char*)buf.data(), buf.size());
+    CHECK(! dec2.begin_payload());
+
+    // invalid record type and dictionary code
+    u_char bad[] = { RouterTLV::MAGIC, RouterTLV::VERSION, 9 };
+    RouterTLV::Decoder dec3(bad, sizeof(bad));
+    CHECK(dec3.begin_payload());
+    CHECK(! dec3.get_record(&type));
+
+    u_char bad2[] = { RouterTLV::MAGIC, RouterTLV::VERSION,
+                      RouterTLV::ELEMENT, 0x83, 0x00 };
+    RouterTLV::Decoder dec4(bad2, sizeof(bad2));
+    CHECK(dec4.begin_payload());
+    CHECK(dec4.get_record(&type));
+    CHECK(! dec4.get_name(&name));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Values) {
+    bool b;
+    int i;
+    unsigned char uc;
+    unsigned long long ull;
+
+    CHECK(RouterTLV::parse("true", &b) && b);
+    CHECK(RouterTLV::parse("0", &b) && ! b);
+    CHECK(! RouterTLV::parse("yes", &b));
+    CHECK(RouterTLV::parse("-5", &i));
+    CHECK_EQUAL(i, -5);
+    CHECK(! RouterTLV::parse("", &i));
+    CHECK(! RouterTLV::parse(" 5", &i));
+    CHECK(! RouterTLV::parse("5x", &i));
+    CHECK(! RouterTLV::parse("4294967296", &i));
+    CHECK(RouterTLV::parse("255", &uc));
+    CHECK_EQUAL(uc, 255);
+    CHECK(! RouterTLV::parse("256", &uc));
+    CHECK(! RouterTLV::parse("-1", &uc));
+    CHECK(RouterTLV::parse("18446744073709551615", &ull));
+    CHECK(! RouterTLV::parse("18446744073709551616", &ull));
+
+    // base64 of each length of partial group
+    const char* data[] = { "", "f", "fo", "foo", "foob" };
+    const char* text[] = { "", "Zg==", "Zm8=", "Zm9v", "Zm9vYg==" };
+    std::string value;
+    for (int n = 0; n < 5; ++n) {
+        CHECK_EQUALSTR(RouterTLV::base64_encode(data[n], strlen(data[n])),
+                       text[n]);
+        CHECK(RouterTLV::base64_decode(text[n], &value));
+        CHECK_EQUALSTR(value, data[n]);
+    }
+    CHECK(RouterTLV::base64_decode("Zm9v\nYg==", &value));
+    CHECK_EQUALSTR(value, "foob");
+    CHECK(! RouterTLV::base64_decode("Zg=", &value));
+    CHECK(! RouterTLV::base64_decode("Zg==Zg==", &value));
+    CHECK(! RouterTLV::base64_decode("Zm9*", &value));
+
+    // simple values, and an element that is skipped over whole
+    std::string buf;
+    RouterTLV::Encoder enc(&buf);
+    enc.begin_element("bpa");
+    enc.attribute_uint("hello_interval", 10);
+    enc.begin_element("link_query");
+    enc.begin_element("x_extension");
+    enc.text("hello", 5);
+    enc.end_element();
+    enc.end_element();
+    enc.element_int("length", -3);
+    enc.element("location", "");
+    enc.end_element();
+
+    RouterTLV::Decoder dec((u_char*)buf.data(), buf.size());
+    std::string name;
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_RECORD(dec, RouterTLV::ATTRIBUTE);
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_value(&value));
+    CHECK_EQUALSTR(value, "10");
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK_EQUALSTR(name, "link_query");
+    CHECK(dec.skip_element());
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_text(&value));
+    CHECK_EQUALSTR(value, "-3");
+    CHECK_RECORD(dec, RouterTLV::ELEMENT);
+    CHECK(dec.get_name(&name));
+    CHECK(dec.get_text(&value));
+    CHECK_EQUALSTR(value, "");
+    CHECK_RECORD(dec, RouterTLV::END);
+    CHECK(dec.done());
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(RouterTLVTest) {
+    ADD_TEST(Dictionary);
+    ADD_TEST(RoundTrip);
+    ADD_TEST(Size);
+    ADD_TEST(Malformed);
+    ADD_TEST(Values);
+}
+
+DECLARE_TEST_FILE(RouterTLVTest, "router tlv test");
@@ -0,0 +1,145 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <string>
+
+#include <oasys/util/UnitTest.h>
+
+#include "conv_layers/SendRing.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define RING_SIZE       1000
+#define RANDOM_ROUNDS   100000
+
+DECLARE_TEST(Basic) {
+    SendRing ring(10);
+    struct iovec iov[2];
+
+    CHECK_EQUAL(ring.freebytes(), 10);
+    CHECK_EQUAL(ring.tailbytes(), 10);
+    CHECK_EQUAL(ring.fill_iov(iov, 10), 0);
+
+    ring.append("abcdef", 6);
+    CHECK_EQUAL(ring.fullbytes(), 6);
+    CHECK_EQUAL(ring.tailbytes(), 4);
+
+    ring.consume(4);
+    CHECK_EQUAL(ring.fill_iov(iov, 10), 1);
+    CHECK_EQUAL(iov[0].iov_len, 2);
+    CHECK(memcmp(iov[0].iov_base, "ef", 2) == 0);
+
+    // the free space now wraps, so the contiguous tail is shorter
+    CHECK_EQUAL(ring.freebytes(), 8);
+    CHECK_EQUAL(ring.tailbytes(), 4);
+    ring.append("ghijklm", 7);
+    CHECK_EQUAL(ring.tailbytes(), 1);
+    CHECK_EQUAL(ring.fill_iov(iov, 10), 2);
+    CHECK_EQUAL(iov[0].iov_len, 6);
+    CHECK_EQUAL(iov[1].iov_len, 3);
+    CHECK(memcmp(iov[0].iov_base, "efghij", 6) == 0);
+    CHECK(memcmp(iov[1].iov_base, "klm", 3) == 0);
+
+    // limited to max_len
+    CHECK_EQUAL(ring.fill_iov(iov, 4), 1);
+    CHECK_EQUAL(iov[0].iov_len, 4);
+
+    // an emptied ring starts over at the front
+    ring.consume(9);
+    CHECK_EQUAL(ring.fullbytes(), 0);
+    CHECK_EQUAL(ring.tailbytes(), 10);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Segments) {
+    SendRing ring(100);
+
+    ring.append("1111", 4);
+    ring.end_segment();
+    ring.end_segment(); // no-op, nothing new queued
+    ring.append("22", 2);
+    ring.end_segment();
+    ring.append("3", 1);
+    CHECK_EQUAL(ring.segments(), 2);
+
+    ring.consume(3);
+    CHECK_EQUAL(ring.segments(), 2);
+    ring.consume(1);
+    CHECK_EQUAL(ring.segments(), 1);
+    ring.consume(3);
+    CHECK_EQUAL(ring.segments(), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Random) {
+    SendRing ring(RING_SIZE);
+    std::string in, out;
+    struct iovec iov[2];
+    u_char buf[RING_SIZE];
+
+    // write and drain random amounts, filling in place through tail()
+    // half the time, and check the byte stream comes out unchanged
+    srandom(3);
+    for (int round = 0; round < RANDOM_ROUNDS; ++round) {
+        size_t len = random() % (ring.freebytes() + 1);
+        for (size_t i = 0; i < len; ++i) {
+            buf[i] = random() & 0xff;
+        }
+
+        if (random() % 2) {
+            ring.append(buf, len);
+        } else {
+            len = std::min(len, ring.tailbytes());
+            memcpy(ring.tail(), buf, len);
+            ring.fill(len);
+        }
+        in.append((char*)buf, len);
+
+        size_t drain = random() % (ring.fullbytes() + 1);
+        int iovcnt = ring.fill_iov(iov, drain);
+        size_t total = 0;
+        for (int i = 0; i < iovcnt; ++i) {
+            out.append((char*)iov[i].iov_base, iov[i].iov_len);
+            total += iov[i].iov_len;
+        }
+        CHECK_EQUAL(total, drain);
+        ring.consume(drain);
+        CHECK_EQUAL(ring.fullbytes() + ring.freebytes(), RING_SIZE);
+    }
+
+    CHECK(in.compare(0, out.size(), out) == 0);
+    CHECK_EQUAL(in.size() - out.size(), ring.fullbytes());
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(SendRingTest) {
+    ADD_TEST(Basic);
+    ADD_TEST(Segments);
+    ADD_TEST(Random);
+}
+
+DECLARE_TEST_FILE(SendRingTest, "send ring test");
@@ -0,0 +1,137 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <string.h>
+#include <pthread.h>
+
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "bundling/TraceRing.h"
+
+using namespace oasys;
+using namespace dtn;
+
+#define THREADS         4
+#define PER_THREAD      100000
+
+DECLARE_TEST(Disabled) {
+    TraceRing::set_enabled(false);
+    TraceRing::instance()->clear();
+
+    DTN_TRACE(BLOCK_GENERATE, 1, 2, 3);
+    CHECK_EQUAL(TraceRing::instance()->recorded(), 0);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Record) {
+    TraceRing::set_enabled(true);
+    TraceRing::instance()->clear();
+
+    DTN_TRACE(BLOCK_GENERATE, 17, 1, 4096);
+    DTN_SEGMENT_TRACE(SEGMENT_SEND, 17, 0, 1024);
+    CHECK_EQUAL(TraceRing::instance()->recorded(), DTN_TRACE_SEGMENTS ? 2 : 1);
+
+    StringBuffer buf;
+    TraceRing::instance()->dump(&buf);
+    log_always_p("/test", "%s", buf.c_str());
+    CHECK(strstr(buf.c_str(), "block_generate bundle 17 type 1 length 4096")
+          != NULL);
+#if DTN_TRACE_SEGMENTS
+    CHECK(strstr(buf.c_str(), "segment_send bundle 17 offset 0 length 1024")
+          != NULL);
+#endif
+
+    // only the most recent record
+    StringBuffer last;
+    TraceRing::instance()->dump(&last, 1);
+    CHECK(strstr(last.c_str(), "showing 1\n") != NULL);
+#if DTN_TRACE_SEGMENTS
+    CHECK(strstr(last.c_str(), "block_generate") == NULL);
+#endif
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Wrap) {
+    TraceRing::set_enabled(true);
+    TraceRing::instance()->clear();
+
+    for (u_int32_t i = 0; i < TraceRing::SIZE + 10; ++i) {
+        DTN_TRACE(DATA_RECV, i, 0, 0);
+    }
+
+    // the oldest records were overwritten
+    StringBuffer buf;
+    TraceRing::instance()->dump(&buf);
+    CHECK(strstr(buf.c_str(), "data_recv todo 9 ") == NULL);
+    CHECK(strstr(buf.c_str(), "data_recv todo 10 ") != NULL);
+
+    return UNIT_TEST_PASSED;
+}
+
+void*
+record_thread(void* arg)
+{
+    u_int64_t id = (u_int64_t)(size_t)arg;
+    for (u_int64_t i = 0; i < PER_THREAD; ++i) {
+        DTN_TRACE(DATA_SEND, id, i, 0);
+    }
+    return NULL;
+}
+
+DECLARE_TEST(Concurrent) {
+    TraceRing::set_enabled(true);
+    TraceRing::instance()->clear();
+
+    oasys::Time t0;
+    t0.get_time();
+
+    // dump while the threads record, which must skip torn records
+    pthread_t threads[THREADS];
+    for (size_t i = 0; i < THREADS; ++i) {
+        pthread_create(&threads[i], NULL, record_thread, (void*)i);
+    }
+    for (int i = 0; i < 10; ++i) {
+        StringBuffer buf;
+        TraceRing::instance()->dump(&buf, 100);
+    }
+    for (size_t i = 0; i < THREADS; ++i) {
+        pthread_join(threads[i], NULL);
+    }
+
+    u_int32_t elapsed = t0.elapsed_ms();
+    CHECK_EQUAL(TraceRing::instance()->recorded(), THREADS * PER_THREAD);
+    log_always_p("/test", "%u records from %u threads in %u ms",
+                 THREADS * PER_THREAD, THREADS, elapsed);
+
+    TraceRing::set_enabled(false);
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(TraceRingTest) {
+    ADD_TEST(Disabled);
+    ADD_TEST(Record);
+    ADD_TEST(Wrap);
+    ADD_TEST(Concurrent);
+}
+
+DECLARE_TEST_FILE(TraceRingTest, "trace ring test");
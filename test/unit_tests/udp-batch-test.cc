@@ -0,0 +1,413 @@
+/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+
+#ifdef HAVE_CONFIG_H
+#  include <dtn-config.h>
+#endif
+
+#include <string>
+#include <vector>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <arpa/inet.h>
+
+#include <oasys/storage/DurableStore.h>
+#include <oasys/thread/MsgQueue.h>
+#include <oasys/thread/Timer.h>
+#include <oasys/util/UnitTest.h>
+#include <oasys/util/Time.h>
+
+#include "bundling/Bundle.h"
+#include "bundling/BundleActions.h"
+#include "bundling/BundleDaemon.h"
+#include "bundling/BundleEvent.h"
+#include "bundling/BundleProtocol.h"
+#include "contacts/InterfaceTable.h"
+#include "contacts/Link.h"
+#include "conv_layers/UDPConvergenceLayer.h"
+#include "storage/BundleStore.h"
+#include "storage/DTNStorageConfig.h"
+#include "storage/GlobalStore.h"
+
+#include "TestDaemon.h"
+
+using namespace oasys;
+using namespace dtn;
+
+typedef UDPConvergenceLayer::DatagramRing DatagramRing;
+
+int sender_fd   = -1;
+int receiver_fd = -1;
+u_int16_t receiver_port = 0;
+
+#define BATCH        32
+#define BENCH_LEN    64
+#define BENCH_COUNT  500000
+#define CL_BATCH     8
+
+TestDaemon*          daemon_ = NULL;
+UDPConvergenceLayer* cl      = NULL;
+
+/**
+ * Make a bundle with a payload that identifies it.
+ */
+Bundle*
+new_bundle(int i)
+{
+    Bundle* b = new Bundle(BundlePayload::MEMORY);
+    b->mutable_source()->assign("dtn://source.dtn/test");
+    b->mutable_dest()->assign("dtn://dest.dtn/test");
+
+    char payload[64];
+    snprintf(payload, sizeof(payload), "udp batch test bundle %d", i);
+    b->mutable_payload()->set_data(payload);
+    b->add_ref("test");
+    return b;
+}
+
+/**
+ * Copy out a bundle's payload.
+ */
+std::string
+payload_of(Bundle* b)
+{
+    u_char buf[64];
+    size_t len = b->payload().length();
+    ASSERT(len <= sizeof(buf));
+    const u_char* data = b->payload().read_data(0, len, buf);
+    return std::string((const char*)data, len);
+}
+
+/**
+ * Queue a bundle on the link as BundleActions::queue_bundle does, and
+ * return its wire image.
+ */
+std::string
+queue_bundle(Bundle* b, const LinkRef& link)
+{
+    BlockInfoVec* blocks = BundleProtocol::prepare_blocks(b, link);
+    size_t len = BundleProtocol::generate_blocks(b, blocks, link);
+
+    std::string wire(len, '\0');
+    bool complete = false;
+    BundleProtocol::produce(b, blocks, (u_char*)&wire[0], 0, len, &complete);
+    ASSERT(complete);
+
+    BundleRef bref(b, "test");
+    link->add_to_queue(bref, len);
+    cl->bundle_queued(link, bref);
+    return wire;
+}
+
+DECLARE_TEST(Init) {
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+
+    receiver_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    CHECK(receiver_fd >= 0);
+
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+    CHECK_EQUAL(bind(receiver_fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    CHECK_EQUAL(getsockname(receiver_fd, (struct sockaddr*)&addr, &addrlen), 0);
+
+    receiver_port = ntohs(addr.sin_port);
+
+    sender_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    CHECK(sender_fd >= 0);
+    CHECK_EQUAL(connect(sender_fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+
+    daemon_ = new TestDaemon();
+    cl = new UDPConvergenceLayer();
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(RingSendRecv) {
+    DatagramRing out(8);
+    DatagramRing in(8);
+
+    for (size_t i = 0; i < 8; ++i) {
+        memset(out.buf(i), 'a' + i, i + 1);
+        out.set_len(i, i + 1);
+    }
+
+    CHECK_EQUAL(out.send(sender_fd, 8), 8);
+
+    size_t got = 0;
+    while (got < 8) {
+        int n = in.recv(receiver_fd);
+        CHECK(n > 0);
+        for (int i = 0; i < n; ++i, ++got) {
+            CHECK_EQUAL(in.len(i), got + 1);
+            CHECK_EQUAL(in.buf(i)[0], 'a' + got);
+            CHECK_EQUAL(in.buf(i)[got], 'a' + got);
+        }
+    }
+    CHECK_EQUAL(got, 8);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(LoopbackBenchmark) {
+    u_char buf[BENCH_LEN];
+    memset(buf, 'x', sizeof(buf));
+
+    // one send / recv syscall per datagram, in rounds of BATCH so the
+    // socket buffer never overflows
+    oasys::Time t0;
+    t0.get_time();
+    size_t received = 0;
+    for (int i = 0; i < BENCH_COUNT / BATCH; ++i) {
+        for (int j = 0; j < BATCH; ++j) {
+            CHECK_EQUAL(send(sender_fd, buf, BENCH_LEN, 0), BENCH_LEN);
+        }
+        for (int j = 0; j < BATCH; ++j) {
+            CHECK_EQUAL(recv(receiver_fd, buf, BENCH_LEN, 0), BENCH_LEN);
+            ++received;
+        }
+    }
+    u_int32_t single_ms = t0.elapsed_ms();
+    log_always_p("/test", "per-datagram: %zu datagrams in %u ms",
+                 received, single_ms);
+
+    // the same traffic through the batched datapath
+    DatagramRing out(BATCH);
+    DatagramRing in(BATCH);
+    for (size_t i = 0; i < BATCH; ++i) {
+        memset(out.buf(i), 'x', BENCH_LEN);
+        out.set_len(i, BENCH_LEN);
+    }
+
+    t0.get_time();
+    received = 0;
+    for (int i = 0; i < BENCH_COUNT / BATCH; ++i) {
+        CHECK_EQUAL(out.send(sender_fd, BATCH), BATCH);
+        int todo = BATCH;
+        while (todo > 0) {
+            int n = in.recv(receiver_fd);
+            CHECK(n > 0);
+            todo     -= n;
+            received += n;
+        }
+    }
+    u_int32_t batch_ms = t0.elapsed_ms();
+    log_always_p("/test", "batched (%u): %zu datagrams in %u ms",
+                 BATCH, received, batch_ms);
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(CLSend) {
+    char nexthop[64];
+    snprintf(nexthop, sizeof(nexthop), "127.0.0.1:%u", receiver_port);
+    const char* argv[] = { "batch_size=8" };
+    LinkRef link = Link::create_link("udp-batch", Link::OPPORTUNISTIC, cl,
+                                     nexthop, 1, argv);
+    CHECK(link != NULL);
+    link->set_state(Link::AVAILABLE);
+
+    BundleActions actions;
+    actions.open_link(link);
+    CHECK(link->contact() != NULL);
+
+    BundleEvent* event;
+    bool contact_up = false;
+    while (! contact_up && (event = daemon_->next_event()) != NULL) {
+        contact_up = (event->type_ == CONTACT_UP);
+        delete event;
+    }
+    CHECK(contact_up);
+
+    std::vector<Bundle*>     bundles;
+    std::vector<std::string> wires;
+
+    // a partial batch is held back until the daemon runs its timers,
+    // i.e. once it is done with the event that queued the bundles
+    for (int i = 0; i < CL_BATCH - 1; ++i) {
+        bundles.push_back(new_bundle(i));
+        wires.push_back(queue_bundle(bundles.back(), link));
+    }
+    u_char buf[UDPConvergenceLayer::MAX_BUNDLE_LEN];
+    CHECK(recv(receiver_fd, buf, sizeof(buf), MSG_DONTWAIT) < 0);
+    CHECK_EQUAL(link->queue()->size(), CL_BATCH - 1);
+
+    oasys::TimerSystem::instance()->run_expired_timers();
+    CHECK_EQUAL(link->queue()->size(), 0);
+
+    // each time a full batch is waiting it goes out right away, and
+    // the remainder is again left for the timer
+    for (int i = 0; i < 2 * CL_BATCH + 2; ++i) {
+        bundles.push_back(new_bundle(bundles.size()));
+        wires.push_back(queue_bundle(bundles.back(), link));
+    }
+    CHECK_EQUAL(link->queue()->size(), 2);
+
+    oasys::TimerSystem::instance()->run_expired_timers();
+    CHECK_EQUAL(link->queue()->size(), 0);
+    CHECK_EQUAL(link->inflight()->size(), bundles.size());
+
+    // the datagrams are the bundles' wire images, in queue order
+    DatagramRing in(CL_BATCH);
+    size_t got = 0;
+    while (got < wires.size()) {
+        int n = in.recv(receiver_fd);
+        CHECK(n > 0);
+        for (int i = 0; i < n; ++i, ++got) {
+            CHECK_EQUAL(in.len(i), wires[got].size());
+            CHECK(memcmp(in.buf(i), wires[got].data(), in.len(i)) == 0);
+        }
+    }
+
+    for (size_t i = 0; i < bundles.size(); ++i) {
+        event = daemon_->next_event();
+        CHECK(event != NULL);
+        CHECK_EQUAL(event->type_, BUNDLE_TRANSMITTED);
+        BundleTransmittedEvent* e = (BundleTransmittedEvent*)event;
+        CHECK(e->bundleref_.object() == bundles[i]);
+        CHECK_EQUAL(e->bytes_sent_, wires[i].size());
+        delete event;
+    }
+
+    actions.close_link(link);
+    for (size_t i = 0; i < bundles.size(); ++i) {
+        BundleRef bref(bundles[i], "test");
+        link->del_from_inflight(bref, wires[i].size());
+        BundleProtocol::delete_blocks(bundles[i], link);
+        free_bundle(bundles[i]);
+    }
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(CLReceive) {
+    // pick a free port for the interface
+    struct sockaddr_in addr;
+    socklen_t addrlen = sizeof(addr);
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    memset(&addr, 0, sizeof(addr));
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    CHECK_EQUAL(bind(fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+    CHECK_EQUAL(getsockname(fd, (struct sockaddr*)&addr, &addrlen), 0);
+    close(fd);
+
+    char port[32];
+    snprintf(port, sizeof(port), "local_port=%u", ntohs(addr.sin_port));
+    const char* argv[] = { "local_addr=127.0.0.1", port, "batch_size=8" };
+    CHECK(InterfaceTable::instance()->add("udp-batch", cl, "udp", 3, argv));
+
+    // send a few batches of bundles to the interface
+    LinkRef link("udp-batch-test");
+    DatagramRing out(CL_BATCH);
+    int out_fd = socket(AF_INET, SOCK_DGRAM, 0);
+    CHECK_EQUAL(connect(out_fd, (struct sockaddr*)&addr, sizeof(addr)), 0);
+
+    std::vector<std::string> payloads;
+    for (int round = 0; round < 4; ++round) {
+        for (int i = 0; i < CL_BATCH; ++i) {
+            Bundle* b = new_bundle(round * CL_BATCH + i);
+            BlockInfoVec* blocks = BundleProtocol::prepare_blocks(b, link);
+            size_t len = BundleProtocol::generate_blocks(b, blocks, link);
+            bool complete = false;
+            BundleProtocol::produce(b, blocks, out.buf(i), 0, len, &complete);
+            CHECK(complete);
+            out.set_len(i, len);
+
+            payloads.push_back(payload_of(b));
+
+            BundleProtocol::delete_blocks(b, link);
+            free_bundle(b);
+        }
+        CHECK_EQUAL(out.send(out_fd, CL_BATCH), CL_BATCH);
+    }
+    close(out_fd);
+
+    // the receiver posts each recvmmsg batch as one event (or a lone
+    // arrival on its own), with the bundles in arrival order
+    size_t got = 0;
+    while (got < payloads.size()) {
+        BundleEvent* event = daemon_->next_event();
+        CHECK(event != NULL);
+
+        std::vector<BundleReceivedEvent*> received;
+        if (event->type_ == BUNDLE_RECEIVED_BATCH) {
+            BundleReceivedBatchEvent* batch = (BundleReceivedBatchEvent*)event;
+            CHECK(batch->events_.size() > 1);
+            received.swap(batch->events_);
+            delete batch;
+        } else {
+            CHECK_EQUAL(event->type_, BUNDLE_RECEIVED);
+            received.push_back((BundleReceivedEvent*)event);
+        }
+
+        for (size_t i = 0; i < received.size(); ++i, ++got) {
+            Bundle* b = received[i]->bundleref_.object();
+            CHECK(got < payloads.size());
+            CHECK(payload_of(b) == payloads[got]);
+
+            b->add_ref("test");
+            delete received[i];
+            free_bundle(b);
+        }
+    }
+    CHECK_EQUAL(got, payloads.size());
+
+    CHECK(InterfaceTable::instance()->del("udp-batch"));
+
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TEST(Cleanup) {
+    close(sender_fd);
+    close(receiver_fd);
+    return UNIT_TEST_PASSED;
+}
+
+DECLARE_TESTER(UDPBatchTest) {
+    ADD_TEST(Init);
+    ADD_TEST(RingSendRecv);
+    ADD_TEST(LoopbackBenchmark);
+    ADD_TEST(CLSend);
+    ADD_TEST(CLReceive);
+    ADD_TEST(Cleanup);
+}
+
+int
+main(int argc, const char** argv)
+{
+    UDPBatchTest t("udp convergence layer batching test");
+    t.init(argc, argv, true);
+
+    system("rm -rf .udp-batch-test");
+    system("mkdir  .udp-batch-test");
+    DTNStorageConfig cfg("", "memorydb", "", "");
+    cfg.init_ = true;
+    cfg.payload_dir_.assign(".udp-batch-test");
+    cfg.leave_clean_file_ = false;
+    oasys::DurableStore ds("/test/ds");
+    ds.create_store(cfg);
+    GlobalStore::init(cfg, &ds);
+    BundleStore::init(cfg, &ds);
+    oasys::TimerSystem::create();
+    InterfaceTable::init();
+
+    t.run_tests();
+
+    system("rm -rf .udp-batch-test");
+}
@@ -0,0 +1,621 @@
+#!/usr/bin/python
+
+#
+#    Copyright 2026 The DTN2 Contributors
+#
+#    Licensed under the Apache License, Version 2.0 (the "License");
+#    you may not use this file except in compliance with the License.
+#    You may obtain a copy of the License at
+#
+#        http://www.apache.org/licenses/LICENSE-2.0
+#
+#    Unless required by applicable law or agreed to in writing, software
+#    distributed under the License is distributed on an "AS IS" BASIS,
+#    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+#    See the License for the specific language governing permissions and
+#    limitations under the License.
+#
+
+#
+# Generate the binary (RouterTLV) encoding and decoding functions for
+# the xsd C++/Tree bindings of an XML schema, so that messages can be
+# written and read straight from the object model without going
+# through a DOM.
+#
+# The schema gives the structure of each type (which members are
+# attributes and which are elements, and which are required), and the
+# xsd-generated header gives the C++ type and container of each
+# member. Only the subset of XML Schema used by router.xsd and
+# clevent.xsd is supported.
+#
+# usage: xsd-tlv.py <schema.xsd> <bindings.h> <namespace> <root>
+#                   <include> <guard> <output base name>
+#
+# e.g. (from servlib):
+#
+#   xsd-tlv.py routing/router.xsd routing/router.h dtn::rtrmessage bpa
+#       router-custom.h EXTERNAL_DP_ENABLED routing/router-tlv
+#
+
+import os
+import re
+import sys
+import xml.etree.ElementTree as ET
+
+XS = '{http://www.w3.org/2001/XMLSchema}'
+
+# C++ types of the built-in simple types, and how each is handled
+BUILTIN = {
+    '::xml_schema::boolean':        'parse',
+    '::xml_schema::byte':           'parse',
+    '::xml_schema::short_':         'parse',
+    '::xml_schema::int_':           'parse',
+    '::xml_schema::long_':          'parse',
+    '::xml_schema::integer':        'parse',
+    '::xml_schema::unsigned_byte':  'parse',
+    '::xml_schema::unsigned_short': 'parse',
+    '::xml_schema::unsigned_int':   'parse',
+    '::xml_schema::unsigned_long':  'parse',
+    '::xml_schema::string':         'string',
+    '::xml_schema::base64_binary':  'base64',
+    '::xml_schema::type':           'any',
+}
+
+# How the values of the parsed types are written
+FORMAT = {
+    '::xml_schema::boolean':        ('bool', 'bool'),
+    '::xml_schema::byte':           ('int', 'long long'),
+    '::xml_schema::short_':         ('int', 'long long'),
+    '::xml_schema::int_':           ('int', 'long long'),
+    '::xml_schema::long_':          ('int', 'long long'),
+    '::xml_schema::integer':        ('int', 'long long'),
+    '::xml_schema::unsigned_byte':  ('uint', 'unsigned long long'),
+    '::xml_schema::unsigned_short': ('uint', 'unsigned long long'),
+    '::xml_schema::unsigned_int':   ('uint', 'unsigned long long'),
+    '::xml_schema::unsigned_long':  ('uint', 'unsigned long long'),
+}
+
+def fail(msg):
+    sys.stderr.write('xsd-tlv: %s\n' % msg)
+    sys.exit(1)
+
+#----------------------------------------------------------------------
+# The xsd-generated header: the C++ type and container of each member
+# of each class.
+#----------------------------------------------------------------------
+def read_header(path, ns):
+    prefix = '::' + ns + '::'
+    classes = {}
+    cur = None
+    lines = open(path).read().split('\n')
+    i = 0
+    while i < len(lines):
+        line = lines[i]
+        m = re.match(r'^    class (\w+): public ', line)
+        if m:
+            cur = classes.setdefault(m.group(1), {})
+        m = re.match(r'^      struct (\w+)$', line)
+        if m and cur is not None and lines[i + 1].strip() == '{':
+            member = m.group(1)
+            tm = re.match(r'^\s+typedef (.+) (type_?);$', lines[i + 2])
+            if tm is None:
+                i += 1
+                continue
+            ctype = tm.group(1)
+            if ctype.startswith(prefix):
+                ctype = ctype[len(prefix):]
+            container = 'one'
+            j = i + 3
+            while lines[j].strip() != '};':
+                cm = re.search(r'::xsd::cxx::tree::(optional|sequence)<', lines[j])
+                if cm:
+                    container = cm.group(1)
+                j += 1
+            cur[member] = (ctype, container)
+            i = j
+        i += 1
+    return classes
+
+#----------------------------------------------------------------------
+# The schema: the members of each complex type.
+#----------------------------------------------------------------------
+class Member:
+    def __init__(self, name, is_attr, xtype, container):
+        self.name      = name
+        self.is_attr   = is_attr
+        self.xtype     = xtype      # schema type name
+        self.container = container  # one, optional or sequence
+        self.ctype     = None       # C++ type, from the header
+
+class Schema:
+    def __init__(self, path):
+        root = ET.parse(path).getroot()
+        self.simple   = {}     # name -> 'enum', 'string' or 'integer'
+        self.complex  = {}     # name -> complexType node
+        self.groups   = {}     # name -> attributeGroup node
+        self.elements = {}     # name -> element node
+        self.order    = []     # complex types, in schema order
+
+        for node in root:
+            name = node.get('name')
+            if node.tag == XS + 'simpleType':
+                self.simple[name] = self.simple_kind(node)
+            elif node.tag == XS + 'complexType':
+                self.complex[name] = node
+                self.order.append(name)
+            elif node.tag == XS + 'attributeGroup':
+                self.groups[name] = node
+            elif node.tag == XS + 'element':
+                self.elements[name] = node
+                if node.find(XS + 'complexType') is not None:
+                    self.order.append(name)
+
+    def simple_kind(self, node):
+        r = node.find(XS + 'restriction')
+        if r is not None:
+            if r.find(XS + 'enumeration') is not None:
+                return 'enum'
+            if r.get('base') == 'xs:integer':
+                return 'integer'
+            return 'string'
+        if node.find(XS + 'union') is not None:
+            return 'string'
+        fail('unsupported simple type %s' % node.get('name'))
+
+    def type_node(self, name):
+        if name in self.complex:
+            return self.complex[name]
+        return self.elements[name].find(XS + 'complexType')
+
+    def element_type(self, node):
+        ref = node.get('ref')
+        if ref is not None:
+            target = self.elements[ref]
+            if target.get('type') is not None:
+                return ref, target.get('type')
+            return ref, ref
+        if node.get('type') is None:
+            fail('anonymous nested type for %s' % node.get('name'))
+        return node.get('name'), node.get('type')
+
+    def members(self, name):
+        members = []
+        self.add_content(self.type_node(name), members, False)
+        return members
+
+    def add_content(self, node, members, optional):
+        for child in node:
+            tag = child.tag[len(XS):]
+            if tag in ('annotation', 'documentation'):
+                continue
+            elif tag == 'attribute':
+                container = 'one'
+                if child.get('use') != 'required':
+                    container = 'optional'
+                members.append(Member(child.get('name'), True,
+                                      child.get('type'), container))
+            elif tag == 'attributeGroup':
+                self.add_content(self.groups[child.get('ref')], members,
+                                 optional)
+            elif tag in ('sequence', 'all'):
+                self.add_content(child, members,
+                                 optional or child.get('minOccurs') == '0')
+            elif tag == 'choice':
+                if child.get('maxOccurs') not in (None, '1'):
+                    fail('repeated choice in %s' % node.get('name'))
+                self.add_content(child, members, True)
+            elif tag == 'element':
+                name, xtype = self.element_type(child)
+                if child.get('maxOccurs') not in (None, '1'):
+                    container = 'sequence'
+                elif optional or child.get('minOccurs') == '0':
+                    container = 'optional'
+                else:
+                    container = 'one'
+                m = Member(name, False, xtype, container)
+                m.min_one = (container == 'sequence' and not optional and
+                             child.get('minOccurs') not in ('0',))
+                members.append(m)
+            else:
+                fail('unsupported schema construct %s' % tag)
+
+#----------------------------------------------------------------------
+# Code generation.
+#----------------------------------------------------------------------
+class Generator:
+    def __init__(self, schema, header, ns, root):
+        self.schema = schema
+        self.header = header
+        self.ns     = ns
+        self.root   = root
+        self.out    = []
+
+        # the class for each type, and its members
+        self.types = []
+        for name in schema.order:
+            cls = name
+            if name + '_base' in header:
+                cls = name + '_base'
+            if cls not in header:
+                fail('no class for %s in the header' % name)
+            members = schema.members(name)
+            for m in members:
+                if m.name not in header[cls]:
+                    fail('no member %s in %s' % (m.name, cls))
+                m.ctype, container = header[cls][m.name]
+                if container != m.container:
+                    fail('%s::%s is %s in the header, %s in the schema' %
+                         (cls, m.name, container, m.container))
+                m.kind = self.kind(m)
+            self.types.append((name, members))
+
+    def kind(self, m):
+        if m.ctype in BUILTIN:
+            return BUILTIN[m.ctype]
+        if m.ctype in self.schema.simple:
+            return self.schema.simple[m.ctype]
+        if m.ctype in self.schema.complex or m.ctype in self.schema.elements:
+            return 'complex'
+        fail('unsupported type %s for %s' % (m.ctype, m.name))
+
+    def emit(self, s=''):
+        self.out.append(s)
+
+    def separator(self):
+        self.emit('//' + '-' * 70)
+
+    #------------------------------------------------------------------
+    def encode_value(self, m, expr):
+        """Return the statement that writes a simple value."""
+        what = m.is_attr and 'attribute' or 'element'
+        if m.kind == 'parse':
+            fmt, cast = FORMAT[m.ctype]
+            return 'enc->%s_%s("%s", (%s)%s);' % (what, fmt, m.name, cast,
+                                                  expr)
+        if m.kind == 'integer':
+            return ('enc->%s_int("%s", (long long)static_cast< '
+                    '::xml_schema::integer >(%s));' % (what, m.name, expr))
+        if m.kind in ('string', 'enum'):
+            return ('enc->%s("%s", static_cast< const std::string& >(%s));'
+                    % (what, m.name, expr))
+        if m.kind == 'base64':
+            return ('enc->%s("%s", RouterTLV::base64_encode(%s.data(), '
+                    '%s.size()));' % (what, m.name, expr, expr))
+        fail('no simple encoding for %s' % m.name)
+
+    def encode_member(self, m, expr, indent):
+        pad = ' ' * indent
+        if m.kind == 'complex':
+            self.emit(pad + 'enc->begin_element("%s");' % m.name)
+            self.emit(pad + 'encode(%s, enc);' % expr)
+            self.emit(pad + 'enc->end_element();')
+        elif m.kind == 'any':
+            self.emit(pad + 'enc->begin_element("%s");' % m.name)
+            self.emit(pad + 'enc->end_element();')
+        else:
+            self.emit(pad + self.encode_value(m, expr))
+
+    def gen_encode(self, name, members):
+        self.separator()
+        self.emit('static void')
+        self.emit('encode(const %s& x, RouterTLV::Encoder* enc)' % name)
+        self.emit('{')
+        if not members:
+            self.emit('    (void)x;')
+            self.emit('    (void)enc;')
+
+        # attributes come first within the element
+        ordered = ([m for m in members if m.is_attr] +
+                   [m for m in members if not m.is_attr])
+        for m in ordered:
+            acc = 'x.%s()' % m.name
+            if m.container == 'one':
+                self.encode_member(m, acc, 4)
+            elif m.container == 'optional':
+                self.emit('    if (%s.present()) {' % acc)
+                self.encode_member(m, acc + '.get()', 8)
+                self.emit('    }')
+            else:
+                self.emit('    for (%s::%s::const_iterator i = %s.begin();'
+                          % (name, m.name, acc))
+                self.emit('         i != %s.end(); ++i)' % acc)
+                self.emit('    {')
+                self.encode_member(m, '*i', 8)
+                self.emit('    }')
+        self.emit('}')
+        self.emit()
+
+    #------------------------------------------------------------------
+    def decode_value(self, m, pad):
+        """Emit the statements that convert the text of a simple value
+        into v."""
+        if m.kind == 'parse':
+            self.emit(pad + '%s v;' % m.ctype)
+            self.emit(pad + 'if (! RouterTLV::parse(text, &v)) {')
+            self.emit(pad + '    return false;')
+            self.emit(pad + '}')
+        elif m.kind == 'integer':
+            self.emit(pad + '::xml_schema::integer i;')
+            self.emit(pad + 'if (! RouterTLV::parse(text, &i)) {')
+            self.emit(pad + '    return false;')
+            self.emit(pad + '}')
+            self.emit(pad + '%s v(i);' % m.ctype)
+        elif m.kind == 'string':
+            self.emit(pad + '%s v(text);' % m.ctype)
+        elif m.kind == 'enum':
+            # converting to the enum checks the value
+            self.emit(pad + '%s v((::xml_schema::string(text)));' % m.ctype)
+            self.emit(pad + '(void)static_cast< %s::_xsd_%s >(v);'
+                      % (m.ctype, m.ctype))
+        elif m.kind == 'base64':
+            self.emit(pad + 'std::string data;')
+            self.emit(pad + 'if (! RouterTLV::base64_decode(text, &data)) {')
+            self.emit(pad + '    return false;')
+            self.emit(pad + '}')
+            self.emit(pad + '%s v(data.data(), data.size());' % m.ctype)
+        else:
+            fail('no simple decoding for %s' % m.name)
+
+    def decode_member(self, m, bit, pad):
+        if m.kind == 'complex':
+            if m.container == 'sequence':
+                self.emit(pad + '%s c;' % m.ctype)
+                self.emit(pad + 'if (! decode(dec, &c)) {')
+                self.emit(pad + '    return false;')
+                self.emit(pad + '}')
+                self.emit(pad + 'x->%s().push_back(c);' % m.name)
+            else:
+                self.emit(pad + 'std::auto_ptr< %s > c(new %s());'
+                          % (m.ctype, m.ctype))
+                self.emit(pad + 'if (! decode(dec, c.get())) {')
+                self.emit(pad + '    return false;')
+                self.emit(pad + '}')
+                self.emit(pad + 'x->%s(c);' % m.name)
+        elif m.kind == 'any':
+            self.emit(pad + 'if (! dec->skip_element()) {')
+            self.emit(pad + '    return false;')
+            self.emit(pad + '}')
+            self.emit(pad + 'x->%s(%s());' % (m.name, m.ctype))
+        else:
+            if not m.is_attr:
+                self.emit(pad + 'if (! dec->get_text(&text)) {')
+                self.emit(pad + '    return false;')
+                self.emit(pad + '}')
+            self.decode_value(m, pad)
+            if m.container == 'sequence':
+                self.emit(pad + 'x->%s().push_back(v);' % m.name)
+            else:
+                self.emit(pad + 'x->%s(v);' % m.name)
+        if bit is not None:
+            self.emit(pad + 'seen |= 0x%xULL;' % (1 << bit))
+
+    def decode_dispatch(self, members, bits, pad):
+        first = True
+        for m in members:
+            cond = 'name == "%s"' % m.name
+            self.emit(pad + (first and 'if (%s) {' or '} else if (%s) {')
+                      % cond)
+            self.decode_member(m, bits.get(m.name), pad + '    ')
+            first = False
+
+    def gen_decode(self, name, members):
+        attrs = [m for m in members if m.is_attr]
+        elems = [m for m in members if not m.is_attr]
+
+        bits = {}
+        for m in members:
+            if m.container == 'one' or getattr(m, 'min_one', False):
+                bits[m.name] = len(bits)
+        if len(bits) > 64:
+            fail('too many required members in %s' % name)
+        required = (1 << len(bits)) - 1
+
+        self.separator()
+        self.emit('static bool')
+        self.emit('decode(RouterTLV::Decoder* dec, %s* x)' % name)
+        self.emit('{')
+        if not members:
+            self.emit('    (void)x;')
+        if bits:
+            self.emit('    u_int64_t seen = 0;')
+        self.emit('    RouterTLV::record_t type;')
+        self.emit('    std::string name, text;')
+        self.emit()
+        self.emit('    while (dec->get_record(&type)) {')
+        self.emit('        if (type == RouterTLV::END) {')
+        if bits:
+            self.emit('            return seen == 0x%xULL;' % required)
+        else:
+            self.emit('            return true;')
+        self.emit('        }')
+        self.emit()
+        self.emit('        // character data around the elements is ignored')
+        self.emit('        if (type == RouterTLV::TEXT) {')
+        self.emit('            if (! dec->get_value(&text)) {')
+        self.emit('                return false;')
+        self.emit('            }')
+        self.emit('            continue;')
+        self.emit('        }')
+        self.emit()
+        self.emit('        if (! dec->get_name(&name)) {')
+        self.emit('            return false;')
+        self.emit('        }')
+        self.emit()
+        self.emit('        // as with the xsd parser, unknown attributes are '
+                  'ignored')
+        self.emit('        if (type == RouterTLV::ATTRIBUTE) {')
+        self.emit('            if (! dec->get_value(&text)) {')
+        self.emit('                return false;')
+        self.emit('            }')
+        if attrs:
+            self.decode_dispatch(attrs, bits, ' ' * 12)
+            self.emit('            }')
+        self.emit('            continue;')
+        self.emit('        }')
+        self.emit()
+        if elems:
+            self.decode_dispatch(elems, bits, ' ' * 8)
+            self.emit('        } else {')
+            self.emit('            return false;')
+            self.emit('        }')
+        else:
+            self.emit('        return false;')
+        self.emit('    }')
+        self.emit()
+        self.emit('    return false;')
+        self.emit('}')
+        self.emit()
+
+    #------------------------------------------------------------------
+    def gen_cc(self, header_name, guard, xsd_name):
+        self.emit(COPYRIGHT)
+        self.emit(GENERATED % (os.path.basename(sys.argv[0]), xsd_name))
+        self.emit()
+        self.emit('#ifdef HAVE_CONFIG_H')
+        self.emit('#  include <dtn-config.h>')
+        self.emit('#endif')
+        self.emit()
+        self.emit('#if defined(XERCES_C_ENABLED) && defined(%s)' % guard)
+        self.emit()
+        self.emit('#include "%s"' % header_name)
+        self.emit()
+        for part in self.ns.split('::'):
+            self.emit('namespace %s {' % part)
+        self.emit()
+
+        # prototypes, since the types refer to each other
+        for name, members in self.types:
+            self.emit('static void encode(const %s& x, RouterTLV::Encoder* '
+                      'enc);' % name)
+            self.emit('static bool decode(RouterTLV::Decoder* dec, %s* x);'
+                      % name)
+        self.emit()
+
+        for name, members in self.types:
+            self.gen_encode(name, members)
+            self.gen_decode(name, members)
+
+        root = self.root
+        self.separator()
+        self.emit('void')
+        self.emit('%s_tlv(const %s& message, RouterTLV::Encoder* enc)'
+                  % (root, root))
+        self.emit('{')
+        self.emit('    enc->begin_element("%s");' % root)
+        self.emit('    encode(message, enc);')
+        self.emit('    enc->end_element();')
+        self.emit('}')
+        self.emit()
+        self.separator()
+        self.emit('std::auto_ptr< %s >' % root)
+        self.emit('%s_tlv(RouterTLV::Decoder* dec)' % root)
+        self.emit('{')
+        self.emit('    std::auto_ptr< %s > message;' % root)
+        self.emit()
+        self.emit('    RouterTLV::record_t type;')
+        self.emit('    std::string name;')
+        self.emit('    if (! dec->get_record(&type) || type != '
+                  'RouterTLV::ELEMENT ||')
+        self.emit('        ! dec->get_name(&name) || name != "%s")' % root)
+        self.emit('    {')
+        self.emit('        return message;')
+        self.emit('    }')
+        self.emit()
+        self.emit('    message.reset(new %s());' % root)
+        self.emit('    try {')
+        self.emit('        if (! decode(dec, message.get())) {')
+        self.emit('            message.reset();')
+        self.emit('        }')
+        self.emit('    } catch (::xml_schema::exception&) {')
+        self.emit('        // an unknown enumeration value')
+        self.emit('        message.reset();')
+        self.emit('    }')
+        self.emit()
+        self.emit('    return message;')
+        self.emit('}')
+        self.emit()
+        for part in reversed(self.ns.split('::')):
+            self.emit('} // namespace %s' % part)
+        self.emit()
+        self.emit('#endif // XERCES_C_ENABLED && %s' % guard)
+
+    def gen_h(self, include, guard, xsd_name, macro):
+        root = self.root
+        self.emit(COPYRIGHT)
+        self.emit(GENERATED % (os.path.basename(sys.argv[0]), xsd_name))
+        self.emit()
+        self.emit('#ifndef %s' % macro)
+        self.emit('#define %s' % macro)
+        self.emit()
+        self.emit('#if defined(XERCES_C_ENABLED) && defined(%s)' % guard)
+        self.emit()
+        self.emit('#include <memory>')
+        self.emit('#include "%s"' % include)
+        self.emit('#include "routing/RouterTLV.h"')
+        self.emit()
+        for part in self.ns.split('::'):
+            self.emit('namespace %s {' % part)
+        self.emit()
+        self.emit('/**')
+        self.emit(' * Append the records for a %s message to a binary '
+                  'payload.' % root)
+        self.emit(' */')
+        self.emit('void %s_tlv(const %s& message, RouterTLV::Encoder* enc);'
+                  % (root, root))
+        self.emit()
+        self.emit('/**')
+        self.emit(' * Read the next %s message of a binary payload. Returns '
+                  'NULL if' % root)
+        self.emit(' * the records are malformed or do not match the schema.')
+        self.emit(' */')
+        self.emit('std::auto_ptr< %s > %s_tlv(RouterTLV::Decoder* dec);'
+                  % (root, root))
+        self.emit()
+        for part in reversed(self.ns.split('::')):
+            self.emit('} // namespace %s' % part)
+        self.emit()
+        self.emit('#endif // XERCES_C_ENABLED && %s' % guard)
+        self.emit()
+        self.emit('#endif /* %s */' % macro)
+
+COPYRIGHT = '''/*
+ *    Copyright 2026 The DTN2 Contributors
+ *
+ *    Licensed under the Apache License, Version 2.0 (the "License");
+ *    you may not use this file except in compliance with the License.
+ *    You may obtain a copy of the License at
+ *
+ *        http://www.apache.org/licenses/LICENSE-2.0
+ *
+ *    Unless required by applicable law or agreed to in writing, software
+ *    distributed under the License is distributed on an "AS IS" BASIS,
+ *    WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *    See the License for the specific language governing permissions and
+ *    limitations under the License.
+ */
+'''
+
+GENERATED = '''// Generated by tools/%s from %s, do not edit. Regenerate with
+// "make tlvbindings" in servlib after the xsd bindings change.'''
+
+def main():
+    if len(sys.argv) != 8:
+        fail('usage: xsd-tlv.py <schema.xsd> <bindings.h> <namespace> '
+             '<root> <include> <guard> <output base name>')
+    xsd, bindings, ns, root, include, guard, base = sys.argv[1:]
+
+    schema = Schema(xsd)
+    header = read_header(bindings, ns)
+    xsd_name = os.path.basename(xsd)
+    basename = os.path.basename(base)
+    macro = '_' + re.sub(r'[^A-Z0-9]', '_', basename.upper()) + '_BINDINGS_H_'
+
+    gen = Generator(schema, header, ns, root)
+    gen.gen_h(include, guard, xsd_name, macro)
+    open(base + '.h', 'w').write('\n'.join(gen.out) + '\n')
+
+    gen = Generator(schema, header, ns, root)
+    gen.gen_cc(basename + '.h', guard, xsd_name)
+    open(base + '.cc', 'w').write('\n'.join(gen.out) + '\n')
+
+main()